@@ -321,7 +321,10 @@ enum {
     D_SHA1,
     D_RMD160,
     D_SHA256,
+    D_SHA384,
     D_SHA512,
+    D_SHA3_256,
+    D_SHA3_512,
     D_WHIRLPOOL,
     D_HMAC,
     D_CBC_DES,
@@ -345,17 +348,21 @@ enum {
     D_EVP_CMAC,
     D_KMAC128,
     D_KMAC256,
+    D_SHAKE128,
+    D_SHAKE256,
     ALGOR_NUM
 };
 /* name of algorithms to test. MUST BE KEEP IN SYNC with above enum ! */
 static const char *names[ALGOR_NUM] = {
     "md2", "mdc2", "md4", "md5", "sha1", "rmd160",
-    "sha256", "sha512", "whirlpool", "hmac(sha256)",
+    "sha256", "sha384", "sha512", "sha3-256", "sha3-512", "whirlpool",
+    "hmac(sha256)",
     "des-cbc", "des-ede3", "rc4", "idea-cbc", "seed-cbc",
     "rc2-cbc", "rc5-cbc", "blowfish", "cast-cbc",
     "aes-128-cbc", "aes-192-cbc", "aes-256-cbc",
     "camellia-128-cbc", "camellia-192-cbc", "camellia-256-cbc",
-    "evp", "ghash", "rand", "cmac", "kmac128", "kmac256"
+    "evp", "ghash", "rand", "cmac", "kmac128", "kmac256",
+    "shake128-squeeze", "shake256-squeeze"
 };
 
 /* list of configured algorithm (remaining), with some few alias */
@@ -367,7 +374,12 @@ static const OPT_PAIR doit_choices[] = {
     { "hmac", D_HMAC },
     { "sha1", D_SHA1 },
     { "sha256", D_SHA256 },
+    { "sha384", D_SHA384 },
     { "sha512", D_SHA512 },
+    { "sha3-256", D_SHA3_256 },
+    { "sha3-512", D_SHA3_512 },
+    { "shake128-squeeze", D_SHAKE128 },
+    { "shake256-squeeze", D_SHAKE256 },
     { "whirlpool", D_WHIRLPOOL },
     { "ripemd", D_RMD160 },
     { "rmd160", D_RMD160 },
@@ -850,11 +862,69 @@ static int SHA256_loop(void *args)
     return EVP_Digest_loop("sha256", D_SHA256, args);
 }
 
+static int SHA384_loop(void *args)
+{
+    return EVP_Digest_loop("sha384", D_SHA384, args);
+}
+
 static int SHA512_loop(void *args)
 {
     return EVP_Digest_loop("sha512", D_SHA512, args);
 }
 
+static int SHA3_256_loop(void *args)
+{
+    return EVP_Digest_loop("sha3-256", D_SHA3_256, args);
+}
+
+static int SHA3_512_loop(void *args)
+{
+    return EVP_Digest_loop("sha3-512", D_SHA3_512, args);
+}
+
+/*
+ * Squeeze-bound XOF use, as in the ML-KEM and ML-DSA matrix and vector
+ * expansion: absorb a short seed and squeeze |lengths[testnum]| bytes.
+ */
+static int EVP_Digest_squeeze_loop(const char *mdname, int algindex, void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **)args;
+    unsigned char *buf = tempargs->buf;
+    unsigned char *buf2 = tempargs->buf2;
+    int count;
+    EVP_MD *md = NULL;
+    EVP_MD_CTX *ctx = NULL;
+
+    if (!opt_md_silent(mdname, &md))
+        return -1;
+    if ((ctx = EVP_MD_CTX_new()) == NULL) {
+        count = -1;
+        goto out;
+    }
+    for (count = 0; COND(c[algindex][testnum]); count++) {
+        if (!EVP_DigestInit_ex2(ctx, md, NULL)
+            || !EVP_DigestUpdate(ctx, buf, 32)
+            || !EVP_DigestSqueeze(ctx, buf2, (size_t)lengths[testnum])) {
+            count = -1;
+            break;
+        }
+    }
+out:
+    EVP_MD_free(md);
+    EVP_MD_CTX_free(ctx);
+    return count;
+}
+
+static int SHAKE128_squeeze_loop(void *args)
+{
+    return EVP_Digest_squeeze_loop("shake128", D_SHAKE128, args);
+}
+
+static int SHAKE256_squeeze_loop(void *args)
+{
+    return EVP_Digest_squeeze_loop("shake256", D_SHAKE256, args);
+}
+
 static int WHIRLPOOL_loop(void *args)
 {
     return EVP_Digest_loop("whirlpool", D_WHIRLPOOL, args);
@@ -2234,6 +2304,11 @@ int speed_main(int argc, char **argv)
             doit[D_SHA1] = doit[D_SHA256] = doit[D_SHA512] = 1;
             algo_found = 1;
         }
+        if (strcmp(algo, "sha3") == 0) {
+            doit[D_SHA3_256] = doit[D_SHA3_512] = 1;
+            doit[D_SHAKE128] = doit[D_SHAKE256] = 1;
+            algo_found = 1;
+        }
 #ifndef OPENSSL_NO_DEPRECATED_3_0
         if (strcmp(algo, "openssl") == 0) /* just for compatibility */
             algo_found = 1;
@@ -2459,6 +2534,10 @@ int speed_main(int argc, char **argv)
             if (!have_md(names[i]))
                 doit[i] = 0;
         }
+        if (!have_md("shake128"))
+            doit[D_SHAKE128] = 0;
+        if (!have_md("shake256"))
+            doit[D_SHAKE256] = 0;
         for (i = D_CBC_DES; i <= D_CBC_256_CML; i++) {
             if (!have_cipher(names[i]))
                 doit[i] = 0;
@@ -2581,6 +2660,18 @@ int speed_main(int argc, char **argv)
         }
     }
 
+    if (doit[D_SHA384]) {
+        for (testnum = 0; testnum < size_num; testnum++) {
+            print_message(names[D_SHA384], lengths[testnum], seconds.sym);
+            Time_F(START);
+            count = run_benchmark(async_jobs, SHA384_loop, loopargs);
+            d = Time_F(STOP);
+            print_result(D_SHA384, testnum, count, d);
+            if (count < 0)
+                break;
+        }
+    }
+
     if (doit[D_SHA512]) {
         for (testnum = 0; testnum < size_num; testnum++) {
             print_message(names[D_SHA512], lengths[testnum], seconds.sym);
@@ -2593,6 +2684,54 @@ int speed_main(int argc, char **argv)
         }
     }
 
+    if (doit[D_SHA3_256]) {
+        for (testnum = 0; testnum < size_num; testnum++) {
+            print_message(names[D_SHA3_256], lengths[testnum], seconds.sym);
+            Time_F(START);
+            count = run_benchmark(async_jobs, SHA3_256_loop, loopargs);
+            d = Time_F(STOP);
+            print_result(D_SHA3_256, testnum, count, d);
+            if (count < 0)
+                break;
+        }
+    }
+
+    if (doit[D_SHA3_512]) {
+        for (testnum = 0; testnum < size_num; testnum++) {
+            print_message(names[D_SHA3_512], lengths[testnum], seconds.sym);
+            Time_F(START);
+            count = run_benchmark(async_jobs, SHA3_512_loop, loopargs);
+            d = Time_F(STOP);
+            print_result(D_SHA3_512, testnum, count, d);
+            if (count < 0)
+                break;
+        }
+    }
+
+    if (doit[D_SHAKE128]) {
+        for (testnum = 0; testnum < size_num; testnum++) {
+            print_message(names[D_SHAKE128], lengths[testnum], seconds.sym);
+            Time_F(START);
+            count = run_benchmark(async_jobs, SHAKE128_squeeze_loop, loopargs);
+            d = Time_F(STOP);
+            print_result(D_SHAKE128, testnum, count, d);
+            if (count < 0)
+                break;
+        }
+    }
+
+    if (doit[D_SHAKE256]) {
+        for (testnum = 0; testnum < size_num; testnum++) {
+            print_message(names[D_SHAKE256], lengths[testnum], seconds.sym);
+            Time_F(START);
+            count = run_benchmark(async_jobs, SHAKE256_squeeze_loop, loopargs);
+            d = Time_F(STOP);
+            print_result(D_SHAKE256, testnum, count, d);
+            if (count < 0)
+                break;
+        }
+    }
+
     if (doit[D_WHIRLPOOL]) {
         for (testnum = 0; testnum < size_num; testnum++) {
             print_message(names[D_WHIRLPOOL], lengths[testnum], seconds.sym);
@@ -1517,3 +1517,99 @@ err:
 
     return ret;
 }
+
+#ifdef RSAZ_X8_ENABLED
+/*
+ * Run |lanes| exponentiations with |bits| bit moduli through the eight lane
+ * kernel.  The bases and exponents are copied into zero padded buffers, as
+ * the kernel reads |bits| / 64 words of each.
+ */
+static int bn_mod_exp_mont_consttime_x8(BIGNUM *rr[], const BIGNUM *const a[],
+    const BIGNUM *const p[], const BIGNUM *const m[],
+    BN_MONT_CTX *const mont[], int lanes, int bits)
+{
+    int words = bits / BN_BITS2, lane, ret = 0;
+    size_t buf_len = (size_t)3 * lanes * words * sizeof(BN_ULONG);
+    BN_ULONG *buf, *res[8], k0[8];
+    const BN_ULONG *base[8], *exponent[8], *mod[8], *RR[8];
+
+    if ((buf = OPENSSL_zalloc(buf_len)) == NULL)
+        return 0;
+
+    for (lane = 0; lane < lanes; lane++) {
+        BN_ULONG *b = buf + 3 * lane * words;
+
+        memcpy(b, a[lane]->d, a[lane]->top * sizeof(BN_ULONG));
+        memcpy(b + words, p[lane]->d, p[lane]->top * sizeof(BN_ULONG));
+        base[lane] = b;
+        exponent[lane] = b + words;
+        res[lane] = b + 2 * words;
+        mod[lane] = m[lane]->d;
+        RR[lane] = mont[lane]->RR.d;
+        k0[lane] = mont[lane]->n0[0];
+    }
+
+    if (!ossl_rsaz_mod_exp_avx512_x8(res, base, exponent, mod, RR, k0,
+            lanes, bits))
+        goto err;
+
+    for (lane = 0; lane < lanes; lane++) {
+        if (bn_wexpand(rr[lane], words) == NULL)
+            goto err;
+        memcpy(rr[lane]->d, res[lane], words * sizeof(BN_ULONG));
+        rr[lane]->top = words;
+        rr[lane]->neg = 0;
+        bn_correct_top(rr[lane]);
+        bn_check_top(rr[lane]);
+    }
+    ret = 1;
+err:
+    OPENSSL_clear_free(buf, buf_len);
+    return ret;
+}
+#endif
+
+/*
+ * |num| independent exponentiations rr[i] = a[i]^p[i] mod m[i], in constant
+ * time, where mont[i] is the Montgomery context of m[i] and a[i] < m[i].
+ * With AVX512_IFMA, runs of equally sized 1024, 1536 or 2048 bit moduli are
+ * computed eight at a time.  The rest is computed two at a time with
+ * BN_mod_exp_mont_consttime_x2().
+ */
+int ossl_bn_mod_exp_mont_consttime_batch(BIGNUM *rr[], const BIGNUM *const a[],
+    const BIGNUM *const p[], const BIGNUM *const m[],
+    BN_MONT_CTX *const mont[], size_t num, BN_CTX *ctx)
+{
+    size_t i = 0;
+
+#ifdef RSAZ_X8_ENABLED
+    if (ossl_rsaz_avx512ifma_eligible()) {
+        while (num - i > 2) {
+            int bits = BN_num_bits(m[i]), words = bits / BN_BITS2, lanes;
+
+            if (bits != 1024 && bits != 1536 && bits != 2048)
+                break;
+            for (lanes = 0; lanes < 8 && i + lanes < num; lanes++)
+                if (BN_num_bits(m[i + lanes]) != bits
+                    || a[i + lanes]->top > words || p[i + lanes]->top > words)
+                    break;
+            if (lanes < 3)
+                break;
+            if (!bn_mod_exp_mont_consttime_x8(rr + i, a + i, p + i, m + i,
+                    mont + i, lanes, bits))
+                return 0;
+            i += lanes;
+        }
+    }
+#endif
+
+    for (; i + 1 < num; i += 2)
+        if (!BN_mod_exp_mont_consttime_x2(rr[i], a[i], p[i], m[i], mont[i],
+                rr[i + 1], a[i + 1], p[i + 1], m[i + 1],
+                mont[i + 1], ctx))
+            return 0;
+    if (i < num
+        && !BN_mod_exp_mont_consttime(rr[i], a[i], p[i], m[i], ctx, mont[i]))
+        return 0;
+    return 1;
+}
@@ -14,6 +14,7 @@
  */
 
 #include "internal/cryptlib.h"
+#include "internal/rcu.h"
 #include "bn_local.h"
 
 #define MONT_WORD /* use the faster word-based algorithm */
@@ -427,11 +428,14 @@ BN_MONT_CTX *BN_MONT_CTX_set_locked(BN_MONT_CTX **pmont, CRYPTO_RWLOCK *lock,
 {
     BN_MONT_CTX *ret;
 
-    if (!CRYPTO_THREAD_read_lock(lock))
-        return NULL;
-    ret = *pmont;
-    CRYPTO_THREAD_unlock(lock);
-    if (ret)
+    /*
+     * Once set, |*pmont| is never changed for as long as it's shared, and
+     * it's only published fully set up (see below), so an acquiring load
+     * is all that's needed to read it.  This keeps the common case, where
+     * many threads use the same key, from contending on |lock|.
+     */
+    ret = ossl_rcu_deref(pmont);
+    if (ret != NULL)
         return ret;
 
     /*
@@ -459,8 +463,9 @@ BN_MONT_CTX *BN_MONT_CTX_set_locked(BN_MONT_CTX **pmont, CRYPTO_RWLOCK *lock,
     if (*pmont) {
         BN_MONT_CTX_free(ret);
         ret = *pmont;
-    } else
-        *pmont = ret;
+    } else {
+        ossl_rcu_assign_ptr(pmont, &ret);
+    }
     CRYPTO_THREAD_unlock(lock);
     return ret;
 }
@@ -53,6 +53,23 @@ int ossl_rsaz_mod_exp_avx512_x2(BN_ULONG *res1,
     BN_ULONG k0_2,
     int factor_size);
 
+/*
+ * The eight lane exponentiation is written with intrinsics and needs a
+ * compiler that can target AVX-512 IFMA in a region of the file.
+ */
+#undef RSAZ_X8_ENABLED
+#if defined(__GNUC__) || defined(__clang__)
+#define RSAZ_X8_ENABLED
+
+int ossl_rsaz_mod_exp_avx512_x8(BN_ULONG *const res[],
+    const BN_ULONG *const base[],
+    const BN_ULONG *const exponent[],
+    const BN_ULONG *const m[],
+    const BN_ULONG *const RR[],
+    const BN_ULONG k0[],
+    int lanes, int factor_size);
+#endif
+
 static ossl_inline void bn_select_words(BN_ULONG *r, BN_ULONG mask,
     const BN_ULONG *a,
     const BN_ULONG *b, size_t num)
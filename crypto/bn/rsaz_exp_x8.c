@@ -0,0 +1,332 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*-
+ * Eight independent modular exponentiations at once, one per 64-bit lane of
+ * a 512-bit register, using AVX-512 IFMA.
+ *
+ * Numbers are kept in radix 2^52 and "lane sliced": vector i holds digit i
+ * of all eight operands.  Every lane has its own modulus, exponent and
+ * Montgomery constant, so a batch may freely mix the p and q halves of
+ * several RSA CRT operations.  Compared with the dual exponentiation in
+ * rsaz_exp_x2.c no data moves between the digits of a register: the
+ * Montgomery quotient digits of all lanes come out of one multiplication,
+ * the per-iteration shift is just a moving pointer, and each lane takes
+ * its own entry from the table of powers.
+ */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include "rsaz_exp.h"
+
+#ifndef RSAZ_X8_ENABLED
+NON_EMPTY_TRANSLATION_UNIT
+#else
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+#define X8_LANES 8
+#define X8_DIGIT_SIZE 52
+#define X8_DIGIT_MASK ((uint64_t)0xFFFFFFFFFFFFF)
+#define X8_WIN_SIZE 5
+#define X8_TABLE_SIZE (1 << X8_WIN_SIZE)
+/* Digits of the largest supported modulus, 2048 bits */
+#define X8_MAX_DIGITS 40
+
+/* Number of 52-bit digits needed for a |bits| bit modulus, with headroom */
+static ossl_inline int x8_digits(int bits)
+{
+    return (bits + 2 + X8_DIGIT_SIZE - 1) / X8_DIGIT_SIZE;
+}
+
+/*
+ * Store the |words| word number |in| into lane |lane| of the lane sliced
+ * |digits| digit number |out|.
+ */
+static void x8_to_digits(uint64_t *out, int lane, const BN_ULONG *in,
+    int words, int digits)
+{
+    int i, bit, w, s;
+    uint64_t d;
+
+    for (i = 0; i < digits; i++) {
+        bit = i * X8_DIGIT_SIZE;
+        w = bit / 64;
+        s = bit % 64;
+        d = 0;
+        if (w < words) {
+            d = in[w] >> s;
+            if (s > 64 - X8_DIGIT_SIZE && w + 1 < words)
+                d |= in[w + 1] << (64 - s);
+        }
+        out[i * X8_LANES + lane] = d & X8_DIGIT_MASK;
+    }
+}
+
+/* The inverse of x8_to_digits() */
+static void x8_from_digits(BN_ULONG *out, int words, const uint64_t *in,
+    int lane, int digits)
+{
+    int i, bit, w, s;
+    uint64_t d;
+
+    memset(out, 0, words * sizeof(*out));
+    for (i = 0; i < digits; i++) {
+        d = in[i * X8_LANES + lane];
+        bit = i * X8_DIGIT_SIZE;
+        w = bit / 64;
+        s = bit % 64;
+        if (w < words)
+            out[w] |= d << s;
+        if (s > 64 - X8_DIGIT_SIZE && w + 1 < words)
+            out[w + 1] |= d >> (64 - s);
+    }
+}
+
+OPENSSL_TARGET_REGION("avx512f,avx512ifma")
+
+/*-
+ * Almost Montgomery Multiplication of each lane:
+ *     res = a * b / 2^(52 * digits) mod m
+ * For a, b < 2m, the result is < 2m, which is fine as input to the next
+ * multiplication, see rsaz-2k-avx512.pl.  All digits of |a|, |b| and |m| must
+ * be below 2^52, and so are the digits of |res|.  |res| may alias |a| or |b|.
+ *
+ * The column sums are accumulated without carrying.  Each of the |digits|
+ * iterations adds at most 2^54 to a column, so with at most 40 digits they
+ * stay well within 64 bits.
+ */
+static ossl_inline void amm52_x8(__m512i *res, const __m512i *a,
+    const __m512i *b, const __m512i *m, __m512i k0, int digits)
+{
+    __m512i acc[2 * X8_MAX_DIGITS + 1], *t = acc, y;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i mask = _mm512_set1_epi64((long long)X8_DIGIT_MASK);
+    int i, j;
+
+    for (j = 0; j < 2 * digits + 1; j++)
+        acc[j] = zero;
+
+    for (i = 0; i < digits; i++, t++) {
+        for (j = 0; j < digits; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], a[j], b[i]);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], a[j], b[i]);
+        }
+        /* y = -t[0] / m mod 2^52, the low 52 bits of k0 suffice */
+        y = _mm512_madd52lo_epu64(zero, t[0], k0);
+        for (j = 0; j < digits; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], m[j], y);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], m[j], y);
+        }
+        /* The low 52 bits of t[0] are now zero, move on to the next column */
+        t[1] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], X8_DIGIT_SIZE));
+    }
+
+    for (j = 0; j < digits; j++) {
+        if (j + 1 < digits)
+            t[j + 1] = _mm512_add_epi64(t[j + 1],
+                _mm512_srli_epi64(t[j], X8_DIGIT_SIZE));
+        res[j] = _mm512_and_si512(t[j], mask);
+    }
+}
+
+/*
+ * Instantiate the multiplication for each supported size, so that the
+ * digit count is a constant in the loops.
+ */
+static void amm52x20_x8(__m512i *res, const __m512i *a, const __m512i *b,
+    const __m512i *m, __m512i k0)
+{
+    amm52_x8(res, a, b, m, k0, 20);
+}
+
+static void amm52x30_x8(__m512i *res, const __m512i *a, const __m512i *b,
+    const __m512i *m, __m512i k0)
+{
+    amm52_x8(res, a, b, m, k0, 30);
+}
+
+static void amm52x40_x8(__m512i *res, const __m512i *a, const __m512i *b,
+    const __m512i *m, __m512i k0)
+{
+    amm52_x8(res, a, b, m, k0, 40);
+}
+
+typedef void (*AMM_X8)(__m512i *res, const __m512i *a, const __m512i *b,
+    const __m512i *m, __m512i k0);
+
+/*
+ * Set |out| to the |idx|-th entry of |table| in each lane, where |idx| holds
+ * a different secret index in every lane.  All the entries are read.
+ */
+static void extract_x8(__m512i *out, const __m512i *table, __m512i idx,
+    int digits)
+{
+    __mmask8 k;
+    int i, j;
+
+    for (j = 0; j < digits; j++)
+        out[j] = _mm512_setzero_si512();
+    for (i = 0; i < X8_TABLE_SIZE; i++) {
+        k = _mm512_cmpeq_epi64_mask(idx, _mm512_set1_epi64(i));
+        for (j = 0; j < digits; j++)
+            out[j] = _mm512_mask_mov_epi64(out[j], k, table[i * digits + j]);
+    }
+}
+
+/*
+ * The exponent window of each lane at bit |bit|, from the zero padded
+ * |words| + 1 word exponents in |expz|.
+ */
+static __m512i window_x8(const BN_ULONG *expz, int words, int bit)
+{
+    uint64_t w[X8_LANES];
+    int lane, word = bit / 64, shift = bit % 64;
+
+    for (lane = 0; lane < X8_LANES; lane++) {
+        const BN_ULONG *e = expz + lane * (words + 1);
+
+        w[lane] = e[word] >> shift;
+        if (shift > 64 - X8_WIN_SIZE)
+            w[lane] |= e[word + 1] << (64 - shift);
+        w[lane] &= X8_TABLE_SIZE - 1;
+    }
+    return _mm512_loadu_si512(w);
+}
+
+/*-
+ * Eight {1024,1536,2048}-bit modular exponentiations with fixed window
+ * size 5, in constant time.
+ *
+ * Input and output are in regular 2^64 radix.  Only the first |lanes| of the
+ * eight array entries are used, the remaining lanes repeat the first one.
+ *
+ *  [out] res[i]      - result, |factor_size| / 64 words
+ *  [in]  base[i]     - base, less than m[i]
+ *  [in]  exponent[i] - exponent, |factor_size| / 64 words
+ *  [in]  m[i]        - modulus, |factor_size| bits
+ *  [in]  RR[i]       - Montgomery parameter RR = 2^(2 * factor_size) mod m[i]
+ *  [in]  k0[i]       - Montgomery parameter k0 = -1/m[i] mod 2^64
+ *  [in]  lanes       - number of exponentiations, 1 to 8
+ *  [in]  factor_size - modulus bit size
+ *
+ * \return 0 in case of failure,
+ *         1 in case of success.
+ */
+int ossl_rsaz_mod_exp_avx512_x8(BN_ULONG *const res[], const BN_ULONG *const base[],
+    const BN_ULONG *const exponent[], const BN_ULONG *const m[],
+    const BN_ULONG *const RR[], const BN_ULONG k0[],
+    int lanes, int factor_size)
+{
+    int words = factor_size / 64, digits = x8_digits(factor_size);
+    int coeff_pow = 4 * (X8_DIGIT_SIZE * digits - factor_size);
+    int lane, i, bit;
+    size_t storage_len;
+    unsigned char *storage = NULL;
+    __m512i *base_v, *m_v, *rr_v, *x_v, *y_v, *table, k0_v;
+    BN_ULONG *expz, *tmp;
+    uint64_t k0_l[X8_LANES];
+    AMM_X8 amm;
+    int ret = 0;
+
+    switch (factor_size) {
+    case 1024:
+        amm = amm52x20_x8;
+        break;
+    case 1536:
+        amm = amm52x30_x8;
+        break;
+    case 2048:
+        amm = amm52x40_x8;
+        break;
+    default:
+        return 0;
+    }
+    if (lanes < 1 || lanes > X8_LANES)
+        return 0;
+
+    storage_len = (5 + X8_TABLE_SIZE) * digits * sizeof(__m512i)
+        + (X8_LANES * (words + 1) + words) * sizeof(BN_ULONG) + 64;
+    storage = OPENSSL_zalloc(storage_len);
+    if (storage == NULL)
+        return 0;
+    base_v = (__m512i *)(storage + (64 - ((size_t)storage & 63)));
+    m_v = base_v + digits;
+    rr_v = m_v + digits;
+    x_v = rr_v + digits;
+    y_v = x_v + digits;
+    table = y_v + digits;
+    expz = (BN_ULONG *)(table + X8_TABLE_SIZE * digits);
+    tmp = expz + X8_LANES * (words + 1);
+
+    for (lane = 0; lane < X8_LANES; lane++) {
+        int src = lane < lanes ? lane : 0;
+
+        x8_to_digits((uint64_t *)base_v, lane, base[src], words, digits);
+        x8_to_digits((uint64_t *)m_v, lane, m[src], words, digits);
+        x8_to_digits((uint64_t *)rr_v, lane, RR[src], words, digits);
+        memcpy(expz + lane * (words + 1), exponent[src], words * sizeof(BN_ULONG));
+        k0_l[lane] = k0[src];
+    }
+    k0_v = _mm512_loadu_si512(k0_l);
+
+    /*
+     * Turn RR into RR' = 2^(2 * 52 * digits) mod m, as in
+     * ossl_rsaz_mod_exp_avx512_x2(): RR' = AMM(AMM(RR, RR), 2^coeff_pow).
+     */
+    for (lane = 0; lane < X8_LANES; lane++)
+        ((uint64_t *)x_v)[(coeff_pow / X8_DIGIT_SIZE) * X8_LANES + lane]
+            = (uint64_t)1 << (coeff_pow % X8_DIGIT_SIZE);
+    amm(rr_v, rr_v, rr_v, m_v, k0_v);
+    amm(rr_v, rr_v, x_v, m_v, k0_v);
+
+    /* table[i] = base^i in the Montgomery domain */
+    memset(x_v, 0, digits * sizeof(*x_v));
+    x_v[0] = _mm512_set1_epi64(1);
+    amm(&table[0], x_v, rr_v, m_v, k0_v);
+    amm(&table[digits], base_v, rr_v, m_v, k0_v);
+    for (i = 1; i < X8_TABLE_SIZE / 2; i++) {
+        amm(&table[2 * i * digits], &table[i * digits], &table[i * digits],
+            m_v, k0_v);
+        amm(&table[(2 * i + 1) * digits], &table[2 * i * digits],
+            &table[digits], m_v, k0_v);
+    }
+
+    /*
+     * Scan the exponents in 5 bit windows, starting from the highest
+     * multiple of 5 below |factor_size|.  The bits above |factor_size| are
+     * read from the zero padding.
+     */
+    bit = factor_size - factor_size % X8_WIN_SIZE;
+    extract_x8(y_v, table, window_x8(expz, words, bit), digits);
+    for (bit -= X8_WIN_SIZE; bit >= 0; bit -= X8_WIN_SIZE) {
+        extract_x8(x_v, table, window_x8(expz, words, bit), digits);
+        for (i = 0; i < X8_WIN_SIZE; i++)
+            amm(y_v, y_v, y_v, m_v, k0_v);
+        amm(y_v, y_v, x_v, m_v, k0_v);
+    }
+
+    /* Leave the Montgomery domain, AMM(y, 1) is fully reduced */
+    memset(x_v, 0, digits * sizeof(*x_v));
+    x_v[0] = _mm512_set1_epi64(1);
+    amm(y_v, y_v, x_v, m_v, k0_v);
+
+    for (lane = 0; lane < lanes; lane++) {
+        x8_from_digits(res[lane], words, (const uint64_t *)y_v, lane, digits);
+        bn_reduce_once_in_place(res[lane], /*carry=*/0, m[lane], tmp, words);
+    }
+    ret = 1;
+
+    OPENSSL_clear_free(storage, storage_len);
+    return ret;
+}
+
+OPENSSL_UNTARGET_REGION
+
+#endif
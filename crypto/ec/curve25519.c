@@ -5713,13 +5713,49 @@ int ossl_ed25519_pubkey_verify(const uint8_t *pub, size_t pub_len)
 
 static const char allzeroes[15];
 
+/*
+ * Check 0 <= s < L where L = 2^252 + 27742317777372353535851937790883648493
+ *
+ * If not the signature is publicly invalid. Since it's public we can do the
+ * check in variable time.
+ */
+static int ed25519_scalar_is_canonical(const uint8_t *s)
+{
+    int i;
+    /* 27742317777372353535851937790883648493 in little endian format */
+    static const uint8_t l_low[16] = {
+        0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58, 0xD6, 0x9C, 0xF7, 0xA2,
+        0xDE, 0xF9, 0xDE, 0x14
+    };
+
+    /* First check the most significant byte */
+    if (s[31] > 0x10)
+        return 0;
+    if (s[31] == 0x10) {
+        /*
+         * Most significant byte indicates a value close to 2^252 so check the
+         * rest
+         */
+        if (memcmp(s + 16, allzeroes, sizeof(allzeroes)) != 0)
+            return 0;
+        for (i = 15; i >= 0; i--) {
+            if (s[i] < l_low[i])
+                break;
+            if (s[i] > l_low[i])
+                return 0;
+        }
+        if (i < 0)
+            return 0;
+    }
+    return 1;
+}
+
 int ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
     const uint8_t signature[64], const uint8_t public_key[32],
     const uint8_t dom2flag, const uint8_t phflag, const uint8_t csflag,
     const uint8_t *context, size_t context_len,
     OSSL_LIB_CTX *libctx, const char *propq)
 {
-    int i;
     ge_p3 A;
     const uint8_t *r, *s;
     EVP_MD *sha512;
@@ -5729,11 +5765,6 @@ int ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
     ge_p2 R;
     uint8_t rcheck[32];
     uint8_t h[SHA512_DIGEST_LENGTH];
-    /* 27742317777372353535851937790883648493 in little endian format */
-    const uint8_t l_low[16] = {
-        0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58, 0xD6, 0x9C, 0xF7, 0xA2,
-        0xDE, 0xF9, 0xDE, 0x14
-    };
 
     if (context == NULL)
         context_len = 0;
@@ -5749,32 +5780,8 @@ int ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
     r = signature;
     s = signature + 32;
 
-    /*
-     * Check 0 <= s < L where L = 2^252 + 27742317777372353535851937790883648493
-     *
-     * If not the signature is publicly invalid. Since it's public we can do the
-     * check in variable time.
-     *
-     * First check the most significant byte
-     */
-    if (s[31] > 0x10)
+    if (!ed25519_scalar_is_canonical(s))
         return 0;
-    if (s[31] == 0x10) {
-        /*
-         * Most significant byte indicates a value close to 2^252 so check the
-         * rest
-         */
-        if (memcmp(s + 16, allzeroes, sizeof(allzeroes)) != 0)
-            return 0;
-        for (i = 15; i >= 0; i--) {
-            if (s[i] < l_low[i])
-                break;
-            if (s[i] > l_low[i])
-                return 0;
-        }
-        if (i < 0)
-            return 0;
-    }
 
     if (ge_frombytes_vartime(&A, public_key) != 0) {
         return 0;
@@ -5818,6 +5825,274 @@ err:
     return res;
 }
 
+/* The number of signatures whose encoded R values are computed together */
+#define ED25519_VERIFY_BATCH 16
+/*
+ * Below this many signatures, verifying them one at a time is faster than
+ * computing the table of multiples of the public key.
+ */
+#define ED25519_VERIFY_BATCH_MIN 4
+
+/*
+ * Sets inv[i] = 1/p[i].Z for |num| > 0 points with a single field inversion,
+ * using Montgomery's trick.
+ */
+static void ge_p3_batch_invert_z(fe *inv, const ge_p3 *p, size_t num)
+{
+    fe acc, t;
+    size_t i;
+
+    /* inv[i] = Z[0] * ... * Z[i] */
+    fe_copy(inv[0], p[0].Z);
+    for (i = 1; i < num; i++)
+        fe_mul(inv[i], inv[i - 1], p[i].Z);
+
+    fe_invert(acc, inv[num - 1]);
+    for (i = num - 1; i > 0; i--) {
+        fe_mul(t, acc, inv[i - 1]);
+        fe_mul(acc, acc, p[i].Z);
+        fe_copy(inv[i], t);
+    }
+    fe_copy(inv[0], acc);
+}
+
+/*
+ * table[8*i+j] = (j+1)*256^i*A, in the same layout as k25519Precomp.
+ * |tmp| and |inv| are scratch space for 256 values each.
+ */
+static void ge_precomp_table(ge_precomp *table, ge_p3 *tmp, fe *inv,
+    const ge_p3 *A)
+{
+    ge_cached c;
+    ge_p1p1 r;
+    ge_p3 base = *A, *row;
+    fe x, y;
+    int i, j;
+
+    for (i = 0; i < 32; i++) {
+        row = tmp + 8 * i;
+        row[0] = base;
+        ge_p3_to_cached(&c, &base);
+        for (j = 1; j < 8; j++) {
+            if (j & 1)
+                ge_p3_dbl(&r, &row[j / 2]);
+            else
+                ge_add(&r, &row[j - 1], &c);
+            ge_p1p1_to_p3(&row[j], &r);
+        }
+        /* 256 * base = 32 * (8 * base) */
+        base = row[7];
+        for (j = 0; j < 5; j++) {
+            ge_p3_dbl(&r, &base);
+            ge_p1p1_to_p3(&base, &r);
+        }
+    }
+
+    ge_p3_batch_invert_z(inv, tmp, 256);
+    for (i = 0; i < 256; i++) {
+        fe_mul(x, tmp[i].X, inv[i]);
+        fe_mul(y, tmp[i].Y, inv[i]);
+        fe_add(table[i].yplusx, y, x);
+        fe_sub(table[i].yminusx, y, x);
+        fe_mul(table[i].xy2d, x, y);
+        fe_mul(table[i].xy2d, table[i].xy2d, d2);
+    }
+}
+
+/*
+ * Sets e[0..63] to the signed radix 16 digits of a, each between -8 and 8.
+ *
+ * Preconditions:
+ *   a[31] <= 127
+ */
+static void ge_radix16(signed char e[64], const uint8_t *a)
+{
+    signed char carry;
+    int i;
+
+    for (i = 0; i < 32; ++i) {
+        e[2 * i + 0] = (a[i] >> 0) & 15;
+        e[2 * i + 1] = (a[i] >> 4) & 15;
+    }
+
+    carry = 0;
+    for (i = 0; i < 63; ++i) {
+        e[i] += carry;
+        carry = e[i] + 8;
+        carry >>= 4;
+        e[i] -= carry << 4;
+    }
+    e[63] += carry;
+}
+
+/* h = h + b * P, where table[j] = (j+1)*P and -8 <= b <= 8 */
+static void ge_madd_vartime(ge_p3 *h, const ge_precomp *table, signed char b)
+{
+    ge_p1p1 r;
+
+    if (b == 0)
+        return;
+    if (b > 0)
+        ge_madd(&r, h, &table[b - 1]);
+    else
+        ge_msub(&r, h, &table[-b - 1]);
+    ge_p1p1_to_p3(h, &r);
+}
+
+/*
+ * h = a * A + b * B, in variable time, in the same way as
+ * ge_scalarmult_base(), where |Ai| is computed by ge_precomp_table() for A.
+ *
+ * Preconditions:
+ *   a[31] <= 127
+ *   b[31] <= 127
+ */
+static void ge_double_scalarmult_precomp_vartime(ge_p3 *h, const uint8_t *a,
+    const ge_precomp *Ai, const uint8_t *b)
+{
+    signed char ae[64];
+    signed char be[64];
+    ge_p1p1 r;
+    ge_p2 s;
+    int i;
+
+    ge_radix16(ae, a);
+    ge_radix16(be, b);
+
+    ge_p3_0(h);
+    for (i = 1; i < 64; i += 2) {
+        ge_madd_vartime(h, Ai + 8 * (i / 2), ae[i]);
+        ge_madd_vartime(h, k25519Precomp[i / 2], be[i]);
+    }
+
+    ge_p3_dbl(&r, h);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p2(&s, &r);
+    ge_p2_dbl(&r, &s);
+    ge_p1p1_to_p3(h, &r);
+
+    for (i = 0; i < 64; i += 2) {
+        ge_madd_vartime(h, Ai + 8 * (i / 2), ae[i]);
+        ge_madd_vartime(h, k25519Precomp[i / 2], be[i]);
+    }
+}
+
+/*
+ * Verifies |n| signatures made with the same public key, setting |results[i]|
+ * to what ossl_ed25519_verify() would return for |sigs[i]| and |tbs[i]|.
+ *
+ * The result is computed exactly as for a single signature, i.e. by checking
+ * that the encoding of [s]B - [h]A is the R value of the signature.  The cost
+ * is reduced by computing a table of multiples of A once, so that [h]A needs
+ * no doublings, and by sharing the field inversion of the R encoding between
+ * ED25519_VERIFY_BATCH signatures.
+ * A randomised linear combination of the verification equations is not used,
+ * because it cannot reject signatures that differ from a valid one by a small
+ * order point in the same way as the single verification does.
+ *
+ * Returns 1 if the results were computed, or 0 on error.
+ */
+int ossl_ed25519_verify_batch(const uint8_t *const tbs[], const size_t tbs_len[],
+    const uint8_t *const sigs[], const size_t sig_lens[],
+    const uint8_t public_key[32],
+    const uint8_t dom2flag, const uint8_t phflag, const uint8_t csflag,
+    const uint8_t *context, size_t context_len,
+    int results[], size_t n, OSSL_LIB_CTX *libctx, const char *propq)
+{
+    ge_p3 A, R[ED25519_VERIFY_BATCH];
+    fe inv[ED25519_VERIFY_BATCH], x, y;
+    size_t idx[ED25519_VERIFY_BATCH];
+    uint8_t h[SHA512_DIGEST_LENGTH], rcheck[32];
+    ge_precomp *table = NULL;
+    ge_p3 *tmp = NULL;
+    fe *tmp_inv = NULL;
+    EVP_MD *sha512 = NULL;
+    EVP_MD_CTX *hash_tmpl = NULL, *hash_ctx = NULL;
+    size_t i, j, m;
+    unsigned int sz;
+    int ret = 0;
+
+    if (n < ED25519_VERIFY_BATCH_MIN) {
+        for (i = 0; i < n; i++)
+            results[i] = sig_lens[i] == ED25519_SIGSIZE
+                && ossl_ed25519_verify(tbs[i], tbs_len[i], sigs[i], public_key,
+                    dom2flag, phflag, csflag, context, context_len,
+                    libctx, propq);
+        return 1;
+    }
+
+    for (i = 0; i < n; i++)
+        results[i] = 0;
+
+    if (context == NULL)
+        context_len = 0;
+
+    /* The same checks as ossl_ed25519_verify(), which apply to every signature */
+    if ((csflag && context_len == 0)
+        || (!dom2flag && context_len > 0)
+        || ge_frombytes_vartime(&A, public_key) != 0)
+        return 1;
+
+    fe_neg(A.X, A.X);
+    fe_neg(A.T, A.T);
+
+    table = OPENSSL_malloc_array(256, sizeof(*table));
+    tmp = OPENSSL_malloc_array(256, sizeof(*tmp));
+    tmp_inv = OPENSSL_malloc_array(256, sizeof(*tmp_inv));
+    sha512 = EVP_MD_fetch(libctx, SN_sha512, propq);
+    hash_tmpl = EVP_MD_CTX_new();
+    hash_ctx = EVP_MD_CTX_new();
+    if (table == NULL || tmp == NULL || tmp_inv == NULL || sha512 == NULL
+        || hash_tmpl == NULL || hash_ctx == NULL
+        || !hash_init_with_dom(hash_tmpl, sha512, dom2flag, phflag,
+            context, context_len))
+        goto err;
+
+    ge_precomp_table(table, tmp, tmp_inv, &A);
+
+    for (i = 0; i < n;) {
+        /* Compute [h](-A) + [s]B for the next signatures that may be valid */
+        for (m = 0; i < n && m < ED25519_VERIFY_BATCH; i++) {
+            const uint8_t *r = sigs[i], *s = sigs[i] + 32;
+
+            if (sig_lens[i] != ED25519_SIGSIZE || !ed25519_scalar_is_canonical(s))
+                continue;
+            if (!EVP_MD_CTX_copy_ex(hash_ctx, hash_tmpl)
+                || !EVP_DigestUpdate(hash_ctx, r, 32)
+                || !EVP_DigestUpdate(hash_ctx, public_key, 32)
+                || !EVP_DigestUpdate(hash_ctx, tbs[i], tbs_len[i])
+                || !EVP_DigestFinal_ex(hash_ctx, h, &sz))
+                goto err;
+            x25519_sc_reduce(h);
+            ge_double_scalarmult_precomp_vartime(&R[m], h, table, s);
+            idx[m++] = i;
+        }
+        if (m == 0)
+            continue;
+
+        ge_p3_batch_invert_z(inv, R, m);
+        for (j = 0; j < m; j++) {
+            fe_mul(x, R[j].X, inv[j]);
+            fe_mul(y, R[j].Y, inv[j]);
+            fe_tobytes(rcheck, y);
+            rcheck[31] ^= fe_isnegative(x) << 7;
+            results[idx[j]] = CRYPTO_memcmp(rcheck, sigs[idx[j]], 32) == 0;
+        }
+    }
+    ret = 1;
+err:
+    OPENSSL_free(table);
+    OPENSSL_free(tmp);
+    OPENSSL_free(tmp_inv);
+    EVP_MD_free(sha512);
+    EVP_MD_CTX_free(hash_tmpl);
+    EVP_MD_CTX_free(hash_ctx);
+    return ret;
+}
+
 int ossl_ed25519_public_from_private(OSSL_LIB_CTX *ctx, uint8_t out_public_key[32],
     const uint8_t private_key[32],
     const char *propq)
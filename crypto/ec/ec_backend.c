@@ -585,6 +585,15 @@ int ossl_ec_key_otherparams_fromdata(EC_KEY *ec, const OSSL_PARAM params[])
             || !ec_set_include_public(ec, include))
             return 0;
     }
+
+    p = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC);
+    if (p != NULL) {
+        int precompute;
+
+        if (!OSSL_PARAM_get_int(p, &precompute)
+            || !ossl_ec_key_precompute_public(ec, precompute))
+            return 0;
+    }
     if (!ec_key_point_format_fromdata(ec, params))
         return 0;
     if (!ec_key_group_check_fromdata(ec, params))
@@ -24,6 +24,7 @@
 #include "prov/ecx.h"
 #include "crypto/bn.h"
 
+static void ec_key_pub_precomp_free(EC_KEY *key);
 static int ecdsa_keygen_pairwise_test(EC_KEY *eckey, OSSL_CALLBACK *cb,
     void *cbarg);
 
@@ -88,6 +89,7 @@ void EC_KEY_free(EC_KEY *r)
     CRYPTO_free_ex_data(CRYPTO_EX_INDEX_EC_KEY, r, &r->ex_data);
 #endif
     CRYPTO_FREE_REF(&r->references);
+    ec_key_pub_precomp_free(r);
     EC_GROUP_free(r->group);
     EC_POINT_free(r->pub_key);
     BN_clear_free(r->priv_key);
@@ -685,6 +687,84 @@ void ossl_ec_key_set0_libctx(EC_KEY *key, OSSL_LIB_CTX *libctx)
     /* Do we need to propagate this to the group? */
 }
 
+static void ec_key_pub_precomp_free(EC_KEY *key)
+{
+    if (key->pub_precomp != NULL)
+        key->pub_precomp_meth->point_precomp_free(key->pub_precomp);
+    key->pub_precomp = NULL;
+    key->pub_precomp_meth = NULL;
+}
+
+/* Returns 1 if verifications with |key| use a table for the public key */
+int ossl_ec_key_has_public_precomp(const EC_KEY *key)
+{
+    return key->pub_precomp != NULL
+        && key->pub_precomp_meth == key->group->meth
+        && key->pub_precomp_dirty_cnt == key->dirty_cnt;
+}
+
+/*
+ * Builds a multiplication table for the public key, so that repeated
+ * verifications with a long-lived key don't redo the per-point
+ * precomputation.  Group methods without support for it silently ignore the
+ * request.  The table is not used once the key is modified.
+ *
+ * Other threads may be verifying with the key as soon as the table exists,
+ * so it is never replaced or freed before the key is: asking for it again
+ * does nothing, and dropping it fails.
+ */
+int ossl_ec_key_precompute_public(EC_KEY *key, int enable)
+{
+    const EC_METHOD *meth;
+    BN_CTX *ctx;
+    void *precomp;
+
+    if (key->pub_precomp != NULL) {
+        if (enable && ossl_ec_key_has_public_precomp(key))
+            return 1;
+        ERR_raise_data(ERR_LIB_EC, ERR_R_PASSED_INVALID_ARGUMENT,
+            "the public key table cannot be changed once built");
+        return 0;
+    }
+    if (!enable)
+        return 1;
+
+    if (key->group == NULL || key->pub_key == NULL) {
+        ERR_raise(ERR_LIB_EC, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    meth = key->group->meth;
+    if (meth->point_precompute_mult == NULL)
+        return 1;
+    if (EC_POINT_is_at_infinity(key->group, key->pub_key)) {
+        ERR_raise(ERR_LIB_EC, EC_R_POINT_AT_INFINITY);
+        return 0;
+    }
+
+    if ((ctx = BN_CTX_new_ex(key->libctx)) == NULL)
+        return 0;
+    precomp = meth->point_precompute_mult(key->group, key->pub_key, ctx);
+    BN_CTX_free(ctx);
+    if (precomp == NULL)
+        return 0;
+
+    key->pub_precomp_meth = meth;
+    key->pub_precomp = precomp;
+    key->pub_precomp_dirty_cnt = key->dirty_cnt;
+    return 1;
+}
+
+/* r = g_scalar*G + p_scalar*pub_key */
+int ossl_ec_key_pub_mul(const EC_KEY *key, EC_POINT *r,
+    const BIGNUM *g_scalar, const BIGNUM *p_scalar, BN_CTX *ctx)
+{
+    if (ossl_ec_key_has_public_precomp(key) && ctx != NULL)
+        return key->pub_precomp_meth->mul_precomp(key->group, r, g_scalar,
+            p_scalar, key->pub_precomp, ctx);
+
+    return EC_POINT_mul(key->group, r, g_scalar, key->pub_key, p_scalar, ctx);
+}
+
 const EC_GROUP *EC_KEY_get0_group(const EC_KEY *key)
 {
     return key->group;
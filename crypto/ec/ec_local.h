@@ -200,6 +200,17 @@ struct ec_method_st {
         EC_POINT *r, EC_POINT *s,
         EC_POINT *p, BN_CTX *ctx);
     int (*group_full_init)(EC_GROUP *group, const unsigned char *data);
+    /*
+     * Optional per-point precomputation, used for long-lived public keys:
+     * point_precompute_mult() returns a table for |point|, which is passed
+     * to mul_precomp() to compute r = g_scalar*G + p_scalar*point.
+     */
+    void *(*point_precompute_mult)(const EC_GROUP *group,
+        const EC_POINT *point, BN_CTX *ctx);
+    void (*point_precomp_free)(void *precomp);
+    int (*mul_precomp)(const EC_GROUP *group, EC_POINT *r,
+        const BIGNUM *g_scalar, const BIGNUM *p_scalar,
+        const void *precomp, BN_CTX *ctx);
 };
 
 /*
@@ -311,6 +322,14 @@ struct ec_key_st {
 
     /* Provider data */
     size_t dirty_cnt; /* If any key material changes, increment this */
+
+    /*
+     * Optional multiplication table for pub_key, built by the group method
+     * |pub_precomp_meth| when dirty_cnt was |pub_precomp_dirty_cnt|.
+     */
+    const EC_METHOD *pub_precomp_meth;
+    void *pub_precomp;
+    size_t pub_precomp_dirty_cnt;
 };
 
 struct ec_point_st {
@@ -693,6 +712,8 @@ struct ec_key_method_st {
 EC_KEY *ossl_ec_key_new_method_int(OSSL_LIB_CTX *libctx, const char *propq);
 
 int ossl_ec_key_gen(EC_KEY *eckey);
+int ossl_ec_key_pub_mul(const EC_KEY *key, EC_POINT *r,
+    const BIGNUM *g_scalar, const BIGNUM *p_scalar, BN_CTX *ctx);
 int ossl_ecdh_compute_key(unsigned char **pout, size_t *poutlen,
     const EC_POINT *pub_key, const EC_KEY *ecdh);
 int ossl_ecdh_simple_compute_key(unsigned char **pout, size_t *poutlen,
@@ -790,6 +790,74 @@ static int ecp_nistz256_is_affine_G(const EC_POINT *generator)
     return (bn_get_top(generator->X) == P256_LIMBS) && (bn_get_top(generator->Y) == P256_LIMBS) && is_equal(bn_get_words(generator->X), def_xG) && is_equal(bn_get_words(generator->Y), def_yG) && is_one(generator->Z);
 }
 
+/*
+ * ecp_nistz256_build_table fills |table| for a Booth encoded (w=7) comb
+ * multiplication by |base|: row j holds the multiples 1..64 of
+ * 2^(7*j)*|base|, in affine form and in the Montgomery domain. Each row is
+ * made affine with a single field inversion. |base| must not be the point
+ * at infinity and must have prime order, so that no entry is infinity.
+ */
+__owur static int ecp_nistz256_build_table(PRECOMP256_ROW *table,
+    const EC_POINT *base)
+{
+    P256_POINT *row = NULL;
+    BN_ULONG(*prod)[P256_LIMBS] = NULL;
+    BN_ULONG inv[P256_LIMBS], zinv[P256_LIMBS], zinv2[P256_LIMBS];
+    P256_POINT_AFFINE temp;
+    int j, k, ret = 0;
+
+    if ((row = OPENSSL_malloc_array(64, sizeof(*row))) == NULL
+        || (prod = OPENSSL_malloc_array(64, sizeof(*prod))) == NULL)
+        goto err;
+
+    if (!ecp_nistz256_bignum_to_field_elem(row[0].X, base->X)
+        || !ecp_nistz256_bignum_to_field_elem(row[0].Y, base->Y)
+        || !ecp_nistz256_bignum_to_field_elem(row[0].Z, base->Z)) {
+        ERR_raise(ERR_LIB_EC, EC_R_COORDINATES_OUT_OF_RANGE);
+        goto err;
+    }
+
+    for (j = 0; j < 37; j++) {
+        /* row[k] = (k + 1) * 2^(7*j) * base */
+        ecp_nistz256_point_double(&row[1], &row[0]);
+        for (k = 2; k < 64; k++)
+            ecp_nistz256_point_add(&row[k], &row[k - 1], &row[0]);
+
+        /* Invert all Z coordinates at once with Montgomery's trick */
+        memcpy(prod[0], row[0].Z, sizeof(prod[0]));
+        for (k = 1; k < 64; k++)
+            ecp_nistz256_mul_mont(prod[k], prod[k - 1], row[k].Z);
+        ecp_nistz256_mod_inverse(inv, prod[63]);
+
+        /*
+         * The zero entry is implicitly infinity, and we skip it, storing
+         * other values with -1 offset.
+         */
+        for (k = 63; k >= 0; k--) {
+            if (k > 0) {
+                ecp_nistz256_mul_mont(zinv, inv, prod[k - 1]);
+                ecp_nistz256_mul_mont(inv, inv, row[k].Z);
+            } else {
+                memcpy(zinv, inv, sizeof(zinv));
+            }
+            ecp_nistz256_sqr_mont(zinv2, zinv);
+            ecp_nistz256_mul_mont(temp.X, row[k].X, zinv2);
+            ecp_nistz256_mul_mont(zinv2, zinv2, zinv);
+            ecp_nistz256_mul_mont(temp.Y, row[k].Y, zinv2);
+            ecp_nistz256_scatter_w7(table[j], &temp, k);
+        }
+
+        /* 2^(7*(j+1)) * base = 2 * row[63] */
+        ecp_nistz256_point_double(&row[0], &row[63]);
+    }
+
+    ret = 1;
+err:
+    OPENSSL_free(row);
+    OPENSSL_free(prod);
+    return ret;
+}
+
 __owur static int ecp_nistz256_mult_precompute(EC_GROUP *group, BN_CTX *ctx)
 {
     /*
@@ -799,11 +867,9 @@ __owur static int ecp_nistz256_mult_precompute(EC_GROUP *group, BN_CTX *ctx)
      * therefore require ceil(256/7) = 37 tables.
      */
     const BIGNUM *order;
-    EC_POINT *P = NULL, *T = NULL;
     const EC_POINT *generator;
     NISTZ256_PRE_COMP *pre_comp;
-    BN_CTX *new_ctx = NULL;
-    int i, j, k, ret = 0;
+    int ret = 0;
     size_t w;
 
     PRECOMP256_ROW *preComputedTable = NULL;
@@ -828,14 +894,6 @@ __owur static int ecp_nistz256_mult_precompute(EC_GROUP *group, BN_CTX *ctx)
     if ((pre_comp = ecp_nistz256_pre_comp_new(group)) == NULL)
         return 0;
 
-    if (ctx == NULL) {
-        ctx = new_ctx = BN_CTX_new_ex(group->libctx);
-        if (ctx == NULL)
-            goto err;
-    }
-
-    BN_CTX_start(ctx);
-
     order = EC_GROUP_get0_order(group);
     if (order == NULL)
         goto err;
@@ -852,44 +910,9 @@ __owur static int ecp_nistz256_mult_precompute(EC_GROUP *group, BN_CTX *ctx)
         == NULL)
         goto err;
 
-    P = EC_POINT_new(group);
-    T = EC_POINT_new(group);
-    if (P == NULL || T == NULL)
-        goto err;
-
-    /*
-     * The zero entry is implicitly infinity, and we skip it, storing other
-     * values with -1 offset.
-     */
-    if (!EC_POINT_copy(T, generator))
+    if (!ecp_nistz256_build_table(preComputedTable, generator))
         goto err;
 
-    for (k = 0; k < 64; k++) {
-        if (!EC_POINT_copy(P, T))
-            goto err;
-        for (j = 0; j < 37; j++) {
-            P256_POINT_AFFINE temp;
-            /*
-             * It would be faster to use EC_POINTs_make_affine and
-             * make multiple points affine at the same time.
-             */
-            if (group->meth->make_affine == NULL
-                || !group->meth->make_affine(group, P, ctx))
-                goto err;
-            if (!ecp_nistz256_bignum_to_field_elem(temp.X, P->X) || !ecp_nistz256_bignum_to_field_elem(temp.Y, P->Y)) {
-                ERR_raise(ERR_LIB_EC, EC_R_COORDINATES_OUT_OF_RANGE);
-                goto err;
-            }
-            ecp_nistz256_scatter_w7(preComputedTable[j], &temp, k);
-            for (i = 0; i < 7; i++) {
-                if (!EC_POINT_dbl(group, P, P, ctx))
-                    goto err;
-            }
-        }
-        if (!EC_POINT_add(group, T, T, generator, ctx))
-            goto err;
-    }
-
     pre_comp->group = group;
     pre_comp->w = w;
     pre_comp->precomp = preComputedTable;
@@ -900,13 +923,8 @@ __owur static int ecp_nistz256_mult_precompute(EC_GROUP *group, BN_CTX *ctx)
     ret = 1;
 
 err:
-    BN_CTX_end(ctx);
-    BN_CTX_free(new_ctx);
-
     EC_nistz256_pre_comp_free(pre_comp);
     OPENSSL_free(precomp_storage);
-    EC_POINT_free(P);
-    EC_POINT_free(T);
     return ret;
 }
 
@@ -924,6 +942,120 @@ __owur static int ecp_nistz256_set_from_affine(EC_POINT *out, const EC_GROUP *gr
     return ret;
 }
 
+/*
+ * ecp_nistz256_table_mul sets |r| to |scalar| times the point for which
+ * |preComputedTable| was built with ecp_nistz256_build_table.
+ */
+__owur static int ecp_nistz256_table_mul(const EC_GROUP *group, P256_POINT *r,
+    const PRECOMP256_ROW *preComputedTable,
+    const BIGNUM *scalar, BN_CTX *ctx)
+{
+    int i, ret = 0;
+    unsigned char p_str[33] = { 0 };
+    unsigned int idx = 0;
+    const unsigned int window_size = 7;
+    const unsigned int mask = (1 << (window_size + 1)) - 1;
+    unsigned int wvalue;
+    ALIGN32 union {
+        P256_POINT p;
+        P256_POINT_AFFINE a;
+    } t, p;
+    BN_ULONG infty;
+    BIGNUM *tmp_scalar;
+
+    BN_CTX_start(ctx);
+
+    if ((BN_num_bits(scalar) > 256)
+        || BN_is_negative(scalar)) {
+        if ((tmp_scalar = BN_CTX_get(ctx)) == NULL)
+            goto err;
+
+        if (!BN_nnmod(tmp_scalar, scalar, group->order, ctx)) {
+            ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
+            goto err;
+        }
+        scalar = tmp_scalar;
+    }
+
+    for (i = 0; i < bn_get_top(scalar) * BN_BYTES; i += BN_BYTES) {
+        BN_ULONG d = bn_get_words(scalar)[i / BN_BYTES];
+
+        p_str[i + 0] = (unsigned char)d;
+        p_str[i + 1] = (unsigned char)(d >> 8);
+        p_str[i + 2] = (unsigned char)(d >> 16);
+        p_str[i + 3] = (unsigned char)(d >>= 24);
+        if (BN_BYTES == 8) {
+            d >>= 8;
+            p_str[i + 4] = (unsigned char)d;
+            p_str[i + 5] = (unsigned char)(d >> 8);
+            p_str[i + 6] = (unsigned char)(d >> 16);
+            p_str[i + 7] = (unsigned char)(d >> 24);
+        }
+    }
+
+    for (; i < 33; i++)
+        p_str[i] = 0;
+
+    /* First window */
+    wvalue = (p_str[0] << 1) & mask;
+    idx += window_size;
+
+    wvalue = _booth_recode_w7(wvalue);
+
+    ecp_nistz256_gather_w7(&p.a, preComputedTable[0],
+        wvalue >> 1);
+
+    ecp_nistz256_neg(p.p.Z, p.p.Y);
+    copy_conditional(p.p.Y, p.p.Z, wvalue & 1);
+
+    /*
+     * Since affine infinity is encoded as (0,0) and
+     * Jacobian is (,,0), we need to harmonize them
+     * by assigning "one" or zero to Z.
+     */
+    infty = (p.p.X[0] | p.p.X[1] | p.p.X[2] | p.p.X[3] | p.p.Y[0] | p.p.Y[1] | p.p.Y[2] | p.p.Y[3]);
+    if (P256_LIMBS == 8)
+        infty |= (p.p.X[4] | p.p.X[5] | p.p.X[6] | p.p.X[7] | p.p.Y[4] | p.p.Y[5] | p.p.Y[6] | p.p.Y[7]);
+
+    infty = 0 - is_zero(infty);
+    infty = ~infty;
+
+    p.p.Z[0] = ONE[0] & infty;
+    p.p.Z[1] = ONE[1] & infty;
+    p.p.Z[2] = ONE[2] & infty;
+    p.p.Z[3] = ONE[3] & infty;
+    if (P256_LIMBS == 8) {
+        p.p.Z[4] = ONE[4] & infty;
+        p.p.Z[5] = ONE[5] & infty;
+        p.p.Z[6] = ONE[6] & infty;
+        p.p.Z[7] = ONE[7] & infty;
+    }
+
+    for (i = 1; i < 37; i++) {
+        unsigned int off = (idx - 1) / 8;
+        wvalue = p_str[off] | p_str[off + 1] << 8;
+        wvalue = (wvalue >> ((idx - 1) % 8)) & mask;
+        idx += window_size;
+
+        wvalue = _booth_recode_w7(wvalue);
+
+        ecp_nistz256_gather_w7(&t.a,
+            preComputedTable[i], wvalue >> 1);
+
+        ecp_nistz256_neg(t.p.Z, t.a.Y);
+        copy_conditional(t.a.Y, t.p.Z, wvalue & 1);
+
+        ecp_nistz256_point_add_affine(&p.p, &p.p, &t.a);
+    }
+
+    memcpy(r, &p.p, sizeof(*r));
+    ret = 1;
+
+err:
+    BN_CTX_end(ctx);
+    return ret;
+}
+
 /* r = scalar*G + sum(scalars[i]*points[i]) */
 __owur static int ecp_nistz256_points_mul(const EC_GROUP *group,
     EC_POINT *r,
@@ -932,22 +1064,16 @@ __owur static int ecp_nistz256_points_mul(const EC_GROUP *group,
     const EC_POINT *points[],
     const BIGNUM *scalars[], BN_CTX *ctx)
 {
-    int i = 0, ret = 0, no_precomp_for_generator = 0, p_is_infinity = 0;
-    unsigned char p_str[33] = { 0 };
+    int ret = 0, no_precomp_for_generator = 0, p_is_infinity = 0;
     const PRECOMP256_ROW *preComputedTable = NULL;
     const NISTZ256_PRE_COMP *pre_comp = NULL;
     const EC_POINT *generator = NULL;
     const BIGNUM **new_scalars = NULL;
     const EC_POINT **new_points = NULL;
-    unsigned int idx = 0;
-    const unsigned int window_size = 7;
-    const unsigned int mask = (1 << (window_size + 1)) - 1;
-    unsigned int wvalue;
     ALIGN32 union {
         P256_POINT p;
         P256_POINT_AFFINE a;
     } t, p;
-    BIGNUM *tmp_scalar;
 
     if ((num + 1) == 0 || (num + 1) > OPENSSL_MALLOC_MAX_NELEMS(void *)) {
         ERR_raise(ERR_LIB_EC, ERR_R_PASSED_INVALID_ARGUMENT);
@@ -1000,90 +1126,9 @@ __owur static int ecp_nistz256_points_mul(const EC_GROUP *group,
         }
 
         if (preComputedTable) {
-            BN_ULONG infty;
-
-            if ((BN_num_bits(scalar) > 256)
-                || BN_is_negative(scalar)) {
-                if ((tmp_scalar = BN_CTX_get(ctx)) == NULL)
-                    goto err;
-
-                if (!BN_nnmod(tmp_scalar, scalar, group->order, ctx)) {
-                    ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
-                    goto err;
-                }
-                scalar = tmp_scalar;
-            }
-
-            for (i = 0; i < bn_get_top(scalar) * BN_BYTES; i += BN_BYTES) {
-                BN_ULONG d = bn_get_words(scalar)[i / BN_BYTES];
-
-                p_str[i + 0] = (unsigned char)d;
-                p_str[i + 1] = (unsigned char)(d >> 8);
-                p_str[i + 2] = (unsigned char)(d >> 16);
-                p_str[i + 3] = (unsigned char)(d >>= 24);
-                if (BN_BYTES == 8) {
-                    d >>= 8;
-                    p_str[i + 4] = (unsigned char)d;
-                    p_str[i + 5] = (unsigned char)(d >> 8);
-                    p_str[i + 6] = (unsigned char)(d >> 16);
-                    p_str[i + 7] = (unsigned char)(d >> 24);
-                }
-            }
-
-            for (; i < 33; i++)
-                p_str[i] = 0;
-
-            /* First window */
-            wvalue = (p_str[0] << 1) & mask;
-            idx += window_size;
-
-            wvalue = _booth_recode_w7(wvalue);
-
-            ecp_nistz256_gather_w7(&p.a, preComputedTable[0],
-                wvalue >> 1);
-
-            ecp_nistz256_neg(p.p.Z, p.p.Y);
-            copy_conditional(p.p.Y, p.p.Z, wvalue & 1);
-
-            /*
-             * Since affine infinity is encoded as (0,0) and
-             * Jacobian is (,,0), we need to harmonize them
-             * by assigning "one" or zero to Z.
-             */
-            infty = (p.p.X[0] | p.p.X[1] | p.p.X[2] | p.p.X[3] | p.p.Y[0] | p.p.Y[1] | p.p.Y[2] | p.p.Y[3]);
-            if (P256_LIMBS == 8)
-                infty |= (p.p.X[4] | p.p.X[5] | p.p.X[6] | p.p.X[7] | p.p.Y[4] | p.p.Y[5] | p.p.Y[6] | p.p.Y[7]);
-
-            infty = 0 - is_zero(infty);
-            infty = ~infty;
-
-            p.p.Z[0] = ONE[0] & infty;
-            p.p.Z[1] = ONE[1] & infty;
-            p.p.Z[2] = ONE[2] & infty;
-            p.p.Z[3] = ONE[3] & infty;
-            if (P256_LIMBS == 8) {
-                p.p.Z[4] = ONE[4] & infty;
-                p.p.Z[5] = ONE[5] & infty;
-                p.p.Z[6] = ONE[6] & infty;
-                p.p.Z[7] = ONE[7] & infty;
-            }
-
-            for (i = 1; i < 37; i++) {
-                unsigned int off = (idx - 1) / 8;
-                wvalue = p_str[off] | p_str[off + 1] << 8;
-                wvalue = (wvalue >> ((idx - 1) % 8)) & mask;
-                idx += window_size;
-
-                wvalue = _booth_recode_w7(wvalue);
-
-                ecp_nistz256_gather_w7(&t.a,
-                    preComputedTable[i], wvalue >> 1);
-
-                ecp_nistz256_neg(t.p.Z, t.a.Y);
-                copy_conditional(t.a.Y, t.p.Z, wvalue & 1);
-
-                ecp_nistz256_point_add_affine(&p.p, &p.p, &t.a);
-            }
+            if (!ecp_nistz256_table_mul(group, &p.p, preComputedTable,
+                    scalar, ctx))
+                goto err;
         } else {
             p_is_infinity = 1;
             no_precomp_for_generator = 1;
@@ -1564,6 +1609,83 @@ err:
     return ok;
 }
 
+/*
+ * Tables for arbitrary points, e.g. long-lived public keys that are used
+ * for many signature verifications. They share the layout of the generator
+ * table, so the same Booth w7 evaluation applies.
+ */
+static void *ecp_nistz256_point_precompute_mult(const EC_GROUP *group,
+    const EC_POINT *point,
+    BN_CTX *ctx)
+{
+    NISTZ256_PRE_COMP *pre_comp;
+    PRECOMP256_ROW *preComputedTable;
+    void *precomp_storage = NULL;
+
+    if (EC_POINT_is_at_infinity(group, point)) {
+        ERR_raise(ERR_LIB_EC, EC_R_POINT_AT_INFINITY);
+        return NULL;
+    }
+
+    if ((pre_comp = ecp_nistz256_pre_comp_new(group)) == NULL)
+        return NULL;
+
+    if ((preComputedTable = OPENSSL_aligned_alloc_array(37 * 64, sizeof(P256_POINT_AFFINE), 64,
+             &precomp_storage))
+            == NULL
+        || !ecp_nistz256_build_table(preComputedTable, point)) {
+        OPENSSL_free(precomp_storage);
+        EC_nistz256_pre_comp_free(pre_comp);
+        return NULL;
+    }
+
+    pre_comp->w = 7;
+    pre_comp->precomp = preComputedTable;
+    pre_comp->precomp_storage = precomp_storage;
+    return pre_comp;
+}
+
+static void ecp_nistz256_point_precomp_free(void *precomp)
+{
+    EC_nistz256_pre_comp_free(precomp);
+}
+
+/* r = g_scalar*G + p_scalar*P, where |precomp| holds the table for P */
+__owur static int ecp_nistz256_mul_precomp(const EC_GROUP *group,
+    EC_POINT *r,
+    const BIGNUM *g_scalar,
+    const BIGNUM *p_scalar,
+    const void *precomp, BN_CTX *ctx)
+{
+    const NISTZ256_PRE_COMP *pre_comp = precomp;
+    ALIGN32 P256_POINT acc, t;
+
+    if (!EC_POINT_mul(group, r, g_scalar, NULL, NULL, ctx))
+        return 0;
+    if (p_scalar == NULL)
+        return 1;
+
+    if (!ecp_nistz256_bignum_to_field_elem(acc.X, r->X)
+        || !ecp_nistz256_bignum_to_field_elem(acc.Y, r->Y)
+        || !ecp_nistz256_bignum_to_field_elem(acc.Z, r->Z)) {
+        ERR_raise(ERR_LIB_EC, EC_R_COORDINATES_OUT_OF_RANGE);
+        return 0;
+    }
+    if (!ecp_nistz256_table_mul(group, &t,
+            (const PRECOMP256_ROW *)pre_comp->precomp, p_scalar, ctx))
+        return 0;
+    ecp_nistz256_point_add(&acc, &acc, &t);
+
+    /* Not constant-time, but we're only operating on the public output. */
+    if (!bn_set_words(r->X, acc.X, P256_LIMBS)
+        || !bn_set_words(r->Y, acc.Y, P256_LIMBS)
+        || !bn_set_words(r->Z, acc.Z, P256_LIMBS))
+        return 0;
+    r->Z_is_one = is_one(r->Z) & 1;
+
+    return 1;
+}
+
 const EC_METHOD *EC_GFp_nistz256_method(void)
 {
     static const EC_METHOD ret = {
@@ -1621,7 +1743,10 @@ const EC_METHOD *EC_GFp_nistz256_method(void)
         0, /* ladder_pre */
         0, /* ladder_step */
         0, /* ladder_post */
-        ecp_nistz256group_full_init
+        ecp_nistz256group_full_init,
+        ecp_nistz256_point_precompute_mult,
+        ecp_nistz256_point_precomp_free,
+        ecp_nistz256_mul_precomp
     };
 
     return &ret;
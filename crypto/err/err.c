@@ -328,7 +328,7 @@ void ERR_clear_error(void)
     int i;
     ERR_STATE *es;
 
-    es = ossl_err_get_state_int(0);
+    es = ossl_err_peek_state_int();
     if (es == NULL)
         return;
 
@@ -645,6 +645,28 @@ static void err_delete_thread_state(void *unused)
     OSSL_ERR_STATE_free(state);
 }
 
+/*
+ * Returns the error state of the calling thread if it has one, without
+ * allocating it.  This is used by the mark functions and ERR_clear_error(),
+ * which have nothing to do on a thread that never raised an error, so that
+ * the success paths calling them do not create a thread error state.
+ */
+ERR_STATE *ossl_err_peek_state_int(void)
+{
+    ERR_STATE *state;
+    int saveerrno = get_last_sys_error();
+
+    if (!OPENSSL_init_crypto(OPENSSL_INIT_BASE_ONLY, NULL))
+        return NULL;
+
+    state = CRYPTO_THREAD_get_local_ex(CRYPTO_THREAD_LOCAL_ERR_KEY,
+        CRYPTO_THREAD_NO_CONTEXT);
+    set_sys_error(saveerrno);
+    if (state == (ERR_STATE *)-1)
+        return NULL;
+    return state;
+}
+
 ERR_STATE *ossl_err_get_state_int(int save_sys_error)
 {
     ERR_STATE *state;
@@ -26,8 +26,10 @@ struct err_state_st {
     size_t err_data_size[ERR_NUM_ERRORS];
     int err_data_flags[ERR_NUM_ERRORS];
     char *err_file[ERR_NUM_ERRORS];
+    size_t err_file_size[ERR_NUM_ERRORS];
     int err_line[ERR_NUM_ERRORS];
     char *err_func[ERR_NUM_ERRORS];
+    size_t err_func_size[ERR_NUM_ERRORS];
     int top, bottom;
 };
 
@@ -65,31 +67,57 @@ static ossl_inline void err_set_error(ERR_STATE *es, size_t i,
         : ERR_PACK(lib, 0, reason);
 }
 
+/*
+ * Minimum allocation for the per slot file and function name buffers.  Most
+ * source paths and function names fit, so a slot is normally allocated once
+ * and then reused for every error raised into it.
+ */
+#define ERR_DEBUG_STR_MIN_SIZE 64
+
+static ossl_inline void err_free_debug_str(char **str, size_t *size)
+{
+    OPENSSL_free(*str);
+    *str = NULL;
+    *size = 0;
+}
+
+static ossl_inline void err_set_debug_str(char **str, size_t *size,
+    const char *src)
+{
+    size_t len;
+
+    if (src == NULL || src[0] == '\0') {
+        if (*str != NULL)
+            (*str)[0] = '\0';
+        return;
+    }
+
+    len = strlen(src) + 1;
+    if (len > *size) {
+        size_t newsize = len < ERR_DEBUG_STR_MIN_SIZE
+            ? ERR_DEBUG_STR_MIN_SIZE : len;
+
+        err_free_debug_str(str, size);
+        /* We cannot use OPENSSL_strdup due to possible recursion */
+        if ((*str = CRYPTO_malloc(newsize, NULL, 0)) == NULL)
+            return;
+        *size = newsize;
+    }
+    memcpy(*str, src, len);
+}
+
 static ossl_inline void err_set_debug(ERR_STATE *es, size_t i,
     const char *file, int line,
     const char *fn)
 {
     /*
-     * We dup the file and fn strings because they may be provider owned. If the
-     * provider gets unloaded, they may not be valid anymore.
+     * We copy the file and fn strings because they may be provider owned. If
+     * the provider gets unloaded, they may not be valid anymore.  The copies
+     * live in buffers owned by the slot, which are only grown when needed.
      */
-    OPENSSL_free(es->err_file[i]);
-    if (file == NULL || file[0] == '\0')
-        es->err_file[i] = NULL;
-    else if ((es->err_file[i] = CRYPTO_malloc(strlen(file) + 1,
-                  NULL, 0))
-        != NULL)
-        /* We cannot use OPENSSL_strdup due to possible recursion */
-        strcpy(es->err_file[i], file);
-
+    err_set_debug_str(&es->err_file[i], &es->err_file_size[i], file);
     es->err_line[i] = line;
-    OPENSSL_free(es->err_func[i]);
-    if (fn == NULL || fn[0] == '\0')
-        es->err_func[i] = NULL;
-    else if ((es->err_func[i] = CRYPTO_malloc(strlen(fn) + 1,
-                  NULL, 0))
-        != NULL)
-        strcpy(es->err_func[i], fn);
+    err_set_debug_str(&es->err_func[i], &es->err_func_size[i], fn);
 }
 
 static ossl_inline void err_set_data(ERR_STATE *es, size_t i,
@@ -109,13 +137,17 @@ static ossl_inline void err_clear(ERR_STATE *es, size_t i, int deall)
     es->err_flags[i] = 0;
     es->err_buffer[i] = 0;
     es->err_line[i] = -1;
-    OPENSSL_free(es->err_file[i]);
-    es->err_file[i] = NULL;
-    OPENSSL_free(es->err_func[i]);
-    es->err_func[i] = NULL;
+    if (deall) {
+        err_free_debug_str(&es->err_file[i], &es->err_file_size[i]);
+        err_free_debug_str(&es->err_func[i], &es->err_func_size[i]);
+    } else {
+        err_set_debug_str(&es->err_file[i], &es->err_file_size[i], NULL);
+        err_set_debug_str(&es->err_func[i], &es->err_func_size[i], NULL);
+    }
 }
 
 ERR_STATE *ossl_err_get_state_int(int save_sys_error);
+ERR_STATE *ossl_err_peek_state_int(void);
 void ossl_err_string_int(unsigned long e, const char *func,
     char *buf, size_t len);
 
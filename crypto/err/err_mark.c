@@ -8,13 +8,14 @@
  */
 
 #include <openssl/err.h>
+#include "crypto/err.h"
 #include "err_local.h"
 
 int ERR_set_mark(void)
 {
     ERR_STATE *es;
 
-    es = ossl_err_get_state_int(0);
+    es = ossl_err_peek_state_int();
     if (es == NULL)
         return 0;
 
@@ -28,7 +29,7 @@ int ERR_pop(void)
 {
     ERR_STATE *es;
 
-    es = ossl_err_get_state_int(0);
+    es = ossl_err_peek_state_int();
     if (es == NULL || es->bottom == es->top)
         return 0;
 
@@ -41,7 +42,7 @@ int ERR_pop_to_mark(void)
 {
     ERR_STATE *es;
 
-    es = ossl_err_get_state_int(0);
+    es = ossl_err_peek_state_int();
     if (es == NULL)
         return 0;
 
@@ -62,7 +63,7 @@ int ERR_count_to_mark(void)
     ERR_STATE *es;
     int count = 0, top;
 
-    es = ossl_err_get_state_int(1);
+    es = ossl_err_peek_state_int();
     if (es == NULL)
         return 0;
 
@@ -81,7 +82,7 @@ int ERR_clear_last_mark(void)
     ERR_STATE *es;
     int top;
 
-    es = ossl_err_get_state_int(0);
+    es = ossl_err_peek_state_int();
     if (es == NULL)
         return 0;
 
@@ -96,3 +97,24 @@ int ERR_clear_last_mark(void)
     es->err_marks[top]--;
     return 1;
 }
+
+int ossl_err_all_to_mark(int (*fn)(unsigned long e))
+{
+    ERR_STATE *es;
+    int top;
+
+    es = ossl_err_peek_state_int();
+    if (es == NULL)
+        return 1;
+
+    top = es->top;
+    while (es->bottom != top
+        && es->err_marks[top] == 0) {
+        if ((es->err_flags[top] & ERR_FLAG_CLEAR) == 0
+            && !fn(es->err_buffer[top]))
+            return 0;
+        top = top > 0 ? top - 1 : ERR_NUM_ERRORS - 1;
+    }
+
+    return 1;
+}
@@ -80,8 +80,10 @@ void OSSL_ERR_STATE_save_to_mark(ERR_STATE *es)
         es->err_data_size[i] = thread_es->err_data_size[j];
         es->err_data_flags[i] = thread_es->err_data_flags[j];
         es->err_file[i] = thread_es->err_file[j];
+        es->err_file_size[i] = thread_es->err_file_size[j];
         es->err_line[i] = thread_es->err_line[j];
         es->err_func[i] = thread_es->err_func[j];
+        es->err_func_size[i] = thread_es->err_func_size[j];
 
         thread_es->err_flags[j] = 0;
         thread_es->err_buffer[j] = 0;
@@ -89,8 +91,10 @@ void OSSL_ERR_STATE_save_to_mark(ERR_STATE *es)
         thread_es->err_data_size[j] = 0;
         thread_es->err_data_flags[j] = 0;
         thread_es->err_file[j] = NULL;
+        thread_es->err_file_size[j] = 0;
         thread_es->err_line[j] = 0;
         thread_es->err_func[j] = NULL;
+        thread_es->err_func_size[j] = 0;
     }
 
     if (i > 0) {
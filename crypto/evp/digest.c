@@ -403,6 +403,85 @@ int EVP_DigestSqueeze(EVP_MD_CTX *ctx, unsigned char *md, size_t size)
     return ctx->digest->dsqueeze(ctx->algctx, md, &size, size);
 }
 
+struct digest_batch_st {
+    const unsigned char *const *in;
+    const size_t *inlens;
+    unsigned char *const *out;
+    size_t outsize;
+    int xof;
+};
+
+static void *digest_batch_dup(void *ctx)
+{
+    return EVP_MD_CTX_dup(ctx);
+}
+
+static void digest_batch_free(void *ctx)
+{
+    EVP_MD_CTX_free(ctx);
+}
+
+static int digest_batch_one(void *ctx, size_t i, void *arg)
+{
+    struct digest_batch_st *b = arg;
+
+    return EVP_DigestUpdate(ctx, b->in[i], b->inlens[i])
+        && (b->xof ? EVP_DigestFinalXOF(ctx, b->out[i], b->outsize)
+                   : EVP_DigestFinal_ex(ctx, b->out[i], NULL));
+}
+
+int EVP_DigestBatch(EVP_MD_CTX *ctx, const unsigned char *const *in,
+    const size_t *inlens, unsigned char *const *out, size_t outsize,
+    size_t n)
+{
+    struct digest_batch_st batch;
+    int xof, sz;
+
+    if (ctx->digest == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_INVALID_NULL_ALGORITHM);
+        return 0;
+    }
+
+    if (ctx->digest->prov == NULL || ctx->algctx == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_INVALID_OPERATION);
+        return 0;
+    }
+
+    if (ossl_unlikely((ctx->flags & EVP_MD_CTX_FLAG_FINALISED) != 0)) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_CONTEXT_FINALIZED);
+        return 0;
+    }
+
+    if (n > 0 && (in == NULL || inlens == NULL || out == NULL)) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    /* An XOF produces |outsize| bytes, other digests their usual size */
+    xof = EVP_MD_xof(ctx->digest);
+    if (!xof) {
+        sz = EVP_MD_CTX_get_size(ctx);
+        if (sz <= 0 || outsize < (size_t)sz) {
+            ERR_raise(ERR_LIB_EVP, EVP_R_BUFFER_TOO_SMALL);
+            return 0;
+        }
+    }
+    if (n == 0)
+        return 1;
+
+    if (ctx->digest->batch != NULL)
+        return ctx->digest->batch(ctx->algctx, in, inlens, out, outsize, n);
+
+    /* The provider has no batch support */
+    batch.in = in;
+    batch.inlens = inlens;
+    batch.out = out;
+    batch.outsize = outsize;
+    batch.xof = xof;
+    return evp_batch_on_copies(ctx, n, digest_batch_dup, digest_batch_free,
+        digest_batch_one, &batch);
+}
+
 int EVP_MD_CTX_serialize(EVP_MD_CTX *ctx, unsigned char *out, size_t *outlen)
 {
     if (ctx->digest == NULL) {
@@ -945,6 +1024,10 @@ static void *evp_md_from_algorithm(int name_id,
             if (md->deserialize == NULL)
                 md->deserialize = OSSL_FUNC_digest_deserialize(fns);
             break;
+        case OSSL_FUNC_DIGEST_BATCH:
+            if (md->batch == NULL)
+                md->batch = OSSL_FUNC_digest_batch(fns);
+            break;
         }
     }
     if ((fncnt != 0 && fncnt != 5 && fncnt != 6)
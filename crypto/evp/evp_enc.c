@@ -424,12 +424,13 @@ int EVP_CipherPipelineEncryptInit(EVP_CIPHER_CTX *ctx, const EVP_CIPHER *cipher,
         return 0;
     }
 
-    ctx->numpipes = numpipes;
-
     if (!evp_cipher_init_internal(ctx, cipher, NULL, NULL, 1, 1,
             NULL))
         return 0;
 
+    /* Set after the init, which resets a context that is being reused */
+    ctx->numpipes = numpipes;
+
     if (ctx->cipher->p_einit == NULL) {
         ERR_raise(ERR_LIB_EVP, EVP_R_INITIALIZATION_ERROR);
         return 0;
@@ -454,12 +455,13 @@ int EVP_CipherPipelineDecryptInit(EVP_CIPHER_CTX *ctx, const EVP_CIPHER *cipher,
         return 0;
     }
 
-    ctx->numpipes = numpipes;
-
     if (!evp_cipher_init_internal(ctx, cipher, NULL, NULL, 0, 1,
             NULL))
         return 0;
 
+    /* Set after the init, which resets a context that is being reused */
+    ctx->numpipes = numpipes;
+
     if (ctx->cipher->p_dinit == NULL) {
         ERR_raise(ERR_LIB_EVP, EVP_R_INITIALIZATION_ERROR);
         return 0;
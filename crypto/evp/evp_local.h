@@ -179,6 +179,7 @@ struct evp_signature_st {
     OSSL_FUNC_signature_newctx_fn *newctx;
     OSSL_FUNC_signature_sign_init_fn *sign_init;
     OSSL_FUNC_signature_sign_fn *sign;
+    OSSL_FUNC_signature_sign_batch_fn *sign_batch;
     OSSL_FUNC_signature_sign_message_init_fn *sign_message_init;
     OSSL_FUNC_signature_sign_message_update_fn *sign_message_update;
     OSSL_FUNC_signature_sign_message_final_fn *sign_message_final;
@@ -187,6 +188,7 @@ struct evp_signature_st {
     OSSL_FUNC_signature_verify_message_init_fn *verify_message_init;
     OSSL_FUNC_signature_verify_message_update_fn *verify_message_update;
     OSSL_FUNC_signature_verify_message_final_fn *verify_message_final;
+    OSSL_FUNC_signature_verify_message_batch_fn *verify_message_batch;
     OSSL_FUNC_signature_verify_recover_init_fn *verify_recover_init;
     OSSL_FUNC_signature_verify_recover_fn *verify_recover;
     OSSL_FUNC_signature_digest_sign_init_fn *digest_sign_init;
@@ -404,6 +406,17 @@ int evp_names_do_all(OSSL_PROVIDER *prov, int number,
     void *data);
 int evp_cipher_cache_constants(EVP_CIPHER *cipher);
 
+/*
+ * The batch functions with a provider that has no batch support: |one| is
+ * called for each of the |n| entries of the batch in turn, with a copy of
+ * |ctx| made by |dup| and released with |free|, so that |ctx| itself is
+ * left as it was.  Stops at the first call that does not return 1, and
+ * returns what it returned.  Returns 0 if a copy cannot be made.
+ */
+int evp_batch_on_copies(void *ctx, size_t n, void *(*dup)(void *ctx),
+    void (*free)(void *copy),
+    int (*one)(void *copy, size_t i, void *arg), void *arg);
+
 #define EVP_DO_ALL_PROVIDED_THUNK(type)                                                       \
     struct type##_do_all_provided_thunk {                                                     \
         void (*fn)(type * method, void *arg);                                                 \
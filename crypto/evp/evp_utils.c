@@ -79,3 +79,20 @@ PARAM_FUNCTIONS(EVP_MD,
     evp_do_md_getparams, get_params,
     evp_do_md_ctx_getparams, get_ctx_params,
     evp_do_md_ctx_setparams, set_ctx_params)
+
+int evp_batch_on_copies(void *ctx, size_t n, void *(*dup)(void *ctx),
+    void (*free)(void *copy),
+    int (*one)(void *copy, size_t i, void *arg), void *arg)
+{
+    void *copy;
+    size_t i;
+    int ret = 1;
+
+    for (i = 0; ret == 1 && i < n; i++) {
+        if ((copy = dup(ctx)) == NULL)
+            return 0;
+        ret = one(copy, i, arg);
+        free(copy);
+    }
+    return ret;
+}
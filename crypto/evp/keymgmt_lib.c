@@ -13,6 +13,7 @@
 #include "crypto/evp.h"
 #include "internal/core.h"
 #include "internal/provider.h"
+#include "internal/rcu.h"
 #include "evp_local.h"
 
 /*
@@ -97,6 +98,7 @@ void *evp_keymgmt_util_export_to_provider(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
     int selection)
 {
     struct evp_keymgmt_util_try_import_data_st import_data;
+    CRYPTO_RCU_LOCK *rcu;
     OP_CACHE_ELEM *op;
 
     /* Export to where? */
@@ -119,24 +121,26 @@ void *evp_keymgmt_util_export_to_provider(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
             && pk->keymgmt->prov == keymgmt->prov))
         return pk->keydata;
 
-    if (!CRYPTO_THREAD_read_lock(pk->lock))
-        return NULL;
     /*
-     * If the provider native "origin" hasn't changed since last time, we
-     * try to find our keymgmt in the operation cache.  If it has changed
-     * and our keymgmt isn't found, we will clear the cache further down.
+     * If this key is already exported to |keymgmt| and the provider native
+     * "origin" hasn't changed since then, there is no more to do.  This is
+     * the common case for a key shared by many threads, so the operation
+     * cache is searched under its RCU read lock rather than |pk->lock|.
+     * Nothing was ever cached if that lock doesn't exist yet.  If the
+     * "origin" has changed and our keymgmt isn't found, we will retire the
+     * cache further down.
      */
-    if (pk->dirty_cnt == pk->dirty_cnt_copy) {
-        /* If this key is already exported to |keymgmt|, no more to do */
-        op = evp_keymgmt_util_find_operation_cache(pk, keymgmt, selection);
-        if (op != NULL && op->keymgmt != NULL) {
-            void *ret = op->keydata;
+    rcu = ossl_rcu_deref(&pk->operation_cache_rcu);
+    if (rcu != NULL && ossl_rcu_read_lock(rcu)) {
+        void *keydata = NULL;
 
-            CRYPTO_THREAD_unlock(pk->lock);
-            return ret;
-        }
+        op = evp_keymgmt_util_find_operation_cache(pk, keymgmt, selection);
+        if (op != NULL && op->dirty_cnt == pk->dirty_cnt)
+            keydata = op->keydata;
+        ossl_rcu_read_unlock(rcu);
+        if (keydata != NULL)
+            return keydata;
     }
-    CRYPTO_THREAD_unlock(pk->lock);
 
     /* If the "origin" |keymgmt| doesn't support exporting, give up */
     if (pk->keymgmt->export == NULL)
@@ -190,11 +194,11 @@ void *evp_keymgmt_util_export_to_provider(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
     }
 
     /*
-     * If the dirty counter changed since last time, then clear the
+     * If the dirty counter changed since last time, then retire the
      * operation cache.  In that case, we know that |i| is zero.
      */
     if (pk->dirty_cnt != pk->dirty_cnt_copy)
-        evp_keymgmt_util_clear_operation_cache(pk);
+        evp_keymgmt_util_retire_operation_cache(pk);
 
     /* Add the new export to the operation cache */
     if (!evp_keymgmt_util_cache_keydata(pk, keymgmt, import_data.keydata,
@@ -219,30 +223,57 @@ static void op_cache_free(OP_CACHE_ELEM *e)
     OPENSSL_free(e);
 }
 
+static void op_cache_free_list(OP_CACHE_ELEM *p)
+{
+    OP_CACHE_ELEM *next;
+
+    for (; p != NULL; p = next) {
+        next = p->next;
+        op_cache_free(p);
+    }
+}
+
 void evp_keymgmt_util_clear_operation_cache(EVP_PKEY *pk)
 {
     if (pk == NULL)
         return;
 
-    sk_OP_CACHE_ELEM_pop_free(pk->operation_cache, op_cache_free);
+    op_cache_free_list(pk->operation_cache);
     pk->operation_cache = NULL;
+    ossl_rcu_lock_free(pk->operation_cache_rcu);
+    pk->operation_cache_rcu = NULL;
+}
+
+void evp_keymgmt_util_retire_operation_cache(EVP_PKEY *pk)
+{
+    OP_CACHE_ELEM *p = pk->operation_cache, *empty = NULL;
+
+    if (p == NULL)
+        return;
+
+    /*
+     * Other threads may still be walking the list without |pk->lock|, so it
+     * is unlinked first and only freed once they are all done with it.
+     */
+    ossl_rcu_assign_ptr(&pk->operation_cache, &empty);
+    ossl_synchronize_rcu(pk->operation_cache_rcu);
+    op_cache_free_list(p);
 }
 
 OP_CACHE_ELEM *evp_keymgmt_util_find_operation_cache(EVP_PKEY *pk,
     EVP_KEYMGMT *keymgmt,
     int selection)
 {
-    int i, end = sk_OP_CACHE_ELEM_num(pk->operation_cache);
     OP_CACHE_ELEM *p;
 
     /*
-     * A comparison and sk_P_CACHE_ELEM_find() are avoided to not cause
-     * problems when we've only a read lock.
+     * Elements are only ever added at the head of the list, and are fully
+     * set up before they're published, so this can be called with the
+     * read lock of |pk->operation_cache_rcu| instead of |pk->lock|.
      * A keymgmt is a match if the |keymgmt| pointers are identical or if the
      * provider and the name ID match
      */
-    for (i = 0; i < end; i++) {
-        p = sk_OP_CACHE_ELEM_value(pk->operation_cache, i);
+    for (p = ossl_rcu_deref(&pk->operation_cache); p != NULL; p = p->next) {
         if ((p->selection & selection) == selection
             && (keymgmt == p->keymgmt
                 || (keymgmt->name_id == p->keymgmt->name_id
@@ -258,29 +289,33 @@ int evp_keymgmt_util_cache_keydata(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
     OP_CACHE_ELEM *p = NULL;
 
     if (keydata != NULL) {
-        if (pk->operation_cache == NULL) {
-            pk->operation_cache = sk_OP_CACHE_ELEM_new_null();
-            if (pk->operation_cache == NULL)
-                return 0;
-        }
-
         p = OPENSSL_malloc(sizeof(*p));
         if (p == NULL)
             return 0;
         p->keydata = keydata;
         p->keymgmt = keymgmt;
         p->selection = selection;
+        p->dirty_cnt = pk->dirty_cnt;
+        p->next = pk->operation_cache;
 
-        if (!EVP_KEYMGMT_up_ref(keymgmt)) {
-            OPENSSL_free(p);
-            return 0;
+        if (pk->operation_cache_rcu == NULL) {
+            CRYPTO_RCU_LOCK *rcu
+                = ossl_rcu_lock_new(1, ossl_provider_libctx(keymgmt->prov));
+
+            if (rcu == NULL) {
+                OPENSSL_free(p);
+                return 0;
+            }
+            ossl_rcu_assign_ptr(&pk->operation_cache_rcu, &rcu);
         }
 
-        if (!sk_OP_CACHE_ELEM_push(pk->operation_cache, p)) {
-            EVP_KEYMGMT_free(keymgmt);
+        if (!EVP_KEYMGMT_up_ref(keymgmt)) {
             OPENSSL_free(p);
             return 0;
         }
+
+        /* Publish the fully set up element to lockless readers */
+        ossl_rcu_assign_ptr(&pk->operation_cache, &p);
     }
     return 1;
 }
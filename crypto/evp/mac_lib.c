@@ -194,6 +194,68 @@ int EVP_MAC_finalXOF(EVP_MAC_CTX *ctx, unsigned char *out, size_t outsize)
     return evp_mac_final(ctx, 1, out, NULL, outsize);
 }
 
+struct mac_batch_st {
+    const unsigned char *const *in;
+    const size_t *inlens;
+    unsigned char *const *out;
+    size_t outsize;
+};
+
+static void *mac_batch_dup(void *ctx)
+{
+    return EVP_MAC_CTX_dup(ctx);
+}
+
+static void mac_batch_free(void *ctx)
+{
+    EVP_MAC_CTX_free(ctx);
+}
+
+static int mac_batch_one(void *ctx, size_t i, void *arg)
+{
+    struct mac_batch_st *b = arg;
+    size_t l;
+
+    return EVP_MAC_update(ctx, b->in[i], b->inlens[i])
+        && EVP_MAC_final(ctx, b->out[i], &l, b->outsize);
+}
+
+int EVP_MAC_batch(EVP_MAC_CTX *ctx,
+    const unsigned char *const *in, const size_t *inlens,
+    unsigned char *const *out, size_t outsize, size_t n)
+{
+    struct mac_batch_st batch;
+    size_t macsize;
+
+    if (ctx == NULL || ctx->meth == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_INVALID_NULL_ALGORITHM);
+        return 0;
+    }
+    if (n > 0 && (in == NULL || inlens == NULL || out == NULL)) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    macsize = EVP_MAC_CTX_get_mac_size(ctx);
+    if (outsize < macsize) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    if (n == 0)
+        return 1;
+
+    if (ctx->meth->batch != NULL)
+        return ctx->meth->batch(ctx->algctx, in, inlens, out, outsize, n);
+
+    /* The provider has no batch support */
+    batch.in = in;
+    batch.inlens = inlens;
+    batch.out = out;
+    batch.outsize = outsize;
+    return evp_batch_on_copies(ctx, n, mac_batch_dup, mac_batch_free,
+        mac_batch_one, &batch);
+}
+
 /*
  * The {get,set}_params functions return 1 if there is no corresponding
  * function in the implementation.  This is the same as if there was one,
@@ -1929,7 +1929,7 @@ void *evp_pkey_export_to_provider(EVP_PKEY *pk, OSSL_LIB_CTX *libctx,
         }
 
         /*
-         * If the dirty counter changed since last time, then clear the
+         * If the dirty counter changed since last time, then retire the
          * operation cache.  In that case, we know that |i| is zero.  Just
          * in case this is a re-export, we increment then decrement the
          * keymgmt reference counter.
@@ -1944,7 +1944,7 @@ void *evp_pkey_export_to_provider(EVP_PKEY *pk, OSSL_LIB_CTX *libctx,
             goto end;
 
         if (pk->ameth->dirty_cnt(pk) != pk->dirty_cnt_copy)
-            evp_keymgmt_util_clear_operation_cache(pk);
+            evp_keymgmt_util_retire_operation_cache(pk);
 
         EVP_KEYMGMT_free(tmp_keymgmt); /* refcnt-- */
 
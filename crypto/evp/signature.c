@@ -13,11 +13,16 @@
 #include <openssl/core_names.h>
 #include <openssl/objects.h>
 #include <openssl/evp.h>
+#include <openssl/ecerr.h>
+#include <openssl/proverr.h>
+#include <openssl/rsaerr.h>
 #include "internal/numbers.h" /* includes SIZE_MAX */
 #include "internal/cryptlib.h"
 #include "internal/provider.h"
 #include "internal/core.h"
 #include "crypto/evp.h"
+#include "crypto/err.h"
+#include "crypto/sm2err.h"
 #include "evp_local.h"
 
 static void evp_signature_free(void *data)
@@ -109,6 +114,11 @@ static void *evp_signature_from_algorithm(int name_id,
                 break;
             signature->sign = OSSL_FUNC_signature_sign(fns);
             break;
+        case OSSL_FUNC_SIGNATURE_SIGN_BATCH:
+            if (signature->sign_batch != NULL)
+                break;
+            signature->sign_batch = OSSL_FUNC_signature_sign_batch(fns);
+            break;
         case OSSL_FUNC_SIGNATURE_SIGN_MESSAGE_INIT:
             if (signature->sign_message_init != NULL)
                 break;
@@ -158,6 +168,12 @@ static void *evp_signature_from_algorithm(int name_id,
             signature->verify_message_final
                 = OSSL_FUNC_signature_verify_message_final(fns);
             break;
+        case OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_BATCH:
+            if (signature->verify_message_batch != NULL)
+                break;
+            signature->verify_message_batch
+                = OSSL_FUNC_signature_verify_message_batch(fns);
+            break;
         case OSSL_FUNC_SIGNATURE_VERIFY_RECOVER_INIT:
             if (signature->verify_recover_init != NULL)
                 break;
@@ -1022,6 +1038,65 @@ int EVP_PKEY_sign(EVP_PKEY_CTX *ctx,
     return ret;
 }
 
+int EVP_PKEY_sign_batch(EVP_PKEY_CTX *ctx,
+    unsigned char *const *sigs, size_t *siglens,
+    const unsigned char *const *tbs, const size_t *tbslens, size_t n)
+{
+    EVP_SIGNATURE *signature;
+    const char *desc;
+    size_t i;
+
+    if (ctx == NULL
+        || (n > 0
+            && (sigs == NULL || siglens == NULL || tbs == NULL
+                || tbslens == NULL))) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return -1;
+    }
+
+    if (ctx->operation != EVP_PKEY_OP_SIGN) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_INITIALIZED);
+        return -1;
+    }
+
+    if (ctx->op.sig.algctx == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_SUPPORTED_FOR_THIS_KEYTYPE);
+        return -2;
+    }
+
+    signature = ctx->op.sig.signature;
+    desc = signature->description != NULL ? signature->description : "";
+    if (signature->sign_batch != NULL) {
+        if (signature->sign_batch(ctx->op.sig.algctx, sigs, siglens,
+                tbs, tbslens, n) <= 0) {
+            ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_FAILURE,
+                "%s sign_batch:%s", signature->type_name, desc);
+            return 0;
+        }
+        return 1;
+    }
+
+    /*
+     * The provider has no batch support.  Unlike a message signature, a
+     * signature of a digest can be repeated with the same context, so sign
+     * each input in turn.
+     */
+    if (signature->sign == NULL) {
+        ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_NOT_SUPPORTED,
+            "%s sign_batch:%s", signature->type_name, desc);
+        return -2;
+    }
+    for (i = 0; i < n; i++) {
+        if (signature->sign(ctx->op.sig.algctx, sigs[i], &siglens[i],
+                siglens[i], tbs[i], tbslens[i]) <= 0) {
+            ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_FAILURE,
+                "%s sign_batch:%s", signature->type_name, desc);
+            return 0;
+        }
+    }
+    return 1;
+}
+
 int EVP_PKEY_verify_init(EVP_PKEY_CTX *ctx)
 {
     return evp_pkey_signature_init(ctx, NULL, EVP_PKEY_OP_VERIFY, NULL);
@@ -1129,6 +1204,164 @@ int EVP_PKEY_verify_message_final(EVP_PKEY_CTX *ctx)
     return ret;
 }
 
+struct verify_batch_st {
+    EVP_SIGNATURE *signature;
+    const unsigned char *const *sigs;
+    const size_t *siglens;
+    const unsigned char *const *tbs;
+    const size_t *tbslens;
+    int *results;
+};
+
+#ifndef FIPS_MODULE
+/*
+ * Whether |e| only says that a signature is not valid.  Malformed DER in an
+ * ECDSA or DSA signature shows up as an ASN.1 error, and the ERR_R_XXX_LIB
+ * reasons pass on an error from under them, which is checked on its own.
+ */
+static int is_bad_signature(unsigned long e)
+{
+    int reason = ERR_GET_REASON(e);
+
+    if (ERR_FATAL_ERROR(e))
+        return 0;
+    switch (ERR_GET_LIB(e)) {
+    case ERR_LIB_ASN1:
+        return 1;
+    case ERR_LIB_RSA:
+        switch (reason) {
+        case RSA_R_BAD_PAD_BYTE_COUNT:
+        case RSA_R_BAD_SIGNATURE:
+        case RSA_R_BLOCK_TYPE_IS_NOT_01:
+        case RSA_R_DATA_TOO_LARGE_FOR_MODULUS:
+        case RSA_R_DIGEST_DOES_NOT_MATCH:
+        case RSA_R_FIRST_OCTET_INVALID:
+        case RSA_R_INVALID_HEADER:
+        case RSA_R_INVALID_PADDING:
+        case RSA_R_INVALID_TRAILER:
+        case RSA_R_LAST_OCTET_INVALID:
+        case RSA_R_NULL_BEFORE_BLOCK_MISSING:
+        case RSA_R_PADDING_CHECK_FAILED:
+        case RSA_R_SLEN_CHECK_FAILED:
+        case RSA_R_SLEN_RECOVERY_FAILED:
+        case RSA_R_WRONG_SIGNATURE_LENGTH:
+            return 1;
+        }
+        break;
+    case ERR_LIB_EC:
+        return reason == EC_R_BAD_SIGNATURE;
+#ifndef OPENSSL_NO_SM2
+    case ERR_LIB_SM2:
+        return reason == SM2_R_BAD_SIGNATURE;
+#endif
+    case ERR_LIB_PROV:
+        if (reason == PROV_R_INVALID_SIGNATURE_SIZE)
+            return 1;
+        break;
+    }
+    return reason == ERR_R_RSA_LIB || reason == ERR_R_EC_LIB
+        || reason == ERR_R_DSA_LIB || reason == ERR_R_ASN1_LIB
+        || reason == ERR_R_NESTED_ASN1_ERROR;
+}
+#endif
+
+static int verify_batch_one(void *algctx, size_t i, void *arg)
+{
+    struct verify_batch_st *b = arg;
+    int ok;
+
+    /*
+     * A bad signature is reported in |results|, not as an error.  Any other
+     * error stops the batch, and is left on the queue.
+     */
+    ERR_set_mark();
+    ok = b->signature->verify(algctx, b->sigs[i], b->siglens[i], b->tbs[i],
+        b->tbslens[i]);
+#ifndef FIPS_MODULE
+    if (ok <= 0 && !ossl_err_all_to_mark(is_bad_signature)) {
+#else
+    /* The FIPS provider can only count the errors, so any error stops */
+    if (ok <= 0 && ERR_count_to_mark() > 0) {
+#endif
+        ERR_clear_last_mark();
+        return -1;
+    }
+    ERR_pop_to_mark();
+    b->results[i] = ok > 0;
+    return 1;
+}
+
+int EVP_PKEY_verify_message_batch(EVP_PKEY_CTX *ctx,
+    const unsigned char *const *sigs, const size_t *siglens,
+    const unsigned char *const *tbs, const size_t *tbslens,
+    int *results, size_t n)
+{
+    struct verify_batch_st batch;
+    EVP_SIGNATURE *signature;
+    const char *desc;
+    size_t i;
+    int ret = 1;
+
+    if (ctx == NULL
+        || (n > 0
+            && (sigs == NULL || siglens == NULL || tbs == NULL
+                || tbslens == NULL || results == NULL))) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return -1;
+    }
+
+    if (ctx->operation != EVP_PKEY_OP_VERIFYMSG) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_INITIALIZED);
+        return -1;
+    }
+
+    if (ctx->op.sig.algctx == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_SUPPORTED_FOR_THIS_KEYTYPE);
+        return -2;
+    }
+
+    signature = ctx->op.sig.signature;
+    desc = signature->description != NULL ? signature->description : "";
+    if (signature->verify_message_batch != NULL) {
+        if (!signature->verify_message_batch(ctx->op.sig.algctx, sigs, siglens,
+                tbs, tbslens, results, n)) {
+            ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_FAILURE,
+                "%s verify_message_batch:%s", signature->type_name, desc);
+            return -1;
+        }
+    } else {
+        /*
+         * The provider has no batch support, so verify each signature with a
+         * copy of the initialised context, as a one-shot verification may
+         * only be done once per context.
+         */
+        if (signature->verify == NULL
+            || signature->dupctx == NULL || signature->freectx == NULL) {
+            ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_NOT_SUPPORTED,
+                "%s verify_message_batch:%s", signature->type_name, desc);
+            return -2;
+        }
+        batch.signature = signature;
+        batch.sigs = sigs;
+        batch.siglens = siglens;
+        batch.tbs = tbs;
+        batch.tbslens = tbslens;
+        batch.results = results;
+        if (evp_batch_on_copies(ctx->op.sig.algctx, n, signature->dupctx,
+                signature->freectx, verify_batch_one, &batch)
+            != 1) {
+            ERR_raise_data(ERR_LIB_EVP, EVP_R_PROVIDER_SIGNATURE_FAILURE,
+                "%s verify_message_batch:%s", signature->type_name, desc);
+            return -1;
+        }
+    }
+
+    for (i = 0; i < n; i++)
+        if (!results[i])
+            ret = 0;
+    return ret;
+}
+
 int EVP_PKEY_verify(EVP_PKEY_CTX *ctx,
     const unsigned char *sig, size_t siglen,
     const unsigned char *tbs, size_t tbslen)
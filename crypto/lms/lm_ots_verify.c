@@ -11,9 +11,18 @@
 #include <openssl/byteorder.h>
 #include "crypto/lms_sig.h"
 #include "crypto/lms_util.h"
+#include "crypto/sha.h"
 
 static int lm_ots_compute_pubkey_final(EVP_MD_CTX *ctx, EVP_MD_CTX *ctxIq,
-    const LM_OTS_SIG *sig, unsigned char *Kc);
+    const LM_OTS_SIG *sig, const unsigned char *Id, const unsigned char *qbuf,
+    unsigned char *Kc);
+
+#if defined(SHA256_ASM) && !defined(OPENSSL_NO_ASM) \
+    && (defined(__x86_64) || defined(_M_AMD64))
+#define LM_OTS_SHA256_MB
+/* The number of chains that are computed in parallel */
+#define LM_OTS_MB_LANES 8
+#endif
 
 /**
  * @brief OTS Signature verification.
@@ -56,7 +65,7 @@ int ossl_lm_ots_compute_pubkey(EVP_MD_CTX *ctx, EVP_MD_CTX *ctxIq,
         && EVP_DigestUpdate(ctx, d_mesg, sizeof(d_mesg))
         && EVP_DigestUpdate(ctx, sig->C, sig->params->n)
         && EVP_DigestUpdate(ctx, msg, msglen)
-        && lm_ots_compute_pubkey_final(ctx, ctxIq, sig, Kc));
+        && lm_ots_compute_pubkey_final(ctx, ctxIq, sig, Id, qbuf, Kc));
 }
 
 /**
@@ -69,6 +78,135 @@ static ossl_inline void INC16(unsigned char *tag)
         ++tag[0];
 }
 
+#ifdef LM_OTS_SHA256_MB
+/* The size of I || u32str(q) || u16str(i) || u8str(j) */
+#define LM_OTS_MB_HDR (LMS_SIZE_I + LMS_SIZE_q + 3)
+
+/*
+ * @brief Load the next chain, starting from index |*next|, that needs hashing
+ * into the SHA-256 block |b|.  Chains that need no hashing have their start
+ * value copied straight to |z|.
+ *
+ * @returns 1 if a chain was loaded, or 0 if there are none left.
+ */
+static int lm_ots_mb_load_chain(unsigned char *b, const LM_OTS_PARAMS *params,
+    const unsigned char *Q, const unsigned char *y, unsigned char *z,
+    uint32_t *next, uint32_t *chain)
+{
+    uint32_t n = params->n;
+    uint8_t w = (uint8_t)params->w, end = (uint8_t)((1 << w) - 1), a;
+
+    for (; *next < params->p; ++*next) {
+        a = lms_ots_coef(Q, (uint16_t)*next, w);
+        if (a == end) {
+            memcpy(z + *next * n, y + *next * n, n);
+            continue;
+        }
+        OPENSSL_store_u16_be(b + LMS_SIZE_I + LMS_SIZE_q, (uint16_t)*next);
+        b[LM_OTS_MB_HDR - 1] = a;
+        memcpy(b + LM_OTS_MB_HDR, y + *next * n, n);
+        *chain = (*next)++;
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * @brief Compute the ends of all the Winternitz chains of a LM_OTS signature,
+ * LM_OTS_MB_LANES chains at a time, using the multi-buffer SHA-256 kernel.
+ *
+ * Each chain step hashes I || u32str(q) || u16str(i) || u8str(j) || tmp,
+ * which fits into a single SHA-256 block for both n = 32 and n = 24, so the
+ * padded blocks are built here and passed directly to the compression
+ * function.  A lane that finishes its chain is refilled with the next one.
+ *
+ * @param params The LM_OTS parameters, which must use SHA256 or SHA256-192.
+ * @param Id A 16 byte identifier (I) associated with a LMS tree
+ * @param qbuf The leaf index of the LMS tree encoded as u32str(q).
+ * @param Q The message digest followed by its checksum
+ * @param y The p chain start values from the signature
+ * @param z The returned p chain end values, each n bytes long
+ */
+static void lm_ots_chains_sha256_mb(const LM_OTS_PARAMS *params,
+    const unsigned char *Id, const unsigned char *qbuf,
+    const unsigned char *Q, const unsigned char *y, unsigned char *z)
+{
+    static const unsigned int iv[8] = {
+        0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+        0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+    };
+    const uint32_t n = params->n;
+    const uint8_t end = (uint8_t)((1 << params->w) - 1);
+    const uint64_t bits = 8 * (uint64_t)(LM_OTS_MB_HDR + n);
+    unsigned char storage[sizeof(SHA256_MB_CTX) + 32];
+    SHA256_MB_CTX *mctx;
+    HASH_DESC desc[LM_OTS_MB_LANES];
+    unsigned char blocks[LM_OTS_MB_LANES][64];
+    uint32_t chain[LM_OTS_MB_LANES], next = 0, k;
+    HASH_DESC tmp;
+    int l, active = 0;
+
+    mctx = (SHA256_MB_CTX *)(storage + 32 - ((size_t)storage % 32));
+
+    /* Pad each block and assign the first chains to the lanes */
+    for (l = 0; l < LM_OTS_MB_LANES; l++) {
+        unsigned char *b = blocks[l];
+
+        memset(b, 0, sizeof(blocks[l]));
+        memcpy(b, Id, LMS_SIZE_I);
+        memcpy(b + LMS_SIZE_I, qbuf, LMS_SIZE_q);
+        b[LM_OTS_MB_HDR + n] = 0x80;
+        for (k = 0; k < 8; k++)
+            b[63 - k] = (unsigned char)(bits >> (8 * k));
+        desc[l].ptr = b;
+        desc[l].blocks = lm_ots_mb_load_chain(b, params, Q, y, z, &next,
+            &chain[l]);
+        active += desc[l].blocks;
+    }
+
+    /*
+     * The kernel stops at the first group of four lanes (or pair of lanes
+     * for SHA extensions) that has no blocks, so the active lanes are kept
+     * at the front of |desc|.
+     */
+    while (active > 0) {
+        for (k = 0; k < 8; k++)
+            for (l = 0; l < LM_OTS_MB_LANES; l++)
+                ((unsigned int *)mctx)[8 * k + l] = iv[k];
+        sha256_multi_block(mctx, desc, (active + 3) / 4);
+
+        for (l = 0; l < active; l++) {
+            unsigned char *b = (unsigned char *)desc[l].ptr;
+
+            /* tmp = H(I || u32str(q) || u16str(i) || u8str(j) || tmp) */
+            for (k = 0; k < n / 4; k++)
+                OPENSSL_store_u32_be(b + LM_OTS_MB_HDR + 4 * k,
+                    ((unsigned int *)mctx)[8 * k + l]);
+            if (++b[LM_OTS_MB_HDR - 1] == end) {
+                /* The chain is complete, so move on to the next one */
+                memcpy(z + chain[l] * n, b + LM_OTS_MB_HDR, n);
+                desc[l].blocks = lm_ots_mb_load_chain(b, params, Q, y, z,
+                    &next, &chain[l]);
+            }
+        }
+        /* Move the lanes that have run out of chains to the end */
+        for (l = 0; l < active;) {
+            if (desc[l].blocks != 0) {
+                l++;
+                continue;
+            }
+            --active;
+            tmp = desc[l];
+            desc[l] = desc[active];
+            desc[active] = tmp;
+            k = chain[l];
+            chain[l] = chain[active];
+            chain[active] = k;
+        }
+    }
+}
+#endif
+
 /*
  * @brief OTS signature verification final phase
  * See RFC 8554 Section 4.3 Signature Verification
@@ -80,11 +218,14 @@ static ossl_inline void INC16(unsigned char *tag)
  *            This ctx is reused for other calculations.
  * @param ctxIq A EVP_MD_CTX object that contains a non finalized value of H(I || q).
  * @param sig An object containing LM_OTS signature data.
+ * @param Id A 16 byte identifier (I) associated with a LMS tree
+ * @param qbuf The leaf index of the LMS tree encoded as u32str(q).
  * @param Kc The computed public key. It is assumed the size is n.
  * @returns 1 on success, or 0 otherwise.
  */
 static int lm_ots_compute_pubkey_final(EVP_MD_CTX *ctx, EVP_MD_CTX *ctxIq,
-    const LM_OTS_SIG *sig, unsigned char *Kc)
+    const LM_OTS_SIG *sig, const unsigned char *Id, const unsigned char *qbuf,
+    unsigned char *Kc)
 {
     int ret = 0, i;
     EVP_MD_CTX *ctxKc = NULL;
@@ -114,6 +255,21 @@ static int lm_ots_compute_pubkey_final(EVP_MD_CTX *ctx, EVP_MD_CTX *ctxIq,
         || !EVP_DigestUpdate(ctxKc, d_pblc, sizeof(d_pblc)))
         goto err;
 
+#ifdef LM_OTS_SHA256_MB
+    if (strncmp(params->digestname, "SHA256", 6) == 0) {
+        unsigned char *zs = OPENSSL_malloc(p * n);
+
+        if (zs != NULL)
+            lm_ots_chains_sha256_mb(params, Id, qbuf, Q, sig->y, zs);
+        ret = zs != NULL
+            && EVP_DigestUpdate(ctxKc, zs, p * n)
+            && EVP_DigestFinal(ctxKc, Kc, NULL);
+        OPENSSL_free(zs);
+        EVP_MD_CTX_free(ctxKc);
+        return ret;
+    }
+#endif
+
     y = sig->y;
     tag[0] = 0;
     tag[1] = 0;
@@ -21,11 +21,33 @@ LMS_KEY *ossl_lms_key_new(OSSL_LIB_CTX *libctx)
 {
     LMS_KEY *ret = OPENSSL_zalloc(sizeof(LMS_KEY));
 
-    if (ret != NULL)
-        ret->libctx = libctx;
+    if (ret == NULL)
+        return NULL;
+    ret->libctx = libctx;
+    ret->cache = OPENSSL_zalloc(sizeof(*ret->cache));
+    if (ret->cache == NULL
+        || (ret->cache->lock = CRYPTO_THREAD_lock_new()) == NULL) {
+        OPENSSL_free(ret->cache);
+        OPENSSL_free(ret);
+        return NULL;
+    }
     return ret;
 }
 
+/**
+ * @brief Discard the authenticated tree nodes that have been cached by
+ * signature verification, e.g. because the public key is being replaced.
+ */
+void ossl_lms_key_clear_cache(LMS_KEY *lmskey)
+{
+    LMS_NODE_CACHE *cache = lmskey->cache;
+
+    OPENSSL_free(cache->nodes);
+    OPENSSL_free(cache->valid);
+    cache->nodes = NULL;
+    cache->valid = NULL;
+}
+
 /**
  * @brief Destroy a LMS_KEY object
  */
@@ -38,6 +60,9 @@ void ossl_lms_key_free(LMS_KEY *lmskey)
 
     pub = &lmskey->pub;
     OPENSSL_free(pub->encoded);
+    ossl_lms_key_clear_cache(lmskey);
+    CRYPTO_THREAD_lock_free(lmskey->cache->lock);
+    OPENSSL_free(lmskey->cache);
     OPENSSL_free(lmskey);
 }
 
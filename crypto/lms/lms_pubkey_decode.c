@@ -98,6 +98,7 @@ int ossl_lms_pubkey_decode(const unsigned char *pub, size_t publen,
     if (pkey->encoded != NULL) {
         OPENSSL_free(pkey->encoded);
         pkey->encodedlen = 0;
+        ossl_lms_key_clear_cache(lmskey);
     }
     pkey->encoded = OPENSSL_memdup(pub, publen);
     if (pkey->encoded == NULL)
@@ -21,6 +21,101 @@ const uint16_t OSSL_LMS_D_MESG = 0x8181;
 const uint16_t OSSL_LMS_D_LEAF = 0x8282;
 const uint16_t OSSL_LMS_D_INTR = 0x8383;
 
+/*
+ * Verification caches the internal nodes of the top LMS_NODE_CACHE_HEIGHT
+ * levels of the tree, i.e. the nodes with a node number below |cache_end|,
+ * once they have been authenticated by computing the root from them.
+ * If a later path computation reaches a node whose value matches the cache,
+ * and all the remaining path entries match the cached siblings, then the
+ * remaining hashes would reproduce the authenticated nodes up to the root.
+ * They can therefore be skipped without changing which signatures verify.
+ */
+static uint32_t lms_node_cache_end(const LMS_PARAMS *lms_params)
+{
+    uint32_t height = lms_params->h;
+
+    if (height > LMS_NODE_CACHE_HEIGHT)
+        height = LMS_NODE_CACHE_HEIGHT;
+    return 1U << height;
+}
+
+/*
+ * @brief Check if the node |node_num| with value |Tc|, and the remaining
+ * |paths| entries up to the root are all authenticated nodes in |cache|.
+ *
+ * @returns 1 if they are, or 0 otherwise.
+ */
+static int lms_node_cache_match(LMS_NODE_CACHE *cache, uint32_t n,
+    uint32_t node_num, const unsigned char *Tc, const unsigned char *paths)
+{
+    int ret = 0;
+
+    if (!CRYPTO_THREAD_read_lock(cache->lock))
+        return 0;
+    if (cache->nodes == NULL
+        || !cache->valid[node_num]
+        || memcmp(cache->nodes + node_num * n, Tc, n) != 0)
+        goto end;
+    for (; node_num > 1; node_num >>= 1, paths += n) {
+        uint32_t sibling = node_num ^ 1;
+
+        if (!cache->valid[sibling]
+            || memcmp(cache->nodes + sibling * n, paths, n) != 0)
+            goto end;
+    }
+    ret = 1;
+end:
+    CRYPTO_THREAD_unlock(cache->lock);
+    return ret;
+}
+
+/*
+ * @brief Add the nodes of a path that has been verified to |cache|.
+ *
+ * @param leaf The node number of the leaf at the start of the path
+ * @param paths The path entries, i.e. the sibling of each node on the path
+ * @param nodes The computed nodes on the path, from the parent of the leaf
+ *              up to but excluding the node number |top|
+ * @param top The node at which the path computation stopped
+ */
+static void lms_node_cache_add(LMS_NODE_CACHE *cache,
+    const LMS_PARAMS *lms_params, uint32_t leaf, const unsigned char *paths,
+    const unsigned char *nodes, uint32_t top)
+{
+    uint32_t n = lms_params->n, end = lms_node_cache_end(lms_params);
+    uint32_t node_num;
+
+    if (!CRYPTO_THREAD_write_lock(cache->lock))
+        return;
+    if (cache->nodes == NULL) {
+        cache->nodes = OPENSSL_malloc_array(end, n);
+        cache->valid = OPENSSL_zalloc(end);
+        if (cache->nodes == NULL || cache->valid == NULL) {
+            OPENSSL_free(cache->nodes);
+            OPENSSL_free(cache->valid);
+            cache->nodes = NULL;
+            cache->valid = NULL;
+            goto end;
+        }
+    }
+    for (node_num = leaf; node_num > top; node_num >>= 1) {
+        uint32_t parent = node_num >> 1;
+
+        if ((node_num ^ 1) < end) {
+            memcpy(cache->nodes + (node_num ^ 1) * n, paths, n);
+            cache->valid[node_num ^ 1] = 1;
+        }
+        if (parent < end) {
+            memcpy(cache->nodes + parent * n, nodes, n);
+            cache->valid[parent] = 1;
+        }
+        paths += n;
+        nodes += n;
+    }
+end:
+    CRYPTO_THREAD_unlock(cache->lock);
+}
+
 /*
  * @brief Compute the candidate LMS root value Tc
  *
@@ -28,17 +123,25 @@ const uint16_t OSSL_LMS_D_INTR = 0x8383;
  *              the path through the tree from the leaf associated with the
  *              LM-OTS signature to the root public key node.
  * @param n The hash output size (The size of each path in |paths|)
- * @param nodenum The leaf index node number. The root node had a value of 1
- *                Each subsequent level has nodes in the range 2^h...2^(h+1)-1
+ * @param node_num The leaf index node number. The root node had a value of 1
+ *                 Each subsequent level has nodes in the range 2^h...2^(h+1)-1
  * @param ctx A EVP_MD_CTX object used for calculations
  * @param ctxI A EVP_MD_CTX object containing an unfinalised H(I)
+ * @param cache The authenticated nodes of the LMS tree, see above
+ * @param cache_end The node numbers below this value may be cached
+ * @param nodes Returns the computed nodes of the path, n bytes each.
+ * @param top Returns the node number of the last node that was computed,
+ *            which is 1 unless the computation was cut short by the cache.
  * @param Tc Contains H(I || u32str(node_num) || u16str(D_LEAF) || Kc) on input,
- *           and on output returns the calculated candidate public key.
+ *           and on output returns the calculated candidate public key, or the
+ *           value of the node |top|.
  * @returns 1 on success, or 0 otherwise.
  */
 static int lms_sig_compute_tc_from_path(const unsigned char *paths, uint32_t n,
     uint32_t node_num,
     EVP_MD_CTX *ctx, EVP_MD_CTX *ctxI,
+    LMS_NODE_CACHE *cache, uint32_t cache_end,
+    unsigned char *nodes, uint32_t *top,
     unsigned char *Tc)
 {
     int ret = 0;
@@ -59,6 +162,11 @@ static int lms_sig_compute_tc_from_path(const unsigned char *paths, uint32_t n,
         /* At each level the path contains either the left or right child */
         int odd = node_num & 1;
 
+        /* The first cached level is checked once to see if we can stop */
+        if (node_num < cache_end && (node_num << 1) >= cache_end
+            && lms_node_cache_match(cache, n, node_num, Tc, path))
+            break;
+
         node_num = node_num >> 1; /* get the parent node_num */
         OPENSSL_store_u32_be(qbuf, node_num);
 
@@ -87,8 +195,11 @@ static int lms_sig_compute_tc_from_path(const unsigned char *paths, uint32_t n,
          */
         if (!EVP_DigestFinal_ex(ctx, Tc, NULL))
             goto err;
+        memcpy(nodes, Tc, n);
+        nodes += n;
         path += n;
     }
+    *top = node_num;
     ret = 1;
 err:
     return ret;
@@ -99,7 +210,9 @@ err:
  * See RFC 8554 Section 5.4.2. Algorithm 6: Steps 3 & 4
  *
  * @param lms_sig Is a valid decoded LMS_SIG signature object.
- * @param pub Is a valid LMS public key object.
+ * @param pub Is a valid LMS public key object. Although it is const, the
+ *            nodes authenticated by a successful verification are added to
+ *            its node cache, under the cache lock.
  * @param md Contains the fetched digest to be used for Hash operations
  * @param msg A message to verify
  * @param msglen The size of |msg|
@@ -114,11 +227,12 @@ int ossl_lms_sig_verify(const LMS_SIG *lms_sig, const LMS_KEY *pub,
     EVP_MD_CTX *ctxI;
     unsigned char Kc[LMS_MAX_DIGEST_SIZE];
     unsigned char Tc[LMS_MAX_DIGEST_SIZE];
+    unsigned char nodes[LMS_MAX_DIGEST_SIZE * 25];
     unsigned char qbuf[4];
     unsigned char d_leaf[sizeof(uint16_t)];
     const LMS_PARAMS *lms_params = pub->lms_params;
     uint32_t n = lms_params->n;
-    uint32_t node_num;
+    uint32_t node_num, top;
 
     ctx = EVP_MD_CTX_create();
     ctxIq = EVP_MD_CTX_create();
@@ -141,8 +255,9 @@ int ossl_lms_sig_verify(const LMS_SIG *lms_sig, const LMS_KEY *pub,
      * Algorithm 6a: Step 4
      * Compute the candidate LMS root value Tc
      */
-    if (!ossl_assert(lms_sig->q < (uint32_t)(1 << lms_params->h)))
-        return 0;
+    if (!ossl_assert(lms_sig->q < (uint32_t)(1 << lms_params->h))
+        || !ossl_assert(lms_params->h * n <= sizeof(nodes)))
+        goto err;
     node_num = (1 << lms_params->h) + lms_sig->q;
 
     OPENSSL_store_u32_be(qbuf, node_num);
@@ -162,10 +277,21 @@ int ossl_lms_sig_verify(const LMS_SIG *lms_sig, const LMS_KEY *pub,
         || !EVP_DigestUpdate(ctx, Kc, n)
         || !EVP_DigestFinal_ex(ctx, Tc, NULL)
         || !lms_sig_compute_tc_from_path(lms_sig->paths, n, node_num,
-            ctx, ctxI, Tc))
+            ctx, ctxI, pub->cache, lms_node_cache_end(lms_params),
+            nodes, &top, Tc))
         goto err;
-    /* Algorithm 6: Step 4 */
-    ret = (memcmp(pub->pub.K, Tc, n) == 0);
+    /*
+     * Algorithm 6: Step 4
+     * If the path computation stopped early then the rest of the path has
+     * already been authenticated.
+     */
+    if (top > 1)
+        ret = 1;
+    else
+        ret = (memcmp(pub->pub.K, Tc, n) == 0);
+    if (ret)
+        lms_node_cache_add(pub->cache, lms_params, node_num, lms_sig->paths,
+            nodes, top);
 err:
     EVP_MD_CTX_free(ctxIq);
     EVP_MD_CTX_free(ctx);
@@ -156,11 +156,59 @@ void ossl_ml_dsa_key_free(ML_DSA_KEY *key)
     OPENSSL_free(key);
 }
 
+void ossl_ml_dsa_expanded_key_free(ML_DSA_EXPANDED_KEY *ek)
+{
+    if (ek == NULL)
+        return;
+    if (ek->s1_ntt.poly != NULL)
+        OPENSSL_secure_clear_free(ek->a_ntt.m_poly,
+            ek->num_polys * sizeof(POLY));
+    else
+        OPENSSL_free(ek->a_ntt.m_poly);
+    OPENSSL_free(ek);
+}
+
+/*
+ * Allocates an (uninitialised) expanded form for a key with |params|, with
+ * room for the private vectors if |priv| is set.
+ */
+static ML_DSA_EXPANDED_KEY *expanded_key_alloc(const ML_DSA_PARAMS *params,
+    int priv)
+{
+    size_t k = params->k, l = params->l;
+    ML_DSA_EXPANDED_KEY *ek;
+    POLY *p;
+
+    if ((ek = OPENSSL_zalloc(sizeof(*ek))) == NULL)
+        return NULL;
+    ek->num_polys = k * l + k + (priv ? l + 2 * k : 0);
+    if (priv)
+        p = OPENSSL_secure_malloc_array(ek->num_polys, sizeof(POLY));
+    else
+        p = OPENSSL_malloc_array(ek->num_polys, sizeof(POLY));
+    if (p == NULL) {
+        OPENSSL_free(ek);
+        return NULL;
+    }
+    matrix_init(&ek->a_ntt, p, k, l);
+    p += k * l;
+    vector_init(&ek->t1_ntt, p, k);
+    p += k;
+    if (priv) {
+        vector_init(&ek->s1_ntt, p, l);
+        vector_init(&ek->s2_ntt, p + l, k);
+        vector_init(&ek->t0_ntt, p + l + k, k);
+    }
+    return ek;
+}
+
 /**
  * @brief Factory reset an ML_DSA_KEY object
  */
 void ossl_ml_dsa_key_reset(ML_DSA_KEY *key)
 {
+    ossl_ml_dsa_expanded_key_free(key->expanded);
+    key->expanded = NULL;
     /*
      * The allocation for |s1.poly| subsumes those for |s2| and |t0|, which we
      * must not access after |s1|'s poly is freed.
@@ -253,6 +301,17 @@ ML_DSA_KEY *ossl_ml_dsa_key_dup(const ML_DSA_KEY *src, int selection)
         EVP_MD_up_ref(src->shake256_md);
         ret->shake128_md = src->shake128_md;
         ret->shake256_md = src->shake256_md;
+        if (src->expanded != NULL && ret->t1.poly != NULL) {
+            const ML_DSA_EXPANDED_KEY *sek = src->expanded;
+            ML_DSA_EXPANDED_KEY *ek;
+            int priv = ret->s1.poly != NULL && sek->s1_ntt.poly != NULL;
+
+            if ((ek = expanded_key_alloc(ret->params, priv)) == NULL)
+                goto err;
+            ret->expanded = ek;
+            memcpy(ek->a_ntt.m_poly, sek->a_ntt.m_poly,
+                ek->num_polys * sizeof(POLY));
+        }
     }
     return ret;
 err:
@@ -395,6 +454,73 @@ int ossl_ml_dsa_key_public_from_private(ML_DSA_KEY *key)
     return ret;
 }
 
+/*
+ * Computes the expanded form of |key|, including the private vectors if |priv|
+ * is set (in which case |key| must be a private key).
+ */
+ML_DSA_EXPANDED_KEY *ossl_ml_dsa_expanded_key_new(const ML_DSA_KEY *key,
+    int priv)
+{
+    const OSSL_ML_DSA_SAMPLE_OPS *sample_ops = ossl_ml_dsa_sample_ops();
+    ML_DSA_EXPANDED_KEY *ek;
+    EVP_MD_CTX *md_ctx = NULL;
+
+    if (key->t1.poly == NULL || (priv && key->s1.poly == NULL)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_MISSING_KEY);
+        return NULL;
+    }
+
+    if ((ek = expanded_key_alloc(key->params, priv)) == NULL)
+        return NULL;
+    if ((md_ctx = EVP_MD_CTX_new()) == NULL
+        || !sample_ops->matrix_expand_A(md_ctx, key->shake128_md, key->rho,
+            &ek->a_ntt)) {
+        EVP_MD_CTX_free(md_ctx);
+        ossl_ml_dsa_expanded_key_free(ek);
+        return NULL;
+    }
+    EVP_MD_CTX_free(md_ctx);
+
+    vector_scale_power2_round_ntt(&key->t1, &ek->t1_ntt);
+    if (priv) {
+        vector_copy(&ek->s1_ntt, &key->s1);
+        vector_ntt(&ek->s1_ntt);
+        vector_copy(&ek->s2_ntt, &key->s2);
+        vector_ntt(&ek->s2_ntt);
+        vector_copy(&ek->t0_ntt, &key->t0);
+        vector_ntt(&ek->t0_ntt);
+    }
+    return ek;
+}
+
+/*
+ * Builds the expanded form of |key| that is used by ossl_ml_dsa_sign() and
+ * ossl_ml_dsa_verify() instead of expanding A from rho and converting the key
+ * vectors to NTT form on every call.  This costs about (k * l + k) KB of
+ * memory for a public key, plus (l + 2 * k) KB of secure memory for a private
+ * key.
+ *
+ * Other threads may be using the key as soon as the expanded form exists, so
+ * it is kept until the key is freed: asking for it again does nothing, and
+ * dropping it fails.
+ */
+int ossl_ml_dsa_key_precompute(ML_DSA_KEY *key, int enable)
+{
+    if (key->expanded != NULL) {
+        if (enable)
+            return 1;
+        ERR_raise_data(ERR_LIB_PROV, PROV_R_NOT_SUPPORTED,
+            "the expanded key cannot be released once built");
+        return 0;
+    }
+    if (enable
+        && (key->expanded = ossl_ml_dsa_expanded_key_new(key,
+                key->s1.poly != NULL))
+            == NULL)
+        return 0;
+    return 1;
+}
+
 int ossl_ml_dsa_key_pairwise_check(const ML_DSA_KEY *key)
 {
     int ret = 0;
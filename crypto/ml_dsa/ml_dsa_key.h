@@ -13,6 +13,21 @@
 #include <openssl/e_os2.h>
 #include "ml_dsa_local.h"
 #include "ml_dsa_vector.h"
+#include "ml_dsa_matrix.h"
+
+/*
+ * An optional expanded form of a key, see ossl_ml_dsa_key_precompute().  All
+ * polynomials are in NTT form.  The s1, s2 and t0 vectors are only present
+ * (and the storage is only allocated from the secure heap) for private keys.
+ */
+typedef struct ml_dsa_expanded_key_st {
+    MATRIX a_ntt; /* The matrix A expanded from rho */
+    VECTOR t1_ntt; /* NTT(t1 * 2^d) */
+    VECTOR s1_ntt;
+    VECTOR s2_ntt;
+    VECTOR t0_ntt;
+    size_t num_polys; /* The size of the block at a_ntt.m_poly */
+} ML_DSA_EXPANDED_KEY;
 
 /* NOTE - any changes to this struct may require updates to ossl_ml_dsa_dup() */
 struct ml_dsa_key_st {
@@ -56,6 +71,12 @@ struct ml_dsa_key_st {
     VECTOR s2; /* private secret of size K with short coefficients (-4..4) or (-2..2) */
     VECTOR s1; /* private secret of size L with short coefficients (-4..4) or (-2..2) */
     /* The s1->poly block is allocated and has space for s2 and t0 also */
+
+    ML_DSA_EXPANDED_KEY *expanded; /* Optional, NULL unless precomputed */
 };
 
+ML_DSA_EXPANDED_KEY *ossl_ml_dsa_expanded_key_new(const ML_DSA_KEY *key,
+    int priv);
+void ossl_ml_dsa_expanded_key_free(ML_DSA_EXPANDED_KEY *ek);
+
 #endif /* !defined(OSSL_LIBCRYPTO_ML_DSA_ML_DSA_KEY_H) */
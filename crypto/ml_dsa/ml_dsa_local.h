@@ -67,10 +67,26 @@ typedef void(ML_DSA_VECTOR_EXPAND_MASK_FN)(VECTOR *out,
     const uint8_t rho_prime[ML_DSA_RHO_PRIME_BYTES], uint32_t kappa, uint32_t gamma1,
     EVP_MD_CTX *h_ctx, const EVP_MD *md);
 
+/*
+ * The batch functions below process up to ML_DSA_BATCH_LANES independent
+ * inputs of the same length at once.
+ */
+#define ML_DSA_BATCH_LANES 4
+
+typedef int(ML_DSA_SAMPLE_IN_BALL_BATCH_FN)(POLY *out[], size_t n,
+    const uint8_t *const seeds[], int seed_len, uint32_t tau,
+    EVP_MD_CTX *h_ctx, const EVP_MD *md);
+typedef int(ML_DSA_SHAKE256_BATCH_FN)(uint8_t *out[], size_t out_len, size_t n,
+    const uint8_t *const in1[], size_t in1_len,
+    const uint8_t *const in2[], size_t in2_len,
+    EVP_MD_CTX *h_ctx, const EVP_MD *md);
+
 typedef struct ossl_ml_dsa_sample_ops_st {
     ML_DSA_MATRIX_EXPAND_A_FN *matrix_expand_A;
     ML_DSA_VECTOR_EXPAND_S_FN *vector_expand_S;
     ML_DSA_VECTOR_EXPAND_MASK_FN *vector_expand_mask;
+    ML_DSA_SAMPLE_IN_BALL_BATCH_FN *sample_in_ball_batch;
+    ML_DSA_SHAKE256_BATCH_FN *shake256_batch;
 } OSSL_ML_DSA_SAMPLE_OPS;
 
 const OSSL_ML_DSA_SAMPLE_OPS *ossl_ml_dsa_sample_ops(void);
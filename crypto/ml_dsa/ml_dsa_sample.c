@@ -38,6 +38,8 @@ static COEFF_FROM_NIBBLE_FUNC coeff_from_nibble_2;
 
 static ML_DSA_MATRIX_EXPAND_A_FN matrix_expand_A_scalar;
 static ML_DSA_VECTOR_EXPAND_S_FN vector_expand_S_scalar;
+static ML_DSA_SAMPLE_IN_BALL_BATCH_FN sample_in_ball_batch_scalar;
+static ML_DSA_SHAKE256_BATCH_FN shake256_batch_scalar;
 static ML_DSA_VECTOR_EXPAND_MASK_FN vector_expand_mask_scalar;
 
 /**
@@ -412,10 +414,39 @@ static void vector_expand_mask_scalar(VECTOR *out,
     OPENSSL_cleanse(derived_seed, sizeof(derived_seed));
 }
 
+static int sample_in_ball_batch_scalar(POLY *out[], size_t n,
+    const uint8_t *const seeds[], int seed_len, uint32_t tau,
+    EVP_MD_CTX *h_ctx, const EVP_MD *md)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if (!ossl_ml_dsa_poly_sample_in_ball(out[i], seeds[i], seed_len,
+                h_ctx, md, tau))
+            return 0;
+    return 1;
+}
+
+static int shake256_batch_scalar(uint8_t *out[], size_t out_len, size_t n,
+    const uint8_t *const in1[], size_t in1_len,
+    const uint8_t *const in2[], size_t in2_len,
+    EVP_MD_CTX *h_ctx, const EVP_MD *md)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if (!shake_xof_2(h_ctx, md, in1[i], in1_len, in2[i], in2_len,
+                out[i], out_len))
+            return 0;
+    return 1;
+}
+
 static const OSSL_ML_DSA_SAMPLE_OPS ml_dsa_sample_generic_meth = {
     matrix_expand_A_scalar,
     vector_expand_S_scalar,
-    vector_expand_mask_scalar
+    vector_expand_mask_scalar,
+    sample_in_ball_batch_scalar,
+    shake256_batch_scalar
 };
 
 #if defined(KECCAK1600_ASM)                                                               \
@@ -172,14 +172,17 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
     uint8_t *alloc = NULL, *w1_encoded = NULL;
     void *alloc_freeptr = NULL;
     size_t alloc_len, w1_encoded_len;
+    const ML_DSA_EXPANDED_KEY *ek = priv->expanded;
     size_t num_polys_sig_k = 2 * k;
-    size_t num_polys_k = 5 * k;
-    size_t num_polys_l = 3 * l;
-    size_t num_polys_k_by_l = k * l;
+    size_t num_polys_k = 3 * k;
+    size_t num_polys_l = 2 * l;
+    size_t num_polys_key;
     size_t poly_count;
     POLY *p, *c_ntt;
-    VECTOR s1_ntt, s2_ntt, t0_ntt, w, w1, cs1, cs2, y;
-    MATRIX a_ntt;
+    VECTOR s1_buf, s2_buf, t0_buf, w, w1, cs1, cs2, y;
+    const VECTOR *s1_ntt = &s1_buf, *s2_ntt = &s2_buf, *t0_ntt = &t0_buf;
+    MATRIX a_buf;
+    const MATRIX *a_ntt = &a_buf;
     ML_DSA_SIG sig;
     uint8_t rho_prime[ML_DSA_RHO_PRIME_BYTES];
     uint8_t c_tilde[ML_DSA_MAX_LAMBDA / 4];
@@ -190,6 +193,10 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
         ERR_raise(ERR_LIB_PROV, PROV_R_BAD_LENGTH);
         return 0;
     }
+    /* Only use an expanded key that includes the private vectors */
+    if (ek != NULL && ek->s1_ntt.poly == NULL)
+        ek = NULL;
+    num_polys_key = ek != NULL ? 0 : k * l + l + 2 * k;
 
     /* Allocate w1_encoded buffer */
     w1_encoded_len = k * (gamma2 == ML_DSA_GAMMA2_Q_MINUS1_DIV88 ? 192 : 128);
@@ -198,7 +205,7 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
         return 0;
 
     /* Allocate aligned POLY array */
-    poly_count = 1 + num_polys_k + num_polys_l + num_polys_k_by_l + num_polys_sig_k;
+    poly_count = 1 + num_polys_k + num_polys_l + num_polys_key + num_polys_sig_k;
     alloc_len = sizeof(*p) * poly_count;
     alloc = OPENSSL_aligned_alloc(alloc_len, 16, &alloc_freeptr);
     if (alloc == NULL)
@@ -211,19 +218,28 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
     /* Init the temp vectors to point to the aligned polys blob */
     p = (POLY *)alloc;
     c_ntt = p++;
-    matrix_init(&a_ntt, p, k, l);
-    p += num_polys_k_by_l;
-    vector_init(&s2_ntt, p, k);
-    vector_init(&t0_ntt, s2_ntt.poly + k, k);
-    vector_init(&w, t0_ntt.poly + k, k);
+    vector_init(&w, p, k);
     vector_init(&w1, w.poly + k, k);
     vector_init(&cs2, w1.poly + k, k);
     p += num_polys_k;
-    vector_init(&s1_ntt, p, l);
-    vector_init(&y, p + l, l);
-    vector_init(&cs1, p + 2 * l, l);
+    vector_init(&y, p, l);
+    vector_init(&cs1, p + l, l);
     p += num_polys_l;
     signature_init(&sig, p, k, p + k, l, c_tilde, c_tilde_len);
+    p += num_polys_sig_k;
+    if (ek == NULL) {
+        /* The key is not expanded, so we need room for its NTT form */
+        matrix_init(&a_buf, p, k, l);
+        p += k * l;
+        vector_init(&s1_buf, p, l);
+        vector_init(&s2_buf, p + l, k);
+        vector_init(&t0_buf, p + l + k, k);
+    } else {
+        a_ntt = &ek->a_ntt;
+        s1_ntt = &ek->s1_ntt;
+        s2_ntt = &ek->s2_ntt;
+        t0_ntt = &ek->t0_ntt;
+    }
     /* End of the allocated blob setup */
 
     /*
@@ -236,8 +252,14 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
     CONSTTIME_SECRET_VECTOR(priv->s1);
     CONSTTIME_SECRET_VECTOR(priv->s2);
     CONSTTIME_SECRET_VECTOR(priv->t0);
+    if (ek != NULL) {
+        CONSTTIME_SECRET_VECTOR(ek->s1_ntt);
+        CONSTTIME_SECRET_VECTOR(ek->s2_ntt);
+        CONSTTIME_SECRET_VECTOR(ek->t0_ntt);
+    }
 
-    if (!sample_ops->matrix_expand_A(md_ctx, priv->shake128_md, priv->rho, &a_ntt))
+    if (ek == NULL
+        && !sample_ops->matrix_expand_A(md_ctx, priv->shake128_md, priv->rho, &a_buf))
         goto err;
 
     /*
@@ -251,12 +273,14 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
             rho_prime, sizeof(rho_prime)))
         goto err;
 
-    vector_copy(&s1_ntt, &priv->s1);
-    vector_ntt(&s1_ntt);
-    vector_copy(&s2_ntt, &priv->s2);
-    vector_ntt(&s2_ntt);
-    vector_copy(&t0_ntt, &priv->t0);
-    vector_ntt(&t0_ntt);
+    if (ek == NULL) {
+        vector_copy(&s1_buf, &priv->s1);
+        vector_ntt(&s1_buf);
+        vector_copy(&s2_buf, &priv->s2);
+        vector_ntt(&s2_buf);
+        vector_copy(&t0_buf, &priv->t0);
+        vector_ntt(&t0_buf);
+    }
 
     /*
      * kappa must not exceed 2^16. But the probability of it
@@ -273,7 +297,7 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
         vector_copy(y_ntt, &y);
         vector_ntt(y_ntt);
 
-        matrix_mult_vector(&a_ntt, y_ntt, &w);
+        matrix_mult_vector(a_ntt, y_ntt, &w);
         vector_ntt_inverse(&w);
 
         vector_high_bits(&w, gamma2, &w1);
@@ -287,9 +311,9 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
                 md_ctx, priv->shake256_md, params->tau))
             break;
 
-        vector_mult_scalar(&s1_ntt, c_ntt, &cs1);
+        vector_mult_scalar(s1_ntt, c_ntt, &cs1);
         vector_ntt_inverse(&cs1);
-        vector_mult_scalar(&s2_ntt, c_ntt, &cs2);
+        vector_mult_scalar(s2_ntt, c_ntt, &cs2);
         vector_ntt_inverse(&cs2);
 
         vector_add(&y, &cs1, &sig.z);
@@ -313,7 +337,7 @@ static int ml_dsa_sign_internal(const ML_DSA_KEY *priv,
                 | constant_time_ge(r0_max, gamma2 - params->beta)))
             continue;
 
-        vector_mult_scalar(&t0_ntt, c_ntt, ct0);
+        vector_mult_scalar(t0_ntt, c_ntt, ct0);
         vector_ntt_inverse(ct0);
         vector_make_hint(ct0, &cs2, &w, gamma2, &sig.hint);
 
@@ -371,6 +395,11 @@ err:
     CONSTTIME_DECLASSIFY_VECTOR(priv->s1);
     CONSTTIME_DECLASSIFY_VECTOR(priv->s2);
     CONSTTIME_DECLASSIFY_VECTOR(priv->t0);
+    if (ek != NULL) {
+        CONSTTIME_DECLASSIFY_VECTOR(ek->s1_ntt);
+        CONSTTIME_DECLASSIFY_VECTOR(ek->s2_ntt);
+        CONSTTIME_DECLASSIFY_VECTOR(ek->t0_ntt);
+    }
     return ret;
 }
 
@@ -396,7 +425,9 @@ static int ml_dsa_verify_internal(const ML_DSA_KEY *pub,
     uint8_t *alloc = NULL, *w1_encoded = NULL;
     void *alloc_freeptr = NULL;
     POLY *p, *c_ntt;
-    MATRIX a_ntt;
+    const ML_DSA_EXPANDED_KEY *ek = pub->expanded;
+    MATRIX a_buf;
+    const MATRIX *a_ntt = &a_buf;
     VECTOR az_ntt, ct1_ntt, *z_ntt, *w1, *w_approx;
     ML_DSA_SIG sig;
     const ML_DSA_PARAMS *params = pub->params;
@@ -407,7 +438,7 @@ static int ml_dsa_verify_internal(const ML_DSA_KEY *pub,
     size_t num_polys_sig = k + l;
     size_t num_polys_k = 2 * k;
     size_t num_polys_l = 1 * l;
-    size_t num_polys_k_by_l = k * l;
+    size_t num_polys_k_by_l = ek != NULL ? 0 : k * l;
     size_t poly_count;
     size_t alloc_len;
     uint8_t c_tilde[ML_DSA_MAX_LAMBDA / 4];
@@ -442,7 +473,10 @@ static int ml_dsa_verify_internal(const ML_DSA_KEY *pub,
     /* Init the temp vectors to point to the aligned polys blob */
     p = (POLY *)alloc;
     c_ntt = p++;
-    matrix_init(&a_ntt, p, k, l);
+    if (ek != NULL)
+        a_ntt = &ek->a_ntt;
+    else
+        matrix_init(&a_buf, p, k, l);
     p += num_polys_k_by_l;
     signature_init(&sig, p, k, p + k, l, c_tilde_sig, c_tilde_len);
     p += num_polys_sig;
@@ -450,7 +484,9 @@ static int ml_dsa_verify_internal(const ML_DSA_KEY *pub,
     vector_init(&ct1_ntt, p + k, k);
 
     if (!ossl_ml_dsa_sig_decode(&sig, sig_enc, sig_enc_len, pub->params)
-        || !sample_ops->matrix_expand_A(md_ctx, pub->shake128_md, pub->rho, &a_ntt))
+        || (ek == NULL
+            && !sample_ops->matrix_expand_A(md_ctx, pub->shake128_md,
+                pub->rho, &a_buf)))
         goto err;
 
     /* Compute verifiers challenge c_ntt = NTT(SampleInBall(c_tilde)) */
@@ -459,8 +495,12 @@ static int ml_dsa_verify_internal(const ML_DSA_KEY *pub,
         goto err;
 
     /* ct1_ntt = NTT(c) * NTT(t1 * 2^d) */
-    vector_scale_power2_round_ntt(&pub->t1, &ct1_ntt);
-    vector_mult_scalar(&ct1_ntt, c_ntt, &ct1_ntt);
+    if (ek != NULL) {
+        vector_mult_scalar(&ek->t1_ntt, c_ntt, &ct1_ntt);
+    } else {
+        vector_scale_power2_round_ntt(&pub->t1, &ct1_ntt);
+        vector_mult_scalar(&ct1_ntt, c_ntt, &ct1_ntt);
+    }
 
     /* compute z_max early in order to reuse sig.z */
     z_max = vector_max(&sig.z);
@@ -468,7 +508,7 @@ static int ml_dsa_verify_internal(const ML_DSA_KEY *pub,
     /* w_approx = NTT_inverse(A * NTT(z) - ct1_ntt) */
     z_ntt = &sig.z;
     vector_ntt(z_ntt);
-    matrix_mult_vector(&a_ntt, z_ntt, &az_ntt);
+    matrix_mult_vector(a_ntt, z_ntt, &az_ntt);
     w_approx = &az_ntt;
     vector_sub(&az_ntt, &ct1_ntt, w_approx);
     vector_ntt_inverse(w_approx);
@@ -581,3 +621,169 @@ err:
     EVP_MD_CTX_free(md_ctx);
     return ret;
 }
+
+/* Per signature state for ossl_ml_dsa_verify_batch() */
+typedef struct {
+    size_t idx; /* The index of the signature in the batch */
+    ML_DSA_SIG sig;
+    POLY *c_ntt;
+    VECTOR az_ntt, ct1_ntt;
+    uint32_t z_max;
+    uint8_t c_tilde_sig[ML_DSA_MAX_LAMBDA / 4];
+    uint8_t c_tilde[ML_DSA_MAX_LAMBDA / 4];
+    uint8_t mu[ML_DSA_MU_BYTES];
+} ML_DSA_VERIFY_LANE;
+
+/**
+ * @brief Verifies |n| signatures made with the same key, as if by calling
+ * ossl_ml_dsa_verify() for each of them.  |results[i]| is set to 1 if
+ * |sigs[i]| is a valid signature of |msgs[i]|, or to 0 if it is not.
+ *
+ * The signatures are processed ML_DSA_BATCH_LANES at a time, so that the
+ * challenge sampling and hashing use the multi-buffer SHAKE256 kernels where
+ * they are available.  If |pub| has no expanded form, the matrix A and
+ * NTT(t1 * 2^d) are computed once for the whole batch.
+ *
+ * @returns 1 if the results were computed, or 0 on error.
+ */
+int ossl_ml_dsa_verify_batch(const ML_DSA_KEY *pub, int msg_is_mu,
+    const uint8_t *const msgs[], const size_t msg_lens[],
+    const uint8_t *context, size_t context_len, int encode,
+    const uint8_t *const sigs[], const size_t sig_lens[],
+    int results[], size_t n)
+{
+    int ret = 0;
+    const OSSL_ML_DSA_SAMPLE_OPS *sample_ops = ossl_ml_dsa_sample_ops();
+    const ML_DSA_PARAMS *params = pub->params;
+    const ML_DSA_EXPANDED_KEY *ek = pub->expanded;
+    ML_DSA_EXPANDED_KEY *tmp_ek = NULL;
+    uint32_t k = (uint32_t)params->k, l = (uint32_t)params->l;
+    uint32_t gamma2 = params->gamma2;
+    size_t c_tilde_len = params->bit_strength >> 2;
+    size_t w1_encoded_len, alloc_len, i, j, m;
+    EVP_MD_CTX *mu_tmpl = NULL, *md_ctx = NULL;
+    uint8_t *alloc = NULL, *w1_encoded = NULL;
+    void *alloc_freeptr = NULL;
+    ML_DSA_VERIFY_LANE lanes[ML_DSA_BATCH_LANES];
+    POLY *p, *c_ntt[ML_DSA_BATCH_LANES];
+    const uint8_t *seeds[ML_DSA_BATCH_LANES], *mus[ML_DSA_BATCH_LANES];
+    const uint8_t *w1s[ML_DSA_BATCH_LANES];
+    uint8_t *c_tildes[ML_DSA_BATCH_LANES];
+
+    if (ossl_ml_dsa_key_get_pub(pub) == NULL)
+        return 0;
+
+    if (ek == NULL) {
+        if ((tmp_ek = ossl_ml_dsa_expanded_key_new(pub, 0)) == NULL)
+            return 0;
+        ek = tmp_ek;
+    }
+
+    /* Allocate the w1_encoded buffers and the aligned POLY array */
+    w1_encoded_len = k * (gamma2 == ML_DSA_GAMMA2_Q_MINUS1_DIV88 ? 192 : 128);
+    w1_encoded = OPENSSL_malloc_array(ML_DSA_BATCH_LANES, w1_encoded_len);
+    alloc_len = sizeof(*p) * ML_DSA_BATCH_LANES * (1 + 3 * k + l);
+    alloc = OPENSSL_aligned_alloc(alloc_len, 16, &alloc_freeptr);
+    md_ctx = EVP_MD_CTX_new();
+    if (w1_encoded == NULL || alloc == NULL || md_ctx == NULL)
+        goto err;
+    if (!msg_is_mu
+        && (mu_tmpl = ossl_ml_dsa_mu_init(pub, encode, context, context_len)) == NULL)
+        goto err;
+
+    p = (POLY *)alloc;
+    for (j = 0; j < ML_DSA_BATCH_LANES; j++) {
+        ML_DSA_VERIFY_LANE *lane = &lanes[j];
+
+        lane->c_ntt = c_ntt[j] = p++;
+        signature_init(&lane->sig, p, k, p + k, l, lane->c_tilde_sig,
+            c_tilde_len);
+        p += k + l;
+        vector_init(&lane->az_ntt, p, k);
+        vector_init(&lane->ct1_ntt, p + k, k);
+        p += 2 * k;
+        seeds[j] = lane->c_tilde_sig;
+        mus[j] = lane->mu;
+        w1s[j] = w1_encoded + j * w1_encoded_len;
+        c_tildes[j] = lane->c_tilde;
+    }
+
+    for (i = 0; i < n;) {
+        /* Fill the lanes with the next signatures that can be decoded */
+        for (m = 0; i < n && m < ML_DSA_BATCH_LANES; i++) {
+            ML_DSA_VERIFY_LANE *lane = &lanes[m];
+
+            results[i] = 0;
+            if (sig_lens[i] != params->sig_len
+                || !ossl_ml_dsa_sig_decode(&lane->sig, sigs[i], sig_lens[i],
+                    params))
+                continue;
+            if (msg_is_mu) {
+                if (msg_lens[i] != ML_DSA_MU_BYTES)
+                    continue;
+                memcpy(lane->mu, msgs[i], ML_DSA_MU_BYTES);
+            } else {
+                /* The template has already absorbed tr and the context */
+                if (!EVP_MD_CTX_copy_ex(md_ctx, mu_tmpl)
+                    || !ossl_ml_dsa_mu_update(md_ctx, msgs[i], msg_lens[i])
+                    || !ossl_ml_dsa_mu_finalize(md_ctx, lane->mu,
+                        sizeof(lane->mu)))
+                    goto err;
+            }
+            lane->idx = i;
+            m++;
+        }
+        if (m == 0)
+            continue;
+
+        /* Compute the verifiers challenges c = SampleInBall(c_tilde) */
+        if (!sample_ops->sample_in_ball_batch(c_ntt, m, seeds, (int)c_tilde_len,
+                params->tau, md_ctx, pub->shake256_md))
+            goto err;
+
+        for (j = 0; j < m; j++) {
+            ML_DSA_VERIFY_LANE *lane = &lanes[j];
+            VECTOR *z_ntt = &lane->sig.z, *w_approx = &lane->az_ntt;
+
+            poly_ntt(lane->c_ntt);
+
+            /* ct1_ntt = NTT(c) * NTT(t1 * 2^d) */
+            vector_mult_scalar(&ek->t1_ntt, lane->c_ntt, &lane->ct1_ntt);
+
+            /* compute z_max early in order to reuse sig.z */
+            lane->z_max = vector_max(&lane->sig.z);
+
+            /* w_approx = NTT_inverse(A * NTT(z) - ct1_ntt) */
+            vector_ntt(z_ntt);
+            matrix_mult_vector(&ek->a_ntt, z_ntt, &lane->az_ntt);
+            vector_sub(&lane->az_ntt, &lane->ct1_ntt, w_approx);
+            vector_ntt_inverse(w_approx);
+
+            /* compute w1_encoded */
+            vector_use_hint(&lane->sig.hint, w_approx, gamma2, w_approx);
+            ossl_ml_dsa_w1_encode(w_approx, gamma2,
+                w1_encoded + j * w1_encoded_len, w1_encoded_len);
+        }
+
+        if (!sample_ops->shake256_batch(c_tildes, c_tilde_len, m,
+                mus, ML_DSA_MU_BYTES, w1s, w1_encoded_len,
+                md_ctx, pub->shake256_md))
+            goto err;
+
+        for (j = 0; j < m; j++) {
+            const ML_DSA_VERIFY_LANE *lane = &lanes[j];
+
+            results[lane->idx] =
+                (lane->z_max < (uint32_t)(params->gamma1 - params->beta))
+                && memcmp(lane->c_tilde, lane->c_tilde_sig, c_tilde_len) == 0;
+        }
+    }
+    ret = 1;
+err:
+    OPENSSL_free(alloc_freeptr);
+    OPENSSL_free(w1_encoded);
+    EVP_MD_CTX_free(md_ctx);
+    EVP_MD_CTX_free(mu_tmpl);
+    ossl_ml_dsa_expanded_key_free(tmp_ek);
+    return ret;
+}
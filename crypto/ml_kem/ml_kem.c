@@ -13,7 +13,9 @@
 #include "crypto/ml_kem.h"
 #include "internal/common.h"
 #include "internal/constant_time.h"
+#include "internal/cryptlib.h"
 #include "internal/sha3.h"
+#include "internal/target_region.h"
 
 #if ML_KEM_SEED_BYTES != ML_KEM_SHARED_SECRET_BYTES + ML_KEM_RANDOM_BYTES
 #error "ML-KEM keygen seed length != shared secret + random bytes length"
@@ -58,6 +60,18 @@
 #define SCALAR_SAMPLING_BUFSIZE 168
 #endif
 
+/*
+ * Matrix expansion can use the 4-way AVX-512VL SHAKE128 implementation when
+ * it is available, the lanes are sampled one SHAKE128 block at a time.
+ */
+#if defined(KECCAK1600_ASM) && defined(SHAKE128_BLOCKSIZE)                   \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64)       \
+        || defined(_M_X64))                                                 \
+    && !defined(OPENSSL_NO_ASM)
+#define ML_KEM_SHAKE_X4
+#define ML_KEM_SHAKE_X4_LANES 4
+#endif
+
 /*
  * Structure of keys
  */
@@ -93,9 +107,70 @@ DECLARE_ML_KEM_VARIANT_KEYDATA(1024);
 #undef DECLARE_ML_KEM_PUBKEYDATA
 #undef DECLARE_ML_KEM_PRVKEYDATA
 
-typedef __owur int (*CBD_FUNC)(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key);
+typedef __owur int (*CBD_FUNC)(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1]);
+
+#if defined(_ARCH_PPC64)
+#include "arch/ppc_arch.h"
+#endif
+
+#if defined(OPENSSL_CPUID_OBJ) && !defined(OPENSSL_NO_ASM)             \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) \
+        || defined(_M_X64))                                           \
+    && !defined(_M_ARM64EC) && defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define MLKEM_AVX2
+#endif
+
+#if (defined(MLKEM_NTT_PPC_ASM) && defined(_ARCH_PPC64)) || defined(MLKEM_AVX2)
+typedef void (*ml_kem_scalar_ntt_fn)(scalar *p);
+typedef void (*ml_kem_scalar_inverse_ntt_fn)(scalar *p);
+typedef void (*ml_kem_scalar_mult_fn)(scalar *out, const scalar *lhs,
+    const scalar *rhs);
+typedef void (*ml_kem_scalar_decompress_fn)(scalar *s, int bits);
+typedef void (*ml_kem_scalar_compress_fn)(scalar *s, int bits);
+typedef void (*ml_kem_scalar_encode_fn)(uint8_t *out, const scalar *s,
+    int bits);
+typedef void (*ml_kem_scalar_cbd_fn)(scalar *out, const uint8_t *in);
+typedef uint16_t *(*ml_kem_sample_scalar_block_fn)(uint16_t *curr,
+    const uint16_t *endout, const uint8_t *in, const uint8_t *endin);
+
+static void scalar_ntt_generic(scalar *p);
+static void scalar_inverse_ntt_generic(scalar *p);
+static void scalar_mult_generic(scalar *out, const scalar *lhs,
+    const scalar *rhs);
+static void scalar_mult_add_generic(scalar *out, const scalar *lhs,
+    const scalar *rhs);
+static void scalar_decompress_generic(scalar *s, int bits);
+static void scalar_compress_generic(scalar *s, int bits);
+static void scalar_encode_generic(uint8_t *out, const scalar *s, int bits);
+static void scalar_cbd_2_generic(scalar *out, const uint8_t *in);
+static void scalar_cbd_3_generic(scalar *out, const uint8_t *in);
+static uint16_t *sample_scalar_block_generic(uint16_t *curr,
+    const uint16_t *endout, const uint8_t *in, const uint8_t *endin);
+
+static ml_kem_scalar_ntt_fn scalar_ntt = scalar_ntt_generic;
+static ml_kem_scalar_inverse_ntt_fn scalar_inverse_ntt = scalar_inverse_ntt_generic;
+static ml_kem_scalar_mult_fn scalar_mult = scalar_mult_generic;
+static ml_kem_scalar_mult_fn scalar_mult_add = scalar_mult_add_generic;
+static ml_kem_scalar_decompress_fn scalar_decompress = scalar_decompress_generic;
+static ml_kem_scalar_compress_fn scalar_compress = scalar_compress_generic;
+static ml_kem_scalar_encode_fn scalar_encode = scalar_encode_generic;
+static ml_kem_scalar_cbd_fn scalar_cbd_2 = scalar_cbd_2_generic;
+static ml_kem_scalar_cbd_fn scalar_cbd_3 = scalar_cbd_3_generic;
+static ml_kem_sample_scalar_block_fn sample_scalar_block
+    = sample_scalar_block_generic;
+#else
+#define scalar_ntt_generic scalar_ntt
+#define scalar_inverse_ntt_generic scalar_inverse_ntt
+#define scalar_mult_generic scalar_mult
+#define scalar_mult_add_generic scalar_mult_add
+#define scalar_decompress_generic scalar_decompress
+#define scalar_compress_generic scalar_compress
+#define scalar_encode_generic scalar_encode
+#define scalar_cbd_2_generic scalar_cbd_2
+#define scalar_cbd_3_generic scalar_cbd_3
+#define sample_scalar_block_generic sample_scalar_block
 static void scalar_encode(uint8_t *out, const scalar *s, int bits);
+#endif
 
 /*
  * The wire-form of a losslessly encoded vector uses 12-bits per element.
@@ -296,12 +371,19 @@ static __owur int single_keccak(uint8_t *out, size_t outlen, const uint8_t *in,
 /*
  * FIPS 203, Section 4.1, equation (4.3): PRF. Takes 32+1 input bytes, and uses
  * SHAKE256 to produce the input to SamplePolyCBD_eta: FIPS 203, algorithm 8.
+ * This is called 2k+1 times per encapsulation, so the Keccak core is used
+ * directly, avoiding the EVP digest dispatch overhead.
  */
-static __owur int prf(uint8_t *out, size_t len, const uint8_t in[ML_KEM_RANDOM_BYTES + 1],
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+static __owur int prf(uint8_t *out, size_t len, const uint8_t in[ML_KEM_RANDOM_BYTES + 1])
 {
-    return EVP_DigestInit_ex(mdctx, key->shake256_md, NULL)
-        && single_keccak(out, len, in, ML_KEM_RANDOM_BYTES + 1, mdctx);
+    KECCAK1600_CTX ctx;
+    int ret;
+
+    ret = ossl_shake_init(&ctx, 256)
+        && ossl_sha3_absorb(&ctx, in, ML_KEM_RANDOM_BYTES + 1)
+        && ossl_sha3_squeeze(&ctx, out, len);
+    OPENSSL_cleanse(&ctx, sizeof(ctx));
+    return ret;
 }
 
 /*
@@ -370,60 +452,60 @@ static __owur int kdf(uint8_t out[ML_KEM_SHARED_SECRET_BYTES],
         && EVP_DigestFinalXOF(mdctx, out, ML_KEM_SHARED_SECRET_BYTES);
 }
 
+/*
+ * FIPS 203, Section 4.2.2, Algorithm 7: "SampleNTT" (steps 6-16). Consumes
+ * the bytes in [|in|, |endin|) (a multiple of 3), appending the accepted
+ * coefficients to |curr| until |endout| is reached, and returns the updated
+ * |curr|.  This is used for matrix expansion and only operates on public
+ * inputs.
+ */
+static uint16_t *sample_scalar_block_generic(uint16_t *curr,
+    const uint16_t *endout, const uint8_t *in, const uint8_t *endin)
+{
+    uint16_t d;
+    uint8_t b1, b2, b3;
+
+    do {
+        b1 = *in++;
+        b2 = *in++;
+        b3 = *in++;
+
+        if (curr >= endout)
+            break;
+        if ((d = ((b2 & 0x0f) << 8) + b1) < kPrime)
+            *curr++ = d;
+        if (curr >= endout)
+            break;
+        if ((d = (b3 << 4) + (b2 >> 4)) < kPrime)
+            *curr++ = d;
+    } while (in < endin);
+    return curr;
+}
+
 /*
  * FIPS 203, Section 4.2.2, Algorithm 7: "SampleNTT" (steps 3-17, steps 1, 2
  * are performed by the caller). Rejection-samples a Keccak stream to get
- * uniformly distributed elements in the range [0,q). This is used for matrix
- * expansion and only operates on public inputs.
+ * uniformly distributed elements in the range [0,q).
  */
-static __owur int sample_scalar(scalar *out, EVP_MD_CTX *mdctx)
+static __owur int sample_scalar(scalar *out, KECCAK1600_CTX *ctx)
 {
     uint16_t *curr = out->c, *endout = curr + DEGREE;
-    uint8_t buf[SCALAR_SAMPLING_BUFSIZE], *in;
-    uint8_t *endin = buf + sizeof(buf);
-    uint16_t d;
-    uint8_t b1, b2, b3;
+    uint8_t buf[SCALAR_SAMPLING_BUFSIZE];
 
     do {
-        if (!EVP_DigestSqueeze(mdctx, in = buf, sizeof(buf)))
+        if (!ossl_sha3_squeeze(ctx, buf, sizeof(buf)))
             return 0;
-        do {
-            b1 = *in++;
-            b2 = *in++;
-            b3 = *in++;
-
-            if (curr >= endout)
-                break;
-            if ((d = ((b2 & 0x0f) << 8) + b1) < kPrime)
-                *curr++ = d;
-            if (curr >= endout)
-                break;
-            if ((d = (b3 << 4) + (b2 >> 4)) < kPrime)
-                *curr++ = d;
-        } while (in < endin);
+        curr = sample_scalar_block(curr, endout, buf, buf + sizeof(buf));
     } while (curr < endout);
     return 1;
 }
 
 static CRYPTO_ONCE ml_kem_ntt_once = CRYPTO_ONCE_STATIC_INIT;
 
-#if defined(_ARCH_PPC64)
-#include "arch/ppc_arch.h"
-#endif
-
 #if defined(MLKEM_NTT_PPC_ASM) && defined(_ARCH_PPC64)
 /*
  * PPC64LE Platform supports.
  */
-typedef void (*ml_kem_scalar_ntt_fn)(scalar *p);
-typedef void (*ml_kem_scalar_inverse_ntt_fn)(scalar *p);
-
-static void scalar_ntt_generic(scalar *p);
-static void scalar_inverse_ntt_generic(scalar *p);
-
-static ml_kem_scalar_ntt_fn scalar_ntt = scalar_ntt_generic;
-static ml_kem_scalar_inverse_ntt_fn scalar_inverse_ntt = scalar_inverse_ntt_generic;
-
 void mlkem_ntt_ppc(uint16_t *c);
 void mlkem_inverse_ntt_ppc(uint16_t *c);
 
@@ -436,14 +518,15 @@ static void scalar_inverse_ntt_ppc(scalar *s)
 {
     mlkem_inverse_ntt_ppc(s->c);
 }
-#else
-#define scalar_ntt_generic scalar_ntt
-#define scalar_inverse_ntt_generic scalar_inverse_ntt
+#endif
+
+#if defined(MLKEM_AVX2)
+#include "ml_kem_avx2.inc"
 #endif
 
 /*
- * Initialize NTT function pointers to PPC64le implementations if available.
- * Scalar implementations are used by default.
+ * Initialize the NTT and related function pointers to PPC64le or x86_64 AVX2
+ * implementations if available.  Scalar implementations are used by default.
  */
 static void ml_kem_ntt_init(void)
 {
@@ -455,6 +538,21 @@ static void ml_kem_ntt_init(void)
     }
 #endif
 #endif
+#if defined(MLKEM_AVX2)
+    if ((OPENSSL_ia32cap_P[2] & (1u << 5)) != 0) {
+        scalar_ntt = scalar_ntt_avx2;
+        scalar_inverse_ntt = scalar_inverse_ntt_avx2;
+        scalar_mult = scalar_mult_avx2;
+        scalar_mult_add = scalar_mult_add_avx2;
+        scalar_decompress = scalar_decompress_avx2;
+        scalar_compress = scalar_compress_avx2;
+        scalar_encode = scalar_encode_avx2;
+        scalar_cbd_2 = scalar_cbd_2_avx2;
+        scalar_cbd_3 = scalar_cbd_3_avx2;
+        sample_scalar_block_avx2_init();
+        sample_scalar_block = sample_scalar_block_avx2;
+    }
+#endif
 }
 
 /*-
@@ -593,7 +691,7 @@ static void scalar_sub(scalar *lhs, const scalar *rhs)
  * two reduced numbers together, so we need some intermediate reduction steps,
  * even if an uint64_t could hold 3 multiplied numbers.
  */
-static void scalar_mult(scalar *out, const scalar *lhs,
+static void scalar_mult_generic(scalar *out, const scalar *lhs,
     const scalar *rhs)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
@@ -611,7 +709,7 @@ static void scalar_mult(scalar *out, const scalar *lhs,
 }
 
 /* Above, but add the result to an existing scalar */
-static ossl_inline void scalar_mult_add(scalar *out, const scalar *lhs,
+static ossl_inline void scalar_mult_add_generic(scalar *out, const scalar *lhs,
     const scalar *rhs)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
@@ -634,7 +732,7 @@ static ossl_inline void scalar_mult_add(scalar *out, const scalar *lhs,
  * FIPS 203, Section 4.2.1, Algorithm 5: "ByteEncode_d", for 2<=d<=12.
  * Here |bits| is |d|.  For efficiency, we handle the d=1 case separately.
  */
-static void scalar_encode(uint8_t *out, const scalar *s, int bits)
+static void scalar_encode_generic(uint8_t *out, const scalar *s, int bits)
 {
     const uint16_t *curr = s->c, *end = curr + DEGREE;
     uint64_t accum = 0, element;
@@ -849,7 +947,7 @@ static __owur uint16_t decompress(uint16_t x, int bits)
  * FIPS 203, Section 4.2.1, Equation (4.7): "Compress_d".
  * In-place lossy rounding of scalars to 2^d bits.
  */
-static void scalar_compress(scalar *s, int bits)
+static void scalar_compress_generic(scalar *s, int bits)
 {
     int i;
 
@@ -861,7 +959,7 @@ static void scalar_compress(scalar *s, int bits)
  * FIPS 203, Section 4.2.1, Equation (4.8): "Decompress_d".
  * In-place approximate recovery of scalars from 2^d bit compression.
  */
-static void scalar_decompress(scalar *s, int bits)
+static void scalar_decompress_generic(scalar *s, int bits)
 {
     int i;
 
@@ -971,6 +1069,59 @@ matrix_mult_transpose_add(scalar *out, const scalar *m, const scalar *a, int ran
     }
 }
 
+#if defined(ML_KEM_SHAKE_X4)
+/*
+ * As matrix_expand() below, but runs four SHAKE128 instances at a time using
+ * the AVX-512VL multi-buffer Keccak.  The matrix has k^2 entries, so for
+ * ML-KEM-768 the last batch is only partially used; its unused lanes hash a
+ * copy of the first lane's input and their output is discarded.
+ */
+static int matrix_expand_x4(ML_KEM_KEY *key)
+{
+    KECCAK1600_X4_AVX512VL_CTX ctx;
+    uint8_t input[ML_KEM_SHAKE_X4_LANES][ML_KEM_RANDOM_BYTES + 2];
+    uint8_t blocks[ML_KEM_SHAKE_X4_LANES][SHAKE128_BLOCKSIZE];
+    uint16_t *curr[ML_KEM_SHAKE_X4_LANES], *endout[ML_KEM_SHAKE_X4_LANES];
+    int rank = key->vinfo->rank;
+    int n = rank * rank;
+    int base, lane, lanes, done;
+
+    for (lane = 0; lane < ML_KEM_SHAKE_X4_LANES; lane++)
+        memcpy(input[lane], key->rho, ML_KEM_RANDOM_BYTES);
+
+    for (base = 0; base < n; base += ML_KEM_SHAKE_X4_LANES) {
+        lanes = n - base < ML_KEM_SHAKE_X4_LANES ? n - base : ML_KEM_SHAKE_X4_LANES;
+        for (lane = 0; lane < ML_KEM_SHAKE_X4_LANES; lane++) {
+            int idx = base + (lane < lanes ? lane : 0);
+
+            input[lane][ML_KEM_RANDOM_BYTES] = idx / rank;
+            input[lane][ML_KEM_RANDOM_BYTES + 1] = idx % rank;
+            curr[lane] = key->m[idx].c;
+            endout[lane] = lane < lanes ? curr[lane] + DEGREE : curr[lane];
+        }
+
+        ossl_sha3_shake128_x4_inc_init_avx512vl(&ctx);
+        ossl_sha3_shake128_x4_inc_absorb_avx512vl(&ctx, input[0], input[1],
+            input[2], input[3], sizeof(input[0]));
+        do {
+            ossl_sha3_shake128_x4_inc_squeeze_avx512vl(blocks[0], blocks[1],
+                blocks[2], blocks[3], SHAKE128_BLOCKSIZE, &ctx);
+            done = 1;
+            for (lane = 0; lane < lanes; lane++) {
+                if (curr[lane] >= endout[lane])
+                    continue;
+                curr[lane] = sample_scalar_block(curr[lane], endout[lane],
+                    blocks[lane], blocks[lane] + SHAKE128_BLOCKSIZE);
+                if (curr[lane] < endout[lane])
+                    done = 0;
+            }
+        } while (!done);
+    }
+    ossl_sha3_shake128_x4_inc_cleanup_avx512vl(&ctx);
+    return 1;
+}
+#endif
+
 /*-
  * Expands the matrix from a seed for key generation and for encaps-CPA.
  * NOTE: FIPS 203 matrix "A" is the transpose of this matrix, computed
@@ -978,21 +1129,27 @@ matrix_mult_transpose_add(scalar *out, const scalar *m, const scalar *a, int ran
  *
  * Where FIPS 203 computes t = A * s + e, we use the transpose of "m".
  */
-static __owur int matrix_expand(EVP_MD_CTX *mdctx, ML_KEM_KEY *key)
+static __owur int matrix_expand(ML_KEM_KEY *key)
 {
     scalar *out = key->m;
     uint8_t input[ML_KEM_RANDOM_BYTES + 2];
+    KECCAK1600_CTX ctx;
     int rank = key->vinfo->rank;
     int i, j;
 
+#if defined(ML_KEM_SHAKE_X4)
+    if (SHA3_avx512vl_capable())
+        return matrix_expand_x4(key);
+#endif
+
     memcpy(input, key->rho, ML_KEM_RANDOM_BYTES);
     for (i = 0; i < rank; i++) {
         for (j = 0; j < rank; j++) {
             input[ML_KEM_RANDOM_BYTES] = i;
             input[ML_KEM_RANDOM_BYTES + 1] = j;
-            if (!EVP_DigestInit_ex(mdctx, key->shake128_md, NULL)
-                || !EVP_DigestUpdate(mdctx, input, sizeof(input))
-                || !sample_scalar(out++, mdctx))
+            if (!ossl_shake_init(&ctx, 128)
+                || !ossl_sha3_absorb(&ctx, input, sizeof(input))
+                || !sample_scalar(out++, &ctx))
                 return 0;
         }
     }
@@ -1000,24 +1157,19 @@ static __owur int matrix_expand(EVP_MD_CTX *mdctx, ML_KEM_KEY *key)
 }
 
 /*
- * Algorithm 7 from the spec, with eta fixed to two and the PRF call
- * included. Creates binominally distributed elements by sampling 2*|eta| bits,
+ * Algorithm 7 from the spec, with eta fixed to two, expanding the PRF output
+ * |r| into |out|; |cbd_2| below makes the PRF call. Creates binominally distributed elements by sampling 2*|eta| bits,
  * and setting the coefficient to the count of the first bits minus the count of
  * the second bits, resulting in a centered binomial distribution. Since eta is
  * two this gives -2/2 with a probability of 1/16, -1/1 with probability 1/4,
  * and 0 with probability 3/8.
  */
-static __owur int cbd_2(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+static void scalar_cbd_2_generic(scalar *out, const uint8_t *r)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
-    uint8_t randbuf[4 * DEGREE / 8], *r = randbuf; /* 64 * eta slots */
     uint16_t value, mask;
     uint8_t b;
 
-    if (!prf(randbuf, sizeof(randbuf), in, mdctx, key))
-        return 0;
-
     do {
         b = *r++;
 
@@ -1038,26 +1190,30 @@ static __owur int cbd_2(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
         mask = constish_time_true(value >> 15);
         *curr++ = value + (kPrime & mask);
     } while (curr < end);
+}
+
+static __owur int cbd_2(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1])
+{
+    uint8_t randbuf[4 * DEGREE / 8]; /* 64 * eta slots */
+
+    if (!prf(randbuf, sizeof(randbuf), in))
+        return 0;
+    scalar_cbd_2(out, randbuf);
     return 1;
 }
 
 /*
- * Algorithm 7 from the spec, with eta fixed to three and the PRF call
- * included. Creates binominally distributed elements by sampling 3*|eta| bits,
+ * Algorithm 7 from the spec, with eta fixed to three, expanding the PRF output
+ * |r| into |out|; |cbd_3| below makes the PRF call. Creates binominally distributed elements by sampling 3*|eta| bits,
  * and setting the coefficient to the count of the first bits minus the count of
  * the second bits, resulting in a centered binomial distribution.
  */
-static __owur int cbd_3(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+static void scalar_cbd_3_generic(scalar *out, const uint8_t *r)
 {
     uint16_t *curr = out->c, *end = curr + DEGREE;
-    uint8_t randbuf[6 * DEGREE / 8], *r = randbuf; /* 64 * eta slots */
     uint8_t b1, b2, b3;
     uint16_t value, mask;
 
-    if (!prf(randbuf, sizeof(randbuf), in, mdctx, key))
-        return 0;
-
     do {
         b1 = *r++;
         b2 = *r++;
@@ -1090,6 +1246,15 @@ static __owur int cbd_3(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
         mask = constish_time_true(value >> 15);
         *curr++ = value + (kPrime & mask);
     } while (curr < end);
+}
+
+static __owur int cbd_3(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1])
+{
+    uint8_t randbuf[6 * DEGREE / 8]; /* 64 * eta slots */
+
+    if (!prf(randbuf, sizeof(randbuf), in))
+        return 0;
+    scalar_cbd_3(out, randbuf);
     return 1;
 }
 
@@ -1098,15 +1263,14 @@ static __owur int cbd_3(scalar *out, uint8_t in[ML_KEM_RANDOM_BYTES + 1],
  * scalar elements and incrementing |counter| for each slot of the vector.
  */
 static __owur int gencbd_vector(scalar *out, CBD_FUNC cbd, uint8_t *counter,
-    const uint8_t seed[ML_KEM_RANDOM_BYTES], int rank,
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+    const uint8_t seed[ML_KEM_RANDOM_BYTES], int rank)
 {
     uint8_t input[ML_KEM_RANDOM_BYTES + 1];
 
     memcpy(input, seed, ML_KEM_RANDOM_BYTES);
     do {
         input[ML_KEM_RANDOM_BYTES] = (*counter)++;
-        if (!cbd(out++, input, mdctx, key))
+        if (!cbd(out++, input))
             return 0;
     } while (--rank > 0);
     return 1;
@@ -1116,15 +1280,14 @@ static __owur int gencbd_vector(scalar *out, CBD_FUNC cbd, uint8_t *counter,
  * As above plus NTT transform.
  */
 static __owur int gencbd_vector_ntt(scalar *out, CBD_FUNC cbd, uint8_t *counter,
-    const uint8_t seed[ML_KEM_RANDOM_BYTES], int rank,
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+    const uint8_t seed[ML_KEM_RANDOM_BYTES], int rank)
 {
     uint8_t input[ML_KEM_RANDOM_BYTES + 1];
 
     memcpy(input, seed, ML_KEM_RANDOM_BYTES);
     do {
         input[ML_KEM_RANDOM_BYTES] = (*counter)++;
-        if (!cbd(out, input, mdctx, key))
+        if (!cbd(out, input))
             return 0;
         scalar_ntt(out++);
     } while (--rank > 0);
@@ -1153,7 +1316,7 @@ static __owur int gencbd_vector_ntt(scalar *out, CBD_FUNC cbd, uint8_t *counter,
 static __owur int encrypt_cpa(uint8_t out[ML_KEM_SHARED_SECRET_BYTES],
     const uint8_t message[DEGREE / 8],
     const uint8_t r[ML_KEM_RANDOM_BYTES], scalar *tmp,
-    EVP_MD_CTX *mdctx, const ML_KEM_KEY *key)
+    const ML_KEM_KEY *key)
 {
     const ML_KEM_VINFO *vinfo = key->vinfo;
     CBD_FUNC cbd_1 = CBD1(vinfo->evp_type);
@@ -1169,7 +1332,7 @@ static __owur int encrypt_cpa(uint8_t out[ML_KEM_SHARED_SECRET_BYTES],
     int dv = vinfo->dv;
 
     /* FIPS 203 "y" vector */
-    if (!gencbd_vector_ntt(y, cbd_1, &counter, r, rank, mdctx, key))
+    if (!gencbd_vector_ntt(y, cbd_1, &counter, r, rank))
         return 0;
     /* FIPS 203 "v" scalar */
     inner_product(&v, key->t, y, rank);
@@ -1178,7 +1341,7 @@ static __owur int encrypt_cpa(uint8_t out[ML_KEM_SHARED_SECRET_BYTES],
     matrix_mult_intt(u, key->m, y, rank);
 
     /* All done with |y|, now free to reuse tmp[0] for FIPS 203 |e1| */
-    if (!gencbd_vector(e1, cbd_2, &counter, r, rank, mdctx, key))
+    if (!gencbd_vector(e1, cbd_2, &counter, r, rank))
         return 0;
     vector_add(u, e1, rank);
     vector_compress(u, du, rank);
@@ -1187,7 +1350,7 @@ static __owur int encrypt_cpa(uint8_t out[ML_KEM_SHARED_SECRET_BYTES],
     /* All done with |e1|, now free to reuse tmp[0] for FIPS 203 |e2| */
     memcpy(input, r, ML_KEM_RANDOM_BYTES);
     input[ML_KEM_RANDOM_BYTES] = counter;
-    if (!cbd_2(e2, input, mdctx, key))
+    if (!cbd_2(e2, input))
         return 0;
     scalar_add(&v, e2);
 
@@ -1283,7 +1446,7 @@ static int parse_pubkey(const uint8_t *in, EVP_MD_CTX *mdctx, ML_KEM_KEY *key)
      * Also pre-compute the matrix expansion, stored with the public key.
      */
     if (!hash_h(key->pkhash, in, vinfo->pubkey_bytes, mdctx, key)
-        || !matrix_expand(mdctx, key)) {
+        || !matrix_expand(key)) {
         ERR_raise_data(ERR_LIB_CRYPTO, ERR_R_INTERNAL_ERROR,
             "internal error while parsing %s public key",
             vinfo->algorithm_name);
@@ -1378,9 +1541,9 @@ static __owur int genkey(const uint8_t seed[ML_KEM_SEED_BYTES],
     CONSTTIME_DECLASSIFY(key->rho, ML_KEM_RANDOM_BYTES);
 
     /* FIPS 203 |e| vector is initial value of key->t */
-    if (!matrix_expand(mdctx, key)
-        || !gencbd_vector_ntt(key->s, cbd_1, &counter, sigma, rank, mdctx, key)
-        || !gencbd_vector_ntt(key->t, cbd_1, &counter, sigma, rank, mdctx, key))
+    if (!matrix_expand(key)
+        || !gencbd_vector_ntt(key->s, cbd_1, &counter, sigma, rank)
+        || !gencbd_vector_ntt(key->t, cbd_1, &counter, sigma, rank))
         goto end;
 
     /* To |e| we now add the product of transpose |m| and |s|, giving |t|. */
@@ -1437,7 +1600,7 @@ static int encap(uint8_t *ctext, uint8_t secret[ML_KEM_SHARED_SECRET_BYTES],
     memcpy(input, entropy, ML_KEM_RANDOM_BYTES);
     memcpy(input + ML_KEM_RANDOM_BYTES, key->pkhash, ML_KEM_PKHASH_BYTES);
     ret = hash_g(Kr, input, sizeof(input), mdctx, key)
-        && encrypt_cpa(ctext, entropy, r, tmp, mdctx, key);
+        && encrypt_cpa(ctext, entropy, r, tmp, key);
     OPENSSL_cleanse((void *)input, sizeof(input));
 
     if (ret)
@@ -1514,7 +1677,7 @@ static int decap(uint8_t secret[ML_KEM_SHARED_SECRET_BYTES],
     }
     decrypt_cpa(m, ctext, tmp, key);
     if (!hash_kr(Kr, m, mdctx, key)
-        || !encrypt_cpa(tmp_ctext, m, r, tmp, mdctx, key)) {
+        || !encrypt_cpa(tmp_ctext, m, r, tmp, key)) {
         ERR_raise_data(ERR_LIB_CRYPTO, ERR_R_INTERNAL_ERROR,
             "internal error while performing %s decapsulation",
             vinfo->algorithm_name);
@@ -331,6 +331,128 @@ int ossl_siv128_decrypt(SIV128_CONTEXT *ctx,
     return 1;
 }
 
+/* Messages whose CMACs are passed to EVP_MAC_batch() in one call */
+#define SIV128_BATCH 32
+
+/*
+ * S2V of up to SIV128_BATCH messages, given the D of each of them after its
+ * associated data.  The last CMAC of all of them is a single batch.
+ */
+static int siv128_do_s2v_p_batch(SIV128_CONTEXT *ctx, SIV_BLOCK *d,
+    SIV_BLOCK *v, const unsigned char *const in[], const size_t len[],
+    size_t n)
+{
+    const unsigned char *t[SIV128_BATCH];
+    unsigned char *out[SIV128_BATCH], *buf, *p;
+    size_t tlen[SIV128_BATCH], total = 0, i, j;
+    int ret;
+
+    for (i = 0; i < n; i++)
+        total += len[i] < SIV_LEN ? SIV_LEN : len[i];
+    if ((buf = OPENSSL_malloc(total > 0 ? total : 1)) == NULL)
+        return 0;
+
+    for (i = 0, p = buf; i < n; i++) {
+        unsigned char *last;
+
+        if (len[i] >= SIV_LEN) {
+            memcpy(p, in[i], len[i]);
+            tlen[i] = len[i];
+            last = p + len[i] - SIV_LEN;
+        } else {
+            memset(p, 0, SIV_LEN);
+            if (len[i] > 0)
+                memcpy(p, in[i], len[i]);
+            p[len[i]] = 0x80;
+            siv128_dbl(&d[i]);
+            tlen[i] = SIV_LEN;
+            last = p;
+        }
+        for (j = 0; j < SIV_LEN; j++)
+            last[j] ^= d[i].byte[j];
+        t[i] = p;
+        out[i] = v[i].byte;
+        p += tlen[i];
+    }
+    ret = EVP_MAC_batch(ctx->mac_ctx_init, t, tlen, out, SIV_LEN, n);
+    OPENSSL_clear_free(buf, total > 0 ? total : 1);
+    return ret;
+}
+
+int ossl_siv128_aad_batch(SIV128_CONTEXT *ctx, SIV_BLOCK *d,
+    const unsigned char *const aad[], const size_t len[], size_t n)
+{
+    SIV_BLOCK mac_out[SIV128_BATCH];
+    unsigned char *out[SIV128_BATCH];
+    size_t i, m;
+
+    for (; n > 0; n -= m, d += m, aad += m, len += m) {
+        m = n < SIV128_BATCH ? n : SIV128_BATCH;
+        for (i = 0; i < m; i++)
+            out[i] = mac_out[i].byte;
+        if (!EVP_MAC_batch(ctx->mac_ctx_init, aad, len, out, SIV_LEN, m))
+            return 0;
+        for (i = 0; i < m; i++) {
+            siv128_dbl(&d[i]);
+            siv128_xorblock(&d[i], &mac_out[i]);
+        }
+    }
+    return 1;
+}
+
+int ossl_siv128_encrypt_batch(SIV128_CONTEXT *ctx, SIV_BLOCK *d,
+    SIV_BLOCK *tag, const unsigned char *const in[],
+    unsigned char *const out[], const size_t len[], size_t n)
+{
+    SIV_BLOCK q;
+    size_t i, m;
+
+    for (; n > 0; n -= m, d += m, tag += m, in += m, out += m, len += m) {
+        m = n < SIV128_BATCH ? n : SIV128_BATCH;
+        if (!siv128_do_s2v_p_batch(ctx, d, tag, in, len, m))
+            return 0;
+        for (i = 0; i < m; i++) {
+            q = tag[i];
+            q.byte[8] &= 0x7f;
+            q.byte[12] &= 0x7f;
+            if (!siv128_do_encrypt(ctx->cipher_ctx, out[i], in[i], len[i], &q))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+int ossl_siv128_decrypt_batch(SIV128_CONTEXT *ctx, SIV_BLOCK *d,
+    const SIV_BLOCK *tag, const unsigned char *const in[],
+    unsigned char *const out[], const size_t len[], size_t n)
+{
+    SIV_BLOCK q, t[SIV128_BATCH];
+    size_t i, m;
+    int ret = 1;
+
+    for (; n > 0; n -= m, d += m, tag += m, in += m, out += m, len += m) {
+        m = n < SIV128_BATCH ? n : SIV128_BATCH;
+        for (i = 0; i < m; i++) {
+            q = tag[i];
+            q.byte[8] &= 0x7f;
+            q.byte[12] &= 0x7f;
+            if (!siv128_do_encrypt(ctx->cipher_ctx, out[i], in[i], len[i], &q))
+                return 0;
+        }
+        if (!siv128_do_s2v_p_batch(ctx, d, t, (const unsigned char *const *)out,
+                len, m))
+            return 0;
+        /* A message that fails to authenticate gets no plaintext */
+        for (i = 0; i < m; i++) {
+            if (CRYPTO_memcmp(t[i].byte, tag[i].byte, SIV_LEN) != 0) {
+                OPENSSL_cleanse(out[i], len[i]);
+                ret = 0;
+            }
+        }
+    }
+    return ret;
+}
+
 /*
  * Return the already calculated final result.
  */
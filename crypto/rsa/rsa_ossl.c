@@ -18,6 +18,8 @@
 #include "crypto/sparse_array.h"
 #include "rsa_local.h"
 #include "internal/constant_time.h"
+#include "internal/rcu.h"
+#include "internal/thread.h"
 #if defined(OPENSSL_SYS_TANDEM)
 #include "internal/tsan_assist.h"
 #include "internal/threads_common.h"
@@ -785,6 +787,188 @@ err:
     return r;
 }
 
+/*
+ * Check whether the Montgomery contexts of all the prime factors are set up.
+ * They're computed once, by whichever thread gets there first, and are then
+ * never changed while the key is in use, so they can be checked for, and
+ * used, without locking.  In the steady state a private key operation thus
+ * takes no locks and allocates nothing for them.
+ */
+static int rsa_ossl_prime_mont_ready(RSA *rsa)
+{
+#ifndef FIPS_MODULE
+    int i;
+
+    for (i = 0; i < sk_RSA_PRIME_INFO_num(rsa->prime_infos); i++) {
+        RSA_PRIME_INFO *pinfo = sk_RSA_PRIME_INFO_value(rsa->prime_infos, i);
+
+        if (ossl_rcu_deref(&pinfo->m) == NULL)
+            return 0;
+    }
+#endif
+    return ossl_rcu_deref(&rsa->_method_mod_p) != NULL
+        && ossl_rcu_deref(&rsa->_method_mod_q) != NULL;
+}
+
+static int rsa_ossl_set_prime_mont(RSA *rsa, BN_CTX *ctx)
+{
+    BIGNUM *factor;
+    int ok = 0;
+#ifndef FIPS_MODULE
+    int i;
+    RSA_PRIME_INFO *pinfo;
+#endif
+
+    if (rsa_ossl_prime_mont_ready(rsa))
+        return 1;
+
+    if ((factor = BN_new()) == NULL)
+        return 0;
+
+    /*
+     * Make sure BN_mod_inverse in Montgomery initialization uses the
+     * BN_FLG_CONSTTIME flag
+     */
+    if (!(BN_with_flags(factor, rsa->p, BN_FLG_CONSTTIME),
+            BN_MONT_CTX_set_locked(&rsa->_method_mod_p, rsa->lock,
+                factor, ctx))
+        || !(BN_with_flags(factor, rsa->q, BN_FLG_CONSTTIME),
+            BN_MONT_CTX_set_locked(&rsa->_method_mod_q, rsa->lock,
+                factor, ctx)))
+        goto err;
+#ifndef FIPS_MODULE
+    for (i = 0; i < sk_RSA_PRIME_INFO_num(rsa->prime_infos); i++) {
+        pinfo = sk_RSA_PRIME_INFO_value(rsa->prime_infos, i);
+        BN_with_flags(factor, pinfo->r, BN_FLG_CONSTTIME);
+        if (!BN_MONT_CTX_set_locked(&pinfo->m, rsa->lock, factor, ctx))
+            goto err;
+    }
+#endif
+    ok = 1;
+err:
+    /*
+     * We MUST free |factor| before any further use of the prime factors
+     */
+    BN_free(factor);
+    return ok;
+}
+
+/*
+ * Reduce |I| for the two halves of a CRT private key operation with equally
+ * sized primes: m1 = I mod q and r1 = I mod p.  |I| must be less than n.
+ */
+static int rsa_ossl_crt_reduce(BIGNUM *r1, BIGNUM *m1, const BIGNUM *I,
+    RSA *rsa, BN_CTX *ctx)
+{
+    /*
+     * Conversion from Montgomery domain, a.k.a. Montgomery reduction,
+     * accepts values in [0-m*2^w) range. w is m's bit width rounded up
+     * to limb width. So that at the very least if |I| is fully reduced,
+     * i.e. less than p*q, we can count on from-to round to perform
+     * below modulo operations on |I|. Unlike BN_mod it's constant time.
+     */
+    return /* m1 = I moq q */
+        bn_from_mont_fixed_top(m1, I, rsa->_method_mod_q, ctx)
+        && bn_to_mont_fixed_top(m1, m1, rsa->_method_mod_q, ctx)
+        /* r1 = I mod p */
+        && bn_from_mont_fixed_top(r1, I, rsa->_method_mod_p, ctx)
+        && bn_to_mont_fixed_top(r1, r1, rsa->_method_mod_p, ctx);
+}
+
+/*
+ * Combine m1 = I^dmq1 mod q and r1 = I^dmp1 mod p into r0 = I^d mod n.
+ * |r1| is overwritten.
+ */
+static int rsa_ossl_crt_combine(BIGNUM *r0, BIGNUM *r1, const BIGNUM *m1,
+    RSA *rsa, BN_CTX *ctx)
+{
+    return /* r1 = (r1 - m1) mod p */
+        /*
+         * bn_mod_sub_fixed_top is not regular modular subtraction,
+         * it can tolerate subtrahend to be larger than modulus, but
+         * not bit-wise wider. This makes up for uncommon q>p case,
+         * when |m1| can be larger than |rsa->p|.
+         */
+        bn_mod_sub_fixed_top(r1, r1, m1, rsa->p)
+
+        /* r1 = r1 * iqmp mod p */
+        && bn_to_mont_fixed_top(r1, r1, rsa->_method_mod_p, ctx)
+        && bn_mul_mont_fixed_top(r1, r1, rsa->iqmp, rsa->_method_mod_p,
+            ctx)
+        /* r0 = r1 * q + m1 */
+        && bn_mul_fixed_top(r0, r1, rsa->q, ctx)
+        && bn_mod_add_fixed_top(r0, r0, m1, rsa->n);
+}
+
+/*
+ * Check the result |r0| of a private key operation on |I| with the public
+ * exponent, and redo the operation without CRT if it is wrong.  |vrfy| is
+ * used as a temporary.
+ */
+static int rsa_ossl_mod_exp_check(BIGNUM *r0, const BIGNUM *I, BIGNUM *vrfy,
+    RSA *rsa, BN_CTX *ctx)
+{
+    if (rsa->e && rsa->n) {
+        if (rsa->meth->bn_mod_exp == BN_mod_exp_mont) {
+            if (!BN_mod_exp_mont(vrfy, r0, rsa->e, rsa->n, ctx,
+                    rsa->_method_mod_n))
+                return 0;
+        } else {
+            bn_correct_top(r0);
+            if (!rsa->meth->bn_mod_exp(vrfy, r0, rsa->e, rsa->n, ctx,
+                    rsa->_method_mod_n))
+                return 0;
+        }
+        /*
+         * If 'I' was greater than (or equal to) rsa->n, the operation will
+         * be equivalent to using 'I mod n'. However, the result of the
+         * verify will *always* be less than 'n' so we don't check for
+         * absolute equality, just congruency.
+         */
+        if (!BN_sub(vrfy, vrfy, I))
+            return 0;
+        if (BN_is_zero(vrfy)) {
+            bn_correct_top(r0);
+            return 1;
+        }
+        if (!BN_mod(vrfy, vrfy, rsa->n, ctx))
+            return 0;
+        if (BN_is_negative(vrfy))
+            if (!BN_add(vrfy, vrfy, rsa->n))
+                return 0;
+        if (!BN_is_zero(vrfy)) {
+            /*
+             * 'I' and 'vrfy' aren't congruent mod n. Don't leak
+             * miscalculated CRT output, just do a raw (slower) mod_exp and
+             * return that instead.
+             */
+
+            BIGNUM *d = BN_new();
+            if (d == NULL)
+                return 0;
+            BN_with_flags(d, rsa->d, BN_FLG_CONSTTIME);
+
+            if (!rsa->meth->bn_mod_exp(r0, I, d, rsa->n, ctx,
+                    rsa->_method_mod_n)) {
+                BN_free(d);
+                return 0;
+            }
+            /* We MUST free d before any further use of rsa->d */
+            BN_free(d);
+        }
+    }
+    /*
+     * It's unfortunate that we have to bn_correct_top(r0). What hopefully
+     * saves the day is that correction is highly unlike, and private key
+     * operations are customarily performed on blinded message. Which means
+     * that attacker won't observe correlation with chosen plaintext.
+     * Secondly, remaining code would still handle it in same computational
+     * time and even conceal memory access pattern around corrected top.
+     */
+    bn_correct_top(r0);
+    return 1;
+}
+
 static int rsa_ossl_mod_exp(BIGNUM *r0, const BIGNUM *I, RSA *rsa, BN_CTX *ctx)
 {
     BIGNUM *r1, *m1, *vrfy;
@@ -814,39 +998,9 @@ static int rsa_ossl_mod_exp(BIGNUM *r0, const BIGNUM *I, RSA *rsa, BN_CTX *ctx)
 #endif
 
     if (rsa->flags & RSA_FLAG_CACHE_PRIVATE) {
-        BIGNUM *factor = BN_new();
-
-        if (factor == NULL)
+        if (!rsa_ossl_set_prime_mont(rsa, ctx))
             goto err;
 
-        /*
-         * Make sure BN_mod_inverse in Montgomery initialization uses the
-         * BN_FLG_CONSTTIME flag
-         */
-        if (!(BN_with_flags(factor, rsa->p, BN_FLG_CONSTTIME),
-                BN_MONT_CTX_set_locked(&rsa->_method_mod_p, rsa->lock,
-                    factor, ctx))
-            || !(BN_with_flags(factor, rsa->q, BN_FLG_CONSTTIME),
-                BN_MONT_CTX_set_locked(&rsa->_method_mod_q, rsa->lock,
-                    factor, ctx))) {
-            BN_free(factor);
-            goto err;
-        }
-#ifndef FIPS_MODULE
-        for (i = 0; i < ex_primes; i++) {
-            pinfo = sk_RSA_PRIME_INFO_value(rsa->prime_infos, i);
-            BN_with_flags(factor, pinfo->r, BN_FLG_CONSTTIME);
-            if (!BN_MONT_CTX_set_locked(&pinfo->m, rsa->lock, factor, ctx)) {
-                BN_free(factor);
-                goto err;
-            }
-        }
-#endif
-        /*
-         * We MUST free |factor| before any further use of the prime factors
-         */
-        BN_free(factor);
-
         smooth = (rsa->meth->bn_mod_exp == BN_mod_exp_mont)
 #ifndef FIPS_MODULE
             && (ex_primes == 0)
@@ -861,45 +1015,18 @@ static int rsa_ossl_mod_exp(BIGNUM *r0, const BIGNUM *I, RSA *rsa, BN_CTX *ctx)
 
     if (smooth) {
         /*
-         * Conversion from Montgomery domain, a.k.a. Montgomery reduction,
-         * accepts values in [0-m*2^w) range. w is m's bit width rounded up
-         * to limb width. So that at the very least if |I| is fully reduced,
-         * i.e. less than p*q, we can count on from-to round to perform
-         * below modulo operations on |I|. Unlike BN_mod it's constant time.
+         * Use parallel exponentiations optimization if possible,
+         * otherwise fallback to two sequential exponentiations:
+         *    m1 = m1^dmq1 mod q
+         *    r1 = r1^dmp1 mod p
          */
-        if (/* m1 = I moq q */
-            !bn_from_mont_fixed_top(m1, I, rsa->_method_mod_q, ctx)
-            || !bn_to_mont_fixed_top(m1, m1, rsa->_method_mod_q, ctx)
-            /* r1 = I mod p */
-            || !bn_from_mont_fixed_top(r1, I, rsa->_method_mod_p, ctx)
-            || !bn_to_mont_fixed_top(r1, r1, rsa->_method_mod_p, ctx)
-            /*
-             * Use parallel exponentiations optimization if possible,
-             * otherwise fallback to two sequential exponentiations:
-             *    m1 = m1^dmq1 mod q
-             *    r1 = r1^dmp1 mod p
-             */
+        if (!rsa_ossl_crt_reduce(r1, m1, I, rsa, ctx)
             || !BN_mod_exp_mont_consttime_x2(m1, m1, rsa->dmq1, rsa->q,
                 rsa->_method_mod_q,
                 r1, r1, rsa->dmp1, rsa->p,
                 rsa->_method_mod_p,
                 ctx)
-            /* r1 = (r1 - m1) mod p */
-            /*
-             * bn_mod_sub_fixed_top is not regular modular subtraction,
-             * it can tolerate subtrahend to be larger than modulus, but
-             * not bit-wise wider. This makes up for uncommon q>p case,
-             * when |m1| can be larger than |rsa->p|.
-             */
-            || !bn_mod_sub_fixed_top(r1, r1, m1, rsa->p)
-
-            /* r1 = r1 * iqmp mod p */
-            || !bn_to_mont_fixed_top(r1, r1, rsa->_method_mod_p, ctx)
-            || !bn_mul_mont_fixed_top(r1, r1, rsa->iqmp, rsa->_method_mod_p,
-                ctx)
-            /* r0 = r1 * q + m1 */
-            || !bn_mul_fixed_top(r0, r1, rsa->q, ctx)
-            || !bn_mod_add_fixed_top(r0, r0, m1, rsa->n))
+            || !rsa_ossl_crt_combine(r0, r1, m1, rsa, ctx))
             goto err;
 
         goto tail;
@@ -1091,68 +1218,335 @@ static int rsa_ossl_mod_exp(BIGNUM *r0, const BIGNUM *I, RSA *rsa, BN_CTX *ctx)
 #endif
 
 tail:
-    if (rsa->e && rsa->n) {
-        if (rsa->meth->bn_mod_exp == BN_mod_exp_mont) {
-            if (!BN_mod_exp_mont(vrfy, r0, rsa->e, rsa->n, ctx,
-                    rsa->_method_mod_n))
-                goto err;
-        } else {
-            bn_correct_top(r0);
-            if (!rsa->meth->bn_mod_exp(vrfy, r0, rsa->e, rsa->n, ctx,
-                    rsa->_method_mod_n))
-                goto err;
+    ret = rsa_ossl_mod_exp_check(r0, I, vrfy, rsa, ctx);
+err:
+    BN_CTX_end(ctx);
+    return ret;
+}
+
+/* Number of messages whose exponentiations are batched together */
+#define RSA_BATCH_GROUP 4
+/* The maximum number of threads used by ossl_rsa_private_encrypt_batch() */
+#define RSA_BATCH_MAX_THREADS 32
+
+#if defined(OPENSSL_THREADS) && !defined(OPENSSL_NO_THREAD_POOL)
+#define RSA_BATCH_USE_THREADS
+#endif
+
+typedef struct {
+    RSA *rsa;
+    const unsigned char *const *from;
+    const size_t *flen;
+    unsigned char *const *to;
+    int padding;
+    size_t first, num;
+    int ret;
+    /* The last error of a job that failed on a pool thread, or 0 */
+    unsigned long err;
+} RSA_BATCH_JOB;
+
+/*
+ * Whether the private key operations of |rsa| are done by
+ * rsa_ossl_mod_exp() on the smooth CRT path, which the batch follows.
+ */
+static int rsa_ossl_batch_capable(const RSA *rsa)
+{
+    return rsa->meth->rsa_priv_enc == rsa_ossl_private_encrypt
+        && rsa->meth->rsa_mod_exp == rsa_ossl_mod_exp
+        && rsa->meth->bn_mod_exp == BN_mod_exp_mont
+        && (rsa->flags & RSA_FLAG_CACHE_PRIVATE) != 0
+        && (rsa->flags & RSA_FLAG_EXT_PKEY) == 0
+        && rsa->version != RSA_ASN1_VERSION_MULTI
+        && rsa->n != NULL && rsa->e != NULL && rsa->d != NULL
+        && rsa->p != NULL && rsa->q != NULL && rsa->dmp1 != NULL
+        && rsa->dmq1 != NULL && rsa->iqmp != NULL
+        && BN_num_bits(rsa->p) == BN_num_bits(rsa->q);
+}
+
+/*
+ * The private key operation of rsa_ossl_private_encrypt() for up to
+ * RSA_BATCH_GROUP messages, with the CRT exponentiations of all of them
+ * done in one ossl_bn_mod_exp_mont_consttime_batch() call.
+ *
+ * Each message has its own unblinding factor, so that one blinding can be
+ * used for the whole group.
+ */
+static int rsa_ossl_private_encrypt_group(RSA *rsa, size_t n,
+    const unsigned char *const from[], const size_t flen[],
+    unsigned char *const to[], int padding, BN_BLINDING *blinding,
+    BN_CTX *ctx)
+{
+    BIGNUM *f[RSA_BATCH_GROUP], *unblind[RSA_BATCH_GROUP];
+    BIGNUM *r1[RSA_BATCH_GROUP], *m1[RSA_BATCH_GROUP], *r0, *vrfy, *res;
+    BIGNUM *rr[2 * RSA_BATCH_GROUP];
+    const BIGNUM *a[2 * RSA_BATCH_GROUP], *p[2 * RSA_BATCH_GROUP];
+    const BIGNUM *m[2 * RSA_BATCH_GROUP];
+    BN_MONT_CTX *mont[2 * RSA_BATCH_GROUP];
+    unsigned char *buf;
+    int i, num = BN_num_bytes(rsa->n), ret = 0;
+    size_t k;
+
+    BN_CTX_start(ctx);
+    r0 = BN_CTX_get(ctx);
+    vrfy = BN_CTX_get(ctx);
+    buf = OPENSSL_malloc(num);
+    if (vrfy == NULL || buf == NULL)
+        goto err;
+
+    for (k = 0; k < n; k++) {
+        f[k] = BN_CTX_get(ctx);
+        unblind[k] = BN_CTX_get(ctx);
+        r1[k] = BN_CTX_get(ctx);
+        m1[k] = BN_CTX_get(ctx);
+        if (m1[k] == NULL)
+            goto err;
+
+        if (flen[k] > (size_t)num) {
+            ERR_raise(ERR_LIB_RSA, RSA_R_DATA_TOO_LARGE_FOR_KEY_SIZE);
+            goto err;
         }
-        /*
-         * If 'I' was greater than (or equal to) rsa->n, the operation will
-         * be equivalent to using 'I mod n'. However, the result of the
-         * verify will *always* be less than 'n' so we don't check for
-         * absolute equality, just congruency.
-         */
-        if (!BN_sub(vrfy, vrfy, I))
+        switch (padding) {
+        case RSA_PKCS1_PADDING:
+            i = RSA_padding_add_PKCS1_type_1(buf, num, from[k], (int)flen[k]);
+            break;
+        case RSA_X931_PADDING:
+            i = RSA_padding_add_X931(buf, num, from[k], (int)flen[k]);
+            break;
+        case RSA_NO_PADDING:
+            i = RSA_padding_add_none(buf, num, from[k], (int)flen[k]);
+            break;
+        default:
+            ERR_raise(ERR_LIB_RSA, RSA_R_UNKNOWN_PADDING_TYPE);
             goto err;
-        if (BN_is_zero(vrfy)) {
-            bn_correct_top(r0);
-            ret = 1;
-            goto err; /* not actually error */
         }
-        if (!BN_mod(vrfy, vrfy, rsa->n, ctx))
+        if (i <= 0)
             goto err;
-        if (BN_is_negative(vrfy))
-            if (!BN_add(vrfy, vrfy, rsa->n))
-                goto err;
-        if (!BN_is_zero(vrfy)) {
-            /*
-             * 'I' and 'vrfy' aren't congruent mod n. Don't leak
-             * miscalculated CRT output, just do a raw (slower) mod_exp and
-             * return that instead.
-             */
 
-            BIGNUM *d = BN_new();
-            if (d == NULL)
+        if (BN_bin2bn(buf, num, f[k]) == NULL)
+            goto err;
+
+        if (BN_ucmp(f[k], rsa->n) >= 0) {
+            /* usually the padding functions would catch this */
+            ERR_raise(ERR_LIB_RSA, RSA_R_DATA_TOO_LARGE_FOR_MODULUS);
+            goto err;
+        }
+
+        if (blinding != NULL
+            && !BN_BLINDING_convert_ex(f[k], unblind[k], blinding, ctx))
+            goto err;
+
+        if (!rsa_ossl_crt_reduce(r1[k], m1[k], f[k], rsa, ctx))
+            goto err;
+
+        /* m1 = m1^dmq1 mod q */
+        rr[2 * k] = m1[k];
+        a[2 * k] = m1[k];
+        p[2 * k] = rsa->dmq1;
+        m[2 * k] = rsa->q;
+        mont[2 * k] = rsa->_method_mod_q;
+        /* r1 = r1^dmp1 mod p */
+        rr[2 * k + 1] = r1[k];
+        a[2 * k + 1] = r1[k];
+        p[2 * k + 1] = rsa->dmp1;
+        m[2 * k + 1] = rsa->p;
+        mont[2 * k + 1] = rsa->_method_mod_p;
+    }
+
+    if (!ossl_bn_mod_exp_mont_consttime_batch(rr, a, p, m, mont, 2 * n, ctx))
+        goto err;
+
+    for (k = 0; k < n; k++) {
+        if (!rsa_ossl_crt_combine(r0, r1[k], m1[k], rsa, ctx)
+            || !rsa_ossl_mod_exp_check(r0, f[k], vrfy, rsa, ctx))
+            goto err;
+
+        if (blinding != NULL) {
+            BN_set_flags(r0, BN_FLG_CONSTTIME);
+            if (!BN_BLINDING_invert_ex(r0, unblind[k], blinding, ctx))
                 goto err;
-            BN_with_flags(d, rsa->d, BN_FLG_CONSTTIME);
+        }
 
-            if (!rsa->meth->bn_mod_exp(r0, I, d, rsa->n, ctx,
-                    rsa->_method_mod_n)) {
-                BN_free(d);
+        res = r0;
+        if (padding == RSA_X931_PADDING) {
+            if (!BN_sub(f[k], rsa->n, r0))
                 goto err;
-            }
-            /* We MUST free d before any further use of rsa->d */
-            BN_free(d);
+            if (BN_cmp(r0, f[k]) > 0)
+                res = f[k];
         }
+        if (BN_bn2binpad(res, to[k], num) < 0)
+            goto err;
     }
-    /*
-     * It's unfortunate that we have to bn_correct_top(r0). What hopefully
-     * saves the day is that correction is highly unlike, and private key
-     * operations are customarily performed on blinded message. Which means
-     * that attacker won't observe correlation with chosen plaintext.
-     * Secondly, remaining code would still handle it in same computational
-     * time and even conceal memory access pattern around corrected top.
-     */
-    bn_correct_top(r0);
     ret = 1;
 err:
     BN_CTX_end(ctx);
+    OPENSSL_clear_free(buf, num);
+    return ret;
+}
+
+static uint32_t rsa_ossl_batch_job(void *data)
+{
+    RSA_BATCH_JOB *job = (RSA_BATCH_JOB *)data;
+    RSA *rsa = job->rsa;
+    BN_CTX *ctx;
+    BN_BLINDING *blinding = NULL;
+    size_t i, n;
+
+    job->ret = 0;
+    if ((ctx = BN_CTX_new_ex(rsa->libctx)) == NULL)
+        return 0;
+
+    if (!(rsa->flags & RSA_FLAG_NO_BLINDING)) {
+        blinding = rsa_get_blinding(rsa, ctx);
+        if (blinding == NULL) {
+            ERR_raise(ERR_LIB_RSA, ERR_R_INTERNAL_ERROR);
+            goto err;
+        }
+    }
+
+    for (i = job->first; i < job->first + job->num; i += n) {
+        n = job->first + job->num - i;
+        if (n > RSA_BATCH_GROUP)
+            n = RSA_BATCH_GROUP;
+        if (!rsa_ossl_private_encrypt_group(rsa, n, job->from + i,
+                job->flen + i, job->to + i, job->padding, blinding, ctx))
+            goto err;
+    }
+    job->ret = 1;
+err:
+    BN_CTX_free(ctx);
+    return 0;
+}
+
+#if defined(RSA_BATCH_USE_THREADS)
+/*
+ * rsa_ossl_batch_job() on a pool thread, where the error queue is not the
+ * caller's.  The last error is kept in the job so that the caller can raise
+ * it again.
+ */
+static uint32_t rsa_ossl_batch_thread(void *data)
+{
+    RSA_BATCH_JOB *job = (RSA_BATCH_JOB *)data;
+
+    rsa_ossl_batch_job(job);
+    if (!job->ret) {
+        job->err = ERR_peek_last_error();
+        ERR_clear_error();
+    }
+    return 0;
+}
+#endif
+
+/*
+ * Sign |num| messages |from[i]| of |flen[i]| bytes into |to[i]| with the
+ * private key |rsa|, each as if by RSA_private_encrypt() with |padding|.
+ * Every |to[i]| must have room for RSA_size(rsa) bytes.
+ *
+ * For two prime keys handled by this RSA method, the CRT exponentiations of
+ * several messages are computed together, and the messages are spread over
+ * the threads of the library context thread pool, if it has idle threads.
+ * Other keys are signed one message at a time.
+ *
+ * Returns 1 on success and 0 on failure.
+ */
+int ossl_rsa_private_encrypt_batch(RSA *rsa, size_t num,
+    const unsigned char *const from[], const size_t flen[],
+    unsigned char *const to[], int padding)
+{
+    RSA_BATCH_JOB job[RSA_BATCH_MAX_THREADS];
+    void *thread[RSA_BATCH_MAX_THREADS];
+    BN_CTX *ctx;
+    size_t i, per_thread, groups, nthreads;
+#if defined(RSA_BATCH_USE_THREADS)
+    uint64_t avail;
+#endif
+    int ret;
+
+    if (num == 0)
+        return 1;
+
+    if (!rsa_ossl_batch_capable(rsa)) {
+        for (i = 0; i < num; i++) {
+            if (flen[i] > INT_MAX) {
+                ERR_raise(ERR_LIB_RSA, RSA_R_DATA_TOO_LARGE_FOR_KEY_SIZE);
+                return 0;
+            }
+            if (RSA_private_encrypt((int)flen[i], from[i], to[i], rsa,
+                    padding) <= 0)
+                return 0;
+        }
+        return 1;
+    }
+
+    /* Set up the shared Montgomery contexts before any thread needs them */
+    if ((ctx = BN_CTX_new_ex(rsa->libctx)) == NULL)
+        return 0;
+    ret = rsa_ossl_set_prime_mont(rsa, ctx)
+        && (!(rsa->flags & RSA_FLAG_CACHE_PUBLIC)
+            || BN_MONT_CTX_set_locked(&rsa->_method_mod_n, rsa->lock,
+                rsa->n, ctx));
+    BN_CTX_free(ctx);
+    if (!ret)
+        return 0;
+
+    /* Each thread gets at least one full group of messages */
+    groups = (num + RSA_BATCH_GROUP - 1) / RSA_BATCH_GROUP;
+    nthreads = groups < RSA_BATCH_MAX_THREADS ? groups : RSA_BATCH_MAX_THREADS;
+#if defined(RSA_BATCH_USE_THREADS)
+    if (nthreads > 1) {
+        /* Don't block waiting for pool threads, the caller is also a worker */
+        avail = ossl_get_avail_threads(rsa->libctx);
+        if (avail < nthreads - 1)
+            nthreads = (size_t)avail + 1;
+    }
+#else
+    nthreads = 1;
+#endif
+    per_thread = (groups + nthreads - 1) / nthreads * RSA_BATCH_GROUP;
+
+    for (i = 0; i < nthreads; i++) {
+        job[i].rsa = rsa;
+        job[i].from = from;
+        job[i].flen = flen;
+        job[i].to = to;
+        job[i].padding = padding;
+        job[i].first = i * per_thread;
+        job[i].num = 0;
+        if (job[i].first < num)
+            job[i].num = num - job[i].first < per_thread
+                ? num - job[i].first : per_thread;
+        job[i].ret = 0;
+        job[i].err = 0;
+        thread[i] = NULL;
+    }
+
+#if defined(RSA_BATCH_USE_THREADS)
+    for (i = 1; i < nthreads; i++)
+        if (job[i].num > 0)
+            thread[i] = ossl_crypto_thread_start(rsa->libctx,
+                &rsa_ossl_batch_thread, &job[i]);
+#endif
+    rsa_ossl_batch_job(&job[0]);
+    ret = job[0].ret;
+
+    for (i = 1; i < nthreads; i++) {
+        if (thread[i] == NULL) {
+            rsa_ossl_batch_job(&job[i]);
+        } else {
+#if defined(RSA_BATCH_USE_THREADS)
+            if (!ossl_crypto_thread_join(thread[i], NULL))
+                job[i].ret = 0;
+            ossl_crypto_thread_clean(thread[i]);
+            if (!job[i].ret) {
+                if (job[i].err != 0)
+                    ERR_raise(ERR_GET_LIB(job[i].err),
+                        ERR_GET_REASON(job[i].err));
+                else
+                    ERR_raise(ERR_LIB_RSA, ERR_R_INTERNAL_ERROR);
+            }
+#endif
+        }
+        ret &= job[i].ret;
+    }
     return ret;
 }
 
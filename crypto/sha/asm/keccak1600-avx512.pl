@@ -33,6 +33,40 @@
 # Skylake-X		5.7
 #
 # (*)	Corresponds to SHA3-256.
+#
+# The entry points are named SHA3_absorb_avx512 and SHA3_squeeze_avx512
+# and are picked at run time by the SHA-3 methods when
+# SHA3_avx512_capable() says so. SHA3_squeeze_avx512 takes the same
+# |next| argument as SHA3_squeeze. Win64 is not supported, there and with
+# assemblers that lack AVX-512 only a capability function returning 0 is
+# emitted.
+
+# $output is the last argument if it looks like a file (it has an extension)
+# $flavour is the first argument if it doesn't look like a file
+$output = $#ARGV >= 0 && $ARGV[$#ARGV] =~ m|\.\w+$| ? pop : undef;
+$flavour = $#ARGV >= 0 && $ARGV[0] !~ m|\.| ? shift : undef;
+
+$win64=0; $win64=1 if ($flavour =~ /[nm]asm|mingw64/ || $output =~ /\.asm$/);
+
+$0 =~ m/(.*[\/\\])[^\/\\]+$/; $dir=$1;
+( $xlate="${dir}x86_64-xlate.pl" and -f $xlate ) or
+( $xlate="${dir}../../perlasm/x86_64-xlate.pl" and -f $xlate) or
+die "can't locate x86_64-xlate.pl";
+
+$avx512 = 0;
+if (`$ENV{CC} -Wa,-v -c -o /dev/null -x assembler /dev/null 2>&1`
+	=~ /GNU assembler version ([2-9]\.[0-9]+)/) {
+    $avx512 = ($1>=2.26);
+}
+if (!$avx512 && `$ENV{CC} -v 2>&1`
+	=~ /((?:clang|LLVM) version|.*based on LLVM) ([0-9]+\.[0-9]+)/) {
+    $avx512 = ($2>=3.9);
+}
+$avx512 = 0 if ($win64);
+
+open OUT,"| \"$^X\" \"$xlate\" $flavour \"$output\""
+    or die "can't call $xlate: $!";
+*STDOUT=*OUT;
 
 ########################################################################
 # Below code is combination of two ideas. One is taken from Keccak Code
@@ -131,9 +165,24 @@ my @Rhotate1 = map("%zmm$_",(27..31));
 my ($C00,$D00) = @T[0..1];
 my ($k00001,$k00010,$k00100,$k01000,$k10000,$k11111) = map("%k$_",(1..6));
 
+if ($avx512) {{{
+
 $code.=<<___;
 .text
 
+.extern	OPENSSL_ia32cap_P
+
+.globl	SHA3_avx512_capable
+.type	SHA3_avx512_capable,\@abi-omnipotent
+.align	32
+SHA3_avx512_capable:
+	mov	OPENSSL_ia32cap_P+8(%rip),%ecx
+	xor	%eax,%eax
+	test	\$`1<<16`,%ecx			# AVX512F
+	setnz	%al
+	ret
+.size	SHA3_avx512_capable,.-SHA3_avx512_capable
+
 .type	__KeccakF1600,\@function
 .align	32
 __KeccakF1600:
@@ -276,14 +325,14 @@ __KeccakF1600:
 .size	__KeccakF1600,.-__KeccakF1600
 ___
 
-my ($A_flat,$inp,$len,$bsz) = ("%rdi","%rsi","%rdx","%rcx");
+my ($A_flat,$inp,$len,$bsz,$next) = ("%rdi","%rsi","%rdx","%rcx","%r8");
 my  $out = $inp;	# in squeeze
 
 $code.=<<___;
-.globl	SHA3_absorb
-.type	SHA3_absorb,\@function
+.globl	SHA3_absorb_avx512
+.type	SHA3_absorb_avx512,\@function,4
 .align	32
-SHA3_absorb:
+SHA3_absorb_avx512:
 	mov	%rsp,%r11
 
 	lea	-320(%rsp),%rsp
@@ -384,18 +433,22 @@ $code.=<<___;
 	lea	(%r11),%rsp
 	lea	($len,$bsz),%rax		# return value
 	ret
-.size	SHA3_absorb,.-SHA3_absorb
+.size	SHA3_absorb_avx512,.-SHA3_absorb_avx512
 
-.globl	SHA3_squeeze
-.type	SHA3_squeeze,\@function
+.globl	SHA3_squeeze_avx512
+.type	SHA3_squeeze_avx512,\@function,5
 .align	32
-SHA3_squeeze:
+SHA3_squeeze_avx512:
 	mov	%rsp,%r11
+	mov	${next}d,%r9d			# theta_perm takes over $next
 
 	lea	96($A_flat),$A_flat
+	test	%r9d,%r9d
+	jnz	.Lload_squeeze_avx512
 	cmp	$bsz,$len
 	jbe	.Lno_output_extension_avx512
 
+.Lload_squeeze_avx512:
 	lea		theta_perm(%rip),%r8
 
 	kxnorw		$k11111,$k11111,$k11111
@@ -436,6 +489,17 @@ SHA3_squeeze:
 	vmovdqu64	40*3-96($A_flat),${A30}{$k11111}{z}
 	vmovdqu64	40*4-96($A_flat),${A40}{$k11111}{z}
 
+	test	%r9d,%r9d			# permute before the first block?
+	jz	.Lno_output_extension_avx512
+
+	call	__KeccakF1600
+
+	vmovdqu64	$A00,40*0-96($A_flat){$k11111}
+	vmovdqu64	$A10,40*1-96($A_flat){$k11111}
+	vmovdqu64	$A20,40*2-96($A_flat){$k11111}
+	vmovdqu64	$A30,40*3-96($A_flat){$k11111}
+	vmovdqu64	$A40,40*4-96($A_flat){$k11111}
+
 .Lno_output_extension_avx512:
 	shr	\$3,$bsz
 	lea	-96($A_flat),%r9
@@ -484,9 +548,9 @@ SHA3_squeeze:
 
 	lea	(%r11),%rsp
 	ret
-.size	SHA3_squeeze,.-SHA3_squeeze
+.size	SHA3_squeeze_avx512,.-SHA3_squeeze_avx512
 
-.section .rodata
+.section .rodata align=64
 .align	64
 theta_perm:
 	.quad	0, 1, 2, 3, 4, 5, 6, 7		# [not used]
@@ -546,6 +610,32 @@ iotas:
 .asciz	"Keccak-1600 absorb and squeeze for AVX-512F, CRYPTOGAMS by <https://github.com/dot-asm>"
 ___
 
-$output=pop and open STDOUT,">$output";
+}}} else {{{
+
+# Without AVX-512 support in the assembler, or on Win64, the capability
+# function returns 0 and the C code never calls the other two.
+
+$code.=<<___;
+.text
+
+.globl	SHA3_avx512_capable
+.type	SHA3_avx512_capable,\@abi-omnipotent
+SHA3_avx512_capable:
+	xor	%eax,%eax
+	ret
+.size	SHA3_avx512_capable,.-SHA3_avx512_capable
+
+.globl	SHA3_absorb_avx512
+.globl	SHA3_squeeze_avx512
+.type	SHA3_absorb_avx512,\@abi-omnipotent
+SHA3_absorb_avx512:
+SHA3_squeeze_avx512:
+	.byte	0x0f,0x0b	# ud2
+	ret
+.size	SHA3_absorb_avx512,.-SHA3_absorb_avx512
+___
+}}}
+
+$code =~ s/\`([^\`]*)\`/eval $1/gem;
 print $code;
 close STDOUT or die "error closing STDOUT: $!";
@@ -26,6 +26,12 @@
 
 void SHA3_squeeze(uint64_t A[5][5], unsigned char *out, size_t len, size_t r, int next);
 
+/* Keccak-f[1600] permutation primitives shared by the final/squeeze methods */
+typedef size_t(keccak_absorb_fn)(uint64_t A[5][5], const unsigned char *inp,
+    size_t len, size_t r);
+typedef void(keccak_squeeze_fn)(uint64_t A[5][5], unsigned char *out,
+    size_t len, size_t r, int next);
+
 void ossl_sha3_reset(KECCAK1600_CTX *ctx)
 {
 #if defined(__s390x__) && defined(OPENSSL_CPUID_OBJ)
@@ -148,7 +154,8 @@ size_t ossl_sha3_absorb_default(KECCAK1600_CTX *ctx, const unsigned char *inp, s
  * Default version of the final() is a single shot method
  * (Use ossl_sha3_default_squeeze() for multiple calls).
  */
-int ossl_sha3_final_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen)
+static int sha3_final(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen,
+    keccak_absorb_fn *absorb, keccak_squeeze_fn *squeeze)
 {
     size_t bsz = ctx->block_size;
     size_t num = ctx->bufsz;
@@ -162,12 +169,17 @@ int ossl_sha3_final_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t outl
     ctx->buf[num] = ctx->pad;
     ctx->buf[bsz - 1] |= 0x80;
 
-    (void)SHA3_absorb(ctx->A, ctx->buf, bsz, bsz);
+    (void)absorb(ctx->A, ctx->buf, bsz, bsz);
 
-    SHA3_squeeze(ctx->A, out, outlen, bsz, 0);
+    squeeze(ctx->A, out, outlen, bsz, 0);
     return 1;
 }
 
+int ossl_sha3_final_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen)
+{
+    return sha3_final(ctx, out, outlen, SHA3_absorb, SHA3_squeeze);
+}
+
 /*
  * This method can be called multiple times.
  * Rather than heavily modifying assembler for SHA3_squeeze(),
@@ -178,7 +190,8 @@ int ossl_sha3_final_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t outl
  * buffer the results. The next request will use the buffer first
  * to grab output bytes.
  */
-int ossl_shake_squeeze_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen)
+static int shake_squeeze(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen,
+    keccak_absorb_fn *absorb, keccak_squeeze_fn *squeeze)
 {
     size_t bsz = ctx->block_size;
     size_t num = ctx->bufsz;
@@ -199,7 +212,7 @@ int ossl_shake_squeeze_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t o
         memset(ctx->buf + num, 0, bsz - num);
         ctx->buf[num] = ctx->pad;
         ctx->buf[bsz - 1] |= 0x80;
-        (void)SHA3_absorb(ctx->A, ctx->buf, bsz, bsz);
+        (void)absorb(ctx->A, ctx->buf, bsz, bsz);
         num = ctx->bufsz = 0;
         next = 0;
     }
@@ -224,14 +237,14 @@ int ossl_shake_squeeze_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t o
     /* Step 2. Copy full sized squeezed blocks to the output buffer directly */
     if (outlen >= bsz) {
         len = bsz * (outlen / bsz);
-        SHA3_squeeze(ctx->A, out, len, bsz, next);
+        squeeze(ctx->A, out, len, bsz, next);
         next = 1;
         out += len;
         outlen -= len;
     }
     if (outlen > 0) {
         /* Step 3. Squeeze one more block into a buffer */
-        SHA3_squeeze(ctx->A, ctx->buf, bsz, bsz, next);
+        squeeze(ctx->A, ctx->buf, bsz, bsz, next);
         memcpy(out, ctx->buf, outlen);
         /* Step 4. Remember the leftover part of the squeezed block */
         ctx->bufsz = bsz - outlen;
@@ -239,12 +252,46 @@ int ossl_shake_squeeze_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t o
     return 1;
 }
 
+int ossl_shake_squeeze_default(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen)
+{
+    return shake_squeeze(ctx, out, outlen, SHA3_absorb, SHA3_squeeze);
+}
+
 static PROV_SHA3_METHOD shake_generic_meth = {
     ossl_sha3_absorb_default,
     ossl_sha3_final_default,
     ossl_shake_squeeze_default
 };
 
+#if defined(KECCAK1600_AVX512)
+/*-
+ * AVX-512F versions, the state stays in the caller's A[5][5] layout so a
+ * context can switch between these and the default methods at any time.
+ */
+size_t ossl_sha3_absorb_avx512(KECCAK1600_CTX *ctx, const unsigned char *inp, size_t len)
+{
+    return SHA3_absorb_avx512(ctx->A, inp, len, ctx->block_size);
+}
+
+int ossl_sha3_final_avx512(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen)
+{
+    return sha3_final(ctx, out, outlen, SHA3_absorb_avx512,
+        SHA3_squeeze_avx512);
+}
+
+int ossl_shake_squeeze_avx512(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen)
+{
+    return shake_squeeze(ctx, out, outlen, SHA3_absorb_avx512,
+        SHA3_squeeze_avx512);
+}
+
+static PROV_SHA3_METHOD shake_avx512_meth = {
+    ossl_sha3_absorb_avx512,
+    ossl_sha3_final_avx512,
+    ossl_shake_squeeze_avx512
+};
+#endif
+
 #if defined(S390_SHA3)
 
 /*-
@@ -332,23 +379,42 @@ static PROV_SHA3_METHOD shake_ARMSHA3_meth = {
 };
 #endif
 
-KECCAK1600_CTX *ossl_shake256_new(void)
+/*
+ * Initialise a caller supplied |ctx| for SHAKE-128 or SHAKE-256 (selected by
+ * |bitlen|), using the fastest absorb/squeeze methods for this platform.
+ */
+int ossl_shake_init(KECCAK1600_CTX *ctx, size_t bitlen)
 {
-    KECCAK1600_CTX *ctx = OPENSSL_zalloc(sizeof(*ctx));
-
-    if (ctx == NULL)
-        return NULL;
-    ossl_keccak_init(ctx, '\x1f', 256, 0);
+    if (bitlen != 128 && bitlen != 256)
+        return 0;
+    if (!ossl_keccak_init(ctx, '\x1f', bitlen, 0))
+        return 0;
     ctx->md_size = SIZE_MAX;
     ctx->meth = shake_generic_meth;
 #if defined(S390_SHA3)
-    if (S390_SHA3_CAPABLE(S390X_SHAKE_256)) {
+    if (bitlen == 128 && S390_SHA3_CAPABLE(S390X_SHAKE_128)) {
+        ctx->pad = S390X_SHAKE_128;
+        ctx->meth = shake_s390x_meth;
+    } else if (bitlen == 256 && S390_SHA3_CAPABLE(S390X_SHAKE_256)) {
         ctx->pad = S390X_SHAKE_256;
         ctx->meth = shake_s390x_meth;
     }
 #elif defined(__aarch64__) && defined(KECCAK1600_ASM)
     if (OPENSSL_armcap_P & ARMV8_HAVE_SHA3_AND_WORTH_USING)
         ctx->meth = shake_ARMSHA3_meth;
+#elif defined(KECCAK1600_AVX512)
+    if (SHA3_avx512_capable())
+        ctx->meth = shake_avx512_meth;
 #endif
+    return 1;
+}
+
+KECCAK1600_CTX *ossl_shake256_new(void)
+{
+    KECCAK1600_CTX *ctx = OPENSSL_zalloc(sizeof(*ctx));
+
+    if (ctx == NULL)
+        return NULL;
+    ossl_shake_init(ctx, 256);
     return ctx;
 }
@@ -210,4 +210,85 @@ void ossl_sha3_shake256_x4_avx512vl(
         in0, in1, in2, in3, inlen);
 }
 
+/*
+ * Digest helpers that run four messages through the state of a scalar
+ * context.  The x4 absorb and squeeze routines have the SHAKE128 and SHAKE256
+ * rates built in, so |ctx| must have one of those two block sizes.
+ */
+
+static void sha3_x4_load(KECCAK1600_X4_AVX512VL_CTX *x,
+    const KECCAK1600_CTX *ctx)
+{
+    const uint64_t *a = &ctx->A[0][0];
+    size_t j, k;
+
+    for (j = 0; j < 25; j++)
+        for (k = 0; k < 4; k++)
+            x->A[4 * j + k] = a[j];
+    x->A[100] = 0;
+    x->rate = ctx->block_size;
+    x->finalized = 0;
+}
+
+static void sha3_x4_absorb(KECCAK1600_X4_AVX512VL_CTX *x,
+    const unsigned char *const in[4], size_t inlen)
+{
+    if (x->rate == SHA3_BLOCKSIZE(128))
+        SHA3_shake128_x4_inc_absorb_avx512vl(x->A, in[0], in[1], in[2], in[3],
+            inlen);
+    else
+        SHA3_shake256_x4_inc_absorb_avx512vl(x->A, in[0], in[1], in[2], in[3],
+            inlen);
+}
+
+void ossl_sha3_x4_hash_avx512vl(const KECCAK1600_CTX *ctx,
+    const unsigned char *const in[4], size_t inlen,
+    unsigned char *const out[4], size_t outlen)
+{
+    KECCAK1600_X4_AVX512VL_CTX x;
+    size_t o, k;
+
+    sha3_x4_load(&x, ctx);
+    sha3_x4_absorb(&x, in, inlen);
+
+    /*
+     * Finalizing always pads with the SHAKE suffix, turn it into the one of
+     * |ctx| beforehand.
+     */
+    o = (size_t)x.A[100];
+    for (k = 0; k < 4; k++)
+        x.A[4 * (o / 8) + k] ^= (uint64_t)(ctx->pad ^ 0x1F) << (8 * (o % 8));
+
+    if (x.rate == SHA3_BLOCKSIZE(128)) {
+        SHA3_shake128_x4_inc_finalize_avx512vl(x.A);
+        SHA3_shake128_x4_inc_squeeze_avx512vl(out[0], out[1], out[2], out[3],
+            outlen, x.A);
+    } else {
+        SHA3_shake256_x4_inc_finalize_avx512vl(x.A);
+        SHA3_shake256_x4_inc_squeeze_avx512vl(out[0], out[1], out[2], out[3],
+            outlen, x.A);
+    }
+    OPENSSL_cleanse(&x, sizeof(x));
+}
+
+void ossl_sha3_x4_absorb_avx512vl(const KECCAK1600_CTX *ctx,
+    const unsigned char *const in[4], size_t len, KECCAK1600_CTX *lanes[4])
+{
+    KECCAK1600_X4_AVX512VL_CTX x;
+    uint64_t *a;
+    size_t j, k;
+
+    sha3_x4_load(&x, ctx);
+    sha3_x4_absorb(&x, in, len);
+    for (k = 0; k < 4; k++) {
+        *lanes[k] = *ctx;
+        a = &lanes[k]->A[0][0];
+        for (j = 0; j < 25; j++)
+            a[j] = x.A[4 * j + k];
+        lanes[k]->bufsz = 0;
+        lanes[k]->xof_state = XOF_STATE_ABSORB;
+    }
+    OPENSSL_cleanse(&x, sizeof(x));
+}
+
 #endif /* KECCAK1600_ASM && x86_64 && !OPENSSL_NO_ASM */
@@ -0,0 +1,422 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Batches of independent messages that all continue from the same SHA-1 or
+ * SHA-2 state.  On x86_64 the multi-buffer SHA-1 and SHA-256 kernels, and a
+ * four lane AVX2 SHA-512 compression function, hash several messages at
+ * once.  Anything else finishes each message on a copy of the state.
+ */
+
+/*
+ * SHA low level APIs are deprecated for public use, but still ok for
+ * internal use.
+ */
+#include "internal/deprecated.h"
+
+#include <string.h>
+#include <openssl/byteorder.h>
+#include <openssl/crypto.h>
+#include <openssl/sha.h>
+#include "internal/cryptlib.h"
+#include "crypto/sha.h"
+#include "crypto/md_mb.h"
+
+#if defined(SHA1_ASM) && defined(SHA256_ASM) && !defined(OPENSSL_NO_ASM) \
+    && (defined(__x86_64) || defined(_M_AMD64))
+#define SHA_MB_ASM
+/*
+ * The kernels pick their own code path: with the SHA extensions they
+ * interleave pairs of lanes, which still beats one block at a time.
+ */
+#define SHA_MB_LANES 8
+/* A single message is hashed faster on its own */
+#define SHA_MB_MIN_LANES 2
+
+#endif
+
+#if defined(SHA512_ASM) && !defined(OPENSSL_NO_ASM) \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64))
+#if !defined(_M_ARM64EC)
+#if defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define SHA512_MB_AVX2
+/* The AVX2 bit of CPUID leaf 7 */
+#define SHA512_MB_AVX2_CAPABLE ((OPENSSL_ia32cap_P[2] & (1u << 5)) != 0)
+#define SHA512_MB_LANES 4
+#define SHA512_MB_MIN_LANES 2
+#endif
+#endif /* !defined(_M_ARM64EC) */
+#endif
+
+#ifdef SHA_MB_ASM
+static void sha_mb_compress(int sha1, SHA256_MB_CTX *mctx,
+    const HASH_DESC *desc, size_t lanes)
+{
+    if (sha1)
+        sha1_multi_block((SHA1_MB_CTX *)mctx, desc, (int)(lanes + 3) / 4);
+    else
+        sha256_multi_block(mctx, desc, (int)(lanes + 3) / 4);
+}
+
+/*
+ * Hash |lanes| messages that continue from the |nh| word chaining value |h|
+ * after |bits| bits of earlier input, and write the first |mdlen| bytes of
+ * each result.  The messages with whole blocks take the first lanes, as the
+ * kernels stop at the first group of four lanes without blocks.  Returns 0,
+ * before doing anything, if a message is too long for the kernels.
+ */
+static int sha_mb_lanes(int sha1, const unsigned int *h, size_t nh,
+    uint64_t bits, const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[], size_t mdlen, size_t lanes)
+{
+    unsigned char storage[sizeof(SHA256_MB_CTX) + 32];
+    unsigned char tail[SHA_MB_LANES][2 * SHA256_CBLOCK];
+    HASH_DESC desc[SHA_MB_LANES];
+    size_t order[SHA_MB_LANES];
+    SHA256_MB_CTX *mctx;
+    unsigned int *w;
+    size_t i, j, k, a = 0;
+
+    for (i = 0; i < lanes; i++)
+        if (inl[i] / SHA256_CBLOCK > INT_MAX)
+            return 0;
+
+    mctx = (SHA256_MB_CTX *)(storage + 32 - ((size_t)storage % 32));
+    w = (unsigned int *)mctx;
+    for (k = 0; k < nh; k++)
+        for (j = 0; j < SHA_MB_LANES; j++)
+            w[8 * k + j] = h[k];
+
+    /* Idle lanes in a group of four still need an empty descriptor */
+    for (j = 0; j < SHA_MB_LANES; j++) {
+        desc[j].ptr = NULL;
+        desc[j].blocks = 0;
+    }
+    for (i = 0; i < lanes; i++)
+        if (inl[i] >= SHA256_CBLOCK)
+            order[a++] = i;
+    for (i = 0, j = a; i < lanes; i++)
+        if (inl[i] < SHA256_CBLOCK)
+            order[j++] = i;
+
+    if (a > 0) {
+        for (j = 0; j < a; j++) {
+            desc[j].ptr = in[order[j]];
+            desc[j].blocks = (int)(inl[order[j]] / SHA256_CBLOCK);
+        }
+        sha_mb_compress(sha1, mctx, desc, a);
+    }
+
+    for (j = 0; j < lanes; j++) {
+        i = order[j];
+        desc[j].ptr = tail[j];
+        desc[j].blocks = (int)ossl_md_mb_pad(tail[j], in[i], inl[i],
+            SHA256_CBLOCK, 8, 0, bits);
+    }
+    sha_mb_compress(sha1, mctx, desc, lanes);
+
+    for (j = 0; j < lanes; j++)
+        for (k = 0; k < mdlen / 4; k++)
+            OPENSSL_store_u32_be(out[order[j]] + 4 * k, w[8 * k + j]);
+
+    OPENSSL_cleanse(storage, sizeof(storage));
+    OPENSSL_cleanse(tail, sizeof(tail));
+    return 1;
+}
+
+static int sha1_mb_lanes(const void *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t lanes)
+{
+    const SHA_CTX *sc = c;
+    unsigned int h[5];
+
+    h[0] = sc->h0;
+    h[1] = sc->h1;
+    h[2] = sc->h2;
+    h[3] = sc->h3;
+    h[4] = sc->h4;
+    return sha_mb_lanes(1, h, 5, ((uint64_t)sc->Nh << 32) | sc->Nl, in, inl,
+        out, SHA_DIGEST_LENGTH, lanes);
+}
+
+static int sha256_mb_lanes(const void *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t lanes)
+{
+    const SHA256_CTX *sc = c;
+
+    return sha_mb_lanes(0, sc->h, 8, ((uint64_t)sc->Nh << 32) | sc->Nl, in,
+        inl, out, sc->md_len, lanes);
+}
+#endif
+
+int ossl_sha1_batch(const SHA_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n)
+{
+    SHA_CTX t;
+    size_t i = 0;
+    int ret = 1;
+
+#ifdef SHA_MB_ASM
+    if (c->num == 0)
+        i = ossl_md_mb_batch(c, in, inl, out, n, SHA_MB_LANES,
+            SHA_MB_MIN_LANES, sha1_mb_lanes);
+#endif
+    for (; ret && i < n; i++) {
+        t = *c;
+        ret = SHA1_Update(&t, in[i], inl[i]) && SHA1_Final(out[i], &t);
+    }
+    OPENSSL_cleanse(&t, sizeof(t));
+    return ret;
+}
+
+int ossl_sha256_batch(const SHA256_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n)
+{
+    SHA256_CTX t;
+    size_t i = 0;
+    int ret = 1;
+
+#ifdef SHA_MB_ASM
+    if (c->num == 0)
+        i = ossl_md_mb_batch(c, in, inl, out, n, SHA_MB_LANES,
+            SHA_MB_MIN_LANES, sha256_mb_lanes);
+#endif
+    for (; ret && i < n; i++) {
+        t = *c;
+        ret = SHA256_Update(&t, in[i], inl[i]) && SHA256_Final(out[i], &t);
+    }
+    OPENSSL_cleanse(&t, sizeof(t));
+    return ret;
+}
+
+#ifdef SHA512_MB_AVX2
+
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+static const uint64_t K512_mb[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+    0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+    0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+    0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+    0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+    0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+    0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+    0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+    0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+    0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+    0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+    0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+    0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+    0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+OPENSSL_TARGET_REGION("avx2")
+
+#define ADD(a, b) _mm256_add_epi64((a), (b))
+#define XOR(a, b) _mm256_xor_si256((a), (b))
+#define ROTR(x, n) \
+    _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+#define SIGMA0(x) XOR(XOR(ROTR((x), 28), ROTR((x), 34)), ROTR((x), 39))
+#define SIGMA1(x) XOR(XOR(ROTR((x), 14), ROTR((x), 18)), ROTR((x), 41))
+#define sigma0(x) XOR(XOR(ROTR((x), 1), ROTR((x), 8)), _mm256_srli_epi64((x), 7))
+#define sigma1(x) XOR(XOR(ROTR((x), 19), ROTR((x), 61)), _mm256_srli_epi64((x), 6))
+#define CH(x, y, z) XOR(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define MAJ(x, y, z)                           \
+    _mm256_or_si256(_mm256_and_si256((x), (y)), \
+        _mm256_and_si256((z), _mm256_or_si256((x), (y))))
+
+#define ROUND(a, b, c, d, e, f, g, h, i)                                   \
+    do {                                                                   \
+        __m256i T1, T2;                                                    \
+                                                                           \
+        if ((i) >= 16)                                                     \
+            X[(i) & 15] = ADD(ADD(X[(i) & 15], sigma0(X[((i) + 1) & 15])), \
+                ADD(X[((i) + 9) & 15], sigma1(X[((i) + 14) & 15])));       \
+        T1 = ADD(ADD(h, SIGMA1(e)), ADD(CH(e, f, g), X[(i) & 15]));        \
+        T1 = ADD(T1, _mm256_set1_epi64x((long long)K512_mb[i]));           \
+        T2 = ADD(SIGMA0(a), MAJ(a, b, c));                                 \
+        d = ADD(d, T1);                                                    \
+        h = ADD(T1, T2);                                                   \
+    } while ((void)0, 0)
+
+/*
+ * Compress blocks[l] blocks from ptr[l] into lane l of |st|, which holds
+ * word j of the state of lane l in st[j][l].  The lanes that have run out of
+ * blocks are kept as they are.
+ */
+static void sha512_mb_avx2(uint64_t st[8][SHA512_MB_LANES],
+    const unsigned char *const ptr[SHA512_MB_LANES],
+    const size_t blocks[SHA512_MB_LANES])
+{
+    static const unsigned char zero[SHA512_CBLOCK] = { 0 };
+    const __m256i bswap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+        15, 14, 13, 12, 11, 10, 9, 8);
+    const unsigned char *p[SHA512_MB_LANES];
+    __m256i H[8], X[16], a, b, c, d, e, f, g, h, mask;
+    size_t blk, maxblk = 0, l, t;
+
+    for (l = 0; l < SHA512_MB_LANES; l++)
+        if (blocks[l] > maxblk)
+            maxblk = blocks[l];
+    for (t = 0; t < 8; t++)
+        H[t] = _mm256_loadu_si256((const __m256i *)st[t]);
+
+    for (blk = 0; blk < maxblk; blk++) {
+        for (l = 0; l < SHA512_MB_LANES; l++)
+            p[l] = blk < blocks[l] ? ptr[l] + blk * SHA512_CBLOCK : zero;
+        mask = _mm256_set_epi64x(blk < blocks[3] ? -1 : 0,
+            blk < blocks[2] ? -1 : 0, blk < blocks[1] ? -1 : 0,
+            blk < blocks[0] ? -1 : 0);
+
+        /* Transpose four words of each lane at a time */
+        for (t = 0; t < 16; t += 4) {
+            __m256i r0 = _mm256_loadu_si256((const __m256i *)(p[0] + 8 * t));
+            __m256i r1 = _mm256_loadu_si256((const __m256i *)(p[1] + 8 * t));
+            __m256i r2 = _mm256_loadu_si256((const __m256i *)(p[2] + 8 * t));
+            __m256i r3 = _mm256_loadu_si256((const __m256i *)(p[3] + 8 * t));
+            __m256i u0 = _mm256_unpacklo_epi64(r0, r1);
+            __m256i u1 = _mm256_unpackhi_epi64(r0, r1);
+            __m256i u2 = _mm256_unpacklo_epi64(r2, r3);
+            __m256i u3 = _mm256_unpackhi_epi64(r2, r3);
+
+            X[t] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u2, 0x20),
+                bswap);
+            X[t + 1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u3,
+                                               0x20),
+                bswap);
+            X[t + 2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u2,
+                                               0x31),
+                bswap);
+            X[t + 3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u3,
+                                               0x31),
+                bswap);
+        }
+
+        a = H[0];
+        b = H[1];
+        c = H[2];
+        d = H[3];
+        e = H[4];
+        f = H[5];
+        g = H[6];
+        h = H[7];
+        for (t = 0; t < 80; t += 8) {
+            ROUND(a, b, c, d, e, f, g, h, t);
+            ROUND(h, a, b, c, d, e, f, g, t + 1);
+            ROUND(g, h, a, b, c, d, e, f, t + 2);
+            ROUND(f, g, h, a, b, c, d, e, t + 3);
+            ROUND(e, f, g, h, a, b, c, d, t + 4);
+            ROUND(d, e, f, g, h, a, b, c, t + 5);
+            ROUND(c, d, e, f, g, h, a, b, t + 6);
+            ROUND(b, c, d, e, f, g, h, a, t + 7);
+        }
+        H[0] = _mm256_blendv_epi8(H[0], ADD(H[0], a), mask);
+        H[1] = _mm256_blendv_epi8(H[1], ADD(H[1], b), mask);
+        H[2] = _mm256_blendv_epi8(H[2], ADD(H[2], c), mask);
+        H[3] = _mm256_blendv_epi8(H[3], ADD(H[3], d), mask);
+        H[4] = _mm256_blendv_epi8(H[4], ADD(H[4], e), mask);
+        H[5] = _mm256_blendv_epi8(H[5], ADD(H[5], f), mask);
+        H[6] = _mm256_blendv_epi8(H[6], ADD(H[6], g), mask);
+        H[7] = _mm256_blendv_epi8(H[7], ADD(H[7], h), mask);
+    }
+
+    for (t = 0; t < 8; t++)
+        _mm256_storeu_si256((__m256i *)st[t], H[t]);
+    for (t = 0; t < 16; t++)
+        X[t] = _mm256_setzero_si256();
+}
+
+#undef ADD
+#undef XOR
+#undef ROTR
+#undef SIGMA0
+#undef SIGMA1
+#undef sigma0
+#undef sigma1
+#undef CH
+#undef MAJ
+#undef ROUND
+
+OPENSSL_UNTARGET_REGION
+
+/* As sha_mb_lanes(), for up to four messages */
+static int sha512_mb_lanes(const void *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t lanes)
+{
+    const SHA512_CTX *sc = c;
+    uint64_t st[8][SHA512_MB_LANES];
+    unsigned char tail[SHA512_MB_LANES][2 * SHA512_CBLOCK];
+    unsigned char md[SHA512_DIGEST_LENGTH];
+    const unsigned char *p[SHA512_MB_LANES];
+    size_t nblk[SHA512_MB_LANES], j, l;
+
+    for (j = 0; j < 8; j++)
+        for (l = 0; l < SHA512_MB_LANES; l++)
+            st[j][l] = sc->h[j];
+
+    for (l = 0; l < SHA512_MB_LANES; l++) {
+        p[l] = l < lanes ? in[l] : NULL;
+        nblk[l] = l < lanes ? inl[l] / SHA512_CBLOCK : 0;
+    }
+    sha512_mb_avx2(st, p, nblk);
+
+    for (l = 0; l < lanes; l++) {
+        nblk[l] = ossl_md_mb_pad(tail[l], in[l], inl[l], SHA512_CBLOCK, 16,
+            sc->Nh, sc->Nl);
+        p[l] = tail[l];
+    }
+    sha512_mb_avx2(st, p, nblk);
+
+    for (l = 0; l < lanes; l++) {
+        for (j = 0; j < 8; j++)
+            OPENSSL_store_u64_be(md + 8 * j, st[j][l]);
+        memcpy(out[l], md, sc->md_len);
+    }
+
+    OPENSSL_cleanse(st, sizeof(st));
+    OPENSSL_cleanse(tail, sizeof(tail));
+    OPENSSL_cleanse(md, sizeof(md));
+    return 1;
+}
+#endif /* SHA512_MB_AVX2 */
+
+int ossl_sha512_batch(const SHA512_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n)
+{
+    SHA512_CTX t;
+    size_t i = 0;
+    int ret = 1;
+
+#ifdef SHA512_MB_AVX2
+    if (c->num == 0 && SHA512_MB_AVX2_CAPABLE)
+        i = ossl_md_mb_batch(c, in, inl, out, n, SHA512_MB_LANES,
+            SHA512_MB_MIN_LANES, sha512_mb_lanes);
+#endif
+    for (; ret && i < n; i++) {
+        t = *c;
+        ret = SHA512_Update(&t, in[i], inl[i]) && SHA512_Final(out[i], &t);
+    }
+    OPENSSL_cleanse(&t, sizeof(t));
+    return ret;
+}
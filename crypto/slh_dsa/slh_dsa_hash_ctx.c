@@ -13,6 +13,14 @@
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 #include "crypto/evp.h"
+#include "internal/thread.h"
+
+/* The maximum number of threads used by ossl_slh_run_jobs() */
+#define SLH_MAX_THREADS 32
+
+#if defined(OPENSSL_THREADS) && !defined(OPENSSL_NO_THREAD_POOL)
+#define SLH_USE_THREADS
+#endif
 
 /**
  * @brief Create a SLH_DSA_HASH_CTX that contains parameters, functions, and
@@ -33,6 +41,7 @@ SLH_DSA_HASH_CTX *ossl_slh_dsa_hash_ctx_new(const SLH_DSA_KEY *key)
         return NULL;
 
     ret->key = key;
+    ret->threads = 1;
     if (key->pub != NULL
         && !ossl_slh_dsa_hash_ctx_prehash_pk_seed(ret, SLH_DSA_PK_SEED(key), key->params->n))
         goto err;
@@ -62,6 +71,7 @@ SLH_DSA_HASH_CTX *ossl_slh_dsa_hash_ctx_dup(const SLH_DSA_HASH_CTX *src)
         return NULL;
 
     ret->hmac_digest_used = src->hmac_digest_used;
+    ret->threads = src->threads;
     /* Note that the key is not ref counted, since it does not own the key */
     ret->key = src->key;
 
@@ -103,3 +113,114 @@ void ossl_slh_dsa_hash_ctx_free(SLH_DSA_HASH_CTX *ctx)
     EVP_MAC_CTX_free(ctx->hmac_ctx);
     OPENSSL_free(ctx);
 }
+
+/**
+ * @brief Set the maximum number of threads to use for signing.
+ *
+ * The threads are taken from the thread pool of the key's library context,
+ * a value of 0 or 1 disables multi-threaded signing.
+ *
+ * @param ctx The SLH_DSA_HASH_CTX object.
+ * @param threads The maximum number of threads.
+ */
+void ossl_slh_dsa_hash_ctx_set_threads(SLH_DSA_HASH_CTX *ctx, uint32_t threads)
+{
+    ctx->threads = threads == 0 ? 1 : threads;
+}
+
+typedef struct {
+    SLH_DSA_HASH_CTX *ctx;
+    OSSL_SLH_JOB_FN *fn;
+    void *arg;
+    uint32_t first, step, num_jobs;
+    int ret;
+} SLH_JOB_GROUP;
+
+/* Runs every |step|'th job starting at |first| */
+static uint32_t slh_run_job_group(void *data)
+{
+    SLH_JOB_GROUP *grp = (SLH_JOB_GROUP *)data;
+    uint32_t i;
+
+    grp->ret = 1;
+    for (i = grp->first; i < grp->num_jobs; i += grp->step) {
+        if (!grp->fn(grp->ctx, grp->arg, i)) {
+            grp->ret = 0;
+            break;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Run the independent jobs 0..|num_jobs|-1 of |fn|, using up to
+ * ctx->threads threads from the library context thread pool.
+ *
+ * The calling thread always runs its share of the jobs. Any share that cannot
+ * be started on a pool thread (e.g. because no thread pool is configured) is
+ * also run by the calling thread, so the result does not depend on thread
+ * availability.
+ *
+ * @returns 1 if all jobs succeeded, or 0 otherwise.
+ */
+int ossl_slh_run_jobs(SLH_DSA_HASH_CTX *ctx, uint32_t num_jobs,
+    OSSL_SLH_JOB_FN *fn, void *arg)
+{
+    SLH_JOB_GROUP grp[SLH_MAX_THREADS];
+    void *thread[SLH_MAX_THREADS];
+#if defined(SLH_USE_THREADS)
+    uint64_t avail;
+#endif
+    uint32_t i, nthreads = ctx->threads;
+    int ret;
+
+    if (num_jobs == 0)
+        return 1;
+    if (nthreads > num_jobs)
+        nthreads = num_jobs;
+    if (nthreads > SLH_MAX_THREADS)
+        nthreads = SLH_MAX_THREADS;
+#if defined(SLH_USE_THREADS)
+    if (nthreads > 1) {
+        /* Don't block waiting for pool threads, the caller is also a worker */
+        avail = ossl_get_avail_threads(ctx->key->libctx);
+        if (avail < nthreads - 1)
+            nthreads = (uint32_t)avail + 1;
+    }
+#else
+    nthreads = 1;
+#endif
+
+    for (i = 0; i < nthreads; ++i) {
+        grp[i].ctx = ctx;
+        grp[i].fn = fn;
+        grp[i].arg = arg;
+        grp[i].first = i;
+        grp[i].step = nthreads;
+        grp[i].num_jobs = num_jobs;
+        grp[i].ret = 0;
+        thread[i] = NULL;
+    }
+
+#if defined(SLH_USE_THREADS)
+    for (i = 1; i < nthreads; ++i)
+        thread[i] = ossl_crypto_thread_start(ctx->key->libctx,
+            &slh_run_job_group, &grp[i]);
+#endif
+    slh_run_job_group(&grp[0]);
+    ret = grp[0].ret;
+
+    for (i = 1; i < nthreads; ++i) {
+        if (thread[i] == NULL) {
+            slh_run_job_group(&grp[i]);
+        } else {
+#if defined(SLH_USE_THREADS)
+            if (!ossl_crypto_thread_join(thread[i], NULL))
+                grp[i].ret = 0;
+            ossl_crypto_thread_clean(thread[i]);
+#endif
+        }
+        ret &= grp[i].ret;
+    }
+    return ret;
+}
@@ -54,8 +54,19 @@ struct slh_dsa_hash_ctx_st {
     void *shactx_pkseed; /* A low level SHAKE or SHA256 object with PK.seed hashed in it */
     EVP_MAC_CTX *hmac_ctx; /* required by SHA algorithms for PRFmsg() */
     int hmac_digest_used; /* Used for lazy init of hmac_ctx digest */
+    uint32_t threads; /* Maximum number of threads to use when signing */
 };
 
+/*
+ * A unit of work that can be run on a separate thread by ossl_slh_run_jobs().
+ * Jobs share |ctx| and must only use the hash functions that treat it as
+ * read only (i.e. PRF, F, H, T and wots_pk_gen).
+ */
+typedef int(OSSL_SLH_JOB_FN)(SLH_DSA_HASH_CTX *ctx, void *arg, uint32_t job);
+
+__owur int ossl_slh_run_jobs(SLH_DSA_HASH_CTX *ctx, uint32_t num_jobs,
+    OSSL_SLH_JOB_FN *fn, void *arg);
+
 __owur int ossl_slh_wots_pk_gen(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     const uint8_t *pk_seed, uint8_t *adrs,
     uint8_t *pk_out, size_t pk_out_len);
@@ -71,10 +82,14 @@ __owur int ossl_slh_xmss_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     const uint8_t *pk_seed, uint8_t *adrs,
     uint8_t *pk_out, size_t pk_out_len);
 
+__owur int ossl_slh_xmss_auth_path(SLH_DSA_HASH_CTX *ctx,
+    const uint8_t *sk_seed, uint32_t node_id,
+    const uint8_t *pk_seed, uint8_t *adrs,
+    uint8_t *auth_path);
 __owur int ossl_slh_xmss_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
     const uint8_t *sk_seed, uint32_t node_id,
     const uint8_t *pk_seed, uint8_t *adrs,
-    WPACKET *sig_wpkt);
+    const uint8_t *auth_path, WPACKET *sig_wpkt);
 __owur int ossl_slh_xmss_pk_from_sig(SLH_DSA_HASH_CTX *ctx, uint32_t node_id,
     PACKET *sig_rpkt, const uint8_t *msg,
     const uint8_t *pk_seed, uint8_t *adrs,
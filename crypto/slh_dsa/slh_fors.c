@@ -20,6 +20,10 @@
 #define SLH_MAX_K_TIMES_A (SLH_MAX_A * SLH_MAX_K)
 #define SLH_MAX_ROOTS (SLH_MAX_K_TIMES_A * SLH_MAX_N)
 
+/* The height of the subtrees whose leaves are computed together by F_x() */
+#define SLH_FORS_X_HEIGHT 3
+#define SLH_FORS_X_LEAVES (1 << SLH_FORS_X_HEIGHT)
+
 static void slh_base_2b(const uint8_t *in, uint32_t b, uint32_t *out, size_t out_len);
 
 /**
@@ -53,6 +57,70 @@ static int slh_fors_sk_gen(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     return key->hash_func->PRF(ctx, pk_seed, sk_seed, sk_adrs, pk_out, pk_out_len);
 }
 
+/*
+ * slh_fors_node() for a |height| <= SLH_FORS_X_HEIGHT with F_x(): the PRF
+ * and F values of all the leaves below the node are computed together and
+ * then hashed up a level at a time.  |node| has room for n bytes.
+ */
+static int slh_fors_node_x(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
+    const uint8_t *pk_seed, uint8_t *adrs, uint32_t node_id,
+    uint32_t height, uint8_t *node)
+{
+    int ret = 0;
+    const SLH_DSA_KEY *key = ctx->key;
+    uint32_t n = key->params->n;
+    uint32_t count = 1 << height, first = node_id << height, i, h;
+    uint8_t leaf_adrs[SLH_FORS_X_LEAVES][SLH_ADRS_SIZE_MAX];
+    uint8_t nodes[SLH_FORS_X_LEAVES * SLH_MAX_N];
+    const uint8_t *la[SLH_FORS_X_LEAVES], *m[SLH_FORS_X_LEAVES];
+    uint8_t *o[SLH_FORS_X_LEAVES];
+
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+
+    /* The secret values, as in slh_fors_sk_gen() */
+    for (i = 0; i < count; ++i) {
+        adrsf->copy(leaf_adrs[i], adrs);
+        adrsf->set_type_and_clear(leaf_adrs[i], SLH_ADRS_TYPE_FORS_PRF);
+        adrsf->copy_keypair_address(leaf_adrs[i], adrs);
+        adrsf->set_tree_index(leaf_adrs[i], first + i);
+        la[i] = leaf_adrs[i];
+        m[i] = sk_seed;
+        o[i] = nodes + i * n;
+    }
+    if (!ossl_slh_f_many(ctx, pk_seed, la, m, o, count))
+        goto err;
+
+    for (i = 0; i < count; ++i) {
+        adrsf->copy(leaf_adrs[i], adrs);
+        adrsf->set_tree_height(leaf_adrs[i], 0);
+        adrsf->set_tree_index(leaf_adrs[i], first + i);
+        m[i] = o[i];
+    }
+    if (!ossl_slh_f_many(ctx, pk_seed, la, m, o, count))
+        goto err;
+
+    for (h = 1; h <= height; ++h) {
+        count >>= 1;
+        first >>= 1;
+        adrsf->set_tree_height(adrs, h);
+        for (i = 0; i < count; ++i) {
+            adrsf->set_tree_index(adrs, first + i);
+            if (!key->hash_func->H(ctx, pk_seed, adrs, nodes + 2 * i * n,
+                    nodes + (2 * i + 1) * n, nodes + i * n, n))
+                goto err;
+        }
+    }
+    if (height == 0) {
+        adrsf->set_tree_height(adrs, 0);
+        adrsf->set_tree_index(adrs, node_id);
+    }
+    memcpy(node, nodes, n);
+    ret = 1;
+err:
+    OPENSSL_cleanse(nodes, sizeof(nodes));
+    return ret;
+}
+
 /**
  * @brief Computes the nodes of a Merkle tree.
  * See FIPS 205 Section 8.2 Algorithm 18
@@ -85,6 +153,10 @@ static int slh_fors_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
 
     SLH_ADRS_FUNC_DECLARE(key, adrsf);
 
+    if (key->hash_func->F_x != NULL && height <= SLH_FORS_X_HEIGHT)
+        return slh_fors_node_x(ctx, sk_seed, pk_seed, adrs, node_id, height,
+            node);
+
     if (height == 0) {
         /* Gets here for leaf nodes */
         if (!slh_fors_sk_gen(ctx, sk_seed, pk_seed, adrs, node_id, sk, sizeof(sk)))
@@ -108,6 +180,66 @@ static int slh_fors_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     return 1;
 }
 
+/* The FORS signature being generated by ossl_slh_fors_sign() */
+typedef struct {
+    const uint8_t *sk_seed;
+    const uint8_t *pk_seed;
+    const uint8_t *adrs;
+    uint32_t ids[SLH_MAX_K];
+    uint8_t *sig;
+} SLH_FORS_SIGN_JOBS;
+
+/*
+ * An ossl_slh_run_jobs() job that generates the FORS private key value and
+ * authentication path of size (1 + a) * n for the FORS tree |tree_id|.
+ */
+static int slh_fors_sign_tree_job(SLH_DSA_HASH_CTX *ctx, void *arg,
+    uint32_t tree_id)
+{
+    SLH_FORS_SIGN_JOBS *jobs = (SLH_FORS_SIGN_JOBS *)arg;
+    const SLH_DSA_KEY *key = ctx->key;
+    const SLH_DSA_PARAMS *params = key->params;
+    uint32_t n = params->n;
+    uint32_t a = params->a;
+    uint32_t layer, s;
+    uint32_t node_id = jobs->ids[tree_id]; /* |id| = |a| bits */
+    /*
+     * Give each of the k trees a unique range at each level.
+     * e.g. If we have 4096 leaf nodes (2^a = 2^12) for each tree
+     * i will use indexes from 4096 * i + (0..4095) for its bottom level.
+     * For the next level up from the bottom there would be 2048 nodes
+     * (so tree i uses indexes 2048 * i + (0...2047) for this level)
+     */
+    uint32_t tree_offset = tree_id << a;
+    uint8_t *out = jobs->sig + (size_t)tree_id * (1 + a) * n;
+
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+    SLH_ADRS_DECLARE(adrs);
+
+    adrsf->copy(adrs, jobs->adrs);
+    if (!slh_fors_sk_gen(ctx, jobs->sk_seed, jobs->pk_seed, adrs,
+            node_id + tree_offset, out, n))
+        return 0;
+
+    /*
+     * Traverse from the bottom of the tree (layer = 0)
+     * up to the root (layer = a - 1).
+     * NOTE: This is a really inefficient way of doing this, since at
+     * layer a - 1 it calculates most of the hashes of the entire tree as
+     * well as all the leaf nodes. So it is calculating nodes multiple times.
+     */
+    for (layer = 0; layer < a; ++layer) {
+        out += n;
+        s = node_id ^ 1; /* XOR gets the index of the other child in a binary tree */
+        if (!slh_fors_node(ctx, jobs->sk_seed, jobs->pk_seed, adrs,
+                s + tree_offset, layer, out, n))
+            return 0;
+        node_id >>= 1; /* Get the parent node id */
+        tree_offset >>= 1; /* Each layer up has half as many nodes */
+    }
+    return 1;
+}
+
 /**
  * @brief Generate an FORS signature
  * See FIPS 205 Section 8.3 Algorithm 16
@@ -115,6 +247,8 @@ static int slh_fors_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
  * A FORS signature has a size of (k * (1 + a) * n) bytes
  * There are k trees, each of which have a private key value of size |n| followed
  * by an authentication path of size |a| (where each path is size |n|)
+ * The trees are independent, so they may be computed on multiple threads
+ * if ctx->threads allows.
  *
  * @param ctx Contains SLH_DSA algorithm functions and constants.
  * @param md A message digest of size |(k * a + 7) / 8| bytes to sign
@@ -132,61 +266,22 @@ int ossl_slh_fors_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *md,
     const uint8_t *sk_seed, const uint8_t *pk_seed,
     uint8_t *adrs, WPACKET *sig_wpkt)
 {
-    const SLH_DSA_KEY *key = ctx->key;
-    uint32_t tree_id, layer, s, tree_offset;
-    uint32_t ids[SLH_MAX_K];
-    const SLH_DSA_PARAMS *params = key->params;
-    uint32_t n = params->n;
+    const SLH_DSA_PARAMS *params = ctx->key->params;
     uint32_t k = params->k; /* number of trees */
-    uint32_t a = params->a;
-    uint32_t two_power_a = (1 << a); /* this is t in FIPS 205 */
-    uint32_t tree_id_times_two_power_a = 0;
-    uint8_t out[SLH_MAX_N];
+    SLH_FORS_SIGN_JOBS jobs;
 
     /*
      * Split md into k a-bit values e.g with k = 14, a = 12
      * ids[0..13] = 12 bits each of md
      */
-    slh_base_2b(md, a, ids, k);
+    slh_base_2b(md, params->a, jobs.ids, k);
 
-    for (tree_id = 0; tree_id < k; ++tree_id) {
-        /* Get the tree[i] leaf id */
-        uint32_t node_id = ids[tree_id]; /* |id| = |a| bits */
-
-        /*
-         * Give each of the k trees a unique range at each level.
-         * e.g. If we have 4096 leaf nodes (2^a = 2^12) for each tree
-         * i will use indexes from 4096 * i + (0..4095) for its bottom level.
-         * For the next level up from the bottom there would be 2048 nodes
-         * (so tree i uses indexes 2048 * i + (0...2047) for this level)
-         */
-        tree_offset = tree_id_times_two_power_a;
-
-        if (!slh_fors_sk_gen(ctx, sk_seed, pk_seed, adrs,
-                node_id + tree_id_times_two_power_a, out, sizeof(out))
-            || !WPACKET_memcpy(sig_wpkt, out, n))
-            return 0;
-
-        /*
-         * Traverse from the bottom of the tree (layer = 0)
-         * up to the root (layer = a - 1).
-         * NOTE: This is a really inefficient way of doing this, since at
-         * layer a - 1 it calculates most of the hashes of the entire tree as
-         * well as all the leaf nodes. So it is calculating nodes multiple times.
-         */
-        for (layer = 0; layer < a; ++layer) {
-            s = node_id ^ 1; /* XOR gets the index of the other child in a binary tree */
-            if (!slh_fors_node(ctx, sk_seed, pk_seed, adrs,
-                    s + tree_offset, layer, out, sizeof(out)))
-                return 0;
-            node_id >>= 1; /* Get the parent node id */
-            tree_offset >>= 1; /* Each layer up has half as many nodes */
-            if (!WPACKET_memcpy(sig_wpkt, out, n))
-                return 0;
-        }
-        tree_id_times_two_power_a += two_power_a;
-    }
-    return 1;
+    jobs.sk_seed = sk_seed;
+    jobs.pk_seed = pk_seed;
+    jobs.adrs = adrs;
+    return WPACKET_allocate_bytes(sig_wpkt, (size_t)k * (1 + params->a) * params->n,
+               &jobs.sig)
+        && ossl_slh_run_jobs(ctx, k, slh_fors_sign_tree_job, &jobs);
 }
 
 /**
@@ -220,18 +315,20 @@ int ossl_slh_fors_pk_from_sig(SLH_DSA_HASH_CTX *ctx, PACKET *fors_sig_rpkt,
     uint32_t k = params->k;
     uint32_t n = params->n;
     uint32_t two_power_a = (1 << a);
-    const uint8_t *sk, *authj; /* Pointers to |sig| buffer inside fors_sig_rpkt */
+    /* Pointers to the |sig| buffer inside fors_sig_rpkt */
+    const uint8_t *sk[SLH_MAX_K], *auth[SLH_MAX_K], *authj;
     uint8_t roots[SLH_MAX_ROOTS];
     size_t roots_len = 0; /* The size of |roots| */
-    uint8_t *node0, *node1; /* Pointers into roots[] */
+    uint8_t *node0[SLH_MAX_K], *node1; /* Pointers into roots[] */
     WPACKET root_pkt, *wroot_pkt = &root_pkt; /* Points to |roots| buffer */
+    uint8_t leaf_adrs[SLH_MAX_K][SLH_ADRS_SIZE_MAX];
+    const uint8_t *la[SLH_MAX_K];
 
     SLH_ADRS_DECLARE(pk_adrs);
     SLH_ADRS_FUNC_DECLARE(key, adrsf);
     SLH_ADRS_FN_DECLARE(adrsf, set_tree_index);
     SLH_ADRS_FN_DECLARE(adrsf, set_tree_height);
     SLH_HASH_FUNC_DECLARE(key, hashf);
-    SLH_HASH_FN_DECLARE(hashf, F);
     SLH_HASH_FN_DECLARE(hashf, H);
 
     if (!WPACKET_init_static_len(wroot_pkt, roots, sizeof(roots), 0))
@@ -240,37 +337,40 @@ int ossl_slh_fors_pk_from_sig(SLH_DSA_HASH_CTX *ctx, PACKET *fors_sig_rpkt,
     /* Split md into k a-bit values e.g ids[0..k-1] = 12 bits each of md */
     slh_base_2b(md, a, ids, k);
 
+    /* Regenerate the public keys of the k leaves together */
+    for (i = 0; i < k; ++i) {
+        adrsf->copy(leaf_adrs[i], adrs);
+        set_tree_height(leaf_adrs[i], 0);
+        set_tree_index(leaf_adrs[i], ids[i] + i * two_power_a);
+        la[i] = leaf_adrs[i];
+        if (!PACKET_get_bytes(fors_sig_rpkt, &sk[i], n)
+            || !PACKET_get_bytes(fors_sig_rpkt, &auth[i], (size_t)a * n)
+            || !WPACKET_allocate_bytes(wroot_pkt, n, &node0[i]))
+            goto err;
+    }
+    if (!ossl_slh_f_many(ctx, pk_seed, la, sk, node0, k))
+        goto err;
+
     /* Compute the roots of k Merkle trees */
     for (i = 0; i < k; ++i) {
         uint32_t id = ids[i];
         uint32_t node_id = id + aoff;
 
-        set_tree_height(adrs, 0);
-        set_tree_index(adrs, node_id);
-
-        /* Regenerate the public key of the leaf */
-        if (!PACKET_get_bytes(fors_sig_rpkt, &sk, n)
-            || !WPACKET_allocate_bytes(wroot_pkt, n, &node0)
-            || !F(ctx, pk_seed, adrs, sk, n, node0, n))
-            goto err;
-
         /* This omits the copying of the nodes that the FIPS 205 code does */
-        node1 = node0;
-        for (j = 0; j < a; ++j) {
-            /* Get this layers other child public key */
-            if (!PACKET_get_bytes(fors_sig_rpkt, &authj, n))
-                goto err;
+        node1 = node0[i];
+        authj = auth[i];
+        for (j = 0; j < a; ++j, authj += n) {
             /* Hash the children together to get the parent nodes public key */
             set_tree_height(adrs, j + 1);
             if ((id & 1) == 0) {
                 node_id >>= 1;
                 set_tree_index(adrs, node_id);
-                if (!H(ctx, pk_seed, adrs, node0, authj, node1, n))
+                if (!H(ctx, pk_seed, adrs, node1, authj, node1, n))
                     goto err;
             } else {
                 node_id = (node_id - 1) >> 1;
                 set_tree_index(adrs, node_id);
-                if (!H(ctx, pk_seed, adrs, authj, node0, node1, n))
+                if (!H(ctx, pk_seed, adrs, authj, node1, node1, n))
                     goto err;
             }
             id >>= 1;
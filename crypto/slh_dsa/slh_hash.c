@@ -10,6 +10,7 @@
 #include "internal/deprecated.h" /* PKCS1_MGF1() */
 
 #include <string.h>
+#include <openssl/byteorder.h>
 #include <openssl/evp.h>
 #include <openssl/core_names.h>
 #include <openssl/rsa.h> /* PKCS1_MGF1() */
@@ -20,6 +21,7 @@
 #include "internal/sha3.h"
 #include "crypto/evp.h"
 #include "crypto/sha.h"
+#include "internal/nelem.h"
 
 #define MAX_DIGEST_SIZE 64 /* SHA-512 is used for security category 3 & 5 */
 #define NIBBLE_MASK 15
@@ -54,6 +56,31 @@ static OSSL_SLH_HASHFUNC_T slh_t_sha512;
 static OSSL_SLH_HASHFUNC_wots_pk_gen slh_wots_pk_gen_sha2;
 static OSSL_SLH_HASHFUNC_wots_pk_gen slh_wots_pk_gen_shake;
 
+/*
+ * With the AVX-512VL multi-buffer Keccak, F can be computed for 4 independent
+ * inputs at a time.
+ */
+#if defined(KECCAK1600_ASM)                                                               \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)
+#define SLH_SHAKE_X4
+#define SLH_SHAKE_X4_LANES 4
+static OSSL_SLH_HASHFUNC_F_x slh_f_shake_x4;
+#endif
+
+/*
+ * F and PRF use SHA-256 in all the SHA2 parameter sets, and take a single
+ * block after the precomputed PK.seed block, which the multi-buffer SHA-256
+ * code does for 8 inputs at a time.
+ */
+#if defined(SHA256_ASM)                                                                   \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)
+#define SLH_SHA2_X8
+#define SLH_SHA2_X8_LANES 8
+static OSSL_SLH_HASHFUNC_F_x slh_f_sha256_x8;
+#endif
+
 static const uint8_t zeros[128] = { 0 };
 
 /* See FIPS 205 Section 11.1 */
@@ -333,6 +360,36 @@ int slh_wots_pk_gen_shake(SLH_DSA_HASH_CTX *hctx,
     return ret;
 }
 
+#if defined(SLH_SHAKE_X4)
+/*
+ * F with the AVX-512VL 4-way SHAKE256.  Each PK.seed || ADRS || M input fits
+ * into a single SHAKE256 block, so there is no gain in starting from the
+ * absorbed |pk_seed| state.  Unused lanes repeat the first input.
+ */
+static int slh_f_shake_x4(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed,
+    const uint8_t *const adrs[], const uint8_t *const m[],
+    uint8_t *const out[], size_t lanes)
+{
+    size_t n = hctx->key->params->n;
+    size_t i, in_len = 2 * n + SLH_ADRS_SIZE;
+    uint8_t in[SLH_SHAKE_X4_LANES][2 * SLH_MAX_N + SLH_ADRS_SIZE];
+    uint8_t res[SLH_SHAKE_X4_LANES][SLH_MAX_N];
+
+    for (i = 0; i < SLH_SHAKE_X4_LANES; ++i) {
+        memcpy(in[i], pk_seed, n);
+        memcpy(in[i] + n, adrs[i < lanes ? i : 0], SLH_ADRS_SIZE);
+        memcpy(in[i] + n + SLH_ADRS_SIZE, m[i < lanes ? i : 0], n);
+    }
+    ossl_sha3_shake256_x4_avx512vl(res[0], res[1], res[2], res[3], n,
+        in[0], in[1], in[2], in[3], in_len);
+    for (i = 0; i < lanes; ++i)
+        memcpy(out[i], res[i], n);
+    OPENSSL_cleanse(in, sizeof(in));
+    OPENSSL_cleanse(res, sizeof(res));
+    return 1;
+}
+#endif
+
 static int
 slh_f_sha256(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, const uint8_t *adrs,
     const uint8_t *m1, size_t m1_len, uint8_t *out, size_t out_len)
@@ -345,6 +402,53 @@ slh_f_sha256(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, const uint8_t *adrs
     return 1;
 }
 
+#if defined(SLH_SHA2_X8)
+static int slh_f_sha256_x8(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed,
+    const uint8_t *const adrs[], const uint8_t *const m[],
+    uint8_t *const out[], size_t lanes)
+{
+    const SHA256_CTX *sctx = (const SHA256_CTX *)hctx->shactx_pkseed;
+    size_t n = hctx->key->params->n;
+    unsigned char storage[sizeof(SHA256_MB_CTX) + 32];
+    uint8_t blk[SLH_SHA2_X8_LANES][SHA256_CBLOCK];
+    HASH_DESC desc[SLH_SHA2_X8_LANES];
+    SHA256_MB_CTX *mctx;
+    unsigned int *w;
+    size_t i, j;
+
+    mctx = (SHA256_MB_CTX *)(storage + 32 - ((size_t)storage % 32));
+    w = (unsigned int *)mctx;
+    for (j = 0; j < 8; ++j)
+        for (i = 0; i < SLH_SHA2_X8_LANES; ++i)
+            w[8 * j + i] = sctx->h[j];
+
+    /* ADRSc || M and the padding fit into the one block after PK.seed */
+    memset(blk, 0, sizeof(blk));
+    for (i = 0; i < SLH_SHA2_X8_LANES; ++i) {
+        desc[i].ptr = NULL;
+        desc[i].blocks = 0;
+    }
+    for (i = 0; i < lanes; ++i) {
+        memcpy(blk[i], adrs[i], SLH_ADRSC_SIZE);
+        memcpy(blk[i] + SLH_ADRSC_SIZE, m[i], n);
+        blk[i][SLH_ADRSC_SIZE + n] = 0x80;
+        OPENSSL_store_u64_be(blk[i] + SHA256_CBLOCK - 8,
+            (uint64_t)(SHA256_CBLOCK + SLH_ADRSC_SIZE + n) << 3);
+        desc[i].ptr = blk[i];
+        desc[i].blocks = 1;
+    }
+    sha256_multi_block(mctx, desc, (int)(lanes + 3) / 4);
+
+    for (i = 0; i < lanes; ++i)
+        for (j = 0; j < n / 4; ++j)
+            OPENSSL_store_u32_be(out[i] + 4 * j, w[8 * j + i]);
+
+    OPENSSL_cleanse(storage, sizeof(storage));
+    OPENSSL_cleanse(blk, sizeof(blk));
+    return 1;
+}
+#endif
+
 static int
 slh_h_sha256(SLH_DSA_HASH_CTX *hctx, const uint8_t *pk_seed, const uint8_t *adrs,
     const uint8_t *m1, const uint8_t *m2, uint8_t *out, size_t out_len)
@@ -466,6 +570,28 @@ static int slh_hash_sha256_dup(SLH_DSA_HASH_CTX *dst, const SLH_DSA_HASH_CTX *sr
     return 1;
 }
 
+int ossl_slh_f_many(SLH_DSA_HASH_CTX *ctx, const uint8_t *pk_seed,
+    const uint8_t *const adrs[], const uint8_t *const m[],
+    uint8_t *const out[], size_t num)
+{
+    const SLH_HASH_FUNC *hashf = ctx->key->hash_func;
+    size_t n = ctx->key->params->n;
+    size_t i, k;
+
+    if (hashf->F_x != NULL) {
+        for (i = 0; i < num; i += k) {
+            k = num - i < hashf->lanes ? num - i : hashf->lanes;
+            if (!hashf->F_x(ctx, pk_seed, adrs + i, m + i, out + i, k))
+                return 0;
+        }
+        return 1;
+    }
+    for (i = 0; i < num; ++i)
+        if (!hashf->F(ctx, pk_seed, adrs[i], m[i], n, out[i], n))
+            return 0;
+    return 1;
+}
+
 const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category)
 {
     static const SLH_HASH_FUNC methods[] = {
@@ -477,7 +603,41 @@ const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category)
             slh_f_shake,
             slh_h_shake,
             slh_f_shake,
-            slh_wots_pk_gen_shake },
+            slh_wots_pk_gen_shake,
+            NULL, 0 },
+        { slh_hash_sha256_precache,
+            slh_hash_sha256_dup,
+            slh_hmsg_sha256,
+            slh_prf_sha256,
+            slh_prf_msg_sha2,
+            slh_f_sha256,
+            slh_h_sha256,
+            slh_t_sha256,
+            slh_wots_pk_gen_sha2,
+            NULL, 0 },
+        { slh_hash_sha256_precache,
+            slh_hash_sha256_dup,
+            slh_hmsg_sha512,
+            slh_prf_sha256,
+            slh_prf_msg_sha2,
+            slh_f_sha256,
+            slh_h_sha512,
+            slh_t_sha512,
+            slh_wots_pk_gen_sha2,
+            NULL, 0 },
+#if defined(SLH_SHAKE_X4)
+        { slh_hash_shake_precache,
+            slh_hash_shake_dup,
+            slh_hmsg_shake,
+            slh_prf_shake,
+            slh_prf_msg_shake,
+            slh_f_shake,
+            slh_h_shake,
+            slh_f_shake,
+            slh_wots_pk_gen_shake,
+            slh_f_shake_x4, SLH_SHAKE_X4_LANES },
+#endif
+#if defined(SLH_SHA2_X8)
         { slh_hash_sha256_precache,
             slh_hash_sha256_dup,
             slh_hmsg_sha256,
@@ -486,7 +646,8 @@ const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category)
             slh_f_sha256,
             slh_h_sha256,
             slh_t_sha256,
-            slh_wots_pk_gen_sha2 },
+            slh_wots_pk_gen_sha2,
+            slh_f_sha256_x8, SLH_SHA2_X8_LANES },
         { slh_hash_sha256_precache,
             slh_hash_sha256_dup,
             slh_hmsg_sha512,
@@ -495,7 +656,19 @@ const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category)
             slh_f_sha256,
             slh_h_sha512,
             slh_t_sha512,
-            slh_wots_pk_gen_sha2 }
+            slh_wots_pk_gen_sha2,
+            slh_f_sha256_x8, SLH_SHA2_X8_LANES },
+#endif
     };
-    return &methods[is_shake ? 0 : (security_category == 1 ? 1 : 2)];
+    size_t i = is_shake ? 0 : (security_category == 1 ? 1 : 2);
+
+#if defined(SLH_SHAKE_X4)
+    if (is_shake && SHA3_avx512vl_capable())
+        return &methods[3];
+#endif
+#if defined(SLH_SHA2_X8)
+    if (!is_shake)
+        return &methods[OSSL_NELEM(methods) - 3 + i];
+#endif
+    return &methods[i];
 }
@@ -52,6 +52,15 @@ typedef int(OSSL_SLH_HASHFUNC_H)(SLH_DSA_HASH_CTX *ctx, const uint8_t *pk_seed,
 
 #define OSSL_SLH_HASHFUNC_T OSSL_SLH_HASHFUNC_F
 
+/*
+ * F for |lanes| independent |n| byte inputs at once, i.e.
+ * out[i] = F(PK.seed, adrs[i], m[i]).  PRF has the same form with SK.seed as
+ * the message, so this also computes PRF values.  out[i] may be m[i].
+ */
+typedef int(OSSL_SLH_HASHFUNC_F_x)(SLH_DSA_HASH_CTX *ctx, const uint8_t *pk_seed,
+    const uint8_t *const adrs[], const uint8_t *const m[],
+    uint8_t *const out[], size_t lanes);
+
 typedef int(OSSL_SLH_HASHFUNC_wots_pk_gen)(SLH_DSA_HASH_CTX *hctx,
     const uint8_t *sk_seed, const uint8_t *pk_seed,
     uint8_t *adrs, uint8_t *pk_out, size_t pk_out_len);
@@ -71,8 +80,17 @@ typedef struct slh_hash_func_st {
     OSSL_SLH_HASHFUNC_H *H;
     OSSL_SLH_HASHFUNC_T *T;
     OSSL_SLH_HASHFUNC_wots_pk_gen *wots_pk_gen;
+    /* A multi-lane F for up to |lanes| inputs, or NULL */
+    OSSL_SLH_HASHFUNC_F_x *F_x;
+    size_t lanes;
 } SLH_HASH_FUNC;
 
+/* The most lanes that any F_x() hashes at once */
+#define SLH_MAX_LANES 8
+
 const SLH_HASH_FUNC *ossl_slh_get_hash_fn(int is_shake, int security_category);
+__owur int ossl_slh_f_many(SLH_DSA_HASH_CTX *ctx, const uint8_t *pk_seed,
+    const uint8_t *const adrs[], const uint8_t *const m[],
+    uint8_t *const out[], size_t num);
 
 #endif
@@ -11,6 +11,41 @@
 #include "slh_dsa_local.h"
 #include "slh_dsa_key.h"
 
+/* d = 7, 8, 17 or 22 (number of XMSS tree layers) */
+#define SLH_MAX_D 22
+/* h = 63, 64, 66 or 68 (total height of the hypertree) */
+#define SLH_MAX_H 68
+
+/* The authentication paths of the XMSS keys at each hypertree layer */
+typedef struct {
+    const uint8_t *sk_seed;
+    const uint8_t *pk_seed;
+    uint64_t tree_id[SLH_MAX_D];
+    uint32_t leaf_id[SLH_MAX_D];
+    uint8_t auth_path[SLH_MAX_H * SLH_MAX_N];
+} SLH_HT_AUTH_PATHS;
+
+/*
+ * An ossl_slh_run_jobs() job that computes the XMSS authentication path for
+ * a single hypertree |layer|.
+ */
+static int slh_ht_auth_path_job(SLH_DSA_HASH_CTX *ctx, void *arg,
+    uint32_t layer)
+{
+    SLH_HT_AUTH_PATHS *paths = (SLH_HT_AUTH_PATHS *)arg;
+    const SLH_DSA_KEY *key = ctx->key;
+    const SLH_DSA_PARAMS *params = key->params;
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+    SLH_ADRS_DECLARE(adrs);
+
+    adrsf->zero(adrs);
+    adrsf->set_layer_address(adrs, layer);
+    adrsf->set_tree_address(adrs, paths->tree_id[layer]);
+    return ossl_slh_xmss_auth_path(ctx, paths->sk_seed, paths->leaf_id[layer],
+        paths->pk_seed, adrs,
+        paths->auth_path + layer * params->hm * params->n);
+}
+
 /**
  * @brief Generate a Hypertree Signature
  * See FIPS 205 Section 7.1 Algorithm 12
@@ -19,6 +54,10 @@
  * where the first signature uses the XMSS key at the lowest layer, and the last
  * signature uses the XMSS key at the top layer.
  *
+ * The authentication paths of the XMSS signatures do not depend on the
+ * message, so these are computed first (on multiple threads if ctx->threads
+ * allows), leaving only the WOTS+ signatures to be chained together.
+ *
  * @param ctx Contains SLH_DSA algorithm functions and constants.
  * @param msg A message of size |n|.
  * @param sk_seed The private key seed of size |n|
@@ -44,9 +83,23 @@ int ossl_slh_ht_sign(SLH_DSA_HASH_CTX *ctx,
     uint32_t hm = params->hm;
     uint8_t *psig;
     PACKET rpkt, *xmss_sig_rpkt = &rpkt;
+    SLH_HT_AUTH_PATHS paths;
+    uint64_t tid = tree_id;
+    uint32_t lid = leaf_id;
 
     mask = (1 << hm) - 1; /* A mod 2^h = A & ((2^h - 1))) */
 
+    paths.sk_seed = sk_seed;
+    paths.pk_seed = pk_seed;
+    for (layer = 0; layer < d; ++layer) {
+        paths.tree_id[layer] = tid;
+        paths.leaf_id[layer] = lid;
+        lid = tid & mask;
+        tid >>= hm;
+    }
+    if (!ossl_slh_run_jobs(ctx, d, slh_ht_auth_path_job, &paths))
+        return 0;
+
     adrsf->zero(adrs);
     /*
      * For each XMSS tree there is a current leaf node that is used for signing.
@@ -69,7 +122,7 @@ int ossl_slh_ht_sign(SLH_DSA_HASH_CTX *ctx,
         adrsf->set_tree_address(adrs, tree_id);
         psig = WPACKET_get_curr(sig_wpkt);
         if (!ossl_slh_xmss_sign(ctx, root, sk_seed, leaf_id, pk_seed, adrs,
-                sig_wpkt))
+                paths.auth_path + layer * hm * n, sig_wpkt))
             return 0;
         /*
          * On the last loop it skips getting the public key since it is not needed
@@ -122,6 +122,98 @@ static int slh_wots_chain(SLH_DSA_HASH_CTX *ctx, const uint8_t *in,
     return 1;
 }
 
+/*
+ * Compute the |len| chain secrets PRF(PK.seed, SK.seed, ADRS) of the WOTS+
+ * key at |adrs| into |out|, with |len| * n bytes, using F_x().
+ */
+static int slh_wots_sk_x(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
+    const uint8_t *pk_seed, const uint8_t *adrs, uint8_t *out, size_t len)
+{
+    const SLH_DSA_KEY *key = ctx->key;
+    size_t i, n = key->params->n;
+    uint8_t sk_adrs[SLH_WOTS_LEN_MAX][SLH_ADRS_SIZE_MAX];
+    const uint8_t *a[SLH_WOTS_LEN_MAX], *m[SLH_WOTS_LEN_MAX];
+    uint8_t *o[SLH_WOTS_LEN_MAX];
+
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+
+    for (i = 0; i < len; ++i) {
+        adrsf->copy(sk_adrs[i], adrs);
+        adrsf->set_type_and_clear(sk_adrs[i], SLH_ADRS_TYPE_WOTS_PRF);
+        adrsf->copy_keypair_address(sk_adrs[i], adrs);
+        adrsf->set_chain_address(sk_adrs[i], (uint32_t)i);
+        a[i] = sk_adrs[i];
+        m[i] = sk_seed;
+        o[i] = out + i * n;
+    }
+    return ossl_slh_f_many(ctx, pk_seed, a, m, o, len);
+}
+
+/*
+ * Run the |len| WOTS+ chains of |n| bytes each in |in| from start[i] for
+ * steps[i] steps into |out|, which may be |in|, with F_x().  Each lane takes
+ * the next chain as soon as its current one finishes, so that the lanes stay
+ * busy when the chains are of different lengths, as they are when signing
+ * and verifying.  |adrs| is the WOTS_HASH address of the key.
+ */
+static int slh_wots_chains_x(SLH_DSA_HASH_CTX *ctx, const uint8_t *in,
+    const uint8_t *start, const uint8_t *steps, const uint8_t *pk_seed,
+    const uint8_t *adrs, uint8_t *out, size_t len)
+{
+    const SLH_DSA_KEY *key = ctx->key;
+    SLH_HASH_FUNC_DECLARE(key, hashf);
+    SLH_ADRS_FUNC_DECLARE(key, adrsf);
+    size_t n = key->params->n, lanes = hashf->lanes;
+    size_t i, next = 0, active = 0;
+    uint8_t lane_adrs[SLH_MAX_LANES][SLH_ADRS_SIZE_MAX];
+    const uint8_t *a[SLH_MAX_LANES], *m[SLH_MAX_LANES];
+    uint8_t *o[SLH_MAX_LANES];
+    size_t chain[SLH_MAX_LANES], pos[SLH_MAX_LANES];
+
+    for (;;) {
+        while (active < lanes && next < len) {
+            i = next++;
+            if (steps[i] == 0) {
+                if (in != out)
+                    memcpy(out + i * n, in + i * n, n);
+                continue;
+            }
+            adrsf->copy(lane_adrs[active], adrs);
+            adrsf->set_chain_address(lane_adrs[active], (uint32_t)i);
+            chain[active] = i;
+            pos[active] = start[i];
+            m[active] = in + i * n;
+            o[active] = out + i * n;
+            ++active;
+        }
+        if (active == 0)
+            return 1;
+
+        for (i = 0; i < active; ++i) {
+            adrsf->set_hash_address(lane_adrs[i], (uint32_t)pos[i]);
+            a[i] = lane_adrs[i];
+        }
+        if (!hashf->F_x(ctx, pk_seed, a, m, o, active))
+            return 0;
+
+        /* Move the last lane into the place of a finished chain */
+        for (i = 0; i < active;) {
+            m[i] = o[i];
+            if (++pos[i] < (size_t)start[chain[i]] + steps[chain[i]]) {
+                ++i;
+                continue;
+            }
+            if (--active == i)
+                break;
+            adrsf->copy(lane_adrs[i], lane_adrs[active]);
+            chain[i] = chain[active];
+            pos[i] = pos[active];
+            m[i] = m[active];
+            o[i] = o[active];
+        }
+    }
+}
+
 /**
  * @brief WOTS+ Public key generation.
  * See FIPS 205 Section 5.1 Algorithm 6
@@ -150,8 +242,18 @@ int ossl_slh_wots_pk_gen(SLH_DSA_HASH_CTX *ctx,
     SLH_ADRS_FUNC_DECLARE(key, adrsf);
     SLH_ADRS_DECLARE(wots_pk_adrs);
 
-    if (!hashf->wots_pk_gen(ctx, sk_seed, pk_seed, adrs, tmp, tmp_len))
+    if (hashf->F_x != NULL) {
+        uint8_t start[SLH_WOTS_LEN_MAX], steps[SLH_WOTS_LEN_MAX];
+
+        memset(start, 0, len);
+        memset(steps, NIBBLE_MASK, len);
+        if (!slh_wots_sk_x(ctx, sk_seed, pk_seed, adrs, tmp, len)
+            || !slh_wots_chains_x(ctx, tmp, start, steps, pk_seed, adrs,
+                tmp, len))
+            goto end;
+    } else if (!hashf->wots_pk_gen(ctx, sk_seed, pk_seed, adrs, tmp, tmp_len)) {
         goto end;
+    }
 
     adrsf->copy(wots_pk_adrs, adrs);
     adrsf->set_type_and_clear(wots_pk_adrs, SLH_ADRS_TYPE_WOTS_PK);
@@ -204,6 +306,17 @@ int ossl_slh_wots_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
     /* Compute a 12 bit checksum and add it to the end */
     compute_checksum_nibbles(msg_and_csum_nibbles, len1, msg_and_csum_nibbles + len1);
 
+    if (hashf->F_x != NULL) {
+        uint8_t start[SLH_WOTS_LEN_MAX] = { 0 };
+        uint8_t *sig;
+
+        /* The chain secrets are replaced by the chains in the signature */
+        return WPACKET_allocate_bytes(sig_wpkt, len * n, &sig)
+            && slh_wots_sk_x(ctx, sk_seed, pk_seed, adrs, sig, len)
+            && slh_wots_chains_x(ctx, sig, start, msg_and_csum_nibbles,
+                pk_seed, adrs, sig, len);
+    }
+
     adrsf->copy(sk_adrs, adrs);
     adrsf->set_type_and_clear(sk_adrs, SLH_ADRS_TYPE_WOTS_PRF);
     adrsf->copy_keypair_address(sk_adrs, adrs);
@@ -268,14 +381,26 @@ int ossl_slh_wots_pk_from_sig(SLH_DSA_HASH_CTX *ctx,
     slh_bytes_to_nibbles(msg, n, msg_and_csum_nibbles);
     compute_checksum_nibbles(msg_and_csum_nibbles, len1, msg_and_csum_nibbles + len1);
 
-    /* Compute the end nodes for each of the chains */
-    for (i = 0; i < len; ++i) {
-        set_chain_address(adrs, (uint32_t)i);
-        if (!PACKET_get_bytes(sig_rpkt, &sig_i, n)
-            || !slh_wots_chain(ctx, sig_i, msg_and_csum_nibbles[i],
-                NIBBLE_MASK - msg_and_csum_nibbles[i],
-                pk_seed, adrs, tmp_pkt))
+    if (hashf->F_x != NULL) {
+        uint8_t steps[SLH_WOTS_LEN_MAX];
+
+        for (i = 0; i < len; ++i)
+            steps[i] = NIBBLE_MASK - msg_and_csum_nibbles[i];
+        if (!PACKET_get_bytes(sig_rpkt, &sig_i, len * n)
+            || !WPACKET_allocate_bytes(tmp_pkt, len * n, NULL)
+            || !slh_wots_chains_x(ctx, sig_i, msg_and_csum_nibbles, steps,
+                pk_seed, adrs, tmp, len))
             goto err;
+    } else {
+        /* Compute the end nodes for each of the chains */
+        for (i = 0; i < len; ++i) {
+            set_chain_address(adrs, (uint32_t)i);
+            if (!PACKET_get_bytes(sig_rpkt, &sig_i, n)
+                || !slh_wots_chain(ctx, sig_i, msg_and_csum_nibbles[i],
+                    NIBBLE_MASK - msg_and_csum_nibbles[i],
+                    pk_seed, adrs, tmp_pkt))
+                goto err;
+        }
     }
     /* compress the computed public key value */
     adrsf->copy(wots_pk_adrs, adrs);
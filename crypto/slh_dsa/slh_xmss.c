@@ -64,6 +64,40 @@ int ossl_slh_xmss_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
     return 1;
 }
 
+/**
+ * @brief Compute the authentication path of a WOTS+ key within an XMSS tree.
+ * See FIPS 205 Section 6.2 Algorithm 10 (Steps 1..4)
+ *
+ * The authentication path does not depend on the message being signed, so it
+ * may be computed ahead of time (or in parallel for each hypertree layer).
+ *
+ * @param ctx Contains SLH_DSA algorithm functions and constants.
+ * @param sk_seed A private key seed of size |n|
+ * @param node_id The index of a WOTS+ key within the XMSS tree.
+ * @param pk_seed A public key seed f size |n|
+ * @param adrs An ADRS object containing the layer address and tree address set
+ *              to the XMSS key being used to sign the message.
+ * @param auth_path The returned authentication path of size (XMSS tree_height) * n.
+ * @returns 1 on success, or 0 on error.
+ */
+int ossl_slh_xmss_auth_path(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
+    uint32_t node_id, const uint8_t *pk_seed, uint8_t *adrs,
+    uint8_t *auth_path)
+{
+    const SLH_DSA_KEY *key = ctx->key;
+    size_t n = key->params->n;
+    uint32_t h, hm = key->params->hm;
+
+    for (h = 0; h < hm; ++h) {
+        if (!ossl_slh_xmss_node(ctx, sk_seed, node_id ^ 1, h, pk_seed, adrs,
+                auth_path, n))
+            return 0;
+        auth_path += n;
+        node_id >>= 1;
+    }
+    return 1;
+}
+
 /**
  * @brief Generate an XMSS signature using a message and key.
  * See FIPS 205 Section 6.2 Algorithm 10
@@ -79,21 +113,20 @@ int ossl_slh_xmss_node(SLH_DSA_HASH_CTX *ctx, const uint8_t *sk_seed,
  * @param pk_seed A public key seed f size |n|
  * @param adrs An ADRS object containing the layer address and tree address set
  *              to the XMSS key being used to sign the message.
+ * @param auth_path The authentication path for |node_id| of size
+ *                  (XMSS tree_height) * n (see ossl_slh_xmss_auth_path()).
  * @param sig_wpkt A WPACKET object to write the generated XMSS signature to.
  * @returns 1 on success, or 0 on error.
  */
 int ossl_slh_xmss_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
     const uint8_t *sk_seed, uint32_t node_id,
-    const uint8_t *pk_seed, uint8_t *adrs, WPACKET *sig_wpkt)
+    const uint8_t *pk_seed, uint8_t *adrs,
+    const uint8_t *auth_path, WPACKET *sig_wpkt)
 {
     const SLH_DSA_KEY *key = ctx->key;
     SLH_ADRS_FUNC_DECLARE(key, adrsf);
     SLH_ADRS_DECLARE(tmp_adrs);
-    size_t n = key->params->n;
-    uint32_t h, hm = key->params->hm;
-    uint32_t id = node_id;
-    uint8_t *auth_path; /* Pointer to a buffer offset inside |sig_wpkt| */
-    size_t auth_path_len = n;
+    size_t auth_path_len = key->params->n * key->params->hm;
 
     /*
      * This code reverses the order of the FIPS 205 code so that it does the
@@ -106,14 +139,7 @@ int ossl_slh_xmss_sign(SLH_DSA_HASH_CTX *ctx, const uint8_t *msg,
         return 0;
 
     adrsf->copy(adrs, tmp_adrs);
-    for (h = 0; h < hm; ++h) {
-        if (!WPACKET_allocate_bytes(sig_wpkt, auth_path_len, &auth_path)
-            || !ossl_slh_xmss_node(ctx, sk_seed, id ^ 1, h, pk_seed, adrs,
-                auth_path, auth_path_len))
-            return 0;
-        id >>= 1;
-    }
-    return 1;
+    return WPACKET_memcpy(sig_wpkt, auth_path, auth_path_len);
 }
 
 /**
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * The SM3 batch digest.  Each SM3 block is a chain of dependent rounds, so
+ * on x86_64 without the SM3 instructions eight messages go through the
+ * rounds together, one in each 32-bit lane of the AVX2 registers.
+ */
+
+#include <string.h>
+#include <openssl/byteorder.h>
+#include <openssl/crypto.h>
+#include "internal/cryptlib.h"
+#include "internal/sm3.h"
+#include "crypto/md_mb.h"
+
+#if defined(OPENSSL_SM3_ASM) && defined(OPENSSL_CPUID_OBJ) \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64))
+#if !defined(_M_ARM64EC)
+#if defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define SM3_MB_AVX2
+/* AVX2, and not the SM3 instructions, which are quicker one message at a time */
+#define SM3_MB_AVX2_CAPABLE                     \
+    ((OPENSSL_ia32cap_P[2] & (1u << 5)) != 0    \
+        && (OPENSSL_ia32cap_P[5] & (1u << 1)) == 0)
+#define SM3_MB_LANES 8
+#define SM3_MB_MIN_LANES 2
+#endif
+#endif /* !defined(_M_ARM64EC) */
+#endif
+
+#ifdef SM3_MB_AVX2
+
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+/* T_j rotated left by j mod 32 */
+static const uint32_t sm3_mb_T[64] = {
+    0x79cc4519U, 0xf3988a32U, 0xe7311465U, 0xce6228cbU, 0x9cc45197U, 0x3988a32fU,
+    0x7311465eU, 0xe6228cbcU, 0xcc451979U, 0x988a32f3U, 0x311465e7U, 0x6228cbceU,
+    0xc451979cU, 0x88a32f39U, 0x11465e73U, 0x228cbce6U, 0x9d8a7a87U, 0x3b14f50fU,
+    0x7629ea1eU, 0xec53d43cU, 0xd8a7a879U, 0xb14f50f3U, 0x629ea1e7U, 0xc53d43ceU,
+    0x8a7a879dU, 0x14f50f3bU, 0x29ea1e76U, 0x53d43cecU, 0xa7a879d8U, 0x4f50f3b1U,
+    0x9ea1e762U, 0x3d43cec5U, 0x7a879d8aU, 0xf50f3b14U, 0xea1e7629U, 0xd43cec53U,
+    0xa879d8a7U, 0x50f3b14fU, 0xa1e7629eU, 0x43cec53dU, 0x879d8a7aU, 0x0f3b14f5U,
+    0x1e7629eaU, 0x3cec53d4U, 0x79d8a7a8U, 0xf3b14f50U, 0xe7629ea1U, 0xcec53d43U,
+    0x9d8a7a87U, 0x3b14f50fU, 0x7629ea1eU, 0xec53d43cU, 0xd8a7a879U, 0xb14f50f3U,
+    0x629ea1e7U, 0xc53d43ceU, 0x8a7a879dU, 0x14f50f3bU, 0x29ea1e76U, 0x53d43cecU,
+    0xa7a879d8U, 0x4f50f3b1U, 0x9ea1e762U, 0x3d43cec5U
+};
+
+OPENSSL_TARGET_REGION("avx2")
+
+#define ADD(a, b) _mm256_add_epi32((a), (b))
+#define XOR(a, b) _mm256_xor_si256((a), (b))
+#define ROTL(x, n) \
+    _mm256_or_si256(_mm256_slli_epi32((x), (n)), _mm256_srli_epi32((x), 32 - (n)))
+#define P0(x) XOR(XOR((x), ROTL((x), 9)), ROTL((x), 17))
+#define P1(x) XOR(XOR((x), ROTL((x), 15)), ROTL((x), 23))
+#define FF1(x, y, z)                           \
+    _mm256_or_si256(_mm256_and_si256((x), (y)), \
+        _mm256_and_si256((z), _mm256_or_si256((x), (y))))
+#define GG1(x, y, z) XOR((z), _mm256_and_si256((x), XOR((y), (z))))
+
+#define ROUND(a, b, c, d, e, f, g, h, j)                                   \
+    do {                                                                   \
+        __m256i A12 = ROTL(a, 12), SS1, TT1, TT2;                          \
+                                                                           \
+        SS1 = ROTL(ADD(ADD(A12, e), _mm256_set1_epi32((int)sm3_mb_T[j])), 7); \
+        if ((j) < 16) {                                                    \
+            TT1 = XOR(XOR(a, b), c);                                       \
+            TT2 = XOR(XOR(e, f), g);                                       \
+        } else {                                                           \
+            TT1 = FF1(a, b, c);                                            \
+            TT2 = GG1(e, f, g);                                            \
+        }                                                                  \
+        TT1 = ADD(ADD(TT1, d), ADD(XOR(SS1, A12), XOR(W[j], W[(j) + 4]))); \
+        TT2 = ADD(ADD(TT2, h), ADD(SS1, W[j]));                            \
+        b = ROTL(b, 9);                                                    \
+        d = TT1;                                                           \
+        f = ROTL(f, 19);                                                   \
+        h = P0(TT2);                                                       \
+    } while ((void)0, 0)
+
+/*
+ * Compress blocks[l] blocks from ptr[l] into lane l of |st|, which holds
+ * word j of the state of lane l in st[j][l].  The lanes that have run out of
+ * blocks are kept as they are.
+ */
+static void sm3_mb_avx2(uint32_t st[8][SM3_MB_LANES],
+    const unsigned char *const ptr[SM3_MB_LANES],
+    const size_t blocks[SM3_MB_LANES])
+{
+    static const unsigned char zero[SM3_CBLOCK] = { 0 };
+    const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4,
+        11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4,
+        11, 10, 9, 8, 15, 14, 13, 12);
+    const unsigned char *p[SM3_MB_LANES];
+    __m256i H[8], W[68], a, b, c, d, e, f, g, h, mask;
+    size_t blk, maxblk = 0, l, t;
+
+    for (l = 0; l < SM3_MB_LANES; l++)
+        if (blocks[l] > maxblk)
+            maxblk = blocks[l];
+    for (t = 0; t < 8; t++)
+        H[t] = _mm256_loadu_si256((const __m256i *)st[t]);
+
+    for (blk = 0; blk < maxblk; blk++) {
+        for (l = 0; l < SM3_MB_LANES; l++)
+            p[l] = blk < blocks[l] ? ptr[l] + blk * SM3_CBLOCK : zero;
+        mask = _mm256_setr_epi32(blk < blocks[0] ? -1 : 0,
+            blk < blocks[1] ? -1 : 0, blk < blocks[2] ? -1 : 0,
+            blk < blocks[3] ? -1 : 0, blk < blocks[4] ? -1 : 0,
+            blk < blocks[5] ? -1 : 0, blk < blocks[6] ? -1 : 0,
+            blk < blocks[7] ? -1 : 0);
+
+        /* Transpose eight words of each lane at a time */
+        for (t = 0; t < 16; t += 8) {
+            __m256i r[8], u[8];
+
+            for (l = 0; l < 8; l++)
+                r[l] = _mm256_loadu_si256((const __m256i *)(p[l] + 4 * t));
+            for (l = 0; l < 8; l += 4) {
+                __m256i t0 = _mm256_unpacklo_epi32(r[l], r[l + 1]);
+                __m256i t1 = _mm256_unpackhi_epi32(r[l], r[l + 1]);
+                __m256i t2 = _mm256_unpacklo_epi32(r[l + 2], r[l + 3]);
+                __m256i t3 = _mm256_unpackhi_epi32(r[l + 2], r[l + 3]);
+
+                u[l] = _mm256_unpacklo_epi64(t0, t2);
+                u[l + 1] = _mm256_unpackhi_epi64(t0, t2);
+                u[l + 2] = _mm256_unpacklo_epi64(t1, t3);
+                u[l + 3] = _mm256_unpackhi_epi64(t1, t3);
+            }
+            for (l = 0; l < 4; l++) {
+                W[t + l] = _mm256_shuffle_epi8(
+                    _mm256_permute2x128_si256(u[l], u[l + 4], 0x20), bswap);
+                W[t + l + 4] = _mm256_shuffle_epi8(
+                    _mm256_permute2x128_si256(u[l], u[l + 4], 0x31), bswap);
+            }
+        }
+        for (t = 16; t < 68; t++)
+            W[t] = XOR(XOR(P1(XOR(XOR(W[t - 16], W[t - 9]), ROTL(W[t - 3], 15))),
+                           ROTL(W[t - 13], 7)),
+                W[t - 6]);
+
+        a = H[0];
+        b = H[1];
+        c = H[2];
+        d = H[3];
+        e = H[4];
+        f = H[5];
+        g = H[6];
+        h = H[7];
+        for (t = 0; t < 64; t += 4) {
+            ROUND(a, b, c, d, e, f, g, h, t);
+            ROUND(d, a, b, c, h, e, f, g, t + 1);
+            ROUND(c, d, a, b, g, h, e, f, t + 2);
+            ROUND(b, c, d, a, f, g, h, e, t + 3);
+        }
+        /* SM3 adds the state with XOR */
+        H[0] = _mm256_blendv_epi8(H[0], XOR(H[0], a), mask);
+        H[1] = _mm256_blendv_epi8(H[1], XOR(H[1], b), mask);
+        H[2] = _mm256_blendv_epi8(H[2], XOR(H[2], c), mask);
+        H[3] = _mm256_blendv_epi8(H[3], XOR(H[3], d), mask);
+        H[4] = _mm256_blendv_epi8(H[4], XOR(H[4], e), mask);
+        H[5] = _mm256_blendv_epi8(H[5], XOR(H[5], f), mask);
+        H[6] = _mm256_blendv_epi8(H[6], XOR(H[6], g), mask);
+        H[7] = _mm256_blendv_epi8(H[7], XOR(H[7], h), mask);
+    }
+
+    for (t = 0; t < 8; t++)
+        _mm256_storeu_si256((__m256i *)st[t], H[t]);
+    for (t = 0; t < 68; t++)
+        W[t] = _mm256_setzero_si256();
+}
+
+#undef ADD
+#undef XOR
+#undef ROTL
+#undef P0
+#undef P1
+#undef FF1
+#undef GG1
+#undef ROUND
+
+OPENSSL_UNTARGET_REGION
+
+/* Hash up to eight messages that continue from the SM3_CTX |c| */
+static int sm3_mb_lanes(const void *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t lanes)
+{
+    const SM3_CTX *sc = c;
+    uint32_t st[8][SM3_MB_LANES];
+    unsigned char tail[SM3_MB_LANES][2 * SM3_CBLOCK];
+    const unsigned char *p[SM3_MB_LANES];
+    size_t nblk[SM3_MB_LANES], j, l;
+
+    for (l = 0; l < SM3_MB_LANES; l++) {
+        st[0][l] = sc->A;
+        st[1][l] = sc->B;
+        st[2][l] = sc->C;
+        st[3][l] = sc->D;
+        st[4][l] = sc->E;
+        st[5][l] = sc->F;
+        st[6][l] = sc->G;
+        st[7][l] = sc->H;
+        p[l] = l < lanes ? in[l] : NULL;
+        nblk[l] = l < lanes ? inl[l] / SM3_CBLOCK : 0;
+    }
+    sm3_mb_avx2(st, p, nblk);
+
+    for (l = 0; l < lanes; l++) {
+        nblk[l] = ossl_md_mb_pad(tail[l], in[l], inl[l], SM3_CBLOCK, 8, 0,
+            ((uint64_t)sc->Nh << 32) | sc->Nl);
+        p[l] = tail[l];
+    }
+    sm3_mb_avx2(st, p, nblk);
+
+    for (l = 0; l < lanes; l++)
+        for (j = 0; j < 8; j++)
+            OPENSSL_store_u32_be(out[l] + 4 * j, st[j][l]);
+
+    OPENSSL_cleanse(st, sizeof(st));
+    OPENSSL_cleanse(tail, sizeof(tail));
+    return 1;
+}
+#endif /* SM3_MB_AVX2 */
+
+int ossl_sm3_batch(const SM3_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n)
+{
+    SM3_CTX t;
+    size_t i = 0;
+    int ret = 1;
+
+#ifdef SM3_MB_AVX2
+    if (c->num == 0 && SM3_MB_AVX2_CAPABLE)
+        i = ossl_md_mb_batch(c, in, inl, out, n, SM3_MB_LANES,
+            SM3_MB_MIN_LANES, sm3_mb_lanes);
+#endif
+    for (; ret && i < n; i++) {
+        t = *c;
+        ret = ossl_sm3_update(&t, in[i], inl[i]) && ossl_sm3_final(out[i], &t);
+    }
+    OPENSSL_cleanse(&t, sizeof(t));
+    return ret;
+}
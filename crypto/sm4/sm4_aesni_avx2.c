@@ -0,0 +1,525 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * SM4 with AES-NI and AVX2, for x86_64 processors without the SM4
+ * instructions.
+ *
+ * The SM4 and AES S-boxes are both inversion in GF(2^8), in different
+ * field representations, so the SM4 S-box is an affine map, the AES S-box
+ * and a second affine map.  The affine maps are two nibble table lookups
+ * each with VPSHUFB and the AES S-box is AESENCLAST with a zero round key.
+ * AESENCLAST also does ShiftRows, which is undone beforehand by a byte
+ * shuffle.  Nothing depends on secret data through memory accesses.
+ *
+ * Blocks are processed sixteen at a time, transposed so that a ymm register
+ * holds the same word of eight blocks, or four at a time in xmm registers
+ * for short inputs.  That helps the modes whose blocks are independent:
+ * ECB, CBC decryption, CTR (and so GCM) and XTS.
+ */
+
+#include <string.h>
+#include <openssl/e_os2.h>
+#include <openssl/crypto.h>
+#include "crypto/sm4.h"
+#include "crypto/sm4_platform.h"
+
+#ifdef SM4_AESNI_AVX2
+
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+#define SM4_AVX2_BLOCKS 16
+
+/*
+ * Nibble tables of the affine map into the AES field, applied before
+ * AESENCLAST, and of the map back, applied after it.
+ */
+static const uint64_t sm4_pre_lo[2] = {
+    0x9197E2E474720701ULL, 0xC7C1B4B222245157ULL
+};
+static const uint64_t sm4_pre_hi[2] = {
+    0xE240AB09EB49A200ULL, 0xF052B91BF95BB012ULL
+};
+static const uint64_t sm4_post_lo[2] = {
+    0x5B67F2CEA19D0834ULL, 0xEDD14478172BBE82ULL
+};
+static const uint64_t sm4_post_hi[2] = {
+    0xAE7201DD73AFDC00ULL, 0x11CDBE62CC1063BFULL
+};
+
+static const unsigned char sm4_shuf_isr[16] = {
+    0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3
+};
+static const unsigned char sm4_shuf_bswap[16] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+};
+static const unsigned char sm4_shuf_rol8[16] = {
+    3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14
+};
+static const unsigned char sm4_shuf_rol16[16] = {
+    2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13
+};
+static const unsigned char sm4_shuf_rol24[16] = {
+    1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12
+};
+
+OPENSSL_TARGET_REGION("avx2,aes")
+
+typedef struct {
+    __m256i pre_lo, pre_hi, post_lo, post_hi;
+    __m256i isr, bswap, rol8, rol16, rol24, nibble;
+} SM4_AVX2_CONST;
+
+static ossl_inline __m256i sm4_avx2_bcast(const void *p)
+{
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)p));
+}
+
+static void sm4_avx2_const_init(SM4_AVX2_CONST *c)
+{
+    c->pre_lo = sm4_avx2_bcast(sm4_pre_lo);
+    c->pre_hi = sm4_avx2_bcast(sm4_pre_hi);
+    c->post_lo = sm4_avx2_bcast(sm4_post_lo);
+    c->post_hi = sm4_avx2_bcast(sm4_post_hi);
+    c->isr = sm4_avx2_bcast(sm4_shuf_isr);
+    c->bswap = sm4_avx2_bcast(sm4_shuf_bswap);
+    c->rol8 = sm4_avx2_bcast(sm4_shuf_rol8);
+    c->rol16 = sm4_avx2_bcast(sm4_shuf_rol16);
+    c->rol24 = sm4_avx2_bcast(sm4_shuf_rol24);
+    c->nibble = _mm256_set1_epi8(0x0f);
+}
+
+/* The round function T of eight words: the S-box, then L */
+static ossl_inline __m256i sm4_avx2_t(__m256i x, const SM4_AVX2_CONST *c)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i x0, x1;
+    __m256i t;
+
+    x = _mm256_shuffle_epi8(x, c->isr);
+    x = _mm256_xor_si256(
+        _mm256_shuffle_epi8(c->pre_lo, _mm256_and_si256(x, c->nibble)),
+        _mm256_shuffle_epi8(c->pre_hi,
+            _mm256_and_si256(_mm256_srli_epi32(x, 4), c->nibble)));
+    x0 = _mm_aesenclast_si128(_mm256_castsi256_si128(x), zero);
+    x1 = _mm_aesenclast_si128(_mm256_extracti128_si256(x, 1), zero);
+    x = _mm256_inserti128_si256(_mm256_castsi128_si256(x0), x1, 1);
+    x = _mm256_xor_si256(
+        _mm256_shuffle_epi8(c->post_lo, _mm256_and_si256(x, c->nibble)),
+        _mm256_shuffle_epi8(c->post_hi,
+            _mm256_and_si256(_mm256_srli_epi32(x, 4), c->nibble)));
+
+    /* L(x) = x ^ (x <<< 2) ^ (x <<< 10) ^ (x <<< 18) ^ (x <<< 24) */
+    t = _mm256_xor_si256(x, _mm256_shuffle_epi8(x, c->rol8));
+    t = _mm256_xor_si256(t, _mm256_shuffle_epi8(x, c->rol16));
+    t = _mm256_or_si256(_mm256_slli_epi32(t, 2), _mm256_srli_epi32(t, 30));
+    return _mm256_xor_si256(_mm256_xor_si256(x, t),
+        _mm256_shuffle_epi8(x, c->rol24));
+}
+
+/* The same on four words, using the low halves of the constants */
+static ossl_inline __m128i sm4_sse_t(__m128i x, const SM4_AVX2_CONST *c)
+{
+    const __m128i nibble = _mm256_castsi256_si128(c->nibble);
+    __m128i t;
+
+    x = _mm_shuffle_epi8(x, _mm256_castsi256_si128(c->isr));
+    x = _mm_xor_si128(
+        _mm_shuffle_epi8(_mm256_castsi256_si128(c->pre_lo),
+            _mm_and_si128(x, nibble)),
+        _mm_shuffle_epi8(_mm256_castsi256_si128(c->pre_hi),
+            _mm_and_si128(_mm_srli_epi32(x, 4), nibble)));
+    x = _mm_aesenclast_si128(x, _mm_setzero_si128());
+    x = _mm_xor_si128(
+        _mm_shuffle_epi8(_mm256_castsi256_si128(c->post_lo),
+            _mm_and_si128(x, nibble)),
+        _mm_shuffle_epi8(_mm256_castsi256_si128(c->post_hi),
+            _mm_and_si128(_mm_srli_epi32(x, 4), nibble)));
+
+    t = _mm_xor_si128(x, _mm_shuffle_epi8(x, _mm256_castsi256_si128(c->rol8)));
+    t = _mm_xor_si128(t, _mm_shuffle_epi8(x, _mm256_castsi256_si128(c->rol16)));
+    t = _mm_or_si128(_mm_slli_epi32(t, 2), _mm_srli_epi32(t, 30));
+    return _mm_xor_si128(_mm_xor_si128(x, t),
+        _mm_shuffle_epi8(x, _mm256_castsi256_si128(c->rol24)));
+}
+
+/*
+ * Transpose four rows of four words, in each 128-bit lane.  Applied to
+ * four registers of two blocks each it gives the four words of the blocks;
+ * applied to the words it gives the blocks back.
+ */
+#define SM4_TRANSPOSE(T, P, r0, r1, r2, r3)     \
+    do {                                        \
+        T t0_ = P##_unpacklo_epi32(r0, r1);     \
+        T t1_ = P##_unpackhi_epi32(r0, r1);     \
+        T t2_ = P##_unpacklo_epi32(r2, r3);     \
+        T t3_ = P##_unpackhi_epi32(r2, r3);     \
+                                                \
+        r0 = P##_unpacklo_epi64(t0_, t2_);      \
+        r1 = P##_unpackhi_epi64(t0_, t2_);      \
+        r2 = P##_unpacklo_epi64(t1_, t3_);      \
+        r3 = P##_unpackhi_epi64(t1_, t3_);      \
+    } while (0)
+
+#define SM4_AVX2_RND(a, b, c, d, a_, b_, c_, d_, k)                            \
+    do {                                                                      \
+        __m256i k_ = _mm256_set1_epi32((int)(k));                             \
+                                                                              \
+        a = _mm256_xor_si256(a, sm4_avx2_t(_mm256_xor_si256(                  \
+            _mm256_xor_si256(b, c), _mm256_xor_si256(d, k_)), cst));          \
+        a_ = _mm256_xor_si256(a_, sm4_avx2_t(_mm256_xor_si256(                \
+            _mm256_xor_si256(b_, c_), _mm256_xor_si256(d_, k_)), cst));       \
+    } while (0)
+
+/* Sixteen blocks from |in| to |out| with the round keys |rk| */
+static void sm4_avx2_crypt16(const unsigned char *in, unsigned char *out,
+    const uint32_t *rk, const SM4_AVX2_CONST *cst)
+{
+    __m256i x0, x1, x2, x3, y0, y1, y2, y3;
+    int i;
+
+    x0 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)in), cst->bswap);
+    x1 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 32)), cst->bswap);
+    x2 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 64)), cst->bswap);
+    x3 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 96)), cst->bswap);
+    y0 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 128)), cst->bswap);
+    y1 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 160)), cst->bswap);
+    y2 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 192)), cst->bswap);
+    y3 = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(in + 224)), cst->bswap);
+    SM4_TRANSPOSE(__m256i, _mm256, x0, x1, x2, x3);
+    SM4_TRANSPOSE(__m256i, _mm256, y0, y1, y2, y3);
+
+    for (i = 0; i < SM4_KEY_SCHEDULE; i += 4) {
+        SM4_AVX2_RND(x0, x1, x2, x3, y0, y1, y2, y3, rk[i]);
+        SM4_AVX2_RND(x1, x2, x3, x0, y1, y2, y3, y0, rk[i + 1]);
+        SM4_AVX2_RND(x2, x3, x0, x1, y2, y3, y0, y1, rk[i + 2]);
+        SM4_AVX2_RND(x3, x0, x1, x2, y3, y0, y1, y2, rk[i + 3]);
+    }
+
+    /* The output is the words in reverse order */
+    SM4_TRANSPOSE(__m256i, _mm256, x3, x2, x1, x0);
+    SM4_TRANSPOSE(__m256i, _mm256, y3, y2, y1, y0);
+    _mm256_storeu_si256((__m256i *)out, _mm256_shuffle_epi8(x3, cst->bswap));
+    _mm256_storeu_si256((__m256i *)(out + 32), _mm256_shuffle_epi8(x2, cst->bswap));
+    _mm256_storeu_si256((__m256i *)(out + 64), _mm256_shuffle_epi8(x1, cst->bswap));
+    _mm256_storeu_si256((__m256i *)(out + 96), _mm256_shuffle_epi8(x0, cst->bswap));
+    _mm256_storeu_si256((__m256i *)(out + 128), _mm256_shuffle_epi8(y3, cst->bswap));
+    _mm256_storeu_si256((__m256i *)(out + 160), _mm256_shuffle_epi8(y2, cst->bswap));
+    _mm256_storeu_si256((__m256i *)(out + 192), _mm256_shuffle_epi8(y1, cst->bswap));
+    _mm256_storeu_si256((__m256i *)(out + 224), _mm256_shuffle_epi8(y0, cst->bswap));
+}
+
+#define SM4_SSE_RND(a, b, c, d, k)                                      \
+    a = _mm_xor_si128(a, sm4_sse_t(_mm_xor_si128(_mm_xor_si128(b, c),   \
+        _mm_xor_si128(d, _mm_set1_epi32((int)(k)))), cst))
+
+/* Four blocks from |in| to |out| with the round keys |rk| */
+static void sm4_sse_crypt4(const unsigned char *in, unsigned char *out,
+    const uint32_t *rk, const SM4_AVX2_CONST *cst)
+{
+    const __m128i bswap = _mm256_castsi256_si128(cst->bswap);
+    __m128i x0, x1, x2, x3;
+    int i;
+
+    x0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)in), bswap);
+    x1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 16)), bswap);
+    x2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 32)), bswap);
+    x3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 48)), bswap);
+    SM4_TRANSPOSE(__m128i, _mm, x0, x1, x2, x3);
+
+    for (i = 0; i < SM4_KEY_SCHEDULE; i += 4) {
+        SM4_SSE_RND(x0, x1, x2, x3, rk[i]);
+        SM4_SSE_RND(x1, x2, x3, x0, rk[i + 1]);
+        SM4_SSE_RND(x2, x3, x0, x1, rk[i + 2]);
+        SM4_SSE_RND(x3, x0, x1, x2, rk[i + 3]);
+    }
+
+    SM4_TRANSPOSE(__m128i, _mm, x3, x2, x1, x0);
+    _mm_storeu_si128((__m128i *)out, _mm_shuffle_epi8(x3, bswap));
+    _mm_storeu_si128((__m128i *)(out + 16), _mm_shuffle_epi8(x2, bswap));
+    _mm_storeu_si128((__m128i *)(out + 32), _mm_shuffle_epi8(x1, bswap));
+    _mm_storeu_si128((__m128i *)(out + 48), _mm_shuffle_epi8(x0, bswap));
+}
+
+/* |blocks| blocks from |in| to |out|, which may be the same */
+static void sm4_avx2_blocks(const unsigned char *in, unsigned char *out,
+    size_t blocks, const uint32_t *rk, const SM4_AVX2_CONST *cst)
+{
+    unsigned char buf[SM4_AVX2_BLOCKS * SM4_BLOCK_SIZE];
+    size_t n;
+
+    for (; blocks >= SM4_AVX2_BLOCKS; blocks -= SM4_AVX2_BLOCKS) {
+        sm4_avx2_crypt16(in, out, rk, cst);
+        in += SM4_AVX2_BLOCKS * SM4_BLOCK_SIZE;
+        out += SM4_AVX2_BLOCKS * SM4_BLOCK_SIZE;
+    }
+    for (; blocks >= 4 && blocks <= 8; blocks -= 4) {
+        sm4_sse_crypt4(in, out, rk, cst);
+        in += 4 * SM4_BLOCK_SIZE;
+        out += 4 * SM4_BLOCK_SIZE;
+    }
+    if (blocks == 0)
+        return;
+
+    /* Pad the rest to a whole kernel call in |buf| */
+    n = blocks * SM4_BLOCK_SIZE;
+    memcpy(buf, in, n);
+    if (blocks > 4) {
+        sm4_avx2_crypt16(buf, buf, rk, cst);
+        memcpy(out, buf, n);
+        OPENSSL_cleanse(buf, sizeof(buf));
+    } else {
+        sm4_sse_crypt4(buf, buf, rk, cst);
+        memcpy(out, buf, n);
+        OPENSSL_cleanse(buf, 4 * SM4_BLOCK_SIZE);
+    }
+}
+
+/* The round keys in the order needed for encryption or decryption */
+static const uint32_t *sm4_avx2_rk(const SM4_KEY *key, int enc,
+    uint32_t rk[SM4_KEY_SCHEDULE])
+{
+    int i;
+
+    if (enc)
+        return key->rk;
+    for (i = 0; i < SM4_KEY_SCHEDULE; i++)
+        rk[i] = key->rk[SM4_KEY_SCHEDULE - 1 - i];
+    return rk;
+}
+
+static ossl_inline void sm4_xor16(unsigned char *out, const unsigned char *a,
+    const unsigned char *b)
+{
+    _mm_storeu_si128((__m128i *)out,
+        _mm_xor_si128(_mm_loadu_si128((const __m128i *)a),
+            _mm_loadu_si128((const __m128i *)b)));
+}
+
+void ossl_sm4_aesni_avx2_ecb_encrypt(const unsigned char *in,
+    unsigned char *out, size_t len, const SM4_KEY *key, const int enc)
+{
+    SM4_AVX2_CONST cst;
+    uint32_t rk[SM4_KEY_SCHEDULE];
+
+    sm4_avx2_const_init(&cst);
+    sm4_avx2_blocks(in, out, len / SM4_BLOCK_SIZE, sm4_avx2_rk(key, enc, rk),
+        &cst);
+    if (!enc)
+        OPENSSL_cleanse(rk, sizeof(rk));
+}
+
+/*
+ * CBC encryption is a chain of dependent blocks, for which the table based
+ * code is quicker than a mostly idle kernel.  Decryption is done sixteen
+ * blocks at a time.
+ */
+void ossl_sm4_aesni_avx2_cbc_encrypt(const unsigned char *in,
+    unsigned char *out, size_t len, const SM4_KEY *key, unsigned char *ivec,
+    const int enc)
+{
+    unsigned char buf[SM4_AVX2_BLOCKS * SM4_BLOCK_SIZE];
+    unsigned char iv[SM4_BLOCK_SIZE], next[SM4_BLOCK_SIZE];
+    uint32_t rk[SM4_KEY_SCHEDULE];
+    SM4_AVX2_CONST cst;
+    size_t blocks = len / SM4_BLOCK_SIZE, n, i;
+
+    sm4_avx2_const_init(&cst);
+    memcpy(iv, ivec, SM4_BLOCK_SIZE);
+
+    if (enc) {
+        for (; blocks > 0; blocks--) {
+            sm4_xor16(out, in, iv);
+            ossl_sm4_encrypt(out, out, key);
+            memcpy(iv, out, SM4_BLOCK_SIZE);
+            in += SM4_BLOCK_SIZE;
+            out += SM4_BLOCK_SIZE;
+        }
+        memcpy(ivec, iv, SM4_BLOCK_SIZE);
+        return;
+    }
+
+    sm4_avx2_rk(key, 0, rk);
+    for (; blocks > 0; blocks -= n) {
+        n = blocks < SM4_AVX2_BLOCKS ? blocks : SM4_AVX2_BLOCKS;
+        sm4_avx2_blocks(in, buf, n, rk, &cst);
+        /* |in| and |out| may be the same, keep the last ciphertext block */
+        memcpy(next, in + (n - 1) * SM4_BLOCK_SIZE, SM4_BLOCK_SIZE);
+        for (i = n - 1; i > 0; i--)
+            sm4_xor16(out + i * SM4_BLOCK_SIZE, buf + i * SM4_BLOCK_SIZE,
+                in + (i - 1) * SM4_BLOCK_SIZE);
+        sm4_xor16(out, buf, iv);
+        memcpy(iv, next, SM4_BLOCK_SIZE);
+        in += n * SM4_BLOCK_SIZE;
+        out += n * SM4_BLOCK_SIZE;
+    }
+    memcpy(ivec, iv, SM4_BLOCK_SIZE);
+    OPENSSL_cleanse(buf, sizeof(buf));
+    OPENSSL_cleanse(rk, sizeof(rk));
+}
+
+/*
+ * |blocks| blocks of CTR mode with a 32-bit big-endian counter in the last
+ * word of |ivec|, which is not updated.
+ */
+void ossl_sm4_aesni_avx2_ctr32_encrypt_blocks(const unsigned char *in,
+    unsigned char *out, size_t blocks, const void *key,
+    const unsigned char ivec[16])
+{
+    const SM4_KEY *ks = key;
+    unsigned char buf[SM4_AVX2_BLOCKS * SM4_BLOCK_SIZE];
+    SM4_AVX2_CONST cst;
+    __m128i ctr, one, bswap;
+    size_t n, i;
+
+    sm4_avx2_const_init(&cst);
+    bswap = _mm256_castsi256_si128(cst.bswap);
+    /* Byte swapped words, so that the counter can be added to */
+    ctr = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)ivec), bswap);
+    one = _mm_setr_epi32(0, 0, 0, 1);
+
+    for (; blocks > 0; blocks -= n) {
+        n = blocks < SM4_AVX2_BLOCKS ? blocks : SM4_AVX2_BLOCKS;
+        for (i = 0; i < n; i++) {
+            _mm_storeu_si128((__m128i *)(buf + i * SM4_BLOCK_SIZE),
+                _mm_shuffle_epi8(ctr, bswap));
+            ctr = _mm_add_epi32(ctr, one);
+        }
+        sm4_avx2_blocks(buf, buf, n, ks->rk, &cst);
+        for (i = 0; i < n; i++)
+            sm4_xor16(out + i * SM4_BLOCK_SIZE, in + i * SM4_BLOCK_SIZE,
+                buf + i * SM4_BLOCK_SIZE);
+        in += n * SM4_BLOCK_SIZE;
+        out += n * SM4_BLOCK_SIZE;
+    }
+    OPENSSL_cleanse(buf, sizeof(buf));
+}
+
+static ossl_inline uint64_t sm4_bswap64(uint64_t x)
+{
+    x = (x >> 32) | (x << 32);
+    x = ((x & 0xffff0000ffff0000ULL) >> 16) | ((x & 0x0000ffff0000ffffULL) << 16);
+    return ((x & 0xff00ff00ff00ff00ULL) >> 8) | ((x & 0x00ff00ff00ff00ffULL) << 8);
+}
+
+/*
+ * The next XTS tweak: multiplication by x in the little-endian convention
+ * of IEEE P1619, or in the bit reflected one of GB/T 17964-2021.
+ */
+static ossl_inline void sm4_xts_next(uint64_t t[2], int gb)
+{
+    uint64_t hi, lo, res;
+
+    if (!gb) {
+        res = t[1] >> 63;
+        t[1] = (t[1] << 1) | (t[0] >> 63);
+        t[0] = (t[0] << 1) ^ (0x87 & (0 - res));
+        return;
+    }
+    hi = sm4_bswap64(t[0]);
+    lo = sm4_bswap64(t[1]);
+    res = lo & 1;
+    lo = (lo >> 1) | (hi << 63);
+    hi = (hi >> 1) ^ (0xe1ULL << 56 & (0 - res));
+    t[0] = sm4_bswap64(hi);
+    t[1] = sm4_bswap64(lo);
+}
+
+static void sm4_avx2_xts(const unsigned char *in, unsigned char *out,
+    size_t len, const SM4_KEY *key1, const SM4_KEY *key2,
+    const unsigned char ivec[16], int enc, int gb)
+{
+    unsigned char buf[SM4_AVX2_BLOCKS * SM4_BLOCK_SIZE];
+    uint64_t tw[SM4_AVX2_BLOCKS][2], t[2], t1[2];
+    uint32_t rkbuf[SM4_KEY_SCHEDULE];
+    const uint32_t *rk;
+    SM4_AVX2_CONST cst;
+    size_t blocks = len / SM4_BLOCK_SIZE, rem = len % SM4_BLOCK_SIZE, n, i;
+
+    if (len < SM4_BLOCK_SIZE)
+        return;
+
+    sm4_avx2_const_init(&cst);
+    rk = sm4_avx2_rk(key1, enc, rkbuf);
+    sm4_avx2_blocks(ivec, (unsigned char *)t, 1, key2->rk, &cst);
+
+    /* On decryption the last whole block goes with the stolen bytes */
+    if (rem != 0 && !enc)
+        blocks--;
+
+    for (; blocks > 0; blocks -= n) {
+        n = blocks < SM4_AVX2_BLOCKS ? blocks : SM4_AVX2_BLOCKS;
+        for (i = 0; i < n; i++) {
+            memcpy(tw[i], t, SM4_BLOCK_SIZE);
+            sm4_xts_next(t, gb);
+            sm4_xor16(buf + i * SM4_BLOCK_SIZE, in + i * SM4_BLOCK_SIZE,
+                (unsigned char *)tw[i]);
+        }
+        sm4_avx2_blocks(buf, buf, n, rk, &cst);
+        for (i = 0; i < n; i++)
+            sm4_xor16(out + i * SM4_BLOCK_SIZE, buf + i * SM4_BLOCK_SIZE,
+                (unsigned char *)tw[i]);
+        in += n * SM4_BLOCK_SIZE;
+        out += n * SM4_BLOCK_SIZE;
+    }
+
+    if (rem != 0) {
+        /* Ciphertext stealing */
+        if (enc) {
+            for (i = 0; i < rem; i++) {
+                unsigned char c = in[i];
+
+                out[i] = out[i - SM4_BLOCK_SIZE];
+                buf[i] = c;
+            }
+            memcpy(buf + rem, out - SM4_BLOCK_SIZE + rem, SM4_BLOCK_SIZE - rem);
+            sm4_xor16(buf, buf, (unsigned char *)t);
+            sm4_avx2_blocks(buf, buf, 1, rk, &cst);
+            sm4_xor16(out - SM4_BLOCK_SIZE, buf, (unsigned char *)t);
+        } else {
+            memcpy(t1, t, SM4_BLOCK_SIZE);
+            sm4_xts_next(t1, gb);
+            sm4_xor16(buf, in, (unsigned char *)t1);
+            sm4_avx2_blocks(buf, buf, 1, rk, &cst);
+            sm4_xor16(buf, buf, (unsigned char *)t1);
+            for (i = 0; i < rem; i++) {
+                unsigned char c = in[SM4_BLOCK_SIZE + i];
+
+                out[SM4_BLOCK_SIZE + i] = buf[i];
+                buf[i] = c;
+            }
+            sm4_xor16(buf, buf, (unsigned char *)t);
+            sm4_avx2_blocks(buf, buf, 1, rk, &cst);
+            sm4_xor16(out, buf, (unsigned char *)t);
+        }
+    }
+
+    OPENSSL_cleanse(buf, sizeof(buf));
+    OPENSSL_cleanse(tw, sizeof(tw));
+    OPENSSL_cleanse(rkbuf, sizeof(rkbuf));
+}
+
+void ossl_sm4_aesni_avx2_xts_encrypt(const unsigned char *in,
+    unsigned char *out, size_t len, const SM4_KEY *key1, const SM4_KEY *key2,
+    const unsigned char ivec[16], const int enc)
+{
+    sm4_avx2_xts(in, out, len, key1, key2, ivec, enc, 0);
+}
+
+void ossl_sm4_aesni_avx2_xts_encrypt_gb(const unsigned char *in,
+    unsigned char *out, size_t len, const SM4_KEY *key1, const SM4_KEY *key2,
+    const unsigned char ivec[16], const int enc)
+{
+    sm4_avx2_xts(in, out, len, key1, key2, ivec, enc, 1);
+}
+
+OPENSSL_UNTARGET_REGION
+
+#endif /* SM4_AESNI_AVX2 */
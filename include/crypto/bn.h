@@ -144,3 +144,7 @@ int ossl_bn_mont_ctx_set(BN_MONT_CTX *ctx, const BIGNUM *modulus, int ri,
     uint32_t nlo, uint32_t nhi);
 
 int ossl_bn_mont_ctx_eq(const BN_MONT_CTX *m1, const BN_MONT_CTX *m2);
+
+int ossl_bn_mod_exp_mont_consttime_batch(BIGNUM *rr[], const BIGNUM *const a[],
+    const BIGNUM *const p[], const BIGNUM *const m[],
+    BN_MONT_CTX *const mont[], size_t num, BN_CTX *ctx);
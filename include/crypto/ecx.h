@@ -103,6 +103,12 @@ int ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
     const uint8_t dom2flag, const uint8_t phflag, const uint8_t csflag,
     const uint8_t *context, size_t context_len,
     OSSL_LIB_CTX *libctx, const char *propq);
+int ossl_ed25519_verify_batch(const uint8_t *const tbs[], const size_t tbs_len[],
+    const uint8_t *const sigs[], const size_t sig_lens[],
+    const uint8_t public_key[32],
+    const uint8_t dom2flag, const uint8_t phflag, const uint8_t csflag,
+    const uint8_t *context, size_t context_len,
+    int results[], size_t n, OSSL_LIB_CTX *libctx, const char *propq);
 int ossl_ed25519_pubkey_verify(const uint8_t *pub, size_t pub_len);
 int ossl_ed448_public_from_private(OSSL_LIB_CTX *ctx, uint8_t out_public_key[57],
     const uint8_t private_key[57], const char *propq);
@@ -17,4 +17,10 @@ void err_cleanup(void);
 int err_shelve_state(void **);
 void err_unshelve_state(void *);
 
+/*
+ * Returns 1 if |fn| returns 1 for each error raised since the last mark, or
+ * if there is none, and 0 otherwise.
+ */
+int ossl_err_all_to_mark(int (*fn)(unsigned long e));
+
 #endif
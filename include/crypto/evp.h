@@ -14,6 +14,7 @@
 #include <openssl/evp.h>
 #include <openssl/core_dispatch.h>
 #include "internal/refcount.h"
+#include "internal/rcu.h"
 #include "crypto/ecx.h"
 
 /*
@@ -160,6 +161,7 @@ struct evp_mac_st {
     OSSL_FUNC_mac_get_ctx_params_fn *get_ctx_params;
     OSSL_FUNC_mac_set_ctx_params_fn *set_ctx_params;
     OSSL_FUNC_mac_init_skey_fn *init_skey;
+    OSSL_FUNC_mac_batch_fn *batch;
 };
 
 struct evp_kdf_st {
@@ -220,6 +222,7 @@ struct evp_md_st {
     OSSL_FUNC_digest_gettable_ctx_params_fn *gettable_ctx_params;
     OSSL_FUNC_digest_serialize_fn *serialize;
     OSSL_FUNC_digest_deserialize_fn *deserialize;
+    OSSL_FUNC_digest_batch_fn *batch;
 } /* EVP_MD */;
 
 struct evp_cipher_st {
@@ -335,13 +338,17 @@ int evp_cipher_asn1_to_param_ex(EVP_CIPHER_CTX *c, ASN1_TYPE *type,
  * provider "origin") implements exports, and that the target provider
  * has an EVP_KEYMGMT that implements import.
  */
-typedef struct {
+typedef struct op_cache_elem_st OP_CACHE_ELEM;
+
+struct op_cache_elem_st {
     EVP_KEYMGMT *keymgmt;
     void *keydata;
     int selection;
-} OP_CACHE_ELEM;
-
-DEFINE_STACK_OF(OP_CACHE_ELEM)
+    /* The "origin" dirty count at the time this element was added */
+    size_t dirty_cnt;
+    /* The next (older) element, never changed once the element is added */
+    OP_CACHE_ELEM *next;
+};
 
 /*
  * An EVP_PKEY can have the following states:
@@ -451,8 +458,15 @@ struct evp_pkey_st {
      * those providers, and maintain a cache of the imported keydata,
      * so we don't need to redo the export/import every time we perform
      * the same operation in that same provider.
+     * The cache is a list that is only ever added to at the head, with
+     * |lock| held for writing, so that it can be searched without holding
+     * |lock| by all the threads using a shared key.  Those searches hold
+     * |operation_cache_rcu| for reading instead, which is created with the
+     * first cached element.  When the "origin" changes, the list is unlinked
+     * and freed once no search can still be walking it.
      */
-    STACK_OF(OP_CACHE_ELEM) *operation_cache;
+    OP_CACHE_ELEM *operation_cache;
+    CRYPTO_RCU_LOCK *operation_cache_rcu;
 
     /*
      * We keep a copy of that "origin"'s dirty count, so we know if the
@@ -538,6 +552,7 @@ OP_CACHE_ELEM *evp_keymgmt_util_find_operation_cache(EVP_PKEY *pk,
     EVP_KEYMGMT *keymgmt,
     int selection);
 void evp_keymgmt_util_clear_operation_cache(EVP_PKEY *pk);
+void evp_keymgmt_util_retire_operation_cache(EVP_PKEY *pk);
 int evp_keymgmt_util_cache_keydata(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
     void *keydata, int selection);
 void evp_keymgmt_util_cache_keyinfo(EVP_PKEY *pk);
@@ -17,6 +17,7 @@
 #pragma once
 #ifndef OPENSSL_NO_LMS
 #include "types.h"
+#include <openssl/crypto.h>
 #include <openssl/params.h>
 
 /*
@@ -135,12 +136,32 @@ typedef struct lms_pub_key_st {
     unsigned char *K;
 } LMS_PUB_KEY;
 
+/*
+ * The maximum number of levels below the root of a LMS tree whose nodes are
+ * cached, see lms_verify.c
+ */
+#define LMS_NODE_CACHE_HEIGHT 8
+
+/*
+ * Internal tree nodes that have been authenticated by a successful signature
+ * verification, which are used to shortcut later verifications with the same
+ * public key.  The cache is not part of the value of the key: verification
+ * updates it through a const LMS_KEY, so verification only accesses it with
+ * |lock| held.
+ */
+typedef struct lms_node_cache_st {
+    CRYPTO_RWLOCK *lock;
+    unsigned char *nodes; /* n bytes per node, indexed by the node number */
+    unsigned char *valid; /* Set to 1 for each node that has been cached */
+} LMS_NODE_CACHE;
+
 typedef struct lms_key_st {
     const LMS_PARAMS *lms_params;
     const LM_OTS_PARAMS *ots_params;
     OSSL_LIB_CTX *libctx;
     unsigned char *Id; /* A pointer to 16 bytes (I[16]) */
     LMS_PUB_KEY pub;
+    LMS_NODE_CACHE *cache;
 } LMS_KEY;
 
 const LMS_PARAMS *ossl_lms_params_get(uint32_t lms_type);
@@ -148,6 +169,7 @@ const LM_OTS_PARAMS *ossl_lm_ots_params_get(uint32_t ots_type);
 
 LMS_KEY *ossl_lms_key_new(OSSL_LIB_CTX *libctx);
 void ossl_lms_key_free(LMS_KEY *lmskey);
+void ossl_lms_key_clear_cache(LMS_KEY *lmskey);
 int ossl_lms_key_equal(const LMS_KEY *key1, const LMS_KEY *key2, int selection);
 int ossl_lms_key_valid(const LMS_KEY *key, int selection);
 int ossl_lms_key_has(const LMS_KEY *key, int selection);
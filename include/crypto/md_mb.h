@@ -0,0 +1,79 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_CRYPTO_MD_MB_H
+#define OSSL_CRYPTO_MD_MB_H
+#pragma once
+
+/*
+ * Shared parts of the multi-buffer digests, which hash a batch of messages
+ * that all continue from the same Merkle-Damgard state several at a time,
+ * one message in each lane of a kernel.  The digest supplies the kernel and
+ * a |lanes| function that hashes up to a kernel's worth of messages.
+ */
+
+#include <string.h>
+#include <openssl/byteorder.h>
+#include <openssl/e_os2.h>
+
+/*
+ * Hash the |lanes| messages in[i] of inl[i] bytes, in turn appended to the
+ * state |c|, into out[i].  Returns 0, before doing anything, if the messages
+ * cannot go through the kernel.
+ */
+typedef int OSSL_MD_MB_LANES_FN(const void *c,
+    const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[], size_t lanes);
+
+/*
+ * Run |lanes| over the |n| messages of a batch, |max| at a time, for as long
+ * as there are at least |min| left.  Returns the number of messages done;
+ * the caller finishes the rest one at a time.
+ */
+static ossl_inline size_t ossl_md_mb_batch(const void *c,
+    const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[], size_t n, size_t max, size_t min,
+    OSSL_MD_MB_LANES_FN *lanes)
+{
+    size_t i, k;
+
+    for (i = 0; n - i >= min; i += k) {
+        k = n - i < max ? n - i : max;
+        if (!lanes(c, in + i, inl + i, out + i, k))
+            break;
+    }
+    return i;
+}
+
+/*
+ * Write the padded last one or two |cblock| byte blocks of the |inl| byte
+ * message |in| to |tail|, with the total length in bits in the last |lenlen|
+ * bytes, which is 8 or 16.  |hi| and |lo| are the number of bits hashed
+ * before the message.  Returns the number of blocks written.
+ */
+static ossl_inline size_t ossl_md_mb_pad(unsigned char *tail,
+    const unsigned char *in, size_t inl, size_t cblock, size_t lenlen,
+    uint64_t hi, uint64_t lo)
+{
+    size_t rem = inl % cblock;
+    size_t nblk = rem + 1 + lenlen > cblock ? 2 : 1;
+    uint64_t bits = lo + ((uint64_t)inl << 3);
+
+    memset(tail, 0, nblk * cblock);
+    if (rem > 0)
+        memcpy(tail, in + inl - rem, rem);
+    tail[rem] = 0x80;
+    if (lenlen == 16)
+        OPENSSL_store_u64_be(tail + nblk * cblock - 16,
+            hi + ((uint64_t)inl >> 61) + (bits < lo));
+    OPENSSL_store_u64_be(tail + nblk * cblock - 8, bits);
+    return nblk;
+}
+
+#endif
@@ -108,6 +108,7 @@ __owur const char *ossl_ml_dsa_key_get_name(const ML_DSA_KEY *key);
 OSSL_LIB_CTX *ossl_ml_dsa_key_get0_libctx(const ML_DSA_KEY *key);
 
 __owur int ossl_ml_dsa_key_public_from_private(ML_DSA_KEY *key);
+__owur int ossl_ml_dsa_key_precompute(ML_DSA_KEY *key, int enable);
 __owur int ossl_ml_dsa_pk_decode(ML_DSA_KEY *key, const uint8_t *in, size_t in_len);
 __owur int ossl_ml_dsa_sk_decode(ML_DSA_KEY *key, const uint8_t *in, size_t in_len);
 
@@ -129,5 +130,10 @@ __owur int ossl_ml_dsa_verify(const ML_DSA_KEY *pub, int msg_is_mu,
     const uint8_t *msg, size_t msg_len,
     const uint8_t *context, size_t context_len,
     int encode, const uint8_t *sig, size_t sig_len);
+__owur int ossl_ml_dsa_verify_batch(const ML_DSA_KEY *pub, int msg_is_mu,
+    const uint8_t *const msgs[], const size_t msg_lens[],
+    const uint8_t *context, size_t context_len, int encode,
+    const uint8_t *const sigs[], const size_t sig_lens[],
+    int results[], size_t n);
 
 #endif /* OSSL_CRYPTO_SLH_DSA_H */
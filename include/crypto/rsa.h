@@ -115,6 +115,9 @@ int ossl_rsa_verify(int dtype, const unsigned char *m,
     size_t siglen, RSA *rsa);
 
 const unsigned char *ossl_rsa_digestinfo_encoding(int md_nid, size_t *len);
+int ossl_rsa_private_encrypt_batch(RSA *rsa, size_t num,
+    const unsigned char *const from[], const size_t flen[],
+    unsigned char *const to[], int padding);
 
 extern const char *ossl_rsa_mp_factor_names[];
 extern const char *ossl_rsa_mp_exp_names[];
@@ -20,10 +20,44 @@ int ossl_sha256_192_init(SHA256_CTX *c);
 int sha512_224_init(SHA512_CTX *);
 int sha512_256_init(SHA512_CTX *);
 int ossl_sha1_ctrl(SHA_CTX *ctx, int cmd, int mslen, void *ms);
+
+/*
+ * Finish each of the |n| messages in[i] of inl[i] bytes, in turn appended to
+ * the state of |c|, into out[i].  The state itself is left unchanged.
+ */
+int ossl_sha1_batch(const SHA_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n);
+int ossl_sha256_batch(const SHA256_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n);
+int ossl_sha512_batch(const SHA512_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n);
 #endif
 
 unsigned char *ossl_sha1(const unsigned char *d, size_t n, unsigned char *md);
 
+/*
+ * The multi-buffer SHA-1 and SHA-256 code for x86_64 hashes up to eight
+ * independent messages at once.  The state keeps word j of the eight lanes
+ * together, A[] for the first word, B[] for the second and so on, and each
+ * lane hashes |blocks| whole blocks from |ptr|.  The last argument is the
+ * number of groups of four lanes.
+ */
+typedef struct {
+    unsigned int A[8], B[8], C[8], D[8], E[8];
+} SHA1_MB_CTX;
+
+typedef struct {
+    unsigned int A[8], B[8], C[8], D[8], E[8], F[8], G[8], H[8];
+} SHA256_MB_CTX;
+
+typedef struct {
+    const unsigned char *ptr;
+    int blocks;
+} HASH_DESC;
+
+void sha1_multi_block(SHA1_MB_CTX *, const HASH_DESC *, int);
+void sha256_multi_block(SHA256_MB_CTX *, const HASH_DESC *, int);
+
 int ossl_sp800_185_right_encode(unsigned char *out,
     size_t out_max_len, size_t *out_len,
     size_t bits);
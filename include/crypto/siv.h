@@ -29,6 +29,18 @@ int ossl_siv128_encrypt(SIV128_CONTEXT *ctx,
     const unsigned char *in, unsigned char *out, size_t len);
 int ossl_siv128_decrypt(SIV128_CONTEXT *ctx,
     const unsigned char *in, unsigned char *out, size_t len);
+/*
+ * Batches of messages under the same key, with a D block per message kept by
+ * the caller.  It starts as the D of a freshly initialised context.
+ */
+int ossl_siv128_aad_batch(SIV128_CONTEXT *ctx, union siv_block_u *d,
+    const unsigned char *const aad[], const size_t len[], size_t n);
+int ossl_siv128_encrypt_batch(SIV128_CONTEXT *ctx, union siv_block_u *d,
+    union siv_block_u *tag, const unsigned char *const in[],
+    unsigned char *const out[], const size_t len[], size_t n);
+int ossl_siv128_decrypt_batch(SIV128_CONTEXT *ctx, union siv_block_u *d,
+    const union siv_block_u *tag, const unsigned char *const in[],
+    unsigned char *const out[], const size_t len[], size_t n);
 int ossl_siv128_finish(SIV128_CONTEXT *ctx);
 int ossl_siv128_set_tag(SIV128_CONTEXT *ctx, const unsigned char *tag,
     size_t len);
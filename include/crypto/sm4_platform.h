@@ -56,6 +56,7 @@ void rv64i_zvksed_sm4_cbc_decrypt(const unsigned char *in, unsigned char *out,
 #elif (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64))
 /* Intel x86_64 support */
 #include "internal/cryptlib.h"
+#include "internal/target_region.h"
 #define HWSM4_CAPABLE_X86_64 \
     ((OPENSSL_ia32cap_P[2] & (1 << 5)) && (OPENSSL_ia32cap_P[5] & (1 << 2)))
 int hw_x86_64_sm4_set_key(const unsigned char *userKey, SM4_KEY *key);
@@ -64,6 +65,29 @@ void hw_x86_64_sm4_encrypt(const unsigned char *in, unsigned char *out,
     const SM4_KEY *key);
 void hw_x86_64_sm4_decrypt(const unsigned char *in, unsigned char *out,
     const SM4_KEY *key);
+/* Without the SM4 instructions, the S-box can be computed with AES-NI */
+#if !defined(_M_ARM64EC)
+#if defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define SM4_AESNI_AVX2
+#define SM4_AESNI_AVX2_CAPABLE \
+    ((OPENSSL_ia32cap_P[1] & (1u << 25)) && (OPENSSL_ia32cap_P[2] & (1u << 5)))
+void ossl_sm4_aesni_avx2_cbc_encrypt(const unsigned char *in,
+    unsigned char *out, size_t length, const SM4_KEY *key,
+    unsigned char *ivec, const int enc);
+void ossl_sm4_aesni_avx2_ecb_encrypt(const unsigned char *in,
+    unsigned char *out, size_t length, const SM4_KEY *key,
+    const int enc);
+void ossl_sm4_aesni_avx2_ctr32_encrypt_blocks(const unsigned char *in,
+    unsigned char *out, size_t blocks, const void *key,
+    const unsigned char ivec[16]);
+void ossl_sm4_aesni_avx2_xts_encrypt(const unsigned char *in,
+    unsigned char *out, size_t len, const SM4_KEY *key1,
+    const SM4_KEY *key2, const unsigned char ivec[16], const int enc);
+void ossl_sm4_aesni_avx2_xts_encrypt_gb(const unsigned char *in,
+    unsigned char *out, size_t len, const SM4_KEY *key1,
+    const SM4_KEY *key2, const unsigned char ivec[16], const int enc);
+#endif
+#endif /* !defined(_M_ARM64EC) */
 #endif
 #endif /* OPENSSL_CPUID_OBJ */
 
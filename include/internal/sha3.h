@@ -49,6 +49,7 @@ struct keccak_st {
 };
 
 KECCAK1600_CTX *ossl_shake256_new(void);
+int ossl_shake_init(KECCAK1600_CTX *ctx, size_t bitlen);
 void ossl_sha3_reset(KECCAK1600_CTX *ctx);
 int ossl_sha3_init(KECCAK1600_CTX *ctx, unsigned char pad, size_t bitlen);
 int ossl_keccak_init(KECCAK1600_CTX *ctx, unsigned char pad,
@@ -70,6 +71,20 @@ size_t SHA3_absorb(uint64_t A[5][5], const unsigned char *inp, size_t len,
     && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
     && !defined(OPENSSL_NO_ASM)
 
+#define KECCAK1600_AVX512 1
+
+/* Runtime capability check for AVX512F, single-buffer Keccak */
+int SHA3_avx512_capable(void);
+
+size_t SHA3_absorb_avx512(uint64_t A[5][5], const unsigned char *inp,
+    size_t len, size_t r);
+void SHA3_squeeze_avx512(uint64_t A[5][5], unsigned char *out, size_t len,
+    size_t r, int next);
+
+size_t ossl_sha3_absorb_avx512(KECCAK1600_CTX *ctx, const unsigned char *inp, size_t len);
+int ossl_sha3_final_avx512(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen);
+int ossl_shake_squeeze_avx512(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen);
+
 /* Runtime capability check for AVX512VL */
 int SHA3_avx512vl_capable(void);
 
@@ -134,6 +149,22 @@ void ossl_sha3_shake256_x4_avx512vl(
     const void *in2, const void *in3,
     size_t inlen);
 
+/*
+ * Hash four messages of |inlen| bytes on top of the state of |ctx|, which
+ * must be empty-buffered and have the SHAKE128 or SHAKE256 rate, and squeeze
+ * |outlen| bytes of each.
+ */
+void ossl_sha3_x4_hash_avx512vl(const KECCAK1600_CTX *ctx,
+    const unsigned char *const in[4], size_t inlen,
+    unsigned char *const out[4], size_t outlen);
+
+/*
+ * Absorb |len| bytes, a multiple of the rate, of four messages on top of the
+ * state of |ctx| and leave the results in the four contexts |lanes|.
+ */
+void ossl_sha3_x4_absorb_avx512vl(const KECCAK1600_CTX *ctx,
+    const unsigned char *const in[4], size_t len, KECCAK1600_CTX *lanes[4]);
+
 #endif /* KECCAK1600_ASM && x86_64 && !OPENSSL_NO_ASM */
 
 #endif /* OSSL_INTERNAL_SHA3_H */
@@ -38,4 +38,11 @@ int ossl_sm3_init(SM3_CTX *c);
 int ossl_sm3_update(SM3_CTX *c, const void *data, size_t len);
 int ossl_sm3_final(unsigned char *md, SM3_CTX *c);
 
+/*
+ * Hash |n| messages that each continue from the state of |c| and write
+ * their digests to |out|, |c| itself is left unchanged.
+ */
+int ossl_sm3_batch(const SM3_CTX *c, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t n);
+
 #endif /* OSSL_INTERNAL_SM3_H */
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_INTERNAL_TARGET_REGION_H
+#define OSSL_INTERNAL_TARGET_REGION_H
+#pragma once
+
+/*
+ * The functions between OPENSSL_TARGET_REGION(T) and OPENSSL_UNTARGET_REGION
+ * are compiled for the instruction set extensions listed in T, e.g. "avx2",
+ * so that they can use the matching intrinsics while the rest of the file
+ * is compiled for the baseline.  The caller must check that the CPU
+ * supports T before calling any of them.
+ */
+
+#define OSSL_TARGET_STRINGIFY_(a) #a
+#define OSSL_TARGET_STRINGIFY(a) OSSL_TARGET_STRINGIFY_(a)
+
+#ifdef __clang__
+/*
+ * clang does not have GCC push pop
+ * warning: clang attribute push can't be used within a namespace in clang up
+ * til 8.0 so OPENSSL_TARGET_REGION and OPENSSL_UNTARGET_REGION must be
+ * outside* of a namespace.
+ */
+#define OPENSSL_TARGET_REGION(T)                         \
+    _Pragma(OSSL_TARGET_STRINGIFY(clang attribute push( \
+        __attribute__((target(T))), apply_to = function)))
+#define OPENSSL_UNTARGET_REGION _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+#define OPENSSL_TARGET_REGION(T) \
+    _Pragma("GCC push_options") _Pragma(OSSL_TARGET_STRINGIFY(GCC target(T)))
+#define OPENSSL_UNTARGET_REGION _Pragma("GCC pop_options")
+#endif /* clang then gcc */
+
+/* Default target region macros don't do anything. */
+#ifndef OPENSSL_TARGET_REGION
+#define OPENSSL_TARGET_REGION(T)
+#define OPENSSL_UNTARGET_REGION
+#endif
+
+/*
+ * Defined when the compiler has the intrinsics of extensions that the rest
+ * of the file is not compiled for: clang, GCC 8 and later, and MSVC 2019 and
+ * later, which needs no target region for them.
+ */
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 8)) \
+    || (defined(_MSC_VER) && (_MSC_VER >= 1920))
+#define OPENSSL_TARGET_REGION_INTRINSICS
+#endif
+
+#endif
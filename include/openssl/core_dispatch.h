@@ -317,6 +317,7 @@ OSSL_CORE_MAKE_FUNC(int, SSL_QUIC_TLS_alert,
 #define OSSL_FUNC_DIGEST_COPYCTX 15
 #define OSSL_FUNC_DIGEST_SERIALIZE 16
 #define OSSL_FUNC_DIGEST_DESERIALIZE 17
+#define OSSL_FUNC_DIGEST_BATCH 18
 
 OSSL_CORE_MAKE_FUNC(void *, digest_newctx, (void *provctx))
 OSSL_CORE_MAKE_FUNC(int, digest_init, (void *dctx, const OSSL_PARAM params[]))
@@ -331,6 +332,9 @@ OSSL_CORE_MAKE_FUNC(int, digest_squeeze,
 OSSL_CORE_MAKE_FUNC(int, digest_digest,
     (void *provctx, const unsigned char *in, size_t inl,
         unsigned char *out, size_t *outl, size_t outsz))
+OSSL_CORE_MAKE_FUNC(int, digest_batch,
+    (void *dctx, const unsigned char *const in[], const size_t inl[],
+        unsigned char *const out[], size_t outsz, size_t n))
 
 OSSL_CORE_MAKE_FUNC(void, digest_freectx, (void *dctx))
 OSSL_CORE_MAKE_FUNC(void *, digest_dupctx, (void *dctx))
@@ -435,6 +439,7 @@ OSSL_CORE_MAKE_FUNC(int, cipher_decrypt_skey_init, (void *cctx, void *skeydata,
 #define OSSL_FUNC_MAC_GETTABLE_CTX_PARAMS 11
 #define OSSL_FUNC_MAC_SETTABLE_CTX_PARAMS 12
 #define OSSL_FUNC_MAC_INIT_SKEY 13
+#define OSSL_FUNC_MAC_BATCH 14
 
 OSSL_CORE_MAKE_FUNC(void *, mac_newctx, (void *provctx))
 OSSL_CORE_MAKE_FUNC(void *, mac_dupctx, (void *src))
@@ -456,6 +461,9 @@ OSSL_CORE_MAKE_FUNC(int, mac_get_ctx_params,
 OSSL_CORE_MAKE_FUNC(int, mac_set_ctx_params,
     (void *mctx, const OSSL_PARAM params[]))
 OSSL_CORE_MAKE_FUNC(int, mac_init_skey, (void *mctx, void *key, const OSSL_PARAM params[]))
+OSSL_CORE_MAKE_FUNC(int, mac_batch,
+    (void *mctx, const unsigned char *const in[], const size_t inl[],
+        unsigned char *const out[], size_t outsize, size_t n))
 
 /*-
  * Symmetric key management
@@ -826,10 +834,15 @@ OSSL_CORE_MAKE_FUNC(void *, keyexch_derive_skey, (void *ctx, const char *key_typ
 #define OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_INIT 30
 #define OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_UPDATE 31
 #define OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_FINAL 32
+#define OSSL_FUNC_SIGNATURE_SIGN_BATCH 33
+#define OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_BATCH 34
 
 OSSL_CORE_MAKE_FUNC(void *, signature_newctx, (void *provctx, const char *propq))
 OSSL_CORE_MAKE_FUNC(int, signature_sign_init, (void *ctx, void *provkey, const OSSL_PARAM params[]))
 OSSL_CORE_MAKE_FUNC(int, signature_sign, (void *ctx, unsigned char *sig, size_t *siglen, size_t sigsize, const unsigned char *tbs, size_t tbslen))
+OSSL_CORE_MAKE_FUNC(int, signature_sign_batch,
+    (void *ctx, unsigned char *const sigs[], size_t siglens[],
+        const unsigned char *const tbs[], const size_t tbslens[], size_t n))
 OSSL_CORE_MAKE_FUNC(int, signature_sign_message_init,
     (void *ctx, void *provkey, const OSSL_PARAM params[]))
 OSSL_CORE_MAKE_FUNC(int, signature_sign_message_update,
@@ -848,6 +861,10 @@ OSSL_CORE_MAKE_FUNC(int, signature_verify_message_update,
  * is specified via an OSSL_PARAM.
  */
 OSSL_CORE_MAKE_FUNC(int, signature_verify_message_final, (void *ctx))
+OSSL_CORE_MAKE_FUNC(int, signature_verify_message_batch,
+    (void *ctx, const unsigned char *const sigs[], const size_t siglens[],
+        const unsigned char *const tbs[], const size_t tbslens[],
+        int results[], size_t n))
 OSSL_CORE_MAKE_FUNC(int, signature_verify_recover_init,
     (void *ctx, void *provkey, const OSSL_PARAM params[]))
 OSSL_CORE_MAKE_FUNC(int, signature_verify_recover,
@@ -658,6 +658,9 @@ __owur int EVP_DigestFinalXOF(EVP_MD_CTX *ctx, unsigned char *out,
     size_t outlen);
 __owur int EVP_DigestSqueeze(EVP_MD_CTX *ctx, unsigned char *out,
     size_t outlen);
+__owur int EVP_DigestBatch(EVP_MD_CTX *ctx, const unsigned char *const *in,
+    const size_t *inlens, unsigned char *const *out,
+    size_t outsize, size_t n);
 __owur int EVP_MD_CTX_serialize(EVP_MD_CTX *ctx, unsigned char *out,
     size_t *outlen);
 __owur int EVP_MD_CTX_deserialize(EVP_MD_CTX *ctx, const unsigned char *in,
@@ -1193,6 +1196,9 @@ int EVP_MAC_update(EVP_MAC_CTX *ctx, const unsigned char *data, size_t datalen);
 int EVP_MAC_final(EVP_MAC_CTX *ctx,
     unsigned char *out, size_t *outl, size_t outsize);
 int EVP_MAC_finalXOF(EVP_MAC_CTX *ctx, unsigned char *out, size_t outsize);
+int EVP_MAC_batch(EVP_MAC_CTX *ctx,
+    const unsigned char *const *in, const size_t *inlens,
+    unsigned char *const *out, size_t outsize, size_t n);
 const OSSL_PARAM *EVP_MAC_gettable_params(const EVP_MAC *mac);
 const OSSL_PARAM *EVP_MAC_gettable_ctx_params(const EVP_MAC *mac);
 const OSSL_PARAM *EVP_MAC_settable_ctx_params(const EVP_MAC *mac);
@@ -1777,6 +1783,9 @@ int EVP_PKEY_sign_init_ex2(EVP_PKEY_CTX *ctx,
 int EVP_PKEY_sign(EVP_PKEY_CTX *ctx,
     unsigned char *sig, size_t *siglen,
     const unsigned char *tbs, size_t tbslen);
+int EVP_PKEY_sign_batch(EVP_PKEY_CTX *ctx,
+    unsigned char *const *sigs, size_t *siglens,
+    const unsigned char *const *tbs, const size_t *tbslens, size_t n);
 int EVP_PKEY_sign_message_init(EVP_PKEY_CTX *ctx,
     EVP_SIGNATURE *algo, const OSSL_PARAM params[]);
 int EVP_PKEY_sign_message_update(EVP_PKEY_CTX *ctx,
@@ -1795,6 +1804,10 @@ int EVP_PKEY_verify_message_init(EVP_PKEY_CTX *ctx,
 int EVP_PKEY_verify_message_update(EVP_PKEY_CTX *ctx,
     const unsigned char *in, size_t inlen);
 int EVP_PKEY_verify_message_final(EVP_PKEY_CTX *ctx);
+int EVP_PKEY_verify_message_batch(EVP_PKEY_CTX *ctx,
+    const unsigned char *const *sigs, const size_t *siglens,
+    const unsigned char *const *tbs, const size_t *tbslens,
+    int *results, size_t n);
 int EVP_PKEY_verify_recover_init(EVP_PKEY_CTX *ctx);
 int EVP_PKEY_verify_recover_init_ex(EVP_PKEY_CTX *ctx,
     const OSSL_PARAM params[]);
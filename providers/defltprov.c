@@ -144,6 +144,10 @@ static const OSSL_ALGORITHM deflt_digests[] = {
     { PROV_NAMES_BLAKE2B_512, "provider=default", ossl_blake2b512_functions },
 #endif /* OPENSSL_NO_BLAKE2 */
 
+#ifndef OPENSSL_NO_BLAKE3
+    { PROV_NAMES_BLAKE3, "provider=default", ossl_blake3_functions },
+#endif /* OPENSSL_NO_BLAKE3 */
+
 #ifndef OPENSSL_NO_SM3
     { PROV_NAMES_SM3, "provider=default", ossl_sm3_functions },
 #endif /* OPENSSL_NO_SM3 */
@@ -342,6 +346,9 @@ static const OSSL_ALGORITHM deflt_macs[] = {
     { PROV_NAMES_BLAKE2BMAC, "provider=default", ossl_blake2bmac_functions },
     { PROV_NAMES_BLAKE2SMAC, "provider=default", ossl_blake2smac_functions },
 #endif
+#ifndef OPENSSL_NO_BLAKE3
+    { PROV_NAMES_BLAKE3MAC, "provider=default", ossl_blake3mac_functions },
+#endif
 #ifndef OPENSSL_NO_CMAC
     { PROV_NAMES_CMAC, "provider=default", ossl_cmac_functions },
 #endif
@@ -16,10 +16,15 @@
 
 /* Dispatch functions for AES CCM mode */
 
+#include <openssl/proverr.h>
 #include "cipher_aes_ccm.h"
 #include "prov/implementations.h"
 #include "prov/providercommon.h"
 
+#ifndef FIPS_MODULE
+#include "providers/implementations/ciphers/cipher_aes_ccm.inc"
+#endif
+
 static void *aes_ccm_newctx(void *provctx, size_t keybits)
 {
     PROV_AES_CCM_CTX *ctx;
@@ -50,21 +55,432 @@ static void *aes_ccm_dupctx(void *provctx)
      * the memduped copy
      */
     dupctx->base.ccm_ctx.key = &dupctx->ccm.ks.ks;
+#ifndef FIPS_MODULE
+    dupctx->pipes = NULL;
+#endif
 
     return dupctx;
 }
 
+#ifndef FIPS_MODULE
+static void aes_ccm_pipes_clear_aad(PROV_AES_CCM_PIPES *pipes)
+{
+    size_t i;
+
+    for (i = 0; i < EVP_MAX_PIPES; i++) {
+        OPENSSL_free(pipes->aad[i]);
+        pipes->aad[i] = NULL;
+        pipes->aadlen[i] = 0;
+        pipes->aadsize[i] = 0;
+    }
+}
+
+static void aes_ccm_pipes_free(PROV_AES_CCM_PIPES *pipes)
+{
+    if (pipes == NULL)
+        return;
+    aes_ccm_pipes_clear_aad(pipes);
+    OPENSSL_clear_free(pipes, sizeof(*pipes));
+}
+#endif
+
 static OSSL_FUNC_cipher_freectx_fn aes_ccm_freectx;
 static void aes_ccm_freectx(void *vctx)
 {
     PROV_AES_CCM_CTX *ctx = (PROV_AES_CCM_CTX *)vctx;
 
+#ifndef FIPS_MODULE
+    aes_ccm_pipes_free(ctx->pipes);
+#endif
     OPENSSL_clear_free(ctx, sizeof(*ctx));
 }
 
+#ifdef FIPS_MODULE
+
 /* ossl_aes128ccm_functions */
 IMPLEMENT_aead_cipher(aes, ccm, CCM, AEAD_FLAGS, 128, 8, 96);
 /* ossl_aes192ccm_functions */
 IMPLEMENT_aead_cipher(aes, ccm, CCM, AEAD_FLAGS, 192, 8, 96);
 /* ossl_aes256ccm_functions */
 IMPLEMENT_aead_cipher(aes, ccm, CCM, AEAD_FLAGS, 256, 8, 96);
+
+#else
+
+static OSSL_FUNC_cipher_set_ctx_params_fn aes_ccm_set_ctx_params;
+
+/*-
+ * The pipelined interface processes one whole message per pipe: the AAD is
+ * passed with a NULL output, then the payload with a single update.  The
+ * message lengths are only known at the payload update, so the AAD is
+ * buffered until then.
+ */
+static int aes_ccm_pipeline_init(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[], int enc)
+{
+    PROV_AES_CCM_CTX *ctx = (PROV_AES_CCM_CTX *)vctx;
+    PROV_AES_CCM_PIPES *pipes;
+    size_t i;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (numpipes == 0 || numpipes > EVP_MAX_PIPES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_INPUT_LENGTH);
+        return 0;
+    }
+    if (ctx->pipes == NULL
+        && (ctx->pipes = OPENSSL_zalloc(sizeof(*ctx->pipes))) == NULL)
+        return 0;
+    pipes = ctx->pipes;
+
+    /* Nonces never carry over to the next operation */
+    aes_ccm_pipes_clear_aad(pipes);
+    pipes->numpipes = numpipes;
+    pipes->iv_set = 0;
+    pipes->tag_set = 0;
+    ctx->base.enc = enc;
+
+    if (iv != NULL) {
+        /* The nonce length selects L, as a single nonce length param would */
+        if (ivlen < 7 || ivlen > 13) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_IV_LENGTH);
+            return 0;
+        }
+        ctx->base.l = 15 - ivlen;
+        for (i = 0; i < numpipes; i++) {
+            if (iv[i] == NULL) {
+                ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_IV_LENGTH);
+                return 0;
+            }
+            memcpy(pipes->iv[i], iv[i], ivlen);
+        }
+        pipes->iv_set = 1;
+    }
+    if (key != NULL) {
+        if (keylen != ctx->base.keylen) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+            return 0;
+        }
+        /* M and L are part of the key setup, it is done at the payload */
+        memcpy(pipes->key, key, keylen);
+        pipes->key_set = 1;
+    }
+    return aes_ccm_set_ctx_params(ctx, params);
+}
+
+static OSSL_FUNC_cipher_pipeline_encrypt_init_fn aes_ccm_pipeline_einit;
+static int aes_ccm_pipeline_einit(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    return aes_ccm_pipeline_init(vctx, key, keylen, numpipes, iv, ivlen,
+        params, 1);
+}
+
+static OSSL_FUNC_cipher_pipeline_decrypt_init_fn aes_ccm_pipeline_dinit;
+static int aes_ccm_pipeline_dinit(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    return aes_ccm_pipeline_init(vctx, key, keylen, numpipes, iv, ivlen,
+        params, 0);
+}
+
+static int aes_ccm_pipeline_add_aad(PROV_AES_CCM_PIPES *pipes, size_t i,
+    const unsigned char *aad, size_t alen)
+{
+    size_t need = pipes->aadlen[i] + alen;
+
+    if (alen == 0)
+        return 1;
+    if (need < alen) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_INPUT_LENGTH);
+        return 0;
+    }
+    if (need > pipes->aadsize[i]) {
+        size_t sz = need < 64 ? 64 : need + need / 2;
+        unsigned char *p = OPENSSL_realloc(pipes->aad[i], sz);
+
+        if (p == NULL)
+            return 0;
+        pipes->aad[i] = p;
+        pipes->aadsize[i] = sz;
+    }
+    memcpy(pipes->aad[i] + pipes->aadlen[i], aad, alen);
+    pipes->aadlen[i] = need;
+    return 1;
+}
+
+/* Encrypt or decrypt all pipes, |in| and |out| are NULL for empty payloads */
+static int aes_ccm_pipeline_cipher(PROV_AES_CCM_CTX *ctx, size_t numpipes,
+    unsigned char **out, const unsigned char **in,
+    const size_t *inl)
+{
+    PROV_CCM_CTX *base = &ctx->base;
+    PROV_AES_CCM_PIPES *pipes = ctx->pipes;
+    static const unsigned char empty[1] = { 0 };
+    size_t i, ivlen = 15 - base->l;
+    int ok = 1;
+
+    if (!base->enc && !pipes->tag_set) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_TAG_NOT_SET);
+        return 0;
+    }
+    for (i = 0; i < numpipes; i++) {
+        size_t len = in != NULL ? inl[i] : 0;
+
+        if (base->l < 8 && (len >> (8 * base->l)) != 0) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_INPUT_LENGTH);
+            return 0;
+        }
+    }
+    if (!base->hw->setkey(base, pipes->key, base->keylen))
+        return 0;
+
+#ifdef AES_CCM_MB_AESNI
+    if (numpipes >= AES_CCM_MB_MIN_LANES
+        && base->hw == ossl_prov_aes_hw_ccm_aesni()) {
+        AES_CCM_MB_LANE lanes[EVP_MAX_PIPES];
+
+        for (i = 0; i < numpipes; i++) {
+            lanes[i].nonce = pipes->iv[i];
+            lanes[i].aad = pipes->aad[i];
+            lanes[i].aadlen = pipes->aadlen[i];
+            lanes[i].in = in != NULL ? in[i] : empty;
+            lanes[i].out = out != NULL ? out[i] : NULL;
+            lanes[i].len = in != NULL ? inl[i] : 0;
+        }
+        ossl_aes_ccm_mb_aesni(&ctx->ccm.ks.ks, base->keylen, base->l, base->m,
+            base->enc, lanes, numpipes);
+        for (i = 0; i < numpipes; i++) {
+            if (base->enc) {
+                memcpy(pipes->tag[i], lanes[i].tag, base->m);
+            } else if (CRYPTO_memcmp(pipes->tag[i], lanes[i].tag,
+                           base->m)
+                != 0) {
+                OPENSSL_cleanse(lanes[i].out, lanes[i].len);
+                ok = 0;
+            }
+        }
+        OPENSSL_cleanse(lanes, sizeof(lanes));
+        goto end;
+    }
+#endif
+
+    for (i = 0; i < numpipes; i++) {
+        const unsigned char *pin = in != NULL ? in[i] : empty;
+        unsigned char *pout = out != NULL ? out[i] : NULL;
+        size_t len = in != NULL ? inl[i] : 0;
+
+        if (!base->hw->setiv(base, pipes->iv[i], ivlen, len)
+            || (pipes->aadlen[i] != 0
+                && !base->hw->setaad(base, pipes->aad[i], pipes->aadlen[i]))) {
+            ok = 0;
+            continue;
+        }
+        if (base->enc) {
+            if (!base->hw->auth_encrypt(base, pin, pout, len, pipes->tag[i],
+                    base->m))
+                ok = 0;
+        } else if (!base->hw->auth_decrypt(base, pin, pout, len,
+                       pipes->tag[i], base->m)) {
+            ok = 0;
+        }
+    }
+
+#ifdef AES_CCM_MB_AESNI
+end:
+#endif
+    aes_ccm_pipes_clear_aad(pipes);
+    pipes->iv_set = 0;
+    pipes->tag_set = base->enc && ok;
+    if (!ok)
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+    return ok;
+}
+
+static OSSL_FUNC_cipher_pipeline_update_fn aes_ccm_pipeline_update;
+static int aes_ccm_pipeline_update(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize,
+    const unsigned char **in, const size_t *inl)
+{
+    PROV_AES_CCM_CTX *ctx = (PROV_AES_CCM_CTX *)vctx;
+    PROV_AES_CCM_PIPES *pipes = ctx->pipes;
+    size_t i;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (pipes == NULL || !pipes->key_set || !pipes->iv_set
+        || numpipes != pipes->numpipes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+        return 0;
+    }
+
+    if (out == NULL) {
+        for (i = 0; i < numpipes; i++) {
+            if (!aes_ccm_pipeline_add_aad(pipes, i, in[i], inl[i]))
+                return 0;
+            outl[i] = inl[i];
+        }
+        return 1;
+    }
+
+    for (i = 0; i < numpipes; i++) {
+        if (outsize == NULL || outsize[i] < inl[i]) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+            return 0;
+        }
+    }
+    if (!aes_ccm_pipeline_cipher(ctx, numpipes, out, in, inl))
+        return 0;
+    for (i = 0; i < numpipes; i++)
+        outl[i] = inl[i];
+    return 1;
+}
+
+static OSSL_FUNC_cipher_pipeline_final_fn aes_ccm_pipeline_final;
+static int aes_ccm_pipeline_final(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize)
+{
+    PROV_AES_CCM_CTX *ctx = (PROV_AES_CCM_CTX *)vctx;
+    PROV_AES_CCM_PIPES *pipes = ctx->pipes;
+    size_t i;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (pipes == NULL || !pipes->key_set || numpipes != pipes->numpipes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+        return 0;
+    }
+
+    /* Messages that only had AAD are authenticated here */
+    if (pipes->iv_set
+        && !aes_ccm_pipeline_cipher(ctx, numpipes, NULL, NULL, NULL))
+        return 0;
+
+    for (i = 0; i < numpipes; i++)
+        outl[i] = 0;
+    return 1;
+}
+
+static const OSSL_PARAM *aes_ccm_settable_ctx_params(
+    ossl_unused void *cctx, ossl_unused void *provctx)
+{
+    return aes_ccm_set_ctx_params_list;
+}
+
+static int aes_ccm_set_ctx_params(void *vctx, const OSSL_PARAM params[])
+{
+    PROV_AES_CCM_CTX *ctx = (PROV_AES_CCM_CTX *)vctx;
+    struct aes_ccm_set_ctx_params_st p;
+    size_t taglen;
+
+    if (ctx == NULL || !aes_ccm_set_ctx_params_decoder(params, &p))
+        return 0;
+
+    if (p.pipetag != NULL) {
+        if (ctx->pipes == NULL || ctx->base.enc) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_TAG_NOT_NEEDED);
+            return 0;
+        }
+        if (!ossl_cipher_pipeline_set_tags(p.pipetag, ctx->pipes->tag[0],
+                sizeof(ctx->pipes->tag[0]), ctx->pipes->numpipes, &taglen))
+            return 0;
+        if ((taglen & 1) != 0 || taglen < 4) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_TAG_LENGTH);
+            return 0;
+        }
+        ctx->base.m = taglen;
+        ctx->pipes->tag_set = 1;
+    }
+
+    return ossl_ccm_set_ctx_params(vctx, params);
+}
+
+static const OSSL_PARAM *aes_ccm_gettable_ctx_params(
+    ossl_unused void *cctx, ossl_unused void *provctx)
+{
+    return aes_ccm_get_ctx_params_list;
+}
+
+static int aes_ccm_get_ctx_params(void *vctx, OSSL_PARAM params[])
+{
+    PROV_AES_CCM_CTX *ctx = (PROV_AES_CCM_CTX *)vctx;
+    struct aes_ccm_get_ctx_params_st p;
+
+    if (ctx == NULL || !aes_ccm_get_ctx_params_decoder(params, &p))
+        return 0;
+
+    if (p.pipetag != NULL) {
+        if (ctx->pipes == NULL || !ctx->base.enc || !ctx->pipes->tag_set) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_TAG_NOT_SET);
+            return 0;
+        }
+        if (!ossl_cipher_pipeline_get_tags(p.pipetag, ctx->pipes->tag[0],
+                sizeof(ctx->pipes->tag[0]), ctx->pipes->numpipes, ctx->base.m))
+            return 0;
+    }
+
+    return ossl_ccm_get_ctx_params(vctx, params);
+}
+
+#define IMPLEMENT_aes_ccm_cipher(kbits)                                         \
+    static OSSL_FUNC_cipher_get_params_fn aes_##kbits##_ccm_get_params;         \
+    static int aes_##kbits##_ccm_get_params(OSSL_PARAM params[])                \
+    {                                                                           \
+        return ossl_cipher_generic_get_params(params, EVP_CIPH_CCM_MODE,        \
+            AEAD_FLAGS, kbits, 8, 96);                                          \
+    }                                                                           \
+    static OSSL_FUNC_cipher_newctx_fn aes##kbits##ccm_newctx;                   \
+    static void *aes##kbits##ccm_newctx(void *provctx)                          \
+    {                                                                           \
+        return aes_ccm_newctx(provctx, kbits);                                  \
+    }                                                                           \
+    const OSSL_DISPATCH ossl_aes##kbits##ccm_functions[] = {                    \
+        { OSSL_FUNC_CIPHER_NEWCTX, (void (*)(void))aes##kbits##ccm_newctx },    \
+        { OSSL_FUNC_CIPHER_FREECTX, (void (*)(void))aes_ccm_freectx },          \
+        { OSSL_FUNC_CIPHER_DUPCTX, (void (*)(void))aes_ccm_dupctx },            \
+        { OSSL_FUNC_CIPHER_ENCRYPT_INIT, (void (*)(void))ossl_ccm_einit },      \
+        { OSSL_FUNC_CIPHER_DECRYPT_INIT, (void (*)(void))ossl_ccm_dinit },      \
+        { OSSL_FUNC_CIPHER_UPDATE, (void (*)(void))ossl_ccm_stream_update },    \
+        { OSSL_FUNC_CIPHER_FINAL, (void (*)(void))ossl_ccm_stream_final },      \
+        { OSSL_FUNC_CIPHER_CIPHER, (void (*)(void))ossl_ccm_cipher },           \
+        { OSSL_FUNC_CIPHER_PIPELINE_ENCRYPT_INIT,                               \
+            (void (*)(void))aes_ccm_pipeline_einit },                           \
+        { OSSL_FUNC_CIPHER_PIPELINE_DECRYPT_INIT,                               \
+            (void (*)(void))aes_ccm_pipeline_dinit },                           \
+        { OSSL_FUNC_CIPHER_PIPELINE_UPDATE,                                     \
+            (void (*)(void))aes_ccm_pipeline_update },                          \
+        { OSSL_FUNC_CIPHER_PIPELINE_FINAL,                                      \
+            (void (*)(void))aes_ccm_pipeline_final },                           \
+        { OSSL_FUNC_CIPHER_GET_PARAMS,                                          \
+            (void (*)(void))aes_##kbits##_ccm_get_params },                     \
+        { OSSL_FUNC_CIPHER_GET_CTX_PARAMS,                                      \
+            (void (*)(void))aes_ccm_get_ctx_params },                           \
+        { OSSL_FUNC_CIPHER_SET_CTX_PARAMS,                                      \
+            (void (*)(void))aes_ccm_set_ctx_params },                           \
+        { OSSL_FUNC_CIPHER_GETTABLE_PARAMS,                                     \
+            (void (*)(void))ossl_cipher_generic_gettable_params },              \
+        { OSSL_FUNC_CIPHER_GETTABLE_CTX_PARAMS,                                 \
+            (void (*)(void))aes_ccm_gettable_ctx_params },                      \
+        { OSSL_FUNC_CIPHER_SETTABLE_CTX_PARAMS,                                 \
+            (void (*)(void))aes_ccm_settable_ctx_params },                      \
+        OSSL_DISPATCH_END                                                       \
+    }
+
+/* ossl_aes128ccm_functions */
+IMPLEMENT_aes_ccm_cipher(128);
+/* ossl_aes192ccm_functions */
+IMPLEMENT_aes_ccm_cipher(192);
+/* ossl_aes256ccm_functions */
+IMPLEMENT_aes_ccm_cipher(256);
+
+#endif /* FIPS_MODULE */
@@ -14,6 +14,34 @@
 #include "prov/ciphercommon.h"
 #include "prov/ciphercommon_ccm.h"
 #include "crypto/aes_platform.h"
+#include "internal/target_region.h"
+
+#if defined(AESNI_CAPABLE) && !defined(FIPS_MODULE)
+#if defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)
+#if !defined(_M_ARM64EC)
+#if defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define AES_CCM_MB_AESNI
+#endif
+#endif /* !defined(_M_ARM64EC) */
+#endif
+#endif
+
+#ifndef FIPS_MODULE
+/* State of the pipelined interface, one message per pipe */
+typedef struct prov_aes_ccm_pipes_st {
+    size_t numpipes;
+    unsigned int key_set : 1;
+    unsigned int iv_set : 1;
+    unsigned int tag_set : 1; /* Tags are valid or, when decrypting, set */
+    unsigned char key[32];
+    unsigned char iv[EVP_MAX_PIPES][15];
+    unsigned char tag[EVP_MAX_PIPES][16];
+    /* AAD is collected until the payload length, and so B0, is known */
+    unsigned char *aad[EVP_MAX_PIPES];
+    size_t aadlen[EVP_MAX_PIPES];
+    size_t aadsize[EVP_MAX_PIPES];
+} PROV_AES_CCM_PIPES;
+#endif
 
 typedef struct prov_aes_ccm_ctx_st {
     PROV_CCM_CTX base; /* Must be first */
@@ -46,6 +74,9 @@ typedef struct prov_aes_ccm_ctx_st {
         } s390x;
 #endif /* defined(OPENSSL_CPUID_OBJ) && defined(__s390__) */
     } ccm;
+#ifndef FIPS_MODULE
+    PROV_AES_CCM_PIPES *pipes;
+#endif
 } PROV_AES_CCM_CTX;
 
 int ossl_cipher_set_ccm_aes_initkey(PROV_CCM_CTX *ctx,
@@ -58,6 +89,29 @@ const PROV_CCM_HW *ossl_prov_aes_hw_ccm(size_t keylen);
 #if defined(AESNI_CAPABLE)
 const PROV_CCM_HW *ossl_prov_aes_hw_ccm_aesni(void);
 #endif
+#ifdef AES_CCM_MB_AESNI
+typedef struct aes_ccm_mb_lane_st {
+    const unsigned char *nonce;
+    const unsigned char *aad;
+    size_t aadlen;
+    const unsigned char *in;
+    unsigned char *out;
+    size_t len;
+    unsigned char tag[16];
+} AES_CCM_MB_LANE;
+
+/* Fewer messages leave too much of a group of four idle */
+#define AES_CCM_MB_MIN_LANES 4
+
+/*
+ * Encrypt or decrypt the |n| messages of |lanes| with the AES-NI key schedule
+ * |ks|, interleaving the CBC-MAC and CTR blocks of four of them at a time,
+ * or eight with VAES.  The full 16 byte tag of each message is left in its
+ * |tag|, the caller truncates it to M bytes.
+ */
+void ossl_aes_ccm_mb_aesni(const AES_KEY *ks, size_t keylen, size_t l,
+    size_t m, int enc, AES_CCM_MB_LANE *lanes, size_t n);
+#endif
 #if defined(OPENSSL_CPUID_OBJ) && defined(__riscv) && __riscv_xlen == 32
 const PROV_CCM_HW *ossl_prov_aes_hw_ccm_rv32i(void);
 #endif
@@ -0,0 +1,554 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * AES CCM of several messages at once with AES-NI or VAES.
+ *
+ * CBC-MAC is a chain of dependent AES calls, so a single message keeps only
+ * one or two blocks in flight and leaves most of the AES unit idle.  Here
+ * the messages are taken in groups of four, or eight with VAES, and every
+ * step takes one CBC-MAC block and one counter block from each message of
+ * the group and runs all of them through the rounds together.
+ */
+
+/*
+ * This file uses the low level AES functions (which are deprecated for
+ * non-internal use) in order to implement provider AES ciphers.
+ */
+#include "internal/deprecated.h"
+#include <string.h>
+#include "cipher_aes_ccm.h"
+
+#ifdef AES_CCM_MB_AESNI
+
+/* AVX512F and AVX512BW, both cleared by cpuid when there is no ZMM state */
+#define AES_CCM_MB_AVX512_BITS ((1u << 16) | (1u << 30))
+#define AES_CCM_MB_VAES_CAPABLE                                                \
+    ((OPENSSL_ia32cap_P[2] & AES_CCM_MB_AVX512_BITS) == AES_CCM_MB_AVX512_BITS \
+        && (OPENSSL_ia32cap_P[3] & (1u << 9)) != 0)
+
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+#define CCM_MB_MAX_WIDTH 8
+
+typedef struct {
+    __m128i mac;
+    __m128i s0;
+    __m128i ctr; /* A0 byte reversed, so that the counter is the low qword */
+    unsigned char hdr[10];
+    size_t hlen;
+    size_t nmac; /* B0 and the AAD blocks */
+    size_t nblocks; /* payload blocks */
+    size_t steps;
+} CCM_MB_STATE;
+
+/*
+ * A run of steps in which every message of a group has whole blocks for
+ * both its CBC-MAC and its counter block.  Messages of the group that are
+ * already done, or that pad the group, read and write |scratch| and do not
+ * advance.
+ */
+typedef struct {
+    __m128i mac[CCM_MB_MAX_WIDTH];
+    __m128i ctr[CCM_MB_MAX_WIDTH]; /* the next counter block, byte reversed */
+    const unsigned char *macin[CCM_MB_MAX_WIDTH];
+    const unsigned char *in[CCM_MB_MAX_WIDTH];
+    unsigned char *out[CCM_MB_MAX_WIDTH];
+    size_t inc[CCM_MB_MAX_WIDTH];
+} CCM_MB_RUN;
+
+OPENSSL_TARGET_REGION("aes,ssse3")
+
+static ossl_inline __m128i ccm_bswap_mask(void)
+{
+    return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+/* Block |b| of the length encoded AAD, zero padded */
+static __m128i ccm_aad_block(const CCM_MB_STATE *st, const AES_CCM_MB_LANE *ln,
+    size_t b)
+{
+    unsigned char blk[16];
+    size_t off = 16 * b, n = 0, rem;
+
+    if (off >= st->hlen && ln->aadlen - (off - st->hlen) >= 16)
+        return _mm_loadu_si128((const __m128i *)(ln->aad + off - st->hlen));
+
+    memset(blk, 0, sizeof(blk));
+    if (off < st->hlen) {
+        n = st->hlen - off;
+        memcpy(blk, st->hdr + off, n);
+        off = 0;
+    } else {
+        off -= st->hlen;
+    }
+    rem = ln->aadlen - off;
+    memcpy(blk + n, ln->aad + off, rem < 16 - n ? rem : 16 - n);
+    return _mm_loadu_si128((const __m128i *)blk);
+}
+
+/* Payload block |j|, counting from 1, zero padded */
+static __m128i ccm_payload_block(const unsigned char *p, size_t len, size_t j)
+{
+    unsigned char blk[16];
+    size_t off = 16 * (j - 1);
+
+    if (len - off >= 16)
+        return _mm_loadu_si128((const __m128i *)(p + off));
+    memset(blk, 0, sizeof(blk));
+    memcpy(blk, p + off, len - off);
+    return _mm_loadu_si128((const __m128i *)blk);
+}
+
+static void ccm_xor_block(unsigned char *out, const unsigned char *in,
+    size_t len, size_t j, __m128i ks)
+{
+    unsigned char blk[16];
+    size_t off = 16 * (j - 1), i;
+
+    if (len - off >= 16) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(in + off));
+
+        _mm_storeu_si128((__m128i *)(out + off), _mm_xor_si128(d, ks));
+        return;
+    }
+    _mm_storeu_si128((__m128i *)blk, ks);
+    for (i = 0; off + i < len; i++)
+        out[off + i] = in[off + i] ^ blk[i];
+}
+
+static void ccm_mb_setup(CCM_MB_STATE *t, const AES_CCM_MB_LANE *ln,
+    size_t l, size_t m)
+{
+    unsigned char b0[16], a0[16];
+    uint64_t mlen = (uint64_t)ln->len;
+    size_t alen = ln->aadlen, j;
+
+    /* B0 = flags || N || l(m), A0 = L - 1 || N || 0 */
+    b0[0] = (unsigned char)((alen != 0 ? 0x40 : 0) | (((m - 2) / 2) << 3)
+        | (l - 1));
+    a0[0] = (unsigned char)(l - 1);
+    memcpy(b0 + 1, ln->nonce, 15 - l);
+    memcpy(a0 + 1, ln->nonce, 15 - l);
+    memset(b0 + 16 - l, 0, l);
+    memset(a0 + 16 - l, 0, l);
+    for (j = 0; j < l && j < 8; j++, mlen >>= 8)
+        b0[15 - j] = (unsigned char)mlen;
+
+    t->mac = _mm_loadu_si128((const __m128i *)b0);
+    t->ctr = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)a0),
+        ccm_bswap_mask());
+
+    /* The AAD length encoding of RFC 3610 */
+    t->hlen = 0;
+    if (alen == 0) {
+        t->nmac = 1;
+    } else {
+        if (alen < 0xff00) {
+            t->hdr[0] = (unsigned char)(alen >> 8);
+            t->hdr[1] = (unsigned char)alen;
+            t->hlen = 2;
+        } else {
+            uint64_t a = (uint64_t)alen;
+            size_t w = (a >> 32) == 0 ? 4 : 8;
+
+            t->hdr[0] = 0xff;
+            t->hdr[1] = w == 4 ? 0xfe : 0xff;
+            for (j = 0; j < w; j++)
+                t->hdr[1 + w - j] = (unsigned char)(a >> (8 * j));
+            t->hlen = 2 + w;
+        }
+        t->nmac = 1 + (t->hlen + alen + 15) / 16;
+    }
+    t->nblocks = (ln->len + 15) / 16;
+    t->steps = t->nmac + t->nblocks;
+}
+
+/*-
+ * Step s feeds CBC-MAC block s of a message: B0, the AAD blocks and then
+ * the payload blocks.  When encrypting, the counter block of a payload block
+ * is encrypted in the same step as its CBC-MAC block and S0 in the last
+ * step before the payload.  When decrypting, the plaintext is only known
+ * after the key stream, so the counter blocks run one step ahead and S0 is
+ * left for the last step.
+ */
+static ossl_inline size_t ccm_mb_ctr_index(const CCM_MB_STATE *t, size_t s,
+    size_t dec)
+{
+    return s + 1 + dec - t->nmac;
+}
+
+#define OP_MAC 0
+#define OP_S0 1
+#define OP_CTR 2
+
+/* One step of every message of the group that is not done yet */
+static void ccm_mb_step(CCM_MB_STATE *st, AES_CCM_MB_LANE *lanes, size_t n,
+    size_t s, size_t dec, const __m128i *rk, int rounds)
+{
+    const __m128i bswap = ccm_bswap_mask();
+    __m128i blk[2 * CCM_MB_MAX_WIDTH];
+    unsigned char kind[2 * CCM_MB_MAX_WIDTH], lane[2 * CCM_MB_MAX_WIDTH];
+    size_t ctr[2 * CCM_MB_MAX_WIDTH], i, j, r, nops = 0;
+
+    for (i = 0; i < n; i++) {
+        CCM_MB_STATE *t = &st[i];
+        AES_CCM_MB_LANE *ln = &lanes[i];
+        size_t k;
+        __m128i x;
+
+        if (s >= t->steps)
+            continue;
+
+        if (s == 0)
+            x = t->mac;
+        else if (s < t->nmac)
+            x = _mm_xor_si128(t->mac, ccm_aad_block(t, ln, s - 1));
+        else
+            x = _mm_xor_si128(t->mac,
+                ccm_payload_block(dec ? ln->out : ln->in, ln->len,
+                    s - t->nmac + 1));
+        blk[nops] = x;
+        kind[nops] = OP_MAC;
+        lane[nops++] = (unsigned char)i;
+
+        if (s + 1 + dec < t->nmac)
+            continue;
+        k = ccm_mb_ctr_index(t, s, dec);
+        if (k == (dec ? t->nblocks + 1 : 0)) {
+            blk[nops] = _mm_shuffle_epi8(t->ctr, bswap);
+            kind[nops] = OP_S0;
+        } else if (k >= 1 && k <= t->nblocks) {
+            x = _mm_add_epi64(t->ctr, _mm_set_epi64x(0, (long long)k));
+            blk[nops] = _mm_shuffle_epi8(x, bswap);
+            kind[nops] = OP_CTR;
+            ctr[nops] = k;
+        } else {
+            continue;
+        }
+        lane[nops++] = (unsigned char)i;
+    }
+
+    for (j = 0; j < nops; j++)
+        blk[j] = _mm_xor_si128(blk[j], rk[0]);
+    for (r = 1; r < (size_t)rounds; r++)
+        for (j = 0; j < nops; j++)
+            blk[j] = _mm_aesenc_si128(blk[j], rk[r]);
+    for (j = 0; j < nops; j++)
+        blk[j] = _mm_aesenclast_si128(blk[j], rk[rounds]);
+
+    for (j = 0; j < nops; j++) {
+        CCM_MB_STATE *t = &st[lane[j]];
+        AES_CCM_MB_LANE *ln = &lanes[lane[j]];
+
+        switch (kind[j]) {
+        case OP_MAC:
+            t->mac = blk[j];
+            break;
+        case OP_S0:
+            t->s0 = blk[j];
+            break;
+        default:
+            ccm_xor_block(ln->out, ln->in, ln->len, ctr[j], blk[j]);
+            break;
+        }
+    }
+}
+
+/*
+ * The number of steps from step |s| on for which every message of the group
+ * that is not done has whole blocks for both its CBC-MAC and counter blocks,
+ * 0 if there is a message that is not in its payload yet or that is at its
+ * last block.  The run is set up in |run|.
+ */
+static size_t ccm_mb_run_setup(CCM_MB_STATE *st, AES_CCM_MB_LANE *lanes,
+    size_t n, size_t width, size_t s, size_t dec, CCM_MB_RUN *run,
+    unsigned char *scratch)
+{
+    size_t i, steps = SIZE_MAX;
+
+    for (i = 0; i < n; i++) {
+        CCM_MB_STATE *t = &st[i];
+        AES_CCM_MB_LANE *ln = &lanes[i];
+        size_t j, whole;
+
+        if (s >= t->steps)
+            continue;
+        if (s < t->nmac)
+            return 0;
+        /* CBC-MAC of payload block j, key stream for block j + dec */
+        j = s - t->nmac + 1;
+        whole = ln->len / 16;
+        if (j + dec > whole)
+            return 0;
+        if (whole - j - dec + 1 < steps)
+            steps = whole - j - dec + 1;
+        run->mac[i] = t->mac;
+        run->ctr[i] = _mm_add_epi64(t->ctr,
+            _mm_set_epi64x(0, (long long)(j + dec)));
+        run->macin[i] = (dec ? ln->out : ln->in) + 16 * (j - 1);
+        run->in[i] = ln->in + 16 * (j + dec - 1);
+        run->out[i] = ln->out + 16 * (j + dec - 1);
+        run->inc[i] = 16;
+    }
+    if (steps == SIZE_MAX)
+        return 0;
+
+    for (i = 0; i < width; i++) {
+        if (i < n && s < st[i].steps)
+            continue;
+        run->mac[i] = _mm_setzero_si128();
+        run->ctr[i] = _mm_setzero_si128();
+        run->macin[i] = scratch;
+        run->in[i] = scratch;
+        run->out[i] = scratch + 16;
+        run->inc[i] = 0;
+    }
+    return steps;
+}
+
+static void ccm_mb_run_finish(CCM_MB_STATE *st, size_t n, size_t s,
+    const CCM_MB_RUN *run)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if (s < st[i].steps)
+            st[i].mac = run->mac[i];
+}
+
+/* Four messages, eight blocks in flight */
+static void ccm_mb_run4(CCM_MB_RUN *run, size_t steps, const __m128i *rk,
+    int rounds)
+{
+    const __m128i bswap = ccm_bswap_mask(), one = _mm_set_epi64x(0, 1);
+    __m128i m0 = run->mac[0], m1 = run->mac[1];
+    __m128i m2 = run->mac[2], m3 = run->mac[3];
+    __m128i c0 = run->ctr[0], c1 = run->ctr[1];
+    __m128i c2 = run->ctr[2], c3 = run->ctr[3];
+    size_t t, i;
+    int r;
+
+    for (t = 0; t < steps; t++) {
+        __m128i k0 = _mm_shuffle_epi8(c0, bswap);
+        __m128i k1 = _mm_shuffle_epi8(c1, bswap);
+        __m128i k2 = _mm_shuffle_epi8(c2, bswap);
+        __m128i k3 = _mm_shuffle_epi8(c3, bswap);
+
+        m0 = _mm_xor_si128(m0, _mm_loadu_si128((const __m128i *)run->macin[0]));
+        m1 = _mm_xor_si128(m1, _mm_loadu_si128((const __m128i *)run->macin[1]));
+        m2 = _mm_xor_si128(m2, _mm_loadu_si128((const __m128i *)run->macin[2]));
+        m3 = _mm_xor_si128(m3, _mm_loadu_si128((const __m128i *)run->macin[3]));
+        c0 = _mm_add_epi64(c0, one);
+        c1 = _mm_add_epi64(c1, one);
+        c2 = _mm_add_epi64(c2, one);
+        c3 = _mm_add_epi64(c3, one);
+
+        m0 = _mm_xor_si128(m0, rk[0]);
+        m1 = _mm_xor_si128(m1, rk[0]);
+        m2 = _mm_xor_si128(m2, rk[0]);
+        m3 = _mm_xor_si128(m3, rk[0]);
+        k0 = _mm_xor_si128(k0, rk[0]);
+        k1 = _mm_xor_si128(k1, rk[0]);
+        k2 = _mm_xor_si128(k2, rk[0]);
+        k3 = _mm_xor_si128(k3, rk[0]);
+        for (r = 1; r < rounds; r++) {
+            __m128i k = rk[r];
+
+            m0 = _mm_aesenc_si128(m0, k);
+            m1 = _mm_aesenc_si128(m1, k);
+            m2 = _mm_aesenc_si128(m2, k);
+            m3 = _mm_aesenc_si128(m3, k);
+            k0 = _mm_aesenc_si128(k0, k);
+            k1 = _mm_aesenc_si128(k1, k);
+            k2 = _mm_aesenc_si128(k2, k);
+            k3 = _mm_aesenc_si128(k3, k);
+        }
+        m0 = _mm_aesenclast_si128(m0, rk[rounds]);
+        m1 = _mm_aesenclast_si128(m1, rk[rounds]);
+        m2 = _mm_aesenclast_si128(m2, rk[rounds]);
+        m3 = _mm_aesenclast_si128(m3, rk[rounds]);
+        k0 = _mm_aesenclast_si128(k0, rk[rounds]);
+        k1 = _mm_aesenclast_si128(k1, rk[rounds]);
+        k2 = _mm_aesenclast_si128(k2, rk[rounds]);
+        k3 = _mm_aesenclast_si128(k3, rk[rounds]);
+
+        _mm_storeu_si128((__m128i *)run->out[0], _mm_xor_si128(k0,
+            _mm_loadu_si128((const __m128i *)run->in[0])));
+        _mm_storeu_si128((__m128i *)run->out[1], _mm_xor_si128(k1,
+            _mm_loadu_si128((const __m128i *)run->in[1])));
+        _mm_storeu_si128((__m128i *)run->out[2], _mm_xor_si128(k2,
+            _mm_loadu_si128((const __m128i *)run->in[2])));
+        _mm_storeu_si128((__m128i *)run->out[3], _mm_xor_si128(k3,
+            _mm_loadu_si128((const __m128i *)run->in[3])));
+        for (i = 0; i < 4; i++) {
+            run->macin[i] += run->inc[i];
+            run->in[i] += run->inc[i];
+            run->out[i] += run->inc[i];
+        }
+    }
+    run->mac[0] = m0;
+    run->mac[1] = m1;
+    run->mac[2] = m2;
+    run->mac[3] = m3;
+}
+
+OPENSSL_UNTARGET_REGION
+
+OPENSSL_TARGET_REGION("avx512f,avx512bw,vaes,aes,ssse3")
+
+static ossl_inline __m512i ccm_load4(const unsigned char *const *p)
+{
+    __m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)p[0]));
+
+    v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)p[1]), 1);
+    v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)p[2]), 2);
+    return _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)p[3]), 3);
+}
+
+static ossl_inline void ccm_store4(unsigned char *const *p, __m512i v)
+{
+    _mm_storeu_si128((__m128i *)p[0], _mm512_castsi512_si128(v));
+    _mm_storeu_si128((__m128i *)p[1], _mm512_extracti32x4_epi32(v, 1));
+    _mm_storeu_si128((__m128i *)p[2], _mm512_extracti32x4_epi32(v, 2));
+    _mm_storeu_si128((__m128i *)p[3], _mm512_extracti32x4_epi32(v, 3));
+}
+
+static ossl_inline __m512i ccm_pack4(const __m128i *v)
+{
+    __m512i z = _mm512_castsi128_si512(v[0]);
+
+    z = _mm512_inserti32x4(z, v[1], 1);
+    z = _mm512_inserti32x4(z, v[2], 2);
+    return _mm512_inserti32x4(z, v[3], 3);
+}
+
+static ossl_inline void ccm_unpack4(__m128i *v, __m512i z)
+{
+    v[0] = _mm512_castsi512_si128(z);
+    v[1] = _mm512_extracti32x4_epi32(z, 1);
+    v[2] = _mm512_extracti32x4_epi32(z, 2);
+    v[3] = _mm512_extracti32x4_epi32(z, 3);
+}
+
+/* Eight messages, four registers of four blocks in flight */
+static void ccm_mb_run8_vaes(CCM_MB_RUN *run, size_t steps, const __m128i *rk,
+    int rounds)
+{
+    const __m512i bswap = _mm512_broadcast_i32x4(ccm_bswap_mask());
+    const __m512i one = _mm512_broadcast_i32x4(_mm_set_epi64x(0, 1));
+    __m512i zrk[15];
+    __m512i ma = ccm_pack4(run->mac), mb = ccm_pack4(run->mac + 4);
+    __m512i ca = ccm_pack4(run->ctr), cb = ccm_pack4(run->ctr + 4);
+    size_t t, i;
+    int r;
+
+    for (r = 0; r <= rounds; r++)
+        zrk[r] = _mm512_broadcast_i32x4(rk[r]);
+
+    for (t = 0; t < steps; t++) {
+        __m512i ka = _mm512_shuffle_epi8(ca, bswap);
+        __m512i kb = _mm512_shuffle_epi8(cb, bswap);
+
+        ma = _mm512_xor_si512(ma, ccm_load4(run->macin));
+        mb = _mm512_xor_si512(mb, ccm_load4(run->macin + 4));
+        ca = _mm512_add_epi64(ca, one);
+        cb = _mm512_add_epi64(cb, one);
+
+        ma = _mm512_xor_si512(ma, zrk[0]);
+        mb = _mm512_xor_si512(mb, zrk[0]);
+        ka = _mm512_xor_si512(ka, zrk[0]);
+        kb = _mm512_xor_si512(kb, zrk[0]);
+        for (r = 1; r < rounds; r++) {
+            ma = _mm512_aesenc_epi128(ma, zrk[r]);
+            mb = _mm512_aesenc_epi128(mb, zrk[r]);
+            ka = _mm512_aesenc_epi128(ka, zrk[r]);
+            kb = _mm512_aesenc_epi128(kb, zrk[r]);
+        }
+        ma = _mm512_aesenclast_epi128(ma, zrk[rounds]);
+        mb = _mm512_aesenclast_epi128(mb, zrk[rounds]);
+        ka = _mm512_aesenclast_epi128(ka, zrk[rounds]);
+        kb = _mm512_aesenclast_epi128(kb, zrk[rounds]);
+
+        ccm_store4(run->out, _mm512_xor_si512(ka, ccm_load4(run->in)));
+        ccm_store4(run->out + 4, _mm512_xor_si512(kb, ccm_load4(run->in + 4)));
+        for (i = 0; i < 8; i++) {
+            run->macin[i] += run->inc[i];
+            run->in[i] += run->inc[i];
+            run->out[i] += run->inc[i];
+        }
+    }
+    ccm_unpack4(run->mac, ma);
+    ccm_unpack4(run->mac + 4, mb);
+}
+
+OPENSSL_UNTARGET_REGION
+
+OPENSSL_TARGET_REGION("aes,ssse3")
+
+/* All messages of a group go through the same steps, until each is done */
+static void ccm_mb_group(CCM_MB_STATE *st, AES_CCM_MB_LANE *lanes, size_t n,
+    size_t width, size_t dec, const __m128i *rk, int rounds)
+{
+    unsigned char scratch[32] = { 0 };
+    CCM_MB_RUN run;
+    size_t i, s, steps, last = 0;
+
+    for (i = 0; i < n; i++)
+        if (st[i].steps > last)
+            last = st[i].steps;
+
+    for (s = 0; s < last;) {
+        steps = ccm_mb_run_setup(st, lanes, n, width, s, dec, &run, scratch);
+        if (steps == 0) {
+            ccm_mb_step(st, lanes, n, s, dec, rk, rounds);
+            s++;
+            continue;
+        }
+        if (width == 8)
+            ccm_mb_run8_vaes(&run, steps, rk, rounds);
+        else
+            ccm_mb_run4(&run, steps, rk, rounds);
+        ccm_mb_run_finish(st, n, s, &run);
+        s += steps;
+    }
+    OPENSSL_cleanse(&run, sizeof(run));
+}
+
+void ossl_aes_ccm_mb_aesni(const AES_KEY *ks, size_t keylen, size_t l,
+    size_t m, int enc, AES_CCM_MB_LANE *lanes, size_t n)
+{
+    CCM_MB_STATE st[CCM_MB_MAX_WIDTH];
+    __m128i rk[15];
+    int rounds = (int)(keylen / 4) + 6;
+    int vaes = AES_CCM_MB_VAES_CAPABLE;
+    size_t i, g, width, cnt;
+
+    for (i = 0; i <= (size_t)rounds; i++)
+        rk[i] = _mm_loadu_si128((const __m128i *)ks->rd_key + i);
+
+    for (g = 0; g < n; g += cnt) {
+        /* Eight messages with VAES, unless four leave little idle */
+        width = vaes && n - g > 4 ? 8 : 4;
+        cnt = n - g < width ? n - g : width;
+        for (i = 0; i < cnt; i++)
+            ccm_mb_setup(&st[i], &lanes[g + i], l, m);
+        ccm_mb_group(st, lanes + g, cnt, width, enc ? 0 : 1, rk, rounds);
+        for (i = 0; i < cnt; i++)
+            _mm_storeu_si128((__m128i *)lanes[g + i].tag,
+                _mm_xor_si128(st[i].mac, st[i].s0));
+    }
+    OPENSSL_cleanse(st, sizeof(st));
+    OPENSSL_cleanse(rk, sizeof(rk));
+}
+
+OPENSSL_UNTARGET_REGION
+
+#endif /* AES_CCM_MB_AESNI */
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2019-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -71,6 +71,8 @@ static void *ossl_aes_gcm_siv_dupctx(void *vctx)
     /* NULL-out these things we create later */
     ret->aad = NULL;
     ret->ecb_ctx = NULL;
+    ret->kgk_ctx = NULL;
+    ret->ecb = NULL;
 
     if (in->aad != NULL) {
         if ((ret->aad = OPENSSL_memdup(in->aad, UP16(ret->aad_len))) == NULL)
@@ -106,6 +108,7 @@ static int ossl_aes_gcm_siv_init(void *vctx, const unsigned char *key, size_t ke
             return 0;
         }
         memcpy(ctx->key_gen_key, key, ctx->key_len);
+        ctx->kgk_set = 0;
     }
     if (iv != NULL) {
         if (ivlen != sizeof(ctx->nonce)) {
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2021 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2019-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -34,7 +34,9 @@ typedef struct prov_cipher_hw_aes_gcm_siv_st {
 
 /* Arranged for alignment purposes */
 typedef struct prov_aes_gcm_siv_ctx_st {
-    EVP_CIPHER_CTX *ecb_ctx;
+    EVP_CIPHER_CTX *ecb_ctx; /* keyed with msg_enc_key */
+    EVP_CIPHER_CTX *kgk_ctx; /* keyed with key_gen_key */
+    EVP_CIPHER *ecb; /* AES-ECB of key_len, fetched once */
     const PROV_CIPHER_HW_AES_GCM_SIV *hw; /* maybe not used, yet? */
     uint8_t *aad; /* Allocated, rounded up to 16 bytes, from user */
     OSSL_LIB_CTX *libctx;
@@ -54,6 +56,7 @@ typedef struct prov_aes_gcm_siv_ctx_st {
     unsigned int used_enc : 1;
     unsigned int used_dec : 1;
     unsigned int speed : 1;
+    unsigned int kgk_set : 1; /* kgk_ctx holds the current key_gen_key */
 } PROV_AES_GCM_SIV_CTX;
 
 const PROV_CIPHER_HW_AES_GCM_SIV *ossl_prov_cipher_hw_aes_gcm_siv(size_t keybits);
@@ -23,88 +23,89 @@
 static int aes_gcm_siv_ctr32(PROV_AES_GCM_SIV_CTX *ctx, const unsigned char *init_counter,
     unsigned char *out, const unsigned char *in, size_t len);
 
+/* The key derivation uses 2 blocks for msg_auth_key and up to 4 for msg_enc_key */
+#define KDF_MAX_BLOCKS 6
+
 static int aes_gcm_siv_initkey(void *vctx)
 {
     PROV_AES_GCM_SIV_CTX *ctx = (PROV_AES_GCM_SIV_CTX *)vctx;
-    uint8_t output[BLOCK_SIZE];
-    uint32_t counter = 0x0;
-    size_t i;
-    union {
-        uint32_t counter;
-        uint8_t block[BLOCK_SIZE];
-    } data;
+    uint8_t blocks[KDF_MAX_BLOCKS * BLOCK_SIZE];
+    uint8_t output[KDF_MAX_BLOCKS * BLOCK_SIZE];
+    size_t i, nblocks = 2 + ctx->key_len / 8;
     int out_len;
-    EVP_CIPHER *ecb = NULL;
-    DECLARE_IS_ENDIAN;
 
-    switch (ctx->key_len) {
-    case 16:
-        ecb = EVP_CIPHER_fetch(ctx->libctx, "AES-128-ECB", NULL);
-        break;
-    case 24:
-        ecb = EVP_CIPHER_fetch(ctx->libctx, "AES-192-ECB", NULL);
-        break;
-    case 32:
-        ecb = EVP_CIPHER_fetch(ctx->libctx, "AES-256-ECB", NULL);
-        break;
-    default:
-        goto err;
+    if (ctx->ecb == NULL) {
+        switch (ctx->key_len) {
+        case 16:
+            ctx->ecb = EVP_CIPHER_fetch(ctx->libctx, "AES-128-ECB", NULL);
+            break;
+        case 24:
+            ctx->ecb = EVP_CIPHER_fetch(ctx->libctx, "AES-192-ECB", NULL);
+            break;
+        case 32:
+            ctx->ecb = EVP_CIPHER_fetch(ctx->libctx, "AES-256-ECB", NULL);
+            break;
+        default:
+            break;
+        }
+        if (ctx->ecb == NULL)
+            goto err;
     }
 
     if (ctx->ecb_ctx == NULL && (ctx->ecb_ctx = EVP_CIPHER_CTX_new()) == NULL)
         goto err;
-    if (!EVP_EncryptInit_ex2(ctx->ecb_ctx, ecb, ctx->key_gen_key, NULL, NULL))
+    if (ctx->kgk_ctx == NULL && (ctx->kgk_ctx = EVP_CIPHER_CTX_new()) == NULL)
         goto err;
-
-    memset(&data, 0, sizeof(data));
-    memcpy(&data.block[sizeof(data.counter)], ctx->nonce, NONCE_SIZE);
+    /* The key generating key only needs expanding when it changes */
+    if (!ctx->kgk_set) {
+        if (!EVP_EncryptInit_ex2(ctx->kgk_ctx, ctx->ecb, ctx->key_gen_key,
+                NULL, NULL))
+            goto err;
+        ctx->kgk_set = 1;
+    }
 
     ctx->generated_tag = 0;
     memset(ctx->tag, 0, TAG_SIZE);
 
-    /* msg_auth_key is always 16 bytes in size, regardless of AES128/AES256 */
-    /* counter is stored little-endian */
-    for (i = 0; i < BLOCK_SIZE; i += 8) {
-        if (IS_LITTLE_ENDIAN) {
-            data.counter = counter;
-        } else {
-            data.counter = GSWAP4(counter);
-        }
-        /* Block size is 16 (128 bits), but only 8 bytes are used */
-        out_len = BLOCK_SIZE;
-        if (!EVP_EncryptUpdate(ctx->ecb_ctx, output, &out_len, data.block, BLOCK_SIZE))
-            goto err;
-        memcpy(&ctx->msg_auth_key[i], output, 8);
-        counter++;
-    }
-
-    /* msg_enc_key length is directly tied to key length AES128/AES256 */
-    for (i = 0; i < ctx->key_len; i += 8) {
-        if (IS_LITTLE_ENDIAN) {
-            data.counter = counter;
-        } else {
-            data.counter = GSWAP4(counter);
-        }
-        /* Block size is 16 bytes (128 bits), but only 8 bytes are used */
-        out_len = BLOCK_SIZE;
-        if (!EVP_EncryptUpdate(ctx->ecb_ctx, output, &out_len, data.block, BLOCK_SIZE))
-            goto err;
-        memcpy(&ctx->msg_enc_key[i], output, 8);
-        counter++;
+    /*
+     * Each derivation block is a little-endian 32-bit counter followed by
+     * the nonce.  They are all encrypted in a single call so that the AES
+     * implementation can interleave them, and only the first 8 bytes of
+     * each output block are used.
+     * msg_auth_key is always 16 bytes in size, regardless of AES128/AES256,
+     * msg_enc_key length is directly tied to key length AES128/AES256.
+     */
+    for (i = 0; i < nblocks; i++) {
+        blocks[i * BLOCK_SIZE] = (uint8_t)i;
+        memset(&blocks[i * BLOCK_SIZE + 1], 0, 3);
+        memcpy(&blocks[i * BLOCK_SIZE + 4], ctx->nonce, NONCE_SIZE);
     }
+    out_len = (int)(nblocks * BLOCK_SIZE);
+    if (!EVP_EncryptUpdate(ctx->kgk_ctx, output, &out_len, blocks,
+            (int)(nblocks * BLOCK_SIZE)))
+        goto err;
+    for (i = 0; i < 2; i++)
+        memcpy(&ctx->msg_auth_key[i * 8], &output[i * BLOCK_SIZE], 8);
+    for (i = 2; i < nblocks; i++)
+        memcpy(&ctx->msg_enc_key[(i - 2) * 8], &output[i * BLOCK_SIZE], 8);
+    OPENSSL_cleanse(output, sizeof(output));
 
-    if (!EVP_EncryptInit_ex2(ctx->ecb_ctx, ecb, ctx->msg_enc_key, NULL, NULL))
+    if (!EVP_EncryptInit_ex2(ctx->ecb_ctx, ctx->ecb, ctx->msg_enc_key, NULL, NULL))
         goto err;
 
-    /* Freshen up the state */
+    /* Freshen up the state, the AAD belongs to the previous message */
+    OPENSSL_free(ctx->aad);
+    ctx->aad = NULL;
+    ctx->aad_len = 0;
     ctx->used_enc = 0;
     ctx->used_dec = 0;
-    EVP_CIPHER_free(ecb);
     return 1;
 err:
     EVP_CIPHER_CTX_free(ctx->ecb_ctx);
-    EVP_CIPHER_free(ecb);
+    EVP_CIPHER_CTX_free(ctx->kgk_ctx);
     ctx->ecb_ctx = NULL;
+    ctx->kgk_ctx = NULL;
+    ctx->kgk_set = 0;
     return 0;
 }
 
@@ -309,7 +310,12 @@ static void aes_gcm_siv_clean_ctx(void *vctx)
     PROV_AES_GCM_SIV_CTX *ctx = (PROV_AES_GCM_SIV_CTX *)vctx;
 
     EVP_CIPHER_CTX_free(ctx->ecb_ctx);
+    EVP_CIPHER_CTX_free(ctx->kgk_ctx);
+    EVP_CIPHER_free(ctx->ecb);
     ctx->ecb_ctx = NULL;
+    ctx->kgk_ctx = NULL;
+    ctx->ecb = NULL;
+    ctx->kgk_set = 0;
 }
 
 static int aes_gcm_siv_dup_ctx(void *vdst, void *vsrc)
@@ -318,17 +324,29 @@ static int aes_gcm_siv_dup_ctx(void *vdst, void *vsrc)
     PROV_AES_GCM_SIV_CTX *src = (PROV_AES_GCM_SIV_CTX *)vsrc;
 
     dst->ecb_ctx = NULL;
+    dst->kgk_ctx = NULL;
+    dst->ecb = NULL;
+    if (src->ecb != NULL) {
+        if (!EVP_CIPHER_up_ref(src->ecb))
+            goto err;
+        dst->ecb = src->ecb;
+    }
     if (src->ecb_ctx != NULL) {
         if ((dst->ecb_ctx = EVP_CIPHER_CTX_new()) == NULL)
             goto err;
         if (!EVP_CIPHER_CTX_copy(dst->ecb_ctx, src->ecb_ctx))
             goto err;
     }
+    if (src->kgk_ctx != NULL) {
+        if ((dst->kgk_ctx = EVP_CIPHER_CTX_new()) == NULL)
+            goto err;
+        if (!EVP_CIPHER_CTX_copy(dst->kgk_ctx, src->kgk_ctx))
+            goto err;
+    }
     return 1;
 
 err:
-    EVP_CIPHER_CTX_free(dst->ecb_ctx);
-    dst->ecb_ctx = NULL;
+    aes_gcm_siv_clean_ctx(dst);
     return 0;
 }
 
@@ -344,43 +362,56 @@ const PROV_CIPHER_HW_AES_GCM_SIV *ossl_prov_cipher_hw_aes_gcm_siv(size_t keybits
     return &aes_gcm_siv_hw;
 }
 
-/* AES-GCM-SIV needs AES-CTR32, which is different than the AES-CTR implementation */
+/* Number of counter blocks encrypted by a single ECB call */
+#define CTR32_BLOCKS 32
+
+/*
+ * AES-GCM-SIV needs AES-CTR32, which is different than the AES-CTR
+ * implementation: the counter is the first 32 bits of the block, and is
+ * little-endian.  The counter blocks are built in batches and encrypted with
+ * ECB, which lets the AES implementation interleave several blocks.
+ */
 static int aes_gcm_siv_ctr32(PROV_AES_GCM_SIV_CTX *ctx, const unsigned char *init_counter,
     unsigned char *out, const unsigned char *in, size_t len)
 {
-    uint8_t keystream[BLOCK_SIZE];
-    int out_len;
-    size_t i;
-    size_t j;
-    size_t todo;
+    uint8_t blocks[CTR32_BLOCKS * BLOCK_SIZE];
+    uint8_t keystream[CTR32_BLOCKS * BLOCK_SIZE];
+    uint64_t a, b;
     uint32_t counter;
+    int out_len;
+    size_t i, n, todo;
     int error = 0;
-    union {
-        uint32_t x32[BLOCK_SIZE / sizeof(uint32_t)];
-        uint8_t x8[BLOCK_SIZE];
-    } block;
-    DECLARE_IS_ENDIAN;
-
-    memcpy(&block, init_counter, sizeof(block));
-    if (IS_BIG_ENDIAN) {
-        counter = GSWAP4(block.x32[0]);
-    }
 
-    for (i = 0; i < len; i += sizeof(block)) {
-        out_len = BLOCK_SIZE;
-        error |= !EVP_EncryptUpdate(ctx->ecb_ctx, keystream, &out_len, (uint8_t *)&block, sizeof(block));
-        if (IS_LITTLE_ENDIAN) {
-            block.x32[0]++;
-        } else {
-            counter++;
-            block.x32[0] = GSWAP4(counter);
+    counter = (uint32_t)init_counter[0] | ((uint32_t)init_counter[1] << 8)
+        | ((uint32_t)init_counter[2] << 16) | ((uint32_t)init_counter[3] << 24);
+    for (i = 0; i < CTR32_BLOCKS; i++)
+        memcpy(&blocks[i * BLOCK_SIZE + 4], &init_counter[4], BLOCK_SIZE - 4);
+
+    while (len > 0) {
+        todo = len < sizeof(keystream) ? len : sizeof(keystream);
+        n = (todo + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        for (i = 0; i < n; i++, counter++) {
+            blocks[i * BLOCK_SIZE] = (uint8_t)counter;
+            blocks[i * BLOCK_SIZE + 1] = (uint8_t)(counter >> 8);
+            blocks[i * BLOCK_SIZE + 2] = (uint8_t)(counter >> 16);
+            blocks[i * BLOCK_SIZE + 3] = (uint8_t)(counter >> 24);
+        }
+        out_len = (int)(n * BLOCK_SIZE);
+        error |= !EVP_EncryptUpdate(ctx->ecb_ctx, keystream, &out_len, blocks,
+            (int)(n * BLOCK_SIZE));
+        /* memcpy() avoids alignment issues and compiles to plain loads */
+        for (i = 0; i + 8 <= todo; i += 8) {
+            memcpy(&a, &in[i], 8);
+            memcpy(&b, &keystream[i], 8);
+            a ^= b;
+            memcpy(&out[i], &a, 8);
         }
-        todo = len - i;
-        if (todo > sizeof(keystream))
-            todo = sizeof(keystream);
-        /* Non optimal, but avoids alignment issues */
-        for (j = 0; j < todo; j++)
-            out[i + j] = in[i + j] ^ keystream[j];
+        for (; i < todo; i++)
+            out[i] = in[i] ^ keystream[i];
+        in += todo;
+        out += todo;
+        len -= todo;
     }
+    OPENSSL_cleanse(keystream, sizeof(keystream));
     return !error;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2023 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2019-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -15,6 +15,7 @@
 #include "internal/deprecated.h"
 
 #include <stddef.h>              /* for size_t */
+#include <string.h>              /* for memcpy */
 #include <openssl/e_os2.h>       /* for uint8_t */
 
 #include <openssl/evp.h>
@@ -46,18 +47,17 @@ static ossl_inline void mulx_ghash(uint64_t *a)
     }
 }
 
-#define aligned64(p) (((ossl_ssize_t)p & 0x07) == 0)
 static ossl_inline void byte_reverse16(uint8_t *out, const uint8_t *in)
 {
-    if (aligned64(out) && aligned64(in)) {
-        ((uint64_t *)out)[0] = GSWAP8(((uint64_t *)in)[1]);
-        ((uint64_t *)out)[1] = GSWAP8(((uint64_t *)in)[0]);
-    } else {
-        int i;
+    uint64_t a, b;
 
-        for (i = 0; i < 16; i++)
-            out[i] = in[15 - i];
-    }
+    /* memcpy() avoids alignment issues and compiles to plain loads */
+    memcpy(&a, in, 8);
+    memcpy(&b, in + 8, 8);
+    a = GSWAP8(a);
+    b = GSWAP8(b);
+    memcpy(out, &b, 8);
+    memcpy(out + 8, &a, 8);
 }
 
 /* Initialization of POLYVAL via existing GHASH implementation */
@@ -77,22 +77,31 @@ void ossl_polyval_ghash_init(u128 Htable[16], const uint64_t H[2])
     ossl_gcm_init_4bit(Htable, (uint64_t *)tmp);
 }
 
+/* Number of blocks byte-reversed for each call to the GHASH implementation */
+#define POLYVAL_BLOCKS 32
+
 /* Implementation of POLYVAL via existing GHASH implementation */
 void ossl_polyval_ghash_hash(const u128 Htable[16], uint8_t *tag, const uint8_t *inp, size_t len)
 {
     uint64_t out[2];
-    uint64_t tmp[2];
-    size_t i;
+    uint64_t tmp[POLYVAL_BLOCKS * 2];
+    size_t i, todo;
 
     byte_reverse16((uint8_t *)out, (uint8_t *)tag);
 
     /*
      * This implementation doesn't deal with partials, callers do,
-     * so, len is a multiple of 16
+     * so, len is a multiple of 16.
+     * The blocks are reversed in batches, so that the GHASH implementation
+     * sees many blocks at a time and can aggregate their reductions.
      */
-    for (i = 0; i < len; i += 16) {
-        byte_reverse16((uint8_t *)tmp, &inp[i]);
-        ossl_gcm_ghash_4bit((uint64_t *)out, Htable, (uint8_t *)tmp, 16);
+    while (len > 0) {
+        todo = len < sizeof(tmp) ? len : sizeof(tmp);
+        for (i = 0; i < todo; i += 16)
+            byte_reverse16((uint8_t *)tmp + i, &inp[i]);
+        ossl_gcm_ghash_4bit((uint64_t *)out, Htable, (uint8_t *)tmp, todo);
+        inp += todo;
+        len -= todo;
     }
     byte_reverse16(tag, (uint8_t *)out);
 }
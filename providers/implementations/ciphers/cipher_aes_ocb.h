@@ -13,6 +13,17 @@
 #include <openssl/aes.h>
 #include "prov/ciphercommon.h"
 #include "crypto/aes_platform.h"
+#include "internal/target_region.h"
+
+#if defined(AESNI_CAPABLE)
+#if defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)
+#if !defined(_M_ARM64EC)
+#if defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define AES_OCB_VAES
+#endif
+#endif /* !defined(_M_ARM64EC) */
+#endif
+#endif
 
 #define OCB_MAX_TAG_LEN AES_BLOCK_SIZE
 #define OCB_MAX_DATA_LEN AES_BLOCK_SIZE
@@ -41,4 +52,24 @@ typedef struct prov_aes_ocb_ctx_st {
 
 const PROV_CIPHER_HW *ossl_prov_cipher_hw_aes_ocb(size_t keybits);
 
+#ifdef AES_OCB_VAES
+/* AVX512F, which cpuid clears when there is no ZMM state, and VAES */
+#define AES_OCB_VAES_CAPABLE                    \
+    ((OPENSSL_ia32cap_P[2] & (1u << 16)) != 0 \
+        && (OPENSSL_ia32cap_P[3] & (1u << 9)) != 0)
+
+void ossl_aes_ocb_encrypt_vaes(const unsigned char *in, unsigned char *out,
+    size_t blocks, const void *key,
+    size_t start_block_num,
+    unsigned char offset_i[16],
+    const unsigned char L_[][16],
+    unsigned char checksum[16]);
+void ossl_aes_ocb_decrypt_vaes(const unsigned char *in, unsigned char *out,
+    size_t blocks, const void *key,
+    size_t start_block_num,
+    unsigned char offset_i[16],
+    const unsigned char L_[][16],
+    unsigned char checksum[16]);
+#endif
+
 #endif /* !defined(OSSL_PROVIDERS_IMPLEMENTATIONS_CIPHERS_CIPHER_AES_OCB_H) */
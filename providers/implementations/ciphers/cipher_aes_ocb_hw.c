@@ -65,6 +65,14 @@ static int cipher_hw_aes_ocb_aesni_initkey(PROV_CIPHER_CTX *vctx,
 {
     PROV_AES_OCB_CTX *ctx = (PROV_AES_OCB_CTX *)vctx;
 
+#ifdef AES_OCB_VAES
+    if (AES_OCB_VAES_CAPABLE) {
+        OCB_SET_KEY_FN(aesni_set_encrypt_key, aesni_set_decrypt_key,
+            aesni_encrypt, aesni_decrypt,
+            ossl_aes_ocb_encrypt_vaes, ossl_aes_ocb_decrypt_vaes);
+        return 1;
+    }
+#endif
     OCB_SET_KEY_FN(aesni_set_encrypt_key, aesni_set_decrypt_key,
         aesni_encrypt, aesni_decrypt,
         aesni_ocb_encrypt, aesni_ocb_decrypt);
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * AES OCB with VAES on AVX-512.
+ *
+ * The blocks of an OCB message are independent once their offsets are
+ * known, and the offsets only take one xor each.  So the offsets of sixteen
+ * blocks are computed first, and then the blocks go through the rounds in
+ * four registers of four blocks.  The few blocks before and after those runs
+ * are left to the AES-NI code, which takes the same offset and checksum.
+ */
+
+/*
+ * This file uses the low level AES functions (which are deprecated for
+ * non-internal use) in order to implement provider AES ciphers.
+ */
+#include "internal/deprecated.h"
+#include <openssl/crypto.h>
+#include "cipher_aes_ocb.h"
+
+#ifdef AES_OCB_VAES
+
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+#define OCB_VAES_BLOCKS 16
+
+/* The number of trailing zero bits of |n|, which is never 0 */
+static ossl_inline size_t ocb_vaes_ntz(size_t n)
+{
+    size_t cnt = 0;
+
+    while ((n & 1) == 0) {
+        n >>= 1;
+        cnt++;
+    }
+    return cnt;
+}
+
+OPENSSL_TARGET_REGION("avx512f,vaes,aes")
+
+/*
+ * Encrypts or decrypts the first |blocks| rounded down to a multiple of
+ * sixteen blocks, starting with block number |start|, and updates |offset_i|
+ * and |checksum| as aesni_ocb_encrypt() and aesni_ocb_decrypt() do.  |key|
+ * is the AES-NI key schedule for the direction.  |start| must be 1 modulo 4.
+ * Returns the number of blocks done.
+ *
+ * Of four blocks from 4k + 1 to 4k + 4 the first three take L_0, L_1 and
+ * L_0 from the one before them, and only the last one a higher L_i.  So the
+ * offsets of the four are the previous offset xor L_0, L_0 ^ L_1, L_1 and
+ * L_1 ^ L_i.
+ */
+static ossl_inline size_t ocb_vaes(const unsigned char *in, unsigned char *out,
+    size_t blocks, const AES_KEY *key, size_t start,
+    unsigned char offset_i[16], const unsigned char L_[][16],
+    unsigned char checksum[16], int dec)
+{
+    __m512i zrk[15], off[4], x[4], sum = _mm512_setzero_si512(), pat;
+    __m128i o, l0, l1, s;
+    /* The AES-NI key schedule keeps one less than the number of rounds */
+    int rounds = key->rounds + 1, r;
+    size_t n = blocks - blocks % OCB_VAES_BLOCKS, b;
+
+    if (n == 0)
+        return 0;
+
+    for (r = 0; r <= rounds; r++)
+        zrk[r] = _mm512_broadcast_i32x4(
+            _mm_loadu_si128((const __m128i *)key->rd_key + r));
+    l0 = _mm_loadu_si128((const __m128i *)L_[0]);
+    l1 = _mm_loadu_si128((const __m128i *)L_[1]);
+    pat = _mm512_castsi128_si512(l0);
+    pat = _mm512_inserti32x4(pat, _mm_xor_si128(l0, l1), 1);
+    pat = _mm512_inserti32x4(pat, l1, 2);
+    pat = _mm512_inserti32x4(pat, l1, 3);
+    o = _mm_loadu_si128((const __m128i *)offset_i);
+
+    for (blocks = n; blocks > 0; blocks -= OCB_VAES_BLOCKS) {
+        for (b = 0; b < 4; b++) {
+            __m128i li = _mm_loadu_si128(
+                (const __m128i *)L_[ocb_vaes_ntz(start + 3)]);
+
+            off[b] = _mm512_xor_si512(_mm512_broadcast_i32x4(o), pat);
+            off[b] = _mm512_mask_xor_epi64(off[b], 0xC0, off[b],
+                _mm512_broadcast_i32x4(li));
+            o = _mm_xor_si128(o, _mm_xor_si128(l1, li));
+            start += 4;
+
+            x[b] = _mm512_loadu_si512(in + 64 * b);
+            if (!dec)
+                sum = _mm512_xor_si512(sum, x[b]);
+            x[b] = _mm512_xor_si512(_mm512_xor_si512(x[b], off[b]), zrk[0]);
+        }
+        if (dec) {
+            for (r = 1; r < rounds; r++)
+                for (b = 0; b < 4; b++)
+                    x[b] = _mm512_aesdec_epi128(x[b], zrk[r]);
+            for (b = 0; b < 4; b++) {
+                x[b] = _mm512_xor_si512(
+                    _mm512_aesdeclast_epi128(x[b], zrk[rounds]), off[b]);
+                sum = _mm512_xor_si512(sum, x[b]);
+            }
+        } else {
+            for (r = 1; r < rounds; r++)
+                for (b = 0; b < 4; b++)
+                    x[b] = _mm512_aesenc_epi128(x[b], zrk[r]);
+            for (b = 0; b < 4; b++)
+                x[b] = _mm512_xor_si512(
+                    _mm512_aesenclast_epi128(x[b], zrk[rounds]), off[b]);
+        }
+        for (b = 0; b < 4; b++)
+            _mm512_storeu_si512(out + 64 * b, x[b]);
+        in += 64 * 4;
+        out += 64 * 4;
+    }
+
+    s = _mm_xor_si128(
+        _mm_xor_si128(_mm512_castsi512_si128(sum),
+            _mm512_extracti32x4_epi32(sum, 1)),
+        _mm_xor_si128(_mm512_extracti32x4_epi32(sum, 2),
+            _mm512_extracti32x4_epi32(sum, 3)));
+    s = _mm_xor_si128(s, _mm_loadu_si128((const __m128i *)checksum));
+    _mm_storeu_si128((__m128i *)checksum, s);
+    _mm_storeu_si128((__m128i *)offset_i, o);
+
+    OPENSSL_cleanse(zrk, sizeof(zrk));
+    OPENSSL_cleanse(x, sizeof(x));
+    return n;
+}
+
+/*
+ * The AES-NI code does the blocks up to the next one that is 1 modulo 4,
+ * and whatever is left after the runs of sixteen.
+ */
+static ossl_inline void ocb_vaes_blocks(const unsigned char *in,
+    unsigned char *out, size_t blocks, const void *key, size_t start,
+    unsigned char offset_i[16], const unsigned char L_[][16],
+    unsigned char checksum[16], int dec)
+{
+    ocb128_f aesni = dec ? aesni_ocb_decrypt : aesni_ocb_encrypt;
+    size_t k = (1 - start) & 3, n;
+
+    if (blocks < k + OCB_VAES_BLOCKS) {
+        aesni(in, out, blocks, key, start, offset_i, L_, checksum);
+        return;
+    }
+    if (k > 0)
+        aesni(in, out, k, key, start, offset_i, L_, checksum);
+    n = k + ocb_vaes(in + 16 * k, out + 16 * k, blocks - k, key, start + k,
+        offset_i, L_, checksum, dec);
+    if (n < blocks)
+        aesni(in + 16 * n, out + 16 * n, blocks - n, key, start + n,
+            offset_i, L_, checksum);
+}
+
+void ossl_aes_ocb_encrypt_vaes(const unsigned char *in, unsigned char *out,
+    size_t blocks, const void *key,
+    size_t start_block_num,
+    unsigned char offset_i[16],
+    const unsigned char L_[][16],
+    unsigned char checksum[16])
+{
+    ocb_vaes_blocks(in, out, blocks, key, start_block_num, offset_i, L_,
+        checksum, 0);
+}
+
+void ossl_aes_ocb_decrypt_vaes(const unsigned char *in, unsigned char *out,
+    size_t blocks, const void *key,
+    size_t start_block_num,
+    unsigned char offset_i[16],
+    const unsigned char L_[][16],
+    unsigned char checksum[16])
+{
+    ocb_vaes_blocks(in, out, blocks, key, start_block_num, offset_i, L_,
+        checksum, 1);
+}
+
+OPENSSL_UNTARGET_REGION
+
+#endif /* AES_OCB_VAES */
@@ -53,6 +53,7 @@ static void aes_siv_freectx(void *vctx)
 
     if (ctx != NULL) {
         ctx->hw->cleanup(ctx);
+        OPENSSL_clear_free(ctx->pipes, sizeof(*ctx->pipes));
         OPENSSL_clear_free(ctx, sizeof(*ctx));
     }
 }
@@ -71,6 +72,8 @@ static void *siv_dupctx(void *vctx)
     if (!in->hw->dupctx(in, ret)) {
         OPENSSL_free(ret);
         ret = NULL;
+    } else {
+        ret->pipes = NULL;
     }
     return ret;
 }
@@ -148,6 +151,180 @@ static int siv_stream_final(void *vctx, unsigned char *out, size_t *outl,
     return 1;
 }
 
+/*-
+ * The pipelined interface processes one whole message per pipe.  Every
+ * update with a NULL output adds one associated data component to each
+ * message, as it does for a single message, then a single update takes the
+ * payloads.  The CMACs of all the messages are computed together with EVP_MAC_batch().
+ */
+static int siv_pipeline_init(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[], int enc)
+{
+    PROV_AES_SIV_CTX *ctx = (PROV_AES_SIV_CTX *)vctx;
+    PROV_AES_SIV_PIPES *pipes;
+    size_t i;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (numpipes == 0 || numpipes > EVP_MAX_PIPES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_INPUT_LENGTH);
+        return 0;
+    }
+    /* A nonce is passed as associated data */
+    if (iv != NULL && ivlen != 0) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_IV_LENGTH);
+        return 0;
+    }
+    if (ctx->pipes == NULL
+        && (ctx->pipes = OPENSSL_zalloc(sizeof(*ctx->pipes))) == NULL)
+        return 0;
+    pipes = ctx->pipes;
+    pipes->numpipes = 0;
+    ctx->enc = enc;
+
+    if (key != NULL) {
+        if (keylen != ctx->keylen) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+            return 0;
+        }
+        if (!ctx->hw->initkey(ctx, key, ctx->keylen))
+            return 0;
+    }
+    if (ctx->siv.mac_ctx_init == NULL) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_NO_KEY_SET);
+        return 0;
+    }
+    for (i = 0; i < numpipes; i++)
+        pipes->d[i] = ctx->d0;
+    pipes->numpipes = numpipes;
+    pipes->done = 0;
+    pipes->tag_set = 0;
+    return aes_siv_set_ctx_params(ctx, params);
+}
+
+static OSSL_FUNC_cipher_pipeline_encrypt_init_fn siv_pipeline_einit;
+static int siv_pipeline_einit(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    return siv_pipeline_init(vctx, key, keylen, numpipes, iv, ivlen,
+        params, 1);
+}
+
+static OSSL_FUNC_cipher_pipeline_decrypt_init_fn siv_pipeline_dinit;
+static int siv_pipeline_dinit(void *vctx, const unsigned char *key,
+    size_t keylen, size_t numpipes,
+    const unsigned char **iv, size_t ivlen,
+    const OSSL_PARAM params[])
+{
+    return siv_pipeline_init(vctx, key, keylen, numpipes, iv, ivlen,
+        params, 0);
+}
+
+static int siv_pipeline_cipher(PROV_AES_SIV_CTX *ctx,
+    unsigned char **out, const unsigned char **in, const size_t *inl)
+{
+    PROV_AES_SIV_PIPES *pipes = ctx->pipes;
+    static const unsigned char empty[1] = { 0 };
+    const unsigned char *src[EVP_MAX_PIPES];
+    unsigned char *dst[EVP_MAX_PIPES], sink[1];
+    size_t len[EVP_MAX_PIPES], i;
+    int ok;
+
+    if (!ctx->enc && !pipes->tag_set) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_TAG_NOT_SET);
+        return 0;
+    }
+    for (i = 0; i < pipes->numpipes; i++) {
+        src[i] = in != NULL ? in[i] : empty;
+        dst[i] = out != NULL ? out[i] : sink;
+        len[i] = in != NULL ? inl[i] : 0;
+    }
+
+    if (ctx->enc)
+        ok = ossl_siv128_encrypt_batch(&ctx->siv, pipes->d, pipes->tag, src,
+            dst, len, pipes->numpipes);
+    else
+        ok = ossl_siv128_decrypt_batch(&ctx->siv, pipes->d, pipes->tag, src,
+            dst, len, pipes->numpipes);
+    pipes->done = 1;
+    pipes->tag_set = ctx->enc && ok;
+    if (!ok)
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+    return ok;
+}
+
+static OSSL_FUNC_cipher_pipeline_update_fn siv_pipeline_update;
+static int siv_pipeline_update(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize,
+    const unsigned char **in, const size_t *inl)
+{
+    PROV_AES_SIV_CTX *ctx = (PROV_AES_SIV_CTX *)vctx;
+    PROV_AES_SIV_PIPES *pipes = ctx->pipes;
+    size_t i;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (pipes == NULL || pipes->done || numpipes != pipes->numpipes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+        return 0;
+    }
+
+    if (out == NULL) {
+        if (!ossl_siv128_aad_batch(&ctx->siv, pipes->d, in, inl, numpipes)) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+            return 0;
+        }
+        for (i = 0; i < numpipes; i++)
+            outl[i] = inl[i];
+        return 1;
+    }
+
+    for (i = 0; i < numpipes; i++) {
+        if (outsize == NULL || outsize[i] < inl[i]) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+            return 0;
+        }
+    }
+    if (!siv_pipeline_cipher(ctx, out, in, inl))
+        return 0;
+    for (i = 0; i < numpipes; i++)
+        outl[i] = inl[i];
+    return 1;
+}
+
+static OSSL_FUNC_cipher_pipeline_final_fn siv_pipeline_final;
+static int siv_pipeline_final(void *vctx, size_t numpipes,
+    unsigned char **out, size_t *outl,
+    const size_t *outsize)
+{
+    PROV_AES_SIV_CTX *ctx = (PROV_AES_SIV_CTX *)vctx;
+    PROV_AES_SIV_PIPES *pipes = ctx->pipes;
+    size_t i;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (pipes == NULL || numpipes != pipes->numpipes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_CIPHER_OPERATION_FAILED);
+        return 0;
+    }
+
+    /* Messages that only had associated data are authenticated here */
+    if (!pipes->done && !siv_pipeline_cipher(ctx, NULL, NULL, NULL))
+        return 0;
+
+    for (i = 0; i < numpipes; i++)
+        outl[i] = 0;
+    return 1;
+}
+
 static int aes_siv_get_ctx_params(void *vctx, OSSL_PARAM params[])
 {
     PROV_AES_SIV_CTX *ctx = (PROV_AES_SIV_CTX *)vctx;
@@ -159,6 +336,17 @@ static int aes_siv_get_ctx_params(void *vctx, OSSL_PARAM params[])
 
     sctx = &ctx->siv;
 
+    if (p.pipetag != NULL) {
+        if (ctx->pipes == NULL || !ctx->enc || !ctx->pipes->tag_set) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_TAG_NOT_SET);
+            return 0;
+        }
+        if (!ossl_cipher_pipeline_get_tags(p.pipetag, ctx->pipes->tag[0].byte,
+                sizeof(ctx->pipes->tag[0]), ctx->pipes->numpipes,
+                ctx->taglen))
+            return 0;
+    }
+
     if (p.tag != NULL) {
         if (!ctx->enc
             || p.tag->data_type != OSSL_PARAM_OCTET_STRING
@@ -198,6 +386,23 @@ static int aes_siv_set_ctx_params(void *vctx, const OSSL_PARAM params[])
     if (ctx == NULL || !aes_siv_set_ctx_params_decoder(params, &p))
         return 0;
 
+    if (p.pipetag != NULL) {
+        size_t taglen;
+
+        if (ctx->pipes == NULL || ctx->enc) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_TAG_NOT_NEEDED);
+            return 0;
+        }
+        if (!ossl_cipher_pipeline_set_tags(p.pipetag, ctx->pipes->tag[0].byte,
+                sizeof(ctx->pipes->tag[0]), ctx->pipes->numpipes, &taglen))
+            return 0;
+        if (taglen != ctx->taglen) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_TAG_LENGTH);
+            return 0;
+        }
+        ctx->pipes->tag_set = 1;
+    }
+
     if (p.tag != NULL) {
         if (ctx->enc)
             return 1;
@@ -247,6 +452,10 @@ static const OSSL_PARAM *aes_siv_settable_ctx_params(ossl_unused void *cctx,
     static OSSL_FUNC_cipher_update_fn lc##_stream_update;                        \
     static OSSL_FUNC_cipher_final_fn lc##_stream_final;                          \
     static OSSL_FUNC_cipher_cipher_fn lc##_cipher;                               \
+    static OSSL_FUNC_cipher_pipeline_encrypt_init_fn lc##_pipeline_einit;        \
+    static OSSL_FUNC_cipher_pipeline_decrypt_init_fn lc##_pipeline_dinit;        \
+    static OSSL_FUNC_cipher_pipeline_update_fn lc##_pipeline_update;             \
+    static OSSL_FUNC_cipher_pipeline_final_fn lc##_pipeline_final;               \
     static OSSL_FUNC_cipher_get_params_fn alg##_##kbits##_##lc##_get_params;     \
     static OSSL_FUNC_cipher_get_ctx_params_fn alg##_##lc##_get_ctx_params;       \
     static OSSL_FUNC_cipher_gettable_ctx_params_fn                               \
@@ -273,6 +482,14 @@ static const OSSL_PARAM *aes_siv_settable_ctx_params(ossl_unused void *cctx,
         { OSSL_FUNC_CIPHER_UPDATE, (void (*)(void))lc##_stream_update },         \
         { OSSL_FUNC_CIPHER_FINAL, (void (*)(void))lc##_stream_final },           \
         { OSSL_FUNC_CIPHER_CIPHER, (void (*)(void))lc##_cipher },                \
+        { OSSL_FUNC_CIPHER_PIPELINE_ENCRYPT_INIT,                                \
+            (void (*)(void))lc##_pipeline_einit },                               \
+        { OSSL_FUNC_CIPHER_PIPELINE_DECRYPT_INIT,                                \
+            (void (*)(void))lc##_pipeline_dinit },                               \
+        { OSSL_FUNC_CIPHER_PIPELINE_UPDATE,                                      \
+            (void (*)(void))lc##_pipeline_update },                              \
+        { OSSL_FUNC_CIPHER_PIPELINE_FINAL,                                       \
+            (void (*)(void))lc##_pipeline_final },                               \
         { OSSL_FUNC_CIPHER_GET_PARAMS,                                           \
             (void (*)(void))alg##_##kbits##_##lc##_get_params },                 \
         { OSSL_FUNC_CIPHER_GETTABLE_PARAMS,                                      \
@@ -24,16 +24,27 @@ typedef struct prov_cipher_hw_aes_siv_st {
     int (*dupctx)(void *src, void *dst);
 } PROV_CIPHER_HW_AES_SIV;
 
+/* A pipelined operation, one whole message per pipe */
+typedef struct prov_aes_siv_pipes_st {
+    size_t numpipes;
+    unsigned int done : 1; /* the payloads were processed */
+    unsigned int tag_set : 1;
+    SIV_BLOCK d[EVP_MAX_PIPES];
+    SIV_BLOCK tag[EVP_MAX_PIPES];
+} PROV_AES_SIV_PIPES;
+
 typedef struct prov_siv_ctx_st {
     unsigned int mode; /* The mode that we are using */
     unsigned int enc : 1; /* Set to 1 if we are encrypting or 0 otherwise */
     size_t keylen; /* The input keylength (twice the alg key length) */
     size_t taglen; /* the taglen is the same as the sivlen */
     SIV128_CONTEXT siv;
+    SIV_BLOCK d0; /* D after the key setup, where pipelined messages start */
     EVP_CIPHER *ctr; /* These are fetched - so we need to free them */
     EVP_CIPHER *cbc;
     const PROV_CIPHER_HW_AES_SIV *hw;
     OSSL_LIB_CTX *libctx;
+    PROV_AES_SIV_PIPES *pipes;
 } PROV_AES_SIV_CTX;
 
 const PROV_CIPHER_HW_AES_SIV *ossl_prov_cipher_hw_aes_siv(size_t keybits);
@@ -52,8 +52,11 @@ static int aes_siv_initkey(void *vctx, const unsigned char *key, size_t keylen)
      * klen is the length of the underlying cipher, not the input key,
      * which should be twice as long
      */
-    return ossl_siv128_init(sctx, key, (int)klen, ctx->cbc, ctx->ctr, libctx,
-        propq);
+    if (!ossl_siv128_init(sctx, key, (int)klen, ctx->cbc, ctx->ctr, libctx,
+            propq))
+        return 0;
+    ctx->d0 = sctx->d;
+    return 1;
 }
 
 static int aes_siv_dupctx(void *in_vctx, void *out_vctx)
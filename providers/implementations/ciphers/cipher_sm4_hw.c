@@ -67,6 +67,18 @@ static int cipher_hw_sm4_initkey(PROV_CIPHER_CTX *ctx,
             else if (ctx->mode == EVP_CIPH_CTR_MODE)
                 ctx->stream.ctr = (ctr128_f)vpsm4_ctr32_encrypt_blocks;
         } else
+#endif
+#ifdef SM4_AESNI_AVX2_CAPABLE
+            if (SM4_AESNI_AVX2_CAPABLE) {
+            /* Single blocks and CBC encryption are quicker with the tables */
+            ossl_sm4_set_key(key, ks);
+            ctx->block = (block128_f)ossl_sm4_encrypt;
+            ctx->stream.cbc = NULL;
+            if (ctx->mode == EVP_CIPH_ECB_MODE)
+                ctx->stream.ecb = (ecb128_f)ossl_sm4_aesni_avx2_ecb_encrypt;
+            else if (ctx->mode == EVP_CIPH_CTR_MODE)
+                ctx->stream.ctr = (ctr128_f)ossl_sm4_aesni_avx2_ctr32_encrypt_blocks;
+        } else
 #endif
         {
             ossl_sm4_set_key(key, ks);
@@ -109,6 +121,17 @@ static int cipher_hw_sm4_initkey(PROV_CIPHER_CTX *ctx,
             else if (ctx->mode == EVP_CIPH_ECB_MODE)
                 ctx->stream.ecb = (ecb128_f)vpsm4_ecb_encrypt;
         } else
+#endif
+#ifdef SM4_AESNI_AVX2_CAPABLE
+            if (SM4_AESNI_AVX2_CAPABLE) {
+            ossl_sm4_set_key(key, ks);
+            ctx->block = (block128_f)ossl_sm4_decrypt;
+            ctx->stream.cbc = NULL;
+            if (ctx->mode == EVP_CIPH_CBC_MODE)
+                ctx->stream.cbc = (cbc128_f)ossl_sm4_aesni_avx2_cbc_encrypt;
+            else if (ctx->mode == EVP_CIPH_ECB_MODE)
+                ctx->stream.ecb = (ecb128_f)ossl_sm4_aesni_avx2_ecb_encrypt;
+        } else
 #endif
         {
             ossl_sm4_set_key(key, ks);
@@ -62,6 +62,15 @@ static int cipher_hw_sm4_xts_generic_initkey(PROV_CIPHER_CTX *ctx,
         return 1;
     } else
 #endif /* VPSM4_CAPABLE */
+#ifdef SM4_AESNI_AVX2_CAPABLE
+        if (SM4_AESNI_AVX2_CAPABLE) {
+        stream = ossl_sm4_aesni_avx2_xts_encrypt;
+        stream_gb = ossl_sm4_aesni_avx2_xts_encrypt_gb;
+        XTS_SET_KEY_FN(ossl_sm4_set_key, ossl_sm4_set_key,
+            ossl_sm4_encrypt, ossl_sm4_decrypt, stream, stream_gb);
+        return 1;
+    } else
+#endif /* SM4_AESNI_AVX2_CAPABLE */
     {
         (void)0;
     }
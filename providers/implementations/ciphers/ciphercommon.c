@@ -701,3 +701,44 @@ void ossl_cipher_generic_initkey(void *vctx, size_t kbits, size_t blkbits,
     if (provctx != NULL)
         ctx->libctx = PROV_LIBCTX_OF(provctx); /* used for rand */
 }
+
+int ossl_cipher_pipeline_get_tags(const OSSL_PARAM *p,
+    const unsigned char *tags, size_t stride, size_t numpipes, size_t taglen)
+{
+    unsigned char **out;
+    size_t len, i;
+
+    if (!OSSL_PARAM_get_octet_ptr(p, (const void **)&out, &len)
+        || out == NULL) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
+        return 0;
+    }
+    if (len != taglen) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_TAG_LENGTH);
+        return 0;
+    }
+    for (i = 0; i < numpipes; i++)
+        memcpy(out[i], tags + i * stride, taglen);
+    return 1;
+}
+
+int ossl_cipher_pipeline_set_tags(const OSSL_PARAM *p, unsigned char *tags,
+    size_t stride, size_t numpipes, size_t *taglen)
+{
+    unsigned char **in;
+    size_t len, i;
+
+    if (!OSSL_PARAM_get_octet_ptr(p, (const void **)&in, &len)
+        || in == NULL) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+        return 0;
+    }
+    if (len == 0 || len > stride) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_TAG_LENGTH);
+        return 0;
+    }
+    for (i = 0; i < numpipes; i++)
+        memcpy(tags + i * stride, in[i], len);
+    *taglen = len;
+    return 1;
+}
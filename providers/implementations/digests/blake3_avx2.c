@@ -0,0 +1,174 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Eight-way BLAKE3 compression: each 32-bit lane of a 256-bit register holds
+ * the same state word of a different chunk (or parent node), so the eight
+ * inputs are compressed together with plain vertical operations.
+ */
+
+#include <openssl/e_os2.h>
+#include "blake3_avx2.h"
+
+#if defined(BLAKE3_AVX2) && !defined(OPENSSL_NO_BLAKE3)
+
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+static const uint32_t blake3_IV[8] = {
+    0x6A09E667U, 0xBB67AE85U, 0x3C6EF372U, 0xA54FF53AU,
+    0x510E527FU, 0x9B05688CU, 0x1F83D9ABU, 0x5BE0CD19U
+};
+
+static const uint8_t blake3_msg_schedule[7][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+    { 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+    { 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+    { 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+    { 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+    { 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 }
+};
+
+OPENSSL_TARGET_REGION("avx2")
+
+#define ADD(a, b) _mm256_add_epi32((a), (b))
+#define XOR(a, b) _mm256_xor_si256((a), (b))
+#define ROTR16(x) _mm256_shuffle_epi8((x), r16)
+#define ROTR12(x) \
+    _mm256_or_si256(_mm256_srli_epi32((x), 12), _mm256_slli_epi32((x), 20))
+#define ROTR8(x) _mm256_shuffle_epi8((x), r8)
+#define ROTR7(x) \
+    _mm256_or_si256(_mm256_srli_epi32((x), 7), _mm256_slli_epi32((x), 25))
+
+#define G(a, b, c, d, x, y)               \
+    do {                                  \
+        v[a] = ADD(ADD(v[a], v[b]), (x)); \
+        v[d] = ROTR16(XOR(v[d], v[a]));   \
+        v[c] = ADD(v[c], v[d]);           \
+        v[b] = ROTR12(XOR(v[b], v[c]));   \
+        v[a] = ADD(ADD(v[a], v[b]), (y)); \
+        v[d] = ROTR8(XOR(v[d], v[a]));    \
+        v[c] = ADD(v[c], v[d]);           \
+        v[b] = ROTR7(XOR(v[b], v[c]));    \
+    } while ((void)0, 0)
+
+#define ROUND(r)                                                       \
+    do {                                                               \
+        const uint8_t *s = blake3_msg_schedule[r];                     \
+                                                                       \
+        G(0, 4, 8, 12, m[s[0]], m[s[1]]);                              \
+        G(1, 5, 9, 13, m[s[2]], m[s[3]]);                              \
+        G(2, 6, 10, 14, m[s[4]], m[s[5]]);                             \
+        G(3, 7, 11, 15, m[s[6]], m[s[7]]);                             \
+        G(0, 5, 10, 15, m[s[8]], m[s[9]]);                             \
+        G(1, 6, 11, 12, m[s[10]], m[s[11]]);                           \
+        G(2, 7, 8, 13, m[s[12]], m[s[13]]);                            \
+        G(3, 4, 9, 14, m[s[14]], m[s[15]]);                            \
+    } while ((void)0, 0)
+
+/* Turn eight rows of eight words into eight columns */
+static ossl_inline void transpose8(__m256i x[8])
+{
+    __m256i ab0145 = _mm256_unpacklo_epi32(x[0], x[1]);
+    __m256i ab2367 = _mm256_unpackhi_epi32(x[0], x[1]);
+    __m256i cd0145 = _mm256_unpacklo_epi32(x[2], x[3]);
+    __m256i cd2367 = _mm256_unpackhi_epi32(x[2], x[3]);
+    __m256i ef0145 = _mm256_unpacklo_epi32(x[4], x[5]);
+    __m256i ef2367 = _mm256_unpackhi_epi32(x[4], x[5]);
+    __m256i gh0145 = _mm256_unpacklo_epi32(x[6], x[7]);
+    __m256i gh2367 = _mm256_unpackhi_epi32(x[6], x[7]);
+    __m256i abcd04 = _mm256_unpacklo_epi64(ab0145, cd0145);
+    __m256i abcd15 = _mm256_unpackhi_epi64(ab0145, cd0145);
+    __m256i abcd26 = _mm256_unpacklo_epi64(ab2367, cd2367);
+    __m256i abcd37 = _mm256_unpackhi_epi64(ab2367, cd2367);
+    __m256i efgh04 = _mm256_unpacklo_epi64(ef0145, gh0145);
+    __m256i efgh15 = _mm256_unpackhi_epi64(ef0145, gh0145);
+    __m256i efgh26 = _mm256_unpacklo_epi64(ef2367, gh2367);
+    __m256i efgh37 = _mm256_unpackhi_epi64(ef2367, gh2367);
+
+    x[0] = _mm256_permute2x128_si256(abcd04, efgh04, 0x20);
+    x[1] = _mm256_permute2x128_si256(abcd15, efgh15, 0x20);
+    x[2] = _mm256_permute2x128_si256(abcd26, efgh26, 0x20);
+    x[3] = _mm256_permute2x128_si256(abcd37, efgh37, 0x20);
+    x[4] = _mm256_permute2x128_si256(abcd04, efgh04, 0x31);
+    x[5] = _mm256_permute2x128_si256(abcd15, efgh15, 0x31);
+    x[6] = _mm256_permute2x128_si256(abcd26, efgh26, 0x31);
+    x[7] = _mm256_permute2x128_si256(abcd37, efgh37, 0x31);
+}
+
+void ossl_blake3_hash8_avx2(const uint8_t *const *inputs, size_t blocks,
+    const uint32_t key[8], uint64_t counter, int increment_counter,
+    uint8_t flags, uint8_t flags_start, uint8_t flags_end, uint8_t *out)
+{
+    const __m256i r16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5,
+        10, 11, 8, 9, 14, 15, 12, 13,
+        2, 3, 0, 1, 6, 7, 4, 5,
+        10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i r8 = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4,
+        9, 10, 11, 8, 13, 14, 15, 12,
+        1, 2, 3, 0, 5, 6, 7, 4,
+        9, 10, 11, 8, 13, 14, 15, 12);
+    uint32_t ctr_lo[8], ctr_hi[8];
+    __m256i h[8], m[16], v[16], t_lo, t_hi;
+    uint8_t block_flags = flags | flags_start;
+    size_t b, pos;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        uint64_t c = counter + (increment_counter ? (uint64_t)i : 0);
+
+        h[i] = _mm256_set1_epi32((int)key[i]);
+        ctr_lo[i] = (uint32_t)c;
+        ctr_hi[i] = (uint32_t)(c >> 32);
+    }
+    t_lo = _mm256_loadu_si256((const __m256i *)ctr_lo);
+    t_hi = _mm256_loadu_si256((const __m256i *)ctr_hi);
+
+    for (b = 0, pos = 0; b < blocks; b++, pos += 64) {
+        if (b + 1 == blocks)
+            block_flags |= flags_end;
+
+        for (i = 0; i < 8; i++) {
+            m[i] = _mm256_loadu_si256((const __m256i *)(inputs[i] + pos));
+            m[i + 8] = _mm256_loadu_si256((const __m256i *)(inputs[i] + pos + 32));
+        }
+        transpose8(m);
+        transpose8(m + 8);
+
+        for (i = 0; i < 8; i++)
+            v[i] = h[i];
+        for (i = 0; i < 4; i++)
+            v[i + 8] = _mm256_set1_epi32((int)blake3_IV[i]);
+        v[12] = t_lo;
+        v[13] = t_hi;
+        v[14] = _mm256_set1_epi32(64);
+        v[15] = _mm256_set1_epi32(block_flags);
+
+        ROUND(0);
+        ROUND(1);
+        ROUND(2);
+        ROUND(3);
+        ROUND(4);
+        ROUND(5);
+        ROUND(6);
+
+        for (i = 0; i < 8; i++)
+            h[i] = XOR(v[i], v[i + 8]);
+        block_flags = flags;
+    }
+
+    transpose8(h);
+    for (i = 0; i < 8; i++)
+        _mm256_storeu_si256((__m256i *)(out + 32 * i), h[i]);
+}
+
+OPENSSL_UNTARGET_REGION
+
+#endif
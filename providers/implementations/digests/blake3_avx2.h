@@ -0,0 +1,39 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_PROV_DIGESTS_BLAKE3_AVX2_H
+#define OSSL_PROV_DIGESTS_BLAKE3_AVX2_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "internal/target_region.h"
+
+#if defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)
+#if !defined(_M_ARM64EC)
+#if defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define BLAKE3_AVX2
+/* The AVX2 bit of CPUID leaf 7 */
+#define BLAKE3_AVX2_CAPABLE ((OPENSSL_ia32cap_P[2] & (1u << 5)) != 0)
+#define BLAKE3_AVX2_DEGREE 8
+
+/*
+ * Hash BLAKE3_AVX2_DEGREE inputs of |blocks| 64 byte blocks each, one input
+ * per 32-bit lane, and write their chaining values one after another to
+ * |out|.  Input i uses the counter |counter| + i if |increment_counter| is
+ * set and |counter| otherwise.  |flags_start| and |flags_end| are added to
+ * the flags of the first and the last block.
+ */
+void ossl_blake3_hash8_avx2(const uint8_t *const *inputs, size_t blocks,
+    const uint32_t key[8], uint64_t counter, int increment_counter,
+    uint8_t flags, uint8_t flags_start, uint8_t flags_end, uint8_t *out);
+#endif
+#endif /* !defined(_M_ARM64EC) */
+#endif
+
+#endif
@@ -0,0 +1,758 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * BLAKE3, see https://github.com/BLAKE3-team/BLAKE3-specs.
+ *
+ * The input is split into 1 KiB chunks that are the leaves of a binary tree.
+ * Whenever an update supplies several whole chunks, the largest complete
+ * subtree is hashed at once: its chunks (and then its parent nodes) are
+ * compressed several at a time by a SIMD kernel, and for large inputs the
+ * two halves of the subtree can be hashed on different threads.
+ */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include "internal/cryptlib.h"
+#include "internal/thread.h"
+#include "blake2_impl.h"
+#include "blake3_avx2.h"
+#include "prov/blake3.h"
+
+#if defined(OPENSSL_NO_DEFAULT_THREAD_POOL) && defined(OPENSSL_NO_THREAD_POOL)
+#define BLAKE3_NO_THREADS
+#endif
+
+#if !defined(OPENSSL_THREADS)
+#define BLAKE3_NO_THREADS
+#endif
+
+/* The widest SIMD kernel, at least two */
+#ifdef BLAKE3_AVX2
+#define BLAKE3_MAX_SIMD_DEGREE BLAKE3_AVX2_DEGREE
+#else
+#define BLAKE3_MAX_SIMD_DEGREE 2
+#endif
+
+/* Subtrees are only split over threads if each half is at least this big */
+#define BLAKE3_MT_MIN_LEN (128 * BLAKE3_CHUNK_LEN)
+
+static const uint32_t blake3_IV[8] = {
+    0x6A09E667U, 0xBB67AE85U, 0x3C6EF372U, 0xA54FF53AU,
+    0x510E527FU, 0x9B05688CU, 0x1F83D9ABU, 0x5BE0CD19U
+};
+
+static const uint8_t blake3_msg_schedule[7][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+    { 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+    { 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+    { 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+    { 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+    { 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 }
+};
+
+/* Run the seven rounds, leaving the full 16 word state in |v| */
+static void blake3_compress_pre(uint32_t v[16], const uint32_t cv[8],
+    const uint8_t block[BLAKE3_BLOCK_LEN], uint8_t block_len,
+    uint64_t counter, uint8_t flags)
+{
+    uint32_t m[16];
+    int i;
+
+    for (i = 0; i < 16; i++)
+        m[i] = load32(block + 4 * i);
+    for (i = 0; i < 8; i++)
+        v[i] = cv[i];
+    v[8] = blake3_IV[0];
+    v[9] = blake3_IV[1];
+    v[10] = blake3_IV[2];
+    v[11] = blake3_IV[3];
+    v[12] = (uint32_t)counter;
+    v[13] = (uint32_t)(counter >> 32);
+    v[14] = block_len;
+    v[15] = flags;
+
+#define G(r, i, a, b, c, d)                               \
+    do {                                                  \
+        a = a + b + m[blake3_msg_schedule[r][2 * i + 0]]; \
+        d = rotr32(d ^ a, 16);                            \
+        c = c + d;                                        \
+        b = rotr32(b ^ c, 12);                            \
+        a = a + b + m[blake3_msg_schedule[r][2 * i + 1]]; \
+        d = rotr32(d ^ a, 8);                             \
+        c = c + d;                                        \
+        b = rotr32(b ^ c, 7);                             \
+    } while (0)
+#define ROUND(r)                           \
+    do {                                   \
+        G(r, 0, v[0], v[4], v[8], v[12]);  \
+        G(r, 1, v[1], v[5], v[9], v[13]);  \
+        G(r, 2, v[2], v[6], v[10], v[14]); \
+        G(r, 3, v[3], v[7], v[11], v[15]); \
+        G(r, 4, v[0], v[5], v[10], v[15]); \
+        G(r, 5, v[1], v[6], v[11], v[12]); \
+        G(r, 6, v[2], v[7], v[8], v[13]);  \
+        G(r, 7, v[3], v[4], v[9], v[14]);  \
+    } while (0)
+#if defined(OPENSSL_SMALL_FOOTPRINT)
+    for (i = 0; i < 7; i++) {
+        ROUND(i);
+    }
+#else
+    ROUND(0);
+    ROUND(1);
+    ROUND(2);
+    ROUND(3);
+    ROUND(4);
+    ROUND(5);
+    ROUND(6);
+#endif
+#undef G
+#undef ROUND
+}
+
+static void blake3_compress_in_place(uint32_t cv[8],
+    const uint8_t block[BLAKE3_BLOCK_LEN], uint8_t block_len,
+    uint64_t counter, uint8_t flags)
+{
+    uint32_t v[16];
+    int i;
+
+    blake3_compress_pre(v, cv, block, block_len, counter, flags);
+    for (i = 0; i < 8; i++)
+        cv[i] = v[i] ^ v[i + 8];
+}
+
+/* The extended output of one compression: 64 bytes instead of 32 */
+static void blake3_compress_xof(const uint32_t cv[8],
+    const uint8_t block[BLAKE3_BLOCK_LEN], uint8_t block_len,
+    uint64_t counter, uint8_t flags, uint8_t out[64])
+{
+    uint32_t v[16];
+    int i;
+
+    blake3_compress_pre(v, cv, block, block_len, counter, flags);
+    for (i = 0; i < 8; i++) {
+        store32(out + 4 * i, v[i] ^ v[i + 8]);
+        store32(out + 32 + 4 * i, v[i + 8] ^ cv[i]);
+    }
+}
+
+static void blake3_store_cv(uint8_t out[BLAKE3_OUT_LEN], const uint32_t cv[8])
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+        store32(out + 4 * i, cv[i]);
+}
+
+static void blake3_hash_one(const uint8_t *input, size_t blocks,
+    const uint32_t key[8], uint64_t counter, uint8_t flags,
+    uint8_t flags_start, uint8_t flags_end, uint8_t out[BLAKE3_OUT_LEN])
+{
+    uint32_t cv[8];
+    uint8_t block_flags = flags | flags_start;
+
+    memcpy(cv, key, sizeof(cv));
+    for (; blocks > 0; blocks--, input += BLAKE3_BLOCK_LEN) {
+        if (blocks == 1)
+            block_flags |= flags_end;
+        blake3_compress_in_place(cv, input, BLAKE3_BLOCK_LEN, counter,
+            block_flags);
+        block_flags = flags;
+    }
+    blake3_store_cv(out, cv);
+}
+
+/*
+ * Hash |num_inputs| inputs of the same number of whole blocks.  These are
+ * either whole chunks, with the chunk counter incremented from one input to
+ * the next, or parent nodes made of two chaining values.
+ */
+static void blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
+    size_t blocks, const uint32_t key[8], uint64_t counter,
+    int increment_counter, uint8_t flags, uint8_t flags_start,
+    uint8_t flags_end, uint8_t *out)
+{
+#ifdef BLAKE3_AVX2
+    if (BLAKE3_AVX2_CAPABLE) {
+        while (num_inputs >= BLAKE3_AVX2_DEGREE) {
+            ossl_blake3_hash8_avx2(inputs, blocks, key, counter,
+                increment_counter, flags, flags_start, flags_end, out);
+            if (increment_counter)
+                counter += BLAKE3_AVX2_DEGREE;
+            inputs += BLAKE3_AVX2_DEGREE;
+            num_inputs -= BLAKE3_AVX2_DEGREE;
+            out += BLAKE3_AVX2_DEGREE * BLAKE3_OUT_LEN;
+        }
+    }
+#endif
+    for (; num_inputs > 0; num_inputs--) {
+        blake3_hash_one(*inputs++, blocks, key, counter, flags, flags_start,
+            flags_end, out);
+        if (increment_counter)
+            counter++;
+        out += BLAKE3_OUT_LEN;
+    }
+}
+
+static size_t blake3_simd_degree(void)
+{
+#ifdef BLAKE3_AVX2
+    if (BLAKE3_AVX2_CAPABLE)
+        return BLAKE3_AVX2_DEGREE;
+#endif
+    return 1;
+}
+
+static void chunk_state_init(BLAKE3_CHUNK_STATE *cs, const uint32_t key[8],
+    uint8_t flags)
+{
+    memcpy(cs->cv, key, sizeof(cs->cv));
+    cs->chunk_counter = 0;
+    memset(cs->buf, 0, sizeof(cs->buf));
+    cs->buf_len = 0;
+    cs->blocks_compressed = 0;
+    cs->flags = flags;
+}
+
+static void chunk_state_reset(BLAKE3_CHUNK_STATE *cs, const uint32_t key[8],
+    uint64_t chunk_counter)
+{
+    chunk_state_init(cs, key, cs->flags);
+    cs->chunk_counter = chunk_counter;
+}
+
+static size_t chunk_state_len(const BLAKE3_CHUNK_STATE *cs)
+{
+    return BLAKE3_BLOCK_LEN * (size_t)cs->blocks_compressed + cs->buf_len;
+}
+
+static uint8_t chunk_state_start_flag(const BLAKE3_CHUNK_STATE *cs)
+{
+    return cs->blocks_compressed == 0 ? BLAKE3_CHUNK_START : 0;
+}
+
+static size_t chunk_state_fill_buf(BLAKE3_CHUNK_STATE *cs,
+    const uint8_t *input, size_t input_len)
+{
+    size_t take = BLAKE3_BLOCK_LEN - cs->buf_len;
+
+    if (take > input_len)
+        take = input_len;
+    memcpy(cs->buf + cs->buf_len, input, take);
+    cs->buf_len += (uint8_t)take;
+    return take;
+}
+
+/*
+ * The last block of a chunk is compressed with the CHUNK_END flag, so a full
+ * block is only compressed once more input is known to follow it.
+ */
+static void chunk_state_update(BLAKE3_CHUNK_STATE *cs, const uint8_t *input,
+    size_t input_len)
+{
+    if (cs->buf_len > 0) {
+        size_t take = chunk_state_fill_buf(cs, input, input_len);
+
+        input += take;
+        input_len -= take;
+        if (input_len > 0) {
+            blake3_compress_in_place(cs->cv, cs->buf, BLAKE3_BLOCK_LEN,
+                cs->chunk_counter, cs->flags | chunk_state_start_flag(cs));
+            cs->blocks_compressed++;
+            cs->buf_len = 0;
+            memset(cs->buf, 0, sizeof(cs->buf));
+        }
+    }
+    while (input_len > BLAKE3_BLOCK_LEN) {
+        blake3_compress_in_place(cs->cv, input, BLAKE3_BLOCK_LEN,
+            cs->chunk_counter, cs->flags | chunk_state_start_flag(cs));
+        cs->blocks_compressed++;
+        input += BLAKE3_BLOCK_LEN;
+        input_len -= BLAKE3_BLOCK_LEN;
+    }
+    chunk_state_fill_buf(cs, input, input_len);
+}
+
+static void chunk_state_output(const BLAKE3_CHUNK_STATE *cs,
+    BLAKE3_OUTPUT *out)
+{
+    memcpy(out->input_cv, cs->cv, sizeof(out->input_cv));
+    memcpy(out->block, cs->buf, sizeof(out->block));
+    out->block_len = cs->buf_len;
+    out->counter = cs->chunk_counter;
+    out->flags = cs->flags | chunk_state_start_flag(cs) | BLAKE3_CHUNK_END;
+}
+
+static void parent_output(const uint8_t block[BLAKE3_BLOCK_LEN],
+    const uint32_t key[8], uint8_t flags, BLAKE3_OUTPUT *out)
+{
+    memcpy(out->input_cv, key, sizeof(out->input_cv));
+    memcpy(out->block, block, sizeof(out->block));
+    out->block_len = BLAKE3_BLOCK_LEN;
+    out->counter = 0;
+    out->flags = flags | BLAKE3_PARENT;
+}
+
+static void output_chaining_value(const BLAKE3_OUTPUT *o,
+    uint8_t cv[BLAKE3_OUT_LEN])
+{
+    uint32_t cv_words[8];
+
+    memcpy(cv_words, o->input_cv, sizeof(cv_words));
+    blake3_compress_in_place(cv_words, o->block, o->block_len, o->counter,
+        o->flags);
+    blake3_store_cv(cv, cv_words);
+}
+
+static void output_root_bytes(const BLAKE3_OUTPUT *o, uint64_t seek,
+    uint8_t *out, size_t out_len)
+{
+    uint64_t counter = seek / 64;
+    size_t offset = (size_t)(seek % 64);
+    uint8_t wide[64];
+
+    while (out_len > 0) {
+        size_t n = 64 - offset;
+
+        blake3_compress_xof(o->input_cv, o->block, o->block_len, counter++,
+            o->flags | BLAKE3_ROOT, wide);
+        if (n > out_len)
+            n = out_len;
+        memcpy(out, wide + offset, n);
+        out += n;
+        out_len -= n;
+        offset = 0;
+    }
+    OPENSSL_cleanse(wide, sizeof(wide));
+}
+
+/* The largest power of two that is less than or equal to |x| (>= 1) */
+static uint64_t round_down_to_power_of_2(uint64_t x)
+{
+    uint64_t p = 1;
+
+    while ((x >> 1) >= p)
+        p <<= 1;
+    return p;
+}
+
+static unsigned int popcnt(uint64_t x)
+{
+    unsigned int n = 0;
+
+    for (; x != 0; x &= x - 1)
+        n++;
+    return n;
+}
+
+/*
+ * The length of the left subtree of an input of |content_len| > 1 chunk:
+ * the largest power of two number of whole chunks that leaves at least one
+ * byte for the right subtree.
+ */
+static size_t left_len(size_t content_len)
+{
+    size_t full_chunks = (content_len - 1) / BLAKE3_CHUNK_LEN;
+
+    return (size_t)round_down_to_power_of_2(full_chunks) * BLAKE3_CHUNK_LEN;
+}
+
+/*
+ * Compress all the whole chunks of |input| with blake3_hash_many(), and the
+ * trailing partial chunk, if any, on its own.  Returns the number of chaining
+ * values written to |out|.
+ */
+static size_t compress_chunks_parallel(const uint8_t *input, size_t input_len,
+    const uint32_t key[8], uint64_t chunk_counter, uint8_t flags, uint8_t *out)
+{
+    const uint8_t *chunks[BLAKE3_MAX_SIMD_DEGREE];
+    size_t pos = 0, n = 0;
+
+    while (input_len - pos >= BLAKE3_CHUNK_LEN) {
+        chunks[n++] = input + pos;
+        pos += BLAKE3_CHUNK_LEN;
+    }
+    blake3_hash_many(chunks, n, BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN, key,
+        chunk_counter, 1, flags, BLAKE3_CHUNK_START, BLAKE3_CHUNK_END, out);
+
+    if (input_len > pos) {
+        BLAKE3_CHUNK_STATE cs;
+        BLAKE3_OUTPUT o;
+
+        chunk_state_init(&cs, key, flags);
+        cs.chunk_counter = chunk_counter + n;
+        chunk_state_update(&cs, input + pos, input_len - pos);
+        chunk_state_output(&cs, &o);
+        output_chaining_value(&o, out + n * BLAKE3_OUT_LEN);
+        return n + 1;
+    }
+    return n;
+}
+
+/*
+ * Compress pairs of the |num_cvs| chaining values into parent nodes.  An odd
+ * chaining value at the end is passed through unchanged.
+ */
+static size_t compress_parents_parallel(const uint8_t *cvs, size_t num_cvs,
+    const uint32_t key[8], uint8_t flags, uint8_t *out)
+{
+    const uint8_t *parents[BLAKE3_MAX_SIMD_DEGREE];
+    size_t n = 0;
+
+    while (num_cvs - 2 * n >= 2) {
+        parents[n] = cvs + 2 * n * BLAKE3_OUT_LEN;
+        n++;
+    }
+    blake3_hash_many(parents, n, 1, key, 0, 0, flags | BLAKE3_PARENT, 0, 0,
+        out);
+
+    if (num_cvs > 2 * n) {
+        memcpy(out + n * BLAKE3_OUT_LEN, cvs + 2 * n * BLAKE3_OUT_LEN,
+            BLAKE3_OUT_LEN);
+        return n + 1;
+    }
+    return n;
+}
+
+typedef struct {
+    const uint8_t *input;
+    size_t input_len;
+    const uint32_t *key;
+    uint64_t chunk_counter;
+    uint8_t flags;
+    uint8_t *out;
+    size_t num_cvs;
+    OSSL_LIB_CTX *libctx;
+    uint32_t threads;
+} BLAKE3_SUBTREE;
+
+static size_t compress_subtree_wide(const uint8_t *input, size_t input_len,
+    const uint32_t key[8], uint64_t chunk_counter, uint8_t flags,
+    uint8_t *out, OSSL_LIB_CTX *libctx, uint32_t threads);
+
+#if !defined(BLAKE3_NO_THREADS)
+static uint32_t blake3_subtree_thr(void *data)
+{
+    BLAKE3_SUBTREE *st = data;
+
+    st->num_cvs = compress_subtree_wide(st->input, st->input_len, st->key,
+        st->chunk_counter, st->flags, st->out, st->libctx, st->threads);
+    return 1;
+}
+#endif
+
+/*
+ * Hash the subtree of |input|, which is more than one chunk and, unless it
+ * is at the right edge of the whole tree, a power of two number of chunks.
+ * This stops short of compressing the last level: it writes between two and
+ * BLAKE3_MAX_SIMD_DEGREE chaining values to |out| and returns their number,
+ * or 0 if a thread could not be joined.
+ * The left half is handed to a pool thread when |threads| > 1 and it is big
+ * enough, the two halves then share the remaining threads.
+ */
+static size_t compress_subtree_wide(const uint8_t *input, size_t input_len,
+    const uint32_t key[8], uint64_t chunk_counter, uint8_t flags,
+    uint8_t *out, OSSL_LIB_CTX *libctx, uint32_t threads)
+{
+    uint8_t cv_array[2 * BLAKE3_MAX_SIMD_DEGREE * BLAKE3_OUT_LEN];
+    size_t degree = blake3_simd_degree();
+    size_t left_input_len, left_n, right_n;
+    BLAKE3_SUBTREE left;
+#if !defined(BLAKE3_NO_THREADS)
+    void *t = NULL;
+#endif
+
+    if (input_len <= degree * BLAKE3_CHUNK_LEN)
+        return compress_chunks_parallel(input, input_len, key, chunk_counter,
+            flags, out);
+
+    /*
+     * The left half always yields |degree| chaining values, so the right
+     * half's start right after them.  With a degree of 1 two are needed to
+     * keep at least two outputs, except at the chunk level.
+     */
+    left_input_len = left_len(input_len);
+    if (left_input_len > BLAKE3_CHUNK_LEN && degree == 1)
+        degree = 2;
+
+    left.input = input;
+    left.input_len = left_input_len;
+    left.key = key;
+    left.chunk_counter = chunk_counter;
+    left.flags = flags;
+    left.out = cv_array;
+    left.libctx = libctx;
+    left.threads = threads / 2;
+#if !defined(BLAKE3_NO_THREADS)
+    if (threads > 1 && left_input_len >= BLAKE3_MT_MIN_LEN) {
+        t = ossl_crypto_thread_start(libctx, &blake3_subtree_thr, &left);
+        if (t != NULL)
+            threads -= threads / 2;
+    }
+#endif
+
+    right_n = compress_subtree_wide(input + left_input_len,
+        input_len - left_input_len, key,
+        chunk_counter + left_input_len / BLAKE3_CHUNK_LEN, flags,
+        cv_array + degree * BLAKE3_OUT_LEN, libctx, threads);
+
+#if !defined(BLAKE3_NO_THREADS)
+    if (t != NULL) {
+        left_n = 0;
+        if (ossl_crypto_thread_join(t, NULL))
+            left_n = left.num_cvs;
+        ossl_crypto_thread_clean(t);
+    } else
+#endif
+    {
+        left_n = compress_subtree_wide(input, left_input_len, key,
+            chunk_counter, flags, cv_array, libctx, left.threads);
+    }
+    if (left_n == 0 || right_n == 0)
+        return 0;
+
+    /* With a degree of 1 the two halves are returned as they are */
+    if (left_n == 1) {
+        memcpy(out, cv_array, 2 * BLAKE3_OUT_LEN);
+        return 2;
+    }
+    return compress_parents_parallel(cv_array, left_n + right_n, key, flags,
+        out);
+}
+
+/*
+ * Reduce the subtree of |input| to the two chaining values of its top node,
+ * which is not compressed as it may turn out to be the root.
+ */
+static int compress_subtree_to_parent_node(const uint8_t *input,
+    size_t input_len, const uint32_t key[8], uint64_t chunk_counter,
+    uint8_t flags, uint8_t out[2 * BLAKE3_OUT_LEN], OSSL_LIB_CTX *libctx,
+    uint32_t threads)
+{
+    uint8_t cv_array[BLAKE3_MAX_SIMD_DEGREE * BLAKE3_OUT_LEN];
+    uint8_t out_array[BLAKE3_MAX_SIMD_DEGREE * BLAKE3_OUT_LEN / 2];
+    size_t num_cvs;
+
+    num_cvs = compress_subtree_wide(input, input_len, key, chunk_counter,
+        flags, cv_array, libctx, threads);
+    if (num_cvs == 0)
+        return 0;
+    while (num_cvs > 2) {
+        num_cvs = compress_parents_parallel(cv_array, num_cvs, key, flags,
+            out_array);
+        memcpy(cv_array, out_array, num_cvs * BLAKE3_OUT_LEN);
+    }
+    memcpy(out, cv_array, 2 * BLAKE3_OUT_LEN);
+    return 1;
+}
+
+/*
+ * Merge completed subtrees on the stack: after |total_len| chunks there is
+ * one stack entry per bit set in |total_len|.
+ */
+static void blake3_merge_cv_stack(BLAKE3_CTX *ctx, uint64_t total_len)
+{
+    size_t post_merge_stack_len = popcnt(total_len);
+    BLAKE3_OUTPUT o;
+
+    while (ctx->cv_stack_len > post_merge_stack_len) {
+        uint8_t *parent = ctx->cv_stack
+            + (ctx->cv_stack_len - 2) * BLAKE3_OUT_LEN;
+
+        parent_output(parent, ctx->key, ctx->chunk.flags, &o);
+        output_chaining_value(&o, parent);
+        ctx->cv_stack_len--;
+    }
+}
+
+static void blake3_push_cv(BLAKE3_CTX *ctx, const uint8_t cv[BLAKE3_OUT_LEN],
+    uint64_t chunk_counter)
+{
+    blake3_merge_cv_stack(ctx, chunk_counter);
+    memcpy(ctx->cv_stack + ctx->cv_stack_len * BLAKE3_OUT_LEN, cv,
+        BLAKE3_OUT_LEN);
+    ctx->cv_stack_len++;
+}
+
+static void blake3_init_base(BLAKE3_CTX *ctx, const uint32_t key[8],
+    uint8_t flags)
+{
+    OSSL_LIB_CTX *libctx = ctx->libctx;
+    uint32_t threads = ctx->threads;
+
+    memset(ctx, 0, sizeof(*ctx));
+    memcpy(ctx->key, key, sizeof(ctx->key));
+    chunk_state_init(&ctx->chunk, key, flags);
+    ctx->libctx = libctx;
+    ctx->threads = threads;
+}
+
+void ossl_blake3_init(BLAKE3_CTX *ctx)
+{
+    blake3_init_base(ctx, blake3_IV, 0);
+}
+
+void ossl_blake3_init_keyed(BLAKE3_CTX *ctx, const uint8_t key[BLAKE3_KEY_LEN])
+{
+    uint32_t key_words[8];
+    int i;
+
+    for (i = 0; i < 8; i++)
+        key_words[i] = load32(key + 4 * i);
+    blake3_init_base(ctx, key_words, BLAKE3_KEYED_HASH);
+    OPENSSL_cleanse(key_words, sizeof(key_words));
+}
+
+/*
+ * Allow the subtrees of large updates to be hashed on up to |threads|
+ * threads, including the calling one, from the thread pool of |libctx|.
+ */
+void ossl_blake3_set_threads(BLAKE3_CTX *ctx, OSSL_LIB_CTX *libctx,
+    uint32_t threads)
+{
+    ctx->libctx = libctx;
+    ctx->threads = threads;
+}
+
+/* Absorb the input data.  Fails once the output has been read. */
+int ossl_blake3_update(BLAKE3_CTX *ctx, const void *data, size_t datalen)
+{
+    const uint8_t *in = data;
+
+    if (ctx->squeezing)
+        return 0;
+    if (datalen == 0)
+        return 1;
+
+    /* Finish the chunk in progress first */
+    if (chunk_state_len(&ctx->chunk) > 0) {
+        size_t take = BLAKE3_CHUNK_LEN - chunk_state_len(&ctx->chunk);
+        uint8_t cv[BLAKE3_OUT_LEN];
+        BLAKE3_OUTPUT o;
+
+        if (take > datalen)
+            take = datalen;
+        chunk_state_update(&ctx->chunk, in, take);
+        in += take;
+        datalen -= take;
+        if (datalen == 0)
+            return 1;
+        /* More input follows, so this chunk is not the root */
+        chunk_state_output(&ctx->chunk, &o);
+        output_chaining_value(&o, cv);
+        blake3_push_cv(ctx, cv, ctx->chunk.chunk_counter);
+        chunk_state_reset(&ctx->chunk, ctx->key, ctx->chunk.chunk_counter + 1);
+    }
+
+    /*
+     * Hash the largest whole subtrees the input allows.  A subtree must be a
+     * power of two number of chunks, and must evenly divide the number of
+     * chunks hashed so far.  The last (possibly whole) chunk is kept back as
+     * it may be the root.
+     */
+    while (datalen > BLAKE3_CHUNK_LEN) {
+        uint64_t subtree_len = round_down_to_power_of_2(datalen);
+        uint64_t count_so_far = ctx->chunk.chunk_counter * BLAKE3_CHUNK_LEN;
+        uint64_t subtree_chunks;
+
+        while (((subtree_len - 1) & count_so_far) != 0)
+            subtree_len /= 2;
+        subtree_chunks = subtree_len / BLAKE3_CHUNK_LEN;
+
+        if (subtree_len <= BLAKE3_CHUNK_LEN) {
+            BLAKE3_CHUNK_STATE cs;
+            BLAKE3_OUTPUT o;
+            uint8_t cv[BLAKE3_OUT_LEN];
+
+            chunk_state_init(&cs, ctx->key, ctx->chunk.flags);
+            cs.chunk_counter = ctx->chunk.chunk_counter;
+            chunk_state_update(&cs, in, (size_t)subtree_len);
+            chunk_state_output(&cs, &o);
+            output_chaining_value(&o, cv);
+            blake3_push_cv(ctx, cv, cs.chunk_counter);
+        } else {
+            uint8_t cv_pair[2 * BLAKE3_OUT_LEN];
+
+            if (!compress_subtree_to_parent_node(in, (size_t)subtree_len,
+                    ctx->key, ctx->chunk.chunk_counter, ctx->chunk.flags,
+                    cv_pair, ctx->libctx, ctx->threads))
+                return 0;
+            blake3_push_cv(ctx, cv_pair, ctx->chunk.chunk_counter);
+            blake3_push_cv(ctx, cv_pair + BLAKE3_OUT_LEN,
+                ctx->chunk.chunk_counter + subtree_chunks / 2);
+        }
+        ctx->chunk.chunk_counter += subtree_chunks;
+        in += subtree_len;
+        datalen -= (size_t)subtree_len;
+    }
+
+    /*
+     * Buffer what is left.  More input is now known to follow the subtrees
+     * on the stack, so they can all be merged, which leaves the final step
+     * to merge just the last chunk into them.
+     */
+    if (datalen > 0) {
+        chunk_state_update(&ctx->chunk, in, datalen);
+        blake3_merge_cv_stack(ctx, ctx->chunk.chunk_counter);
+    }
+    return 1;
+}
+
+/* Set up the root node once all the input has been absorbed */
+static void blake3_finalize(BLAKE3_CTX *ctx)
+{
+    size_t cvs_remaining;
+    uint8_t parent_block[BLAKE3_BLOCK_LEN];
+
+    /* With no subtrees on the stack the current chunk is the root */
+    if (ctx->cv_stack_len == 0) {
+        chunk_state_output(&ctx->chunk, &ctx->root);
+        return;
+    }
+
+    /*
+     * Otherwise fold the stack from the right, starting with the current
+     * chunk, or with the last two stack entries if no bytes are pending.
+     */
+    if (chunk_state_len(&ctx->chunk) > 0) {
+        cvs_remaining = ctx->cv_stack_len;
+        chunk_state_output(&ctx->chunk, &ctx->root);
+    } else {
+        cvs_remaining = ctx->cv_stack_len - 2;
+        parent_output(ctx->cv_stack + cvs_remaining * BLAKE3_OUT_LEN,
+            ctx->key, ctx->chunk.flags, &ctx->root);
+    }
+    while (cvs_remaining > 0) {
+        cvs_remaining--;
+        memcpy(parent_block, ctx->cv_stack + cvs_remaining * BLAKE3_OUT_LEN,
+            BLAKE3_OUT_LEN);
+        output_chaining_value(&ctx->root, parent_block + BLAKE3_OUT_LEN);
+        parent_output(parent_block, ctx->key, ctx->chunk.flags, &ctx->root);
+    }
+    OPENSSL_cleanse(parent_block, sizeof(parent_block));
+}
+
+/*
+ * Read the next |outlen| bytes of output.  The first call ends the input,
+ * further calls continue where the previous one stopped.
+ */
+int ossl_blake3_squeeze(BLAKE3_CTX *ctx, uint8_t *out, size_t outlen)
+{
+    if (!ctx->squeezing) {
+        blake3_finalize(ctx);
+        ctx->squeezing = 1;
+        ctx->out_pos = 0;
+    }
+    output_root_bytes(&ctx->root, ctx->out_pos, out, outlen);
+    ctx->out_pos += outlen;
+    return 1;
+}
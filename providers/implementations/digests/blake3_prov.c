@@ -0,0 +1,234 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/core_names.h>
+#include <openssl/proverr.h>
+#include <openssl/err.h>
+#include "internal/common.h"
+#include "internal/thread.h"
+#include "prov/blake3.h"
+#include "prov/digestcommon.h"
+#include "prov/implementations.h"
+#include "prov/provider_ctx.h"
+#include "providers/implementations/digests/blake3_prov.inc"
+
+#if defined(OPENSSL_NO_DEFAULT_THREAD_POOL) && defined(OPENSSL_NO_THREAD_POOL)
+#define BLAKE3_NO_THREADS
+#endif
+
+#if !defined(OPENSSL_THREADS)
+#define BLAKE3_NO_THREADS
+#endif
+
+/*
+ * BLAKE3 is an XOF, by default EVP_DigestFinal_ex() produces the 256 bit
+ * output that the specification recommends.
+ */
+#define BLAKE3_FLAGS (PROV_DIGEST_FLAG_XOF | PROV_DIGEST_FLAG_ALGID_ABSENT)
+
+typedef struct {
+    BLAKE3_CTX ctx;
+    OSSL_LIB_CTX *libctx;
+    size_t xoflen;
+    /* Set by final, after which no more output can be squeezed */
+    int finalised;
+} BLAKE3_MD_CTX;
+
+static OSSL_FUNC_digest_newctx_fn blake3_newctx;
+static OSSL_FUNC_digest_freectx_fn blake3_freectx;
+static OSSL_FUNC_digest_dupctx_fn blake3_dupctx;
+static OSSL_FUNC_digest_copyctx_fn blake3_copyctx;
+static OSSL_FUNC_digest_init_fn blake3_init;
+static OSSL_FUNC_digest_update_fn blake3_update;
+static OSSL_FUNC_digest_final_fn blake3_final;
+static OSSL_FUNC_digest_squeeze_fn blake3_squeeze;
+static OSSL_FUNC_digest_set_ctx_params_fn blake3_set_ctx_params;
+static OSSL_FUNC_digest_settable_ctx_params_fn blake3_settable_ctx_params;
+static OSSL_FUNC_digest_get_ctx_params_fn blake3_get_ctx_params;
+static OSSL_FUNC_digest_gettable_ctx_params_fn blake3_gettable_ctx_params;
+
+static void *blake3_newctx(void *provctx)
+{
+    BLAKE3_MD_CTX *ctx;
+
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return NULL;
+    ctx = OPENSSL_zalloc(sizeof(*ctx));
+    if (ctx != NULL)
+        ctx->libctx = PROV_LIBCTX_OF(provctx);
+    return ctx;
+}
+
+static void blake3_freectx(void *vctx)
+{
+    OPENSSL_clear_free(vctx, sizeof(BLAKE3_MD_CTX));
+}
+
+static void *blake3_dupctx(void *vctx)
+{
+    BLAKE3_MD_CTX *src = vctx;
+    BLAKE3_MD_CTX *ret = ossl_prov_is_running() ? OPENSSL_malloc(sizeof(*ret))
+                                                : NULL;
+
+    if (ret != NULL)
+        *ret = *src;
+    return ret;
+}
+
+static void blake3_copyctx(void *voutctx, void *vinctx)
+{
+    BLAKE3_MD_CTX *outctx = voutctx;
+    BLAKE3_MD_CTX *inctx = vinctx;
+
+    *outctx = *inctx;
+}
+
+static int blake3_init(void *vctx, const OSSL_PARAM params[])
+{
+    BLAKE3_MD_CTX *ctx = vctx;
+
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    ossl_blake3_set_threads(&ctx->ctx, ctx->libctx, 1);
+    ossl_blake3_init(&ctx->ctx);
+    ctx->xoflen = BLAKE3_OUT_LEN;
+    ctx->finalised = 0;
+    return blake3_set_ctx_params(vctx, params);
+}
+
+static int blake3_update(void *vctx, const unsigned char *in, size_t inlen)
+{
+    BLAKE3_MD_CTX *ctx = vctx;
+
+    return ossl_blake3_update(&ctx->ctx, in, inlen);
+}
+
+static int blake3_final(void *vctx, unsigned char *out, size_t *outl,
+    size_t outsz)
+{
+    BLAKE3_MD_CTX *ctx = vctx;
+
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    if (ctx->finalised || outsz < ctx->xoflen)
+        return 0;
+    ctx->finalised = 1;
+    *outl = ctx->xoflen;
+    return ossl_blake3_squeeze(&ctx->ctx, out, ctx->xoflen);
+}
+
+static int blake3_squeeze(void *vctx, unsigned char *out, size_t *outl,
+    size_t outsz)
+{
+    BLAKE3_MD_CTX *ctx = vctx;
+
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    if (ctx->finalised || !ossl_blake3_squeeze(&ctx->ctx, out, outsz))
+        return 0;
+    *outl = outsz;
+    return 1;
+}
+
+static const OSSL_PARAM *blake3_settable_ctx_params(ossl_unused void *ctx,
+    ossl_unused void *provctx)
+{
+    return blake3_set_ctx_params_list;
+}
+
+static int blake3_set_ctx_params(void *vctx, const OSSL_PARAM params[])
+{
+    BLAKE3_MD_CTX *ctx = vctx;
+    struct blake3_set_ctx_params_st p;
+
+    if (ctx == NULL || !blake3_set_ctx_params_decoder(params, &p))
+        return 0;
+
+    if (p.xoflen != NULL
+        && !OSSL_PARAM_get_size_t(p.xoflen, &ctx->xoflen)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+        return 0;
+    }
+    if (p.threads != NULL) {
+        uint32_t threads;
+
+        if (!OSSL_PARAM_get_uint32(p.threads, &threads)) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+            return 0;
+        }
+        if (threads == 0)
+            threads = 1;
+        if (threads > 1) {
+#ifdef BLAKE3_NO_THREADS
+            ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_THREAD_POOL_SIZE,
+                "requested %u threads, single-threaded mode supported only",
+                threads);
+            return 0;
+#else
+            if (threads > ossl_get_avail_threads(ctx->libctx)) {
+                ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_THREAD_POOL_SIZE,
+                    "requested %u threads, available: %u",
+                    threads, ossl_get_avail_threads(ctx->libctx));
+                return 0;
+            }
+#endif
+        }
+        ossl_blake3_set_threads(&ctx->ctx, ctx->libctx, threads);
+    }
+    return 1;
+}
+
+static const OSSL_PARAM *blake3_gettable_ctx_params(ossl_unused void *ctx,
+    ossl_unused void *provctx)
+{
+    return blake3_get_ctx_params_list;
+}
+
+static int blake3_get_ctx_params(void *vctx, OSSL_PARAM params[])
+{
+    BLAKE3_MD_CTX *ctx = vctx;
+    struct blake3_get_ctx_params_st p;
+
+    if (ctx == NULL || !blake3_get_ctx_params_decoder(params, &p))
+        return 0;
+
+    /* Size is an alias of xoflen */
+    if (p.size != NULL && !OSSL_PARAM_set_size_t(p.size, ctx->xoflen)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+        return 0;
+    }
+    if (p.xoflen != NULL && !OSSL_PARAM_set_size_t(p.xoflen, ctx->xoflen)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+        return 0;
+    }
+    return 1;
+}
+
+PROV_FUNC_DIGEST_GET_PARAM(blake3, BLAKE3_BLOCK_LEN, BLAKE3_OUT_LEN,
+    BLAKE3_FLAGS)
+
+const OSSL_DISPATCH ossl_blake3_functions[] = {
+    { OSSL_FUNC_DIGEST_NEWCTX, (void (*)(void))blake3_newctx },
+    { OSSL_FUNC_DIGEST_INIT, (void (*)(void))blake3_init },
+    { OSSL_FUNC_DIGEST_UPDATE, (void (*)(void))blake3_update },
+    { OSSL_FUNC_DIGEST_FINAL, (void (*)(void))blake3_final },
+    { OSSL_FUNC_DIGEST_SQUEEZE, (void (*)(void))blake3_squeeze },
+    { OSSL_FUNC_DIGEST_FREECTX, (void (*)(void))blake3_freectx },
+    { OSSL_FUNC_DIGEST_DUPCTX, (void (*)(void))blake3_dupctx },
+    { OSSL_FUNC_DIGEST_COPYCTX, (void (*)(void))blake3_copyctx },
+    { OSSL_FUNC_DIGEST_SET_CTX_PARAMS, (void (*)(void))blake3_set_ctx_params },
+    { OSSL_FUNC_DIGEST_SETTABLE_CTX_PARAMS,
+        (void (*)(void))blake3_settable_ctx_params },
+    { OSSL_FUNC_DIGEST_GET_CTX_PARAMS, (void (*)(void))blake3_get_ctx_params },
+    { OSSL_FUNC_DIGEST_GETTABLE_CTX_PARAMS,
+        (void (*)(void))blake3_gettable_ctx_params },
+    PROV_DISPATCH_FUNC_DIGEST_GET_PARAMS(blake3),
+    PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
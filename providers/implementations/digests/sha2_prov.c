@@ -280,55 +280,103 @@ static int SHA512_Deserialize(SHA512_CTX *c, const unsigned char *in,
     return 1;
 }
 
+/*
+ * Batches finish every message on top of the state of the context, which
+ * only needs to hold the common prefix, if any.
+ */
+static OSSL_FUNC_digest_batch_fn sha1_batch;
+static OSSL_FUNC_digest_batch_fn sha256_batch;
+static OSSL_FUNC_digest_batch_fn sha512_batch;
+
+static int sha1_batch(void *vctx, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t outsz, size_t n)
+{
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    if (outsz < SHA_DIGEST_LENGTH) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    return ossl_sha1_batch(vctx, in, inl, out, n);
+}
+
+static int sha256_batch(void *vctx, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t outsz, size_t n)
+{
+    SHA256_CTX *ctx = (SHA256_CTX *)vctx;
+
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    if (outsz < ctx->md_len) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    return ossl_sha256_batch(ctx, in, inl, out, n);
+}
+
+static int sha512_batch(void *vctx, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t outsz, size_t n)
+{
+    SHA512_CTX *ctx = (SHA512_CTX *)vctx;
+
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    if (outsz < ctx->md_len) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    return ossl_sha512_batch(ctx, in, inl, out, n);
+}
+
 /* ossl_sha1_functions */
-IMPLEMENT_digest_functions_with_settable_ctx(
+IMPLEMENT_digest_functions_with_settable_ctx_and_batch(
     sha1, SHA_CTX, SHA_CBLOCK, SHA_DIGEST_LENGTH, SHA2_FLAGS,
     SHA1_Init, SHA1_Update_thunk, SHA1_Final,
-    sha1_settable_ctx_params, sha1_set_ctx_params)
+    sha1_settable_ctx_params, sha1_set_ctx_params, sha1_batch)
 
 /* ossl_sha224_functions */
 IMPLEMENT_digest_functions_with_serialize(sha224, SHA256_CTX,
     SHA256_CBLOCK, SHA224_DIGEST_LENGTH,
     SHA2_FLAGS, SHA224_Init,
     SHA256_Update_thunk, SHA224_Final,
-    SHA256_Serialize, SHA256_Deserialize)
+    SHA256_Serialize, SHA256_Deserialize, sha256_batch)
 
 /* ossl_sha256_functions */
 IMPLEMENT_digest_functions_with_serialize(sha256, SHA256_CTX,
     SHA256_CBLOCK, SHA256_DIGEST_LENGTH,
     SHA2_FLAGS, SHA256_Init,
     SHA256_Update_thunk, SHA256_Final,
-    SHA256_Serialize, SHA256_Deserialize)
+    SHA256_Serialize, SHA256_Deserialize, sha256_batch)
 /* ossl_sha256_192_internal_functions */
 IMPLEMENT_digest_functions_with_serialize(sha256_192_internal, SHA256_CTX,
     SHA256_CBLOCK, SHA256_192_DIGEST_LENGTH,
     SHA2_FLAGS, ossl_sha256_192_init,
     SHA256_Update_thunk, SHA256_Final,
-    SHA256_Serialize, SHA256_Deserialize)
+    SHA256_Serialize, SHA256_Deserialize, sha256_batch)
 /* ossl_sha384_functions */
 IMPLEMENT_digest_functions_with_serialize(sha384, SHA512_CTX,
     SHA512_CBLOCK, SHA384_DIGEST_LENGTH,
     SHA2_FLAGS, SHA384_Init,
     SHA512_Update_thunk, SHA384_Final,
-    SHA512_Serialize, SHA512_Deserialize)
+    SHA512_Serialize, SHA512_Deserialize, sha512_batch)
 
 /* ossl_sha512_functions */
 IMPLEMENT_digest_functions_with_serialize(sha512, SHA512_CTX,
     SHA512_CBLOCK, SHA512_DIGEST_LENGTH,
     SHA2_FLAGS, SHA512_Init,
     SHA512_Update_thunk, SHA512_Final,
-    SHA512_Serialize, SHA512_Deserialize)
+    SHA512_Serialize, SHA512_Deserialize, sha512_batch)
 
 /* ossl_sha512_224_functions */
 IMPLEMENT_digest_functions_with_serialize(sha512_224, SHA512_CTX,
     SHA512_CBLOCK, SHA224_DIGEST_LENGTH,
     SHA2_FLAGS, sha512_224_init,
     SHA512_Update_thunk, SHA512_Final,
-    SHA512_Serialize, SHA512_Deserialize)
+    SHA512_Serialize, SHA512_Deserialize, sha512_batch)
 
 /* ossl_sha512_256_functions */
 IMPLEMENT_digest_functions_with_serialize(sha512_256, SHA512_CTX,
     SHA512_CBLOCK, SHA256_DIGEST_LENGTH,
     SHA2_FLAGS, sha512_256_init,
     SHA512_Update_thunk, SHA512_Final,
-    SHA512_Serialize, SHA512_Deserialize)
+    SHA512_Serialize, SHA512_Deserialize, sha512_batch)
@@ -78,6 +78,7 @@ static OSSL_FUNC_digest_freectx_fn keccak_freectx;
 static OSSL_FUNC_digest_copyctx_fn keccak_copyctx;
 static OSSL_FUNC_digest_dupctx_fn keccak_dupctx;
 static OSSL_FUNC_digest_squeeze_fn shake_squeeze;
+static OSSL_FUNC_digest_batch_fn keccak_batch;
 
 static OSSL_FUNC_digest_get_ctx_params_fn shake_get_ctx_params;
 static OSSL_FUNC_digest_gettable_ctx_params_fn shake_gettable_ctx_params;
@@ -150,6 +151,112 @@ static int shake_squeeze(void *vctx, unsigned char *out, size_t *outl,
     return ret;
 }
 
+/* Finish one message on a copy of |ctx| */
+static int keccak_batch_one(const KECCAK1600_CTX *ctx, const unsigned char *in,
+    size_t inl, unsigned char *out, size_t outlen)
+{
+    KECCAK1600_CTX t = *ctx;
+    int ret;
+
+    t.md_size = outlen;
+    ret = ossl_sha3_absorb(&t, in, inl) && ossl_sha3_final(&t, out, outlen);
+    OPENSSL_cleanse(&t, sizeof(t));
+    return ret;
+}
+
+#if defined(KECCAK1600_ASM)                                                               \
+    && (defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)) \
+    && !defined(OPENSSL_NO_ASM)
+/*
+ * Four messages at a time through the AVX-512VL Keccak, which only knows the
+ * SHAKE128 and SHAKE256 rates.  Messages of different lengths share the
+ * whole blocks of their common length and the first |m| are then finished
+ * one by one.
+ */
+static int keccak_batch_x4(const KECCAK1600_CTX *ctx,
+    const unsigned char *const in[4], const size_t inl[4],
+    unsigned char *const out[4], size_t outlen, size_t m)
+{
+    KECCAK1600_CTX lane[4], *lanes[4];
+    size_t k, len = inl[0];
+    int ret = 1;
+
+    for (k = 1; k < 4; k++)
+        if (inl[k] < len)
+            len = inl[k];
+    if (inl[1] == len && inl[2] == len && inl[3] == len) {
+        ossl_sha3_x4_hash_avx512vl(ctx, in, len, out, outlen);
+        return 1;
+    }
+
+    len -= len % ctx->block_size;
+    for (k = 0; k < 4; k++)
+        lanes[k] = &lane[k];
+    ossl_sha3_x4_absorb_avx512vl(ctx, in, len, lanes);
+    for (k = 0; k < m && ret; k++)
+        ret = keccak_batch_one(lanes[k], in[k] + len, inl[k] - len, out[k],
+            outlen);
+    OPENSSL_cleanse(lane, sizeof(lane));
+    return ret;
+}
+#define KECCAK_BATCH_X4_CAPABLE(ctx) \
+    ((ctx)->bufsz == 0 && SHA3_avx512vl_capable() \
+        && ((ctx)->block_size == SHA3_BLOCKSIZE(128) \
+            || (ctx)->block_size == SHA3_BLOCKSIZE(256)))
+#endif
+
+static int keccak_batch(void *vctx, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t outsz, size_t n)
+{
+    KECCAK1600_CTX *ctx = vctx;
+    size_t i = 0, outlen;
+
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    if (ctx->xof_state == XOF_STATE_FINAL
+        || ctx->xof_state == XOF_STATE_SQUEEZE)
+        return 0;
+    if (ctx->meth.squeeze != NULL) {
+        outlen = outsz;
+    } else {
+        if (ossl_unlikely(ctx->md_size == SIZE_MAX)) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_DIGEST_LENGTH);
+            return 0;
+        }
+        if (outsz < ctx->md_size) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+            return 0;
+        }
+        outlen = ctx->md_size;
+    }
+    if (outlen == 0)
+        return 1;
+
+#ifdef KECCAK_BATCH_X4_CAPABLE
+    if (KECCAK_BATCH_X4_CAPABLE(ctx)) {
+        const unsigned char *gin[4];
+        unsigned char *gout[4];
+        size_t ginl[4], k, m;
+
+        /* Two or three messages leave the spare lanes on repeats of the first */
+        for (; n - i >= 2; i += m) {
+            m = n - i < 4 ? n - i : 4;
+            for (k = 0; k < 4; k++) {
+                gin[k] = in[i + (k < m ? k : 0)];
+                ginl[k] = inl[i + (k < m ? k : 0)];
+                gout[k] = out[i + (k < m ? k : 0)];
+            }
+            if (!keccak_batch_x4(ctx, gin, ginl, gout, outlen, m))
+                return 0;
+        }
+    }
+#endif
+    for (; i < n; i++)
+        if (!keccak_batch_one(ctx, in[i], inl[i], out[i], outlen))
+            return 0;
+    return 1;
+}
+
 #if defined(S390_SHA3)
 
 static sha3_absorb_fn s390x_sha3_absorb;
@@ -405,6 +512,36 @@ static PROV_SHA3_METHOD shake_ARMSHA3_md = {
     } else {                                                  \
         ctx->meth = shake_generic_md;                         \
     }
+#elif defined(KECCAK1600_AVX512)
+static PROV_SHA3_METHOD sha3_avx512_md = {
+    ossl_sha3_absorb_avx512,
+    ossl_sha3_final_avx512,
+    NULL
+};
+static PROV_SHA3_METHOD shake_avx512_md = {
+    ossl_sha3_absorb_avx512,
+    ossl_sha3_final_avx512,
+    ossl_shake_squeeze_avx512
+};
+#define SHAKE_SET_MD(uname, typ)      \
+    if (SHA3_avx512_capable()) {      \
+        ctx->meth = shake_avx512_md;  \
+    } else {                          \
+        ctx->meth = shake_generic_md; \
+    }
+
+#define SHA3_SET_MD(uname, typ)      \
+    if (SHA3_avx512_capable()) {     \
+        ctx->meth = sha3_avx512_md;  \
+    } else {                         \
+        ctx->meth = sha3_generic_md; \
+    }
+#define CSHAKE_KECCAK_SET_MD(bitlen)  \
+    if (SHA3_avx512_capable()) {      \
+        ctx->meth = shake_avx512_md;  \
+    } else {                          \
+        ctx->meth = shake_generic_md; \
+    }
 #else
 #define SHA3_SET_MD(uname, typ) ctx->meth = sha3_generic_md;
 #define CSHAKE_KECCAK_SET_MD(bitlen) ctx->meth = shake_generic_md;
@@ -480,6 +617,7 @@ static PROV_SHA3_METHOD shake_ARMSHA3_md = {
         { OSSL_FUNC_DIGEST_COPYCTX, (void (*)(void))keccak_copyctx },         \
         { OSSL_FUNC_DIGEST_SERIALIZE, (void (*)(void))name##_serialize },     \
         { OSSL_FUNC_DIGEST_DESERIALIZE, (void (*)(void))name##_deserialize }, \
+        { OSSL_FUNC_DIGEST_BATCH, (void (*)(void))keccak_batch },             \
         PROV_DISPATCH_FUNC_DIGEST_GET_PARAMS(name)
 
 #define PROV_FUNC_SHA3_DIGEST(name, bitlen, blksize, dgstsize, flags)     \
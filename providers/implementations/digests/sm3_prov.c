@@ -8,11 +8,28 @@
  */
 
 #include <openssl/crypto.h>
+#include <openssl/err.h>
+#include <openssl/proverr.h>
+#include "internal/common.h"
 #include "internal/sm3.h"
 #include "prov/digestcommon.h"
 #include "prov/implementations.h"
 
+static OSSL_FUNC_digest_batch_fn sm3_batch;
+
+static int sm3_batch(void *vctx, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t outsz, size_t n)
+{
+    if (ossl_unlikely(!ossl_prov_is_running()))
+        return 0;
+    if (outsz < SM3_DIGEST_LENGTH) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    return ossl_sm3_batch(vctx, in, inl, out, n);
+}
+
 /* ossl_sm3_functions */
-IMPLEMENT_digest_functions(sm3, SM3_CTX,
+IMPLEMENT_digest_functions_with_batch(sm3, SM3_CTX,
     SM3_CBLOCK, SM3_DIGEST_LENGTH, 0,
-    ossl_sm3_init, ossl_sm3_update, ossl_sm3_final)
+    ossl_sm3_init, ossl_sm3_update, ossl_sm3_final, sm3_batch)
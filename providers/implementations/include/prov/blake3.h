@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_PROV_BLAKE3_H
+#define OSSL_PROV_BLAKE3_H
+
+#include <openssl/e_os2.h>
+#include <openssl/types.h>
+#include <stddef.h>
+
+#define BLAKE3_KEY_LEN 32
+#define BLAKE3_OUT_LEN 32
+#define BLAKE3_BLOCK_LEN 64
+#define BLAKE3_CHUNK_LEN 1024
+/* 2^54 chunks of 1 KiB cover the whole 2^64 byte input space */
+#define BLAKE3_MAX_DEPTH 54
+
+/* The flags of the compression function */
+#define BLAKE3_CHUNK_START (1 << 0)
+#define BLAKE3_CHUNK_END (1 << 1)
+#define BLAKE3_PARENT (1 << 2)
+#define BLAKE3_ROOT (1 << 3)
+#define BLAKE3_KEYED_HASH (1 << 4)
+
+typedef struct blake3_chunk_state_st {
+    uint32_t cv[8];
+    uint64_t chunk_counter;
+    uint8_t buf[BLAKE3_BLOCK_LEN];
+    uint8_t buf_len;
+    uint8_t blocks_compressed;
+    uint8_t flags;
+} BLAKE3_CHUNK_STATE;
+
+/* Everything needed to produce the root output, and to extend it */
+typedef struct blake3_output_st {
+    uint32_t input_cv[8];
+    uint64_t counter;
+    uint8_t block[BLAKE3_BLOCK_LEN];
+    uint8_t block_len;
+    uint8_t flags;
+} BLAKE3_OUTPUT;
+
+typedef struct blake3_ctx_st {
+    uint32_t key[8];
+    BLAKE3_CHUNK_STATE chunk;
+    uint8_t cv_stack_len;
+    uint8_t cv_stack[(BLAKE3_MAX_DEPTH + 1) * BLAKE3_OUT_LEN];
+    /* Set by the first squeeze, the output is then read from |root| */
+    int squeezing;
+    BLAKE3_OUTPUT root;
+    uint64_t out_pos;
+    /* Subtrees of large updates are spread over this many threads */
+    OSSL_LIB_CTX *libctx;
+    uint32_t threads;
+} BLAKE3_CTX;
+
+void ossl_blake3_init(BLAKE3_CTX *ctx);
+void ossl_blake3_init_keyed(BLAKE3_CTX *ctx,
+    const uint8_t key[BLAKE3_KEY_LEN]);
+void ossl_blake3_set_threads(BLAKE3_CTX *ctx, OSSL_LIB_CTX *libctx,
+    uint32_t threads);
+int ossl_blake3_update(BLAKE3_CTX *ctx, const void *data, size_t datalen);
+int ossl_blake3_squeeze(BLAKE3_CTX *ctx, uint8_t *out, size_t outlen);
+
+#endif /* OSSL_PROV_BLAKE3_H */
@@ -133,6 +133,19 @@ void ossl_cipher_generic_initkey(void *vctx, size_t kbits, size_t blkbits,
     uint64_t flags,
     const PROV_CIPHER_HW *hw, void *provctx);
 
+/*-
+ * AEAD ciphers whose pipelined interface processes one whole message per
+ * pipe read and set the tags of all the messages through the "pipeline-tag"
+ * parameter, which points to one buffer per pipe.  The tags of the
+ * |numpipes| messages are kept |stride| bytes apart in |tags|.  The pipelined
+ * state belongs to a single operation, so it is not duplicated along with
+ * the context.
+ */
+int ossl_cipher_pipeline_get_tags(const OSSL_PARAM *p,
+    const unsigned char *tags, size_t stride, size_t numpipes, size_t taglen);
+int ossl_cipher_pipeline_set_tags(const OSSL_PARAM *p, unsigned char *tags,
+    size_t stride, size_t numpipes, size_t *taglen);
+
 #define IMPLEMENT_generic_cipher_func(alg, UCALG, lcmode, UCMODE, flags, kbits,                 \
     blkbits, ivbits, typ)                                                                       \
     const OSSL_DISPATCH ossl_##alg##kbits##lcmode##_functions[] = {                             \
@@ -124,6 +124,20 @@ extern "C" {
         { OSSL_FUNC_DIGEST_INIT, (void (*)(void))name##_internal_init },           \
         PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
 
+#define IMPLEMENT_digest_functions_with_batch(                                     \
+    name, CTX, blksize, dgstsize, flags, init, upd, fin, batch)                    \
+    static OSSL_FUNC_digest_init_fn name##_internal_init;                          \
+    static int name##_internal_init(void *ctx,                                     \
+        ossl_unused const OSSL_PARAM params[])                                     \
+    {                                                                              \
+        return ossl_prov_is_running() && init(ctx);                                \
+    }                                                                              \
+    PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_START(name, CTX, blksize, dgstsize, flags, \
+        upd, fin),                                                                 \
+        { OSSL_FUNC_DIGEST_INIT, (void (*)(void))name##_internal_init },           \
+        { OSSL_FUNC_DIGEST_BATCH, (void (*)(void))batch },                         \
+        PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
+
 #define IMPLEMENT_digest_functions_with_settable_ctx(                                  \
     name, CTX, blksize, dgstsize, flags, init, upd, fin,                               \
     settable_ctx_params, set_ctx_params)                                               \
@@ -141,9 +155,27 @@ extern "C" {
         { OSSL_FUNC_DIGEST_SET_CTX_PARAMS, (void (*)(void))set_ctx_params },           \
         PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
 
+#define IMPLEMENT_digest_functions_with_settable_ctx_and_batch(                        \
+    name, CTX, blksize, dgstsize, flags, init, upd, fin,                               \
+    settable_ctx_params, set_ctx_params, batch)                                        \
+    static OSSL_FUNC_digest_init_fn name##_internal_init;                              \
+    static int name##_internal_init(void *ctx, const OSSL_PARAM params[])              \
+    {                                                                                  \
+        return ossl_prov_is_running()                                                  \
+            && init(ctx)                                                               \
+            && set_ctx_params(ctx, params);                                            \
+    }                                                                                  \
+    PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_START(name, CTX, blksize, dgstsize, flags,     \
+        upd, fin),                                                                     \
+        { OSSL_FUNC_DIGEST_INIT, (void (*)(void))name##_internal_init },               \
+        { OSSL_FUNC_DIGEST_SETTABLE_CTX_PARAMS, (void (*)(void))settable_ctx_params }, \
+        { OSSL_FUNC_DIGEST_SET_CTX_PARAMS, (void (*)(void))set_ctx_params },           \
+        { OSSL_FUNC_DIGEST_BATCH, (void (*)(void))batch },                             \
+        PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
+
 #define IMPLEMENT_digest_functions_with_serialize(                                 \
     name, CTX, blksize, dgstsize, flags, init, upd, fin,                           \
-    serialize, deserialize)                                                        \
+    serialize, deserialize, batch)                                                 \
     static OSSL_FUNC_digest_init_fn name##_internal_init;                          \
     static int name##_internal_init(void *ctx, const OSSL_PARAM params[])          \
     {                                                                              \
@@ -154,6 +186,7 @@ extern "C" {
         { OSSL_FUNC_DIGEST_INIT, (void (*)(void))name##_internal_init },           \
         { OSSL_FUNC_DIGEST_SERIALIZE, (void (*)(void))serialize },                 \
         { OSSL_FUNC_DIGEST_DESERIALIZE, (void (*)(void))deserialize },             \
+        { OSSL_FUNC_DIGEST_BATCH, (void (*)(void))batch },                         \
         PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
 
 const OSSL_PARAM *ossl_digest_default_gettable_params(void *provctx);
@@ -38,6 +38,7 @@ extern const OSSL_DISPATCH ossl_cshake_128_functions[];
 extern const OSSL_DISPATCH ossl_cshake_256_functions[];
 extern const OSSL_DISPATCH ossl_blake2s256_functions[];
 extern const OSSL_DISPATCH ossl_blake2b512_functions[];
+extern const OSSL_DISPATCH ossl_blake3_functions[];
 extern const OSSL_DISPATCH ossl_md5_functions[];
 extern const OSSL_DISPATCH ossl_md5_sha1_functions[];
 extern const OSSL_DISPATCH ossl_sm3_functions[];
@@ -269,6 +270,7 @@ extern const OSSL_DISPATCH ossl_aes256gcm_siv_functions[];
 /* MACs */
 extern const OSSL_DISPATCH ossl_blake2bmac_functions[];
 extern const OSSL_DISPATCH ossl_blake2smac_functions[];
+extern const OSSL_DISPATCH ossl_blake3mac_functions[];
 extern const OSSL_DISPATCH ossl_cmac_functions[];
 extern const OSSL_DISPATCH ossl_gmac_functions[];
 extern const OSSL_DISPATCH ossl_hmac_functions[];
@@ -268,6 +268,7 @@
  */
 #define PROV_NAMES_BLAKE2S_256 "BLAKE2S-256:BLAKE2s256:1.3.6.1.4.1.1722.12.2.2.8"
 #define PROV_NAMES_BLAKE2B_512 "BLAKE2B-512:BLAKE2b512:1.3.6.1.4.1.1722.12.2.1.16"
+#define PROV_NAMES_BLAKE3 "BLAKE3:BLAKE3-256"
 #define PROV_NAMES_SM3 "SM3:1.2.156.10197.1.401"
 #define PROV_NAMES_MD5 "MD5:SSL3-MD5:1.2.840.113549.2.5"
 #define PROV_NAMES_MD5_SHA1 "MD5-SHA1"
@@ -335,6 +336,7 @@
 #define PROV_NAMES_KMAC_256 "KMAC-256:KMAC256:2.16.840.1.101.3.4.2.20"
 #define PROV_NAMES_BLAKE2BMAC "BLAKE2BMAC:1.3.6.1.4.1.1722.12.2.1"
 #define PROV_NAMES_BLAKE2SMAC "BLAKE2SMAC:1.3.6.1.4.1.1722.12.2.2"
+#define PROV_NAMES_BLAKE3MAC "BLAKE3MAC"
 
 /*-
  * RANDs
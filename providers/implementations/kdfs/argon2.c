@@ -1,5 +1,5 @@
 /*
- * Copyright 2022-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2022-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -32,6 +32,7 @@
 #include "prov/provider_ctx.h"
 #include "prov/providercommon.h"
 #include "prov/blake2.h"
+#include "argon2_avx2.h"
 
 #if defined(OPENSSL_NO_DEFAULT_THREAD_POOL) && defined(OPENSSL_NO_THREAD_POOL)
 #define ARGON2_NO_THREADS
@@ -147,13 +148,6 @@ typedef enum {
     ARGON2_ID = 2
 } ARGON2_TYPE;
 
-typedef struct {
-    uint32_t pass;
-    uint32_t lane;
-    uint8_t slice;
-    uint32_t index;
-} ARGON2_POS;
-
 typedef struct {
     void *provctx;
     uint32_t outlen;
@@ -183,9 +177,23 @@ typedef struct {
     char *propq;
 } KDF_ARGON2;
 
+/*
+ * The lanes of a slice are shared out between a fixed set of workers which
+ * meet at a barrier between slices.
+ */
 typedef struct {
-    ARGON2_POS pos;
     KDF_ARGON2 *ctx;
+    CRYPTO_MUTEX *lock;
+    CRYPTO_CONDVAR *cond;
+    uint32_t nworkers;
+    uint32_t waiting;
+    uint32_t generation;
+    int started;
+} ARGON2_SYNC;
+
+typedef struct {
+    ARGON2_SYNC *sync;
+    uint32_t id;
 } ARGON2_THREAD_DATA;
 
 static OSSL_FUNC_kdf_newctx_fn kdf_argon2i_new;
@@ -376,6 +384,13 @@ static void fill_block(const BLOCK *prev, const BLOCK *ref,
     BLOCK blockR, tmp;
     unsigned i;
 
+#ifdef ARGON2_AVX2
+    if (ARGON2_AVX2_CAPABLE) {
+        ossl_argon2_fill_block_avx2(prev->v, ref->v, next->v, with_xor);
+        return;
+    }
+#endif
+
     copy_block(&blockR, ref);
     xor_block(&blockR, prev);
     copy_block(&tmp, &blockR);
@@ -546,82 +561,111 @@ static void fill_segment(const KDF_ARGON2 *ctx, uint32_t pass, uint32_t lane,
 
 #if !defined(ARGON2_NO_THREADS)
 
+static void argon2_barrier_wait(ARGON2_SYNC *sync)
+{
+    uint32_t generation;
+
+    ossl_crypto_mutex_lock(sync->lock);
+    generation = sync->generation;
+    if (++sync->waiting == sync->nworkers) {
+        sync->waiting = 0;
+        sync->generation++;
+        ossl_crypto_condvar_broadcast(sync->cond);
+    } else {
+        while (generation == sync->generation)
+            ossl_crypto_condvar_wait(sync->cond, sync->lock);
+    }
+    ossl_crypto_mutex_unlock(sync->lock);
+}
+
+/*
+ * Worker |id| fills the segments of lanes id, id + nworkers, ... of every
+ * slice, waiting for the other workers before moving on to the next slice.
+ */
+static void fill_mem_blocks_worker(ARGON2_SYNC *sync, uint32_t id)
+{
+    const KDF_ARGON2 *ctx = sync->ctx;
+    uint32_t r, s, l;
+
+    for (r = 0; r < ctx->passes; ++r) {
+        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+            for (l = id; l < ctx->lanes; l += sync->nworkers)
+                fill_segment(ctx, r, l, (uint8_t)s);
+            argon2_barrier_wait(sync);
+        }
+    }
+}
+
 static uint32_t fill_segment_thr(void *thread_data)
 {
-    ARGON2_THREAD_DATA *my_data;
+    ARGON2_THREAD_DATA *my_data = (ARGON2_THREAD_DATA *)thread_data;
+    ARGON2_SYNC *sync = my_data->sync;
 
-    my_data = (ARGON2_THREAD_DATA *)thread_data;
-    fill_segment(my_data->ctx, my_data->pos.pass, my_data->pos.lane,
-        my_data->pos.slice);
+    /* The number of workers is only known once all of them are started */
+    ossl_crypto_mutex_lock(sync->lock);
+    while (!sync->started)
+        ossl_crypto_condvar_wait(sync->cond, sync->lock);
+    ossl_crypto_mutex_unlock(sync->lock);
 
+    fill_mem_blocks_worker(sync, my_data->id);
     return 0;
 }
 
+/*
+ * Starts ctx->threads - 1 pool threads once for the whole derivation and
+ * uses the calling thread as worker 0.  If the pool cannot start all of
+ * them, the lanes are shared out between the workers that did start.
+ */
 static int fill_mem_blocks_mt(KDF_ARGON2 *ctx)
 {
-    uint32_t r, s, l, ll;
+    ARGON2_SYNC sync;
     void **t;
     ARGON2_THREAD_DATA *t_data;
+    uint32_t n, i;
+    int ret = 1;
+
+    memset(&sync, 0, sizeof(sync));
+    sync.ctx = ctx;
+    sync.lock = ossl_crypto_mutex_new();
+    sync.cond = ossl_crypto_condvar_new();
+    t = OPENSSL_calloc(ctx->threads, sizeof(void *));
+    t_data = OPENSSL_calloc(ctx->threads, sizeof(ARGON2_THREAD_DATA));
+
+    if (sync.lock == NULL || sync.cond == NULL || t == NULL || t_data == NULL) {
+        ret = 0;
+        goto end;
+    }
 
-    t = OPENSSL_calloc(ctx->lanes, sizeof(void *));
-    t_data = OPENSSL_calloc(ctx->lanes, sizeof(ARGON2_THREAD_DATA));
+    for (n = 1; n < ctx->threads; ++n) {
+        t_data[n].sync = &sync;
+        t_data[n].id = n;
+        t[n] = ossl_crypto_thread_start(ctx->libctx, &fill_segment_thr,
+            (void *)&t_data[n]);
+        if (t[n] == NULL)
+            break;
+    }
 
-    if (t == NULL || t_data == NULL)
-        goto fail;
+    ossl_crypto_mutex_lock(sync.lock);
+    sync.nworkers = n;
+    sync.started = 1;
+    ossl_crypto_condvar_broadcast(sync.cond);
+    ossl_crypto_mutex_unlock(sync.lock);
 
-    for (r = 0; r < ctx->passes; ++r) {
-        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
-            for (l = 0; l < ctx->lanes; ++l) {
-                ARGON2_POS p;
-                if (l >= ctx->threads) {
-                    if (ossl_crypto_thread_join(t[l - ctx->threads], NULL) == 0)
-                        goto fail;
-                    if (ossl_crypto_thread_clean(t[l - ctx->threads]) == 0)
-                        goto fail;
-                    t[l] = NULL;
-                }
-
-                p.pass = r;
-                p.lane = l;
-                p.slice = (uint8_t)s;
-                p.index = 0;
-
-                t_data[l].ctx = ctx;
-                memcpy(&(t_data[l].pos), &p, sizeof(ARGON2_POS));
-                t[l] = ossl_crypto_thread_start(ctx->libctx, &fill_segment_thr,
-                    (void *)&t_data[l]);
-                if (t[l] == NULL) {
-                    for (ll = 0; ll < l; ++ll) {
-                        if (ossl_crypto_thread_join(t[ll], NULL) == 0)
-                            goto fail;
-                        if (ossl_crypto_thread_clean(t[ll]) == 0)
-                            goto fail;
-                        t[ll] = NULL;
-                    }
-                    goto fail;
-                }
-            }
-            for (l = ctx->lanes - ctx->threads; l < ctx->lanes; ++l) {
-                if (ossl_crypto_thread_join(t[l], NULL) == 0)
-                    goto fail;
-                if (ossl_crypto_thread_clean(t[l]) == 0)
-                    goto fail;
-                t[l] = NULL;
-            }
-        }
+    fill_mem_blocks_worker(&sync, 0);
+
+    for (i = 1; i < n; ++i) {
+        if (ossl_crypto_thread_join(t[i], NULL) == 0)
+            ret = 0;
+        if (ossl_crypto_thread_clean(t[i]) == 0)
+            ret = 0;
     }
 
+end:
     OPENSSL_free(t_data);
     OPENSSL_free(t);
-
-    return 1;
-
-fail:
-    if (t_data != NULL)
-        OPENSSL_free(t_data);
-    if (t != NULL)
-        OPENSSL_free(t);
-    return 0;
+    ossl_crypto_condvar_free(&sync.cond);
+    ossl_crypto_mutex_free(&sync.lock);
+    return ret;
 }
 
 #endif /* !defined(ARGON2_NO_THREADS) */
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <openssl/e_os2.h>
+#include "argon2_avx2.h"
+
+#if defined(ARGON2_AVX2) && !defined(OPENSSL_NO_ARGON2)
+
+#include <immintrin.h>
+#include "internal/target_region.h"
+
+OPENSSL_TARGET_REGION("avx2")
+
+#define ROTR32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+#define ROTR24(x) _mm256_shuffle_epi8((x), r24)
+#define ROTR16(x) _mm256_shuffle_epi8((x), r16)
+#define ROTR63(x) \
+    _mm256_xor_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+/* a = a + b + 2 * lo32(a) * lo32(b), the BlaMka variant of the BLAKE2b add */
+#define FBLAMKA(a, b)                           \
+    do {                                        \
+        __m256i ml = _mm256_mul_epu32((a), (b)); \
+        ml = _mm256_add_epi64(ml, ml);          \
+        (a) = _mm256_add_epi64((a), _mm256_add_epi64((b), ml)); \
+    } while ((void)0, 0)
+
+/* The first and second half of G on two sets of four columns */
+#define G1(A0, A1, B0, B1, C0, C1, D0, D1)             \
+    do {                                               \
+        FBLAMKA(A0, B0);                               \
+        FBLAMKA(A1, B1);                               \
+        D0 = ROTR32(_mm256_xor_si256(D0, A0));         \
+        D1 = ROTR32(_mm256_xor_si256(D1, A1));         \
+        FBLAMKA(C0, D0);                               \
+        FBLAMKA(C1, D1);                               \
+        B0 = ROTR24(_mm256_xor_si256(B0, C0));         \
+        B1 = ROTR24(_mm256_xor_si256(B1, C1));         \
+    } while ((void)0, 0)
+
+#define G2(A0, A1, B0, B1, C0, C1, D0, D1)             \
+    do {                                               \
+        FBLAMKA(A0, B0);                               \
+        FBLAMKA(A1, B1);                               \
+        D0 = ROTR16(_mm256_xor_si256(D0, A0));         \
+        D1 = ROTR16(_mm256_xor_si256(D1, A1));         \
+        FBLAMKA(C0, D0);                               \
+        FBLAMKA(C1, D1);                               \
+        B0 = ROTR63(_mm256_xor_si256(B0, C0));         \
+        B1 = ROTR63(_mm256_xor_si256(B1, C1));         \
+    } while ((void)0, 0)
+
+/*
+ * Row rounds: each register holds a whole row of four words of one 16-word
+ * group, A0..D0 are one group and A1..D1 the next.
+ */
+#define DIAGONALIZE_1(B, C, D)                               \
+    do {                                                     \
+        B = _mm256_permute4x64_epi64(B, _MM_SHUFFLE(0, 3, 2, 1)); \
+        C = _mm256_permute4x64_epi64(C, _MM_SHUFFLE(1, 0, 3, 2)); \
+        D = _mm256_permute4x64_epi64(D, _MM_SHUFFLE(2, 1, 0, 3)); \
+    } while ((void)0, 0)
+
+#define UNDIAGONALIZE_1(B, C, D)                             \
+    do {                                                     \
+        B = _mm256_permute4x64_epi64(B, _MM_SHUFFLE(2, 1, 0, 3)); \
+        C = _mm256_permute4x64_epi64(C, _MM_SHUFFLE(1, 0, 3, 2)); \
+        D = _mm256_permute4x64_epi64(D, _MM_SHUFFLE(0, 3, 2, 1)); \
+    } while ((void)0, 0)
+
+#define ROUND_1(A0, A1, B0, B1, C0, C1, D0, D1)  \
+    do {                                         \
+        G1(A0, A1, B0, B1, C0, C1, D0, D1);      \
+        G2(A0, A1, B0, B1, C0, C1, D0, D1);      \
+        DIAGONALIZE_1(B0, C0, D0);               \
+        DIAGONALIZE_1(B1, C1, D1);               \
+        G1(A0, A1, B0, B1, C0, C1, D0, D1);      \
+        G2(A0, A1, B0, B1, C0, C1, D0, D1);      \
+        UNDIAGONALIZE_1(B0, C0, D0);             \
+        UNDIAGONALIZE_1(B1, C1, D1);             \
+    } while ((void)0, 0)
+
+/*
+ * Column rounds: the 16 words of two interleaved groups are spread over the
+ * registers two words at a time, X0 holds words 0 and 1 of both groups and
+ * X1 words 2 and 3, so the diagonals need words from both registers.
+ */
+#define DIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1)              \
+    do {                                                           \
+        __m256i t1 = _mm256_blend_epi32(B0, B1, 0xCC);             \
+        __m256i t2 = _mm256_blend_epi32(B0, B1, 0x33);             \
+        B1 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1)); \
+        B0 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1)); \
+        t1 = C0;                                                   \
+        C0 = C1;                                                   \
+        C1 = t1;                                                   \
+        t1 = _mm256_blend_epi32(D0, D1, 0xCC);                     \
+        t2 = _mm256_blend_epi32(D0, D1, 0x33);                     \
+        D0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1)); \
+        D1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1)); \
+    } while ((void)0, 0)
+
+#define UNDIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1)            \
+    do {                                                           \
+        __m256i t1 = _mm256_blend_epi32(B0, B1, 0xCC);             \
+        __m256i t2 = _mm256_blend_epi32(B0, B1, 0x33);             \
+        B0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1)); \
+        B1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1)); \
+        t1 = C0;                                                   \
+        C0 = C1;                                                   \
+        C1 = t1;                                                   \
+        t1 = _mm256_blend_epi32(D0, D1, 0x33);                     \
+        t2 = _mm256_blend_epi32(D0, D1, 0xCC);                     \
+        D0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1)); \
+        D1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1)); \
+    } while ((void)0, 0)
+
+#define ROUND_2(A0, A1, B0, B1, C0, C1, D0, D1)          \
+    do {                                                 \
+        G1(A0, A1, B0, B1, C0, C1, D0, D1);              \
+        G2(A0, A1, B0, B1, C0, C1, D0, D1);              \
+        DIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1);   \
+        G1(A0, A1, B0, B1, C0, C1, D0, D1);              \
+        G2(A0, A1, B0, B1, C0, C1, D0, D1);              \
+        UNDIAGONALIZE_2(A0, A1, B0, B1, C0, C1, D0, D1); \
+    } while ((void)0, 0)
+
+void ossl_argon2_fill_block_avx2(const uint64_t *prev, const uint64_t *ref,
+    uint64_t *next, int with_xor)
+{
+    const __m256i r24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2,
+        11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2,
+        11, 12, 13, 14, 15, 8, 9, 10);
+    const __m256i r16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1,
+        10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1,
+        10, 11, 12, 13, 14, 15, 8, 9);
+    __m256i s[32], xy[32];
+    unsigned int i;
+
+    for (i = 0; i < 32; i++) {
+        s[i] = _mm256_xor_si256(
+            _mm256_loadu_si256((const __m256i *)(prev + 4 * i)),
+            _mm256_loadu_si256((const __m256i *)(ref + 4 * i)));
+        if (with_xor)
+            xy[i] = _mm256_xor_si256(s[i],
+                _mm256_loadu_si256((const __m256i *)(next + 4 * i)));
+        else
+            xy[i] = s[i];
+    }
+
+    for (i = 0; i < 4; i++)
+        ROUND_1(s[8 * i + 0], s[8 * i + 4], s[8 * i + 1], s[8 * i + 5],
+            s[8 * i + 2], s[8 * i + 6], s[8 * i + 3], s[8 * i + 7]);
+
+    for (i = 0; i < 4; i++)
+        ROUND_2(s[0 + i], s[4 + i], s[8 + i], s[12 + i],
+            s[16 + i], s[20 + i], s[24 + i], s[28 + i]);
+
+    for (i = 0; i < 32; i++)
+        _mm256_storeu_si256((__m256i *)(next + 4 * i),
+            _mm256_xor_si256(s[i], xy[i]));
+}
+
+OPENSSL_UNTARGET_REGION
+
+#endif
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_PROV_KDFS_ARGON2_AVX2_H
+#define OSSL_PROV_KDFS_ARGON2_AVX2_H
+
+#include <stdint.h>
+#include "internal/target_region.h"
+
+#if defined(__x86_64) || defined(__x86_64__) || defined(_M_AMD64) || defined(_M_X64)
+#if !defined(_M_ARM64EC)
+#if defined(OPENSSL_TARGET_REGION_INTRINSICS)
+#define ARGON2_AVX2
+/* The AVX2 bit of CPUID leaf 7 */
+#define ARGON2_AVX2_CAPABLE ((OPENSSL_ia32cap_P[2] & (1u << 5)) != 0)
+
+/*
+ * The Argon2 compression function G on 1 KiB blocks of 128 little endian
+ * 64-bit words: next = P(prev ^ ref) ^ prev ^ ref, with the old value of
+ * next also XORed in if |with_xor| is set.
+ */
+void ossl_argon2_fill_block_avx2(const uint64_t *prev, const uint64_t *ref,
+    uint64_t *next, int with_xor);
+#endif
+#endif /* !defined(_M_ARM64EC) */
+#endif
+
+#endif
@@ -17,14 +17,18 @@
 #include <stdarg.h>
 #include <string.h>
 #include <openssl/hmac.h>
+#include <openssl/sha.h>
 #include <openssl/evp.h>
 #include <openssl/kdf.h>
 #include <openssl/core_names.h>
 #include <openssl/proverr.h>
+#include <openssl/byteorder.h>
 #include "internal/cryptlib.h"
 #include "internal/fips.h"
 #include "internal/numbers.h"
+#include "internal/provider.h"
 #include "crypto/evp.h"
+#include "crypto/sha.h"
 #include "prov/provider_ctx.h"
 #include "prov/providercommon.h"
 #include "prov/implementations.h"
@@ -437,6 +441,440 @@ const OSSL_DISPATCH ossl_kdf_pbkdf2_functions[] = {
     OSSL_DISPATCH_END
 };
 
+/*
+ * PBKDF2 with HMAC-SHA1 and HMAC-SHA2 is computed directly on the compression
+ * functions rather than through HMAC_CTX.  The padded password is absorbed
+ * into the inner and outer states once, after which every further iteration
+ * is one compression of U_j-1 from the inner state and one of the result from
+ * the outer state.  Both blocks always have the same length, so their padding
+ * is set up once as well.
+ */
+#define PBKDF2_SHA_MAX_BLOCK 128
+
+typedef union {
+    SHA_CTX sha1;
+    SHA256_CTX sha256;
+    SHA512_CTX sha512;
+} PBKDF2_SHA_CTX;
+
+typedef struct {
+    int nid;
+    size_t mdlen;
+    size_t blocklen;
+    /* The states after absorbing the password xor ipad and opad */
+    PBKDF2_SHA_CTX ictx, octx;
+} PBKDF2_HMAC_SHA;
+
+#if defined(SHA1_ASM) && defined(SHA256_ASM) && !defined(OPENSSL_NO_ASM) \
+    && (defined(__x86_64) || defined(_M_AMD64))
+#define PBKDF2_SHA_MB
+/* The number of output blocks that are computed in parallel */
+#define PBKDF2_MB_LANES 8
+/*
+ * With the SHA extensions the multi-buffer kernels only interleave two lanes,
+ * which is slower than compressing one block at a time.
+ */
+#define PBKDF2_MB_CAPABLE ((OPENSSL_ia32cap_P[2] & (1 << 29)) == 0)
+
+#endif
+
+static int pbkdf2_sha_init(PBKDF2_HMAC_SHA *hs, PBKDF2_SHA_CTX *c)
+{
+    switch (hs->nid) {
+    case NID_sha1:
+        return SHA1_Init(&c->sha1);
+    case NID_sha224:
+        return SHA224_Init(&c->sha256);
+    case NID_sha256:
+        return SHA256_Init(&c->sha256);
+    case NID_sha384:
+        return SHA384_Init(&c->sha512);
+    case NID_sha512:
+        return SHA512_Init(&c->sha512);
+    case NID_sha512_224:
+        return sha512_224_init(&c->sha512);
+    case NID_sha512_256:
+        return sha512_256_init(&c->sha512);
+    }
+    return 0;
+}
+
+static int pbkdf2_sha_update(PBKDF2_HMAC_SHA *hs, PBKDF2_SHA_CTX *c,
+    const unsigned char *in, size_t inlen)
+{
+    if (hs->blocklen == SHA512_CBLOCK)
+        return SHA512_Update(&c->sha512, in, inlen);
+    if (hs->nid == NID_sha1)
+        return SHA1_Update(&c->sha1, in, inlen);
+    return SHA256_Update(&c->sha256, in, inlen);
+}
+
+/* The truncated SHA-2 variants write |mdlen| bytes */
+static int pbkdf2_sha_final(PBKDF2_HMAC_SHA *hs, PBKDF2_SHA_CTX *c,
+    unsigned char *out)
+{
+    if (hs->blocklen == SHA512_CBLOCK)
+        return SHA512_Final(out, &c->sha512);
+    if (hs->nid == NID_sha1)
+        return SHA1_Final(out, &c->sha1);
+    return SHA256_Final(out, &c->sha256);
+}
+
+/*
+ * Set up |hs| for HMAC with |digest| and the key |pass|.  Returns 0 if the
+ * digest is not one of SHA-1 and SHA-2 as implemented by the provider with
+ * the context |provctx|, or on error.  Any other implementation of the same
+ * digest has to go through EVP_MD.
+ */
+static int pbkdf2_hmac_sha_init(PBKDF2_HMAC_SHA *hs, void *provctx,
+    const EVP_MD *digest, const unsigned char *pass, size_t passlen)
+{
+    unsigned char key[PBKDF2_SHA_MAX_BLOCK];
+    PBKDF2_SHA_CTX c;
+    size_t i;
+    int ret = 0;
+
+    if (ossl_provider_ctx(EVP_MD_get0_provider(digest)) != provctx)
+        return 0;
+
+    hs->nid = EVP_MD_get_type(digest);
+    switch (hs->nid) {
+    case NID_sha1:
+        hs->mdlen = SHA_DIGEST_LENGTH;
+        hs->blocklen = SHA_CBLOCK;
+        break;
+    case NID_sha224:
+        hs->mdlen = SHA224_DIGEST_LENGTH;
+        hs->blocklen = SHA_CBLOCK;
+        break;
+    case NID_sha256:
+        hs->mdlen = SHA256_DIGEST_LENGTH;
+        hs->blocklen = SHA_CBLOCK;
+        break;
+    case NID_sha384:
+        hs->mdlen = SHA384_DIGEST_LENGTH;
+        hs->blocklen = SHA512_CBLOCK;
+        break;
+    case NID_sha512:
+        hs->mdlen = SHA512_DIGEST_LENGTH;
+        hs->blocklen = SHA512_CBLOCK;
+        break;
+    case NID_sha512_224:
+        hs->mdlen = SHA224_DIGEST_LENGTH;
+        hs->blocklen = SHA512_CBLOCK;
+        break;
+    case NID_sha512_256:
+        hs->mdlen = SHA256_DIGEST_LENGTH;
+        hs->blocklen = SHA512_CBLOCK;
+        break;
+    default:
+        return 0;
+    }
+
+    memset(key, 0, sizeof(key));
+    if (passlen > hs->blocklen) {
+        if (!pbkdf2_sha_init(hs, &c)
+            || !pbkdf2_sha_update(hs, &c, pass, passlen)
+            || !pbkdf2_sha_final(hs, &c, key))
+            goto err;
+    } else if (passlen > 0) {
+        memcpy(key, pass, passlen);
+    }
+
+    for (i = 0; i < hs->blocklen; i++)
+        key[i] ^= 0x36;
+    if (!pbkdf2_sha_init(hs, &hs->ictx)
+        || !pbkdf2_sha_update(hs, &hs->ictx, key, hs->blocklen))
+        goto err;
+    for (i = 0; i < hs->blocklen; i++)
+        key[i] ^= 0x36 ^ 0x5c;
+    if (!pbkdf2_sha_init(hs, &hs->octx)
+        || !pbkdf2_sha_update(hs, &hs->octx, key, hs->blocklen))
+        goto err;
+    ret = 1;
+
+err:
+    OPENSSL_cleanse(key, sizeof(key));
+    OPENSSL_cleanse(&c, sizeof(c));
+    return ret;
+}
+
+/* U_1 = HMAC(P, S || INT(i)) */
+static int pbkdf2_hmac_sha_first(PBKDF2_HMAC_SHA *hs,
+    const unsigned char *salt, size_t saltlen, const unsigned char itmp[4],
+    unsigned char *u)
+{
+    PBKDF2_SHA_CTX c;
+    int ret;
+
+    c = hs->ictx;
+    ret = pbkdf2_sha_update(hs, &c, salt, saltlen)
+        && pbkdf2_sha_update(hs, &c, itmp, 4)
+        && pbkdf2_sha_final(hs, &c, u);
+    c = hs->octx;
+    ret = ret
+        && pbkdf2_sha_update(hs, &c, u, hs->mdlen)
+        && pbkdf2_sha_final(hs, &c, u);
+    OPENSSL_cleanse(&c, sizeof(c));
+    return ret;
+}
+
+/*
+ * Pad |block| as the final block of a message of |blocklen| + |mdlen| bytes,
+ * the first |mdlen| bytes are left for the message.
+ */
+static void pbkdf2_sha_pad(const PBKDF2_HMAC_SHA *hs, unsigned char *block)
+{
+    uint64_t bits = 8 * (uint64_t)(hs->blocklen + hs->mdlen);
+    size_t i;
+
+    memset(block + hs->mdlen, 0, hs->blocklen - hs->mdlen);
+    block[hs->mdlen] = 0x80;
+    for (i = 0; i < 8; i++)
+        block[hs->blocklen - 1 - i] = (unsigned char)(bits >> (8 * i));
+}
+
+/*
+ * Compress the padded |block| starting from the state |from| and write the
+ * first |mdlen| bytes of the new state to the start of |out|.
+ */
+static void pbkdf2_sha_compress(const PBKDF2_HMAC_SHA *hs,
+    const PBKDF2_SHA_CTX *from, const unsigned char *block, unsigned char *out)
+{
+    unsigned char md[SHA512_DIGEST_LENGTH];
+    PBKDF2_SHA_CTX c;
+    size_t i;
+
+    if (hs->blocklen == SHA512_CBLOCK) {
+        memcpy(c.sha512.h, from->sha512.h, sizeof(c.sha512.h));
+        SHA512_Transform(&c.sha512, block);
+        for (i = 0; i < 8; i++)
+            OPENSSL_store_u64_be(md + 8 * i, c.sha512.h[i]);
+        memcpy(out, md, hs->mdlen);
+    } else if (hs->nid == NID_sha1) {
+        c.sha1.h0 = from->sha1.h0;
+        c.sha1.h1 = from->sha1.h1;
+        c.sha1.h2 = from->sha1.h2;
+        c.sha1.h3 = from->sha1.h3;
+        c.sha1.h4 = from->sha1.h4;
+        SHA1_Transform(&c.sha1, block);
+        OPENSSL_store_u32_be(out, c.sha1.h0);
+        OPENSSL_store_u32_be(out + 4, c.sha1.h1);
+        OPENSSL_store_u32_be(out + 8, c.sha1.h2);
+        OPENSSL_store_u32_be(out + 12, c.sha1.h3);
+        OPENSSL_store_u32_be(out + 16, c.sha1.h4);
+    } else {
+        /* The truncated output of SHA-224 is a multiple of 4 bytes too */
+        memcpy(c.sha256.h, from->sha256.h, sizeof(c.sha256.h));
+        SHA256_Transform(&c.sha256, block);
+        for (i = 0; i < hs->mdlen / 4; i++)
+            OPENSSL_store_u32_be(out + 4 * i, c.sha256.h[i]);
+    }
+}
+
+/*
+ * T = U_1 ^ ... ^ U_iter, where |u| holds U_1 on entry.  The xor always runs
+ * over SHA512_DIGEST_LENGTH bytes of |t|, of which only the first |mdlen|
+ * are T, the rest is the padding of the inner block.
+ */
+static void pbkdf2_hmac_sha_iterate(const PBKDF2_HMAC_SHA *hs, uint64_t iter,
+    const unsigned char *u, unsigned char t[SHA512_DIGEST_LENGTH])
+{
+    unsigned char ib[PBKDF2_SHA_MAX_BLOCK], ob[PBKDF2_SHA_MAX_BLOCK];
+    uint64_t j;
+    size_t k;
+
+    pbkdf2_sha_pad(hs, ib);
+    pbkdf2_sha_pad(hs, ob);
+    memcpy(ib, u, hs->mdlen);
+    memcpy(t, ib, SHA512_DIGEST_LENGTH);
+    for (j = 1; j < iter; j++) {
+        pbkdf2_sha_compress(hs, &hs->ictx, ib, ob);
+        pbkdf2_sha_compress(hs, &hs->octx, ob, ib);
+        for (k = 0; k < SHA512_DIGEST_LENGTH; k++)
+            t[k] ^= ib[k];
+    }
+    OPENSSL_cleanse(ib, sizeof(ib));
+    OPENSSL_cleanse(ob, sizeof(ob));
+}
+
+#ifdef PBKDF2_SHA_MB
+static void pbkdf2_mb_set_state(SHA256_MB_CTX *mctx, const PBKDF2_HMAC_SHA *hs,
+    const PBKDF2_SHA_CTX *from, int lanes)
+{
+    unsigned int *w = (unsigned int *)mctx;
+    unsigned int h[8];
+    int k, l, words;
+
+    /* SHA1_MB_CTX only has the five words A to E */
+    if (hs->nid == NID_sha1) {
+        h[0] = from->sha1.h0;
+        h[1] = from->sha1.h1;
+        h[2] = from->sha1.h2;
+        h[3] = from->sha1.h3;
+        h[4] = from->sha1.h4;
+        words = 5;
+    } else {
+        memcpy(h, from->sha256.h, sizeof(h));
+        words = 8;
+    }
+    for (k = 0; k < words; k++)
+        for (l = 0; l < lanes; l++)
+            w[8 * k + l] = h[k];
+}
+
+static void pbkdf2_mb_compress(const PBKDF2_HMAC_SHA *hs, SHA256_MB_CTX *mctx,
+    const HASH_DESC *desc, int lanes)
+{
+    if (hs->nid == NID_sha1)
+        sha1_multi_block((SHA1_MB_CTX *)mctx, desc, (lanes + 3) / 4);
+    else
+        sha256_multi_block(mctx, desc, (lanes + 3) / 4);
+}
+
+static void pbkdf2_mb_get_state(const SHA256_MB_CTX *mctx,
+    const PBKDF2_HMAC_SHA *hs, unsigned char *block[], int lanes)
+{
+    const unsigned int *w = (const unsigned int *)mctx;
+    size_t k;
+    int l;
+
+    for (l = 0; l < lanes; l++)
+        for (k = 0; k < hs->mdlen / 4; k++)
+            OPENSSL_store_u32_be(block[l] + 4 * k, w[8 * k + l]);
+}
+
+/*
+ * The same as pbkdf2_hmac_sha_iterate() for |lanes| output blocks at once,
+ * using the multi-buffer SHA-1 or SHA-256 kernels.  The lanes are all
+ * active until the end, so the kernel never sees a group of lanes without
+ * blocks.
+ */
+static void pbkdf2_hmac_sha_iterate_mb(const PBKDF2_HMAC_SHA *hs,
+    uint64_t iter, unsigned char *const u[], unsigned char *const t[],
+    int lanes)
+{
+    unsigned char storage[sizeof(SHA256_MB_CTX) + 32];
+    unsigned char blocks[2][PBKDF2_MB_LANES][SHA_CBLOCK];
+    unsigned char *ib[PBKDF2_MB_LANES], *ob[PBKDF2_MB_LANES];
+    HASH_DESC idesc[PBKDF2_MB_LANES], odesc[PBKDF2_MB_LANES];
+    SHA256_MB_CTX *mctx;
+    uint64_t j;
+    size_t k;
+    int l;
+
+    mctx = (SHA256_MB_CTX *)(storage + 32 - ((size_t)storage % 32));
+    for (l = 0; l < lanes; l++) {
+        ib[l] = blocks[0][l];
+        ob[l] = blocks[1][l];
+        pbkdf2_sha_pad(hs, ib[l]);
+        pbkdf2_sha_pad(hs, ob[l]);
+        memcpy(ib[l], u[l], hs->mdlen);
+        memcpy(t[l], u[l], hs->mdlen);
+        idesc[l].ptr = ib[l];
+        idesc[l].blocks = 1;
+        odesc[l].ptr = ob[l];
+        odesc[l].blocks = 1;
+    }
+    for (; l < PBKDF2_MB_LANES; l++) {
+        idesc[l].ptr = odesc[l].ptr = NULL;
+        idesc[l].blocks = odesc[l].blocks = 0;
+    }
+
+    for (j = 1; j < iter; j++) {
+        pbkdf2_mb_set_state(mctx, hs, &hs->ictx, lanes);
+        pbkdf2_mb_compress(hs, mctx, idesc, lanes);
+        pbkdf2_mb_get_state(mctx, hs, ob, lanes);
+        pbkdf2_mb_set_state(mctx, hs, &hs->octx, lanes);
+        pbkdf2_mb_compress(hs, mctx, odesc, lanes);
+        pbkdf2_mb_get_state(mctx, hs, ib, lanes);
+        for (l = 0; l < lanes; l++)
+            for (k = 0; k < hs->mdlen; k++)
+                t[l][k] ^= ib[l][k];
+    }
+    OPENSSL_cleanse(blocks, sizeof(blocks));
+    OPENSSL_cleanse(storage, sizeof(storage));
+}
+#endif
+
+#ifdef PBKDF2_SHA_MB
+/*
+ * Compute up to PBKDF2_MB_LANES output blocks at once, starting with block
+ * number |*i|, for as long as more than one block is left.
+ */
+static int pbkdf2_hmac_sha_derive_mb(PBKDF2_HMAC_SHA *hs,
+    const unsigned char *salt, size_t saltlen, uint64_t iter,
+    unsigned char **key, size_t *keylen, unsigned long *i)
+{
+    unsigned char u[PBKDF2_MB_LANES][SHA256_DIGEST_LENGTH];
+    unsigned char t[PBKDF2_MB_LANES][SHA256_DIGEST_LENGTH];
+    unsigned char *up[PBKDF2_MB_LANES], *tp[PBKDF2_MB_LANES];
+    unsigned char itmp[4];
+    size_t cplen;
+    int l, lanes, ret = 0;
+
+    while (*keylen > hs->mdlen) {
+        for (lanes = 0;
+             lanes < PBKDF2_MB_LANES && lanes * hs->mdlen < *keylen;
+             lanes++) {
+            OPENSSL_store_u32_be(itmp, (uint32_t)(*i)++);
+            up[lanes] = u[lanes];
+            tp[lanes] = t[lanes];
+            if (!pbkdf2_hmac_sha_first(hs, salt, saltlen, itmp, u[lanes]))
+                goto err;
+        }
+        pbkdf2_hmac_sha_iterate_mb(hs, iter, up, tp, lanes);
+        for (l = 0; l < lanes; l++) {
+            cplen = *keylen < hs->mdlen ? *keylen : hs->mdlen;
+            memcpy(*key, t[l], cplen);
+            *key += cplen;
+            *keylen -= cplen;
+        }
+    }
+    ret = 1;
+
+err:
+    OPENSSL_cleanse(u, sizeof(u));
+    OPENSSL_cleanse(t, sizeof(t));
+    return ret;
+}
+#endif
+
+static int pbkdf2_hmac_sha_derive(PBKDF2_HMAC_SHA *hs,
+    const unsigned char *salt, size_t saltlen, uint64_t iter,
+    unsigned char *key, size_t keylen)
+{
+    unsigned char u[SHA512_DIGEST_LENGTH], t[SHA512_DIGEST_LENGTH];
+    unsigned char itmp[4];
+    unsigned long i = 1;
+    size_t cplen;
+    int ret = 0;
+
+#ifdef PBKDF2_SHA_MB
+    if (hs->blocklen == SHA_CBLOCK && PBKDF2_MB_CAPABLE
+        && !pbkdf2_hmac_sha_derive_mb(hs, salt, saltlen, iter, &key, &keylen,
+            &i))
+        return 0;
+#endif
+
+    while (keylen > 0) {
+        cplen = keylen < hs->mdlen ? keylen : hs->mdlen;
+        OPENSSL_store_u32_be(itmp, (uint32_t)i++);
+        if (!pbkdf2_hmac_sha_first(hs, salt, saltlen, itmp, u))
+            goto err;
+        pbkdf2_hmac_sha_iterate(hs, iter, u, t);
+        memcpy(key, t, cplen);
+        key += cplen;
+        keylen -= cplen;
+    }
+    ret = 1;
+
+err:
+    OPENSSL_cleanse(u, sizeof(u));
+    OPENSSL_cleanse(t, sizeof(t));
+    return ret;
+}
+
 /*
  * This is an implementation of PKCS#5 v2.0 password based encryption key
  * derivation function PBKDF2. SHA1 version verified against test vectors
@@ -458,6 +896,7 @@ static int pbkdf2_derive(KDF_PBKDF2 *ctx, const char *pass, size_t passlen,
     uint64_t j;
     unsigned long i = 1;
     HMAC_CTX *hctx_tpl = NULL, *hctx = NULL;
+    PBKDF2_HMAC_SHA hs;
 
     mdlen = EVP_MD_get_size(digest);
     if (mdlen <= 0)
@@ -475,6 +914,13 @@ static int pbkdf2_derive(KDF_PBKDF2 *ctx, const char *pass, size_t passlen,
     if (!lower_bound_check_passed(ctx, saltlen, iter, keylen, passlen, lower_bound_checks))
         return 0;
 
+    if (pbkdf2_hmac_sha_init(&hs, ctx->provctx, digest,
+            (const unsigned char *)pass, passlen)) {
+        ret = pbkdf2_hmac_sha_derive(&hs, salt, saltlen, iter, key, keylen);
+        OPENSSL_cleanse(&hs, sizeof(hs));
+        return ret;
+    }
+
     hctx_tpl = HMAC_CTX_new();
     if (hctx_tpl == NULL)
         return 0;
@@ -1,5 +1,5 @@
 /*
- * Copyright 2017-2025 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2017-2026 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -15,9 +15,11 @@
 #include <openssl/err.h>
 #include <openssl/core_names.h>
 #include <openssl/proverr.h>
+#include <openssl/thread.h>
 #include "crypto/evp.h"
 #include "internal/common.h"
 #include "internal/numbers.h"
+#include "internal/thread.h"
 #include "prov/implementations.h"
 #include "prov/provider_ctx.h"
 #include "prov/providercommon.h"
@@ -27,6 +29,35 @@
 
 #include "providers/implementations/kdfs/scrypt.inc"
 
+#if defined(OPENSSL_NO_DEFAULT_THREAD_POOL) && defined(OPENSSL_NO_THREAD_POOL)
+#define SCRYPT_NO_THREADS
+#endif
+
+#if !defined(OPENSSL_THREADS)
+#define SCRYPT_NO_THREADS
+#endif
+
+/*
+ * Salsa20/8 works on four 4-word rows, so a 128-bit vector unit can compute
+ * one quarter round of every column (or row) at once, provided the words of
+ * each 64-byte block are stored diagonally ("shuffled"): word k of a stored
+ * block holds word 5 * k mod 16 of the block as defined in RFC 7914.
+ */
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SCRYPT_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SCRYPT_NEON
+#endif
+
+#if defined(SCRYPT_SSE2) || defined(SCRYPT_NEON)
+#define SCRYPT_WORD(k) (((k) * 5) & 15)
+#else
+#define SCRYPT_WORD(k) (k)
+#endif
+
 static OSSL_FUNC_kdf_newctx_fn kdf_scrypt_new;
 static OSSL_FUNC_kdf_dupctx_fn kdf_scrypt_dup;
 static OSSL_FUNC_kdf_freectx_fn kdf_scrypt_free;
@@ -40,7 +71,7 @@ static OSSL_FUNC_kdf_get_ctx_params_fn kdf_scrypt_get_ctx_params;
 static int scrypt_alg(const char *pass, size_t passlen,
     const unsigned char *salt, size_t saltlen,
     uint64_t N, uint64_t r, uint64_t p, uint64_t maxmem,
-    unsigned char *key, size_t keylen, EVP_MD *sha256,
+    uint32_t threads, unsigned char *key, size_t keylen, EVP_MD *sha256,
     OSSL_LIB_CTX *libctx, const char *propq);
 
 typedef struct {
@@ -53,6 +84,7 @@ typedef struct {
     uint64_t N;
     uint64_t r, p;
     uint64_t maxmem_bytes;
+    uint32_t threads;
     EVP_MD *sha256;
 } KDF_SCRYPT;
 
@@ -124,6 +156,7 @@ static void *kdf_scrypt_dup(void *vctx)
         dest->r = src->r;
         dest->p = src->p;
         dest->maxmem_bytes = src->maxmem_bytes;
+        dest->threads = src->threads;
         dest->sha256 = src->sha256;
     }
     return dest;
@@ -143,6 +176,7 @@ static void kdf_scrypt_init(KDF_SCRYPT *ctx)
     ctx->r = 8;
     ctx->p = 1;
     ctx->maxmem_bytes = 1025 * 1024 * 1024;
+    ctx->threads = 1;
 }
 
 static int scrypt_set_membuf(unsigned char **buffer, size_t *buflen,
@@ -203,12 +237,28 @@ static int kdf_scrypt_derive(void *vctx, unsigned char *key, size_t keylen,
         return 0;
     }
 
+    if (ctx->threads > 1) {
+#ifdef SCRYPT_NO_THREADS
+        ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_THREAD_POOL_SIZE,
+            "requested %u threads, single-threaded mode supported only",
+            ctx->threads);
+        return 0;
+#else
+        if (ctx->threads > ossl_get_avail_threads(ctx->libctx)) {
+            ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_THREAD_POOL_SIZE,
+                "requested %u threads, available: %u",
+                ctx->threads, ossl_get_avail_threads(ctx->libctx));
+            return 0;
+        }
+#endif
+    }
+
     if (ctx->sha256 == NULL && !set_digest(ctx))
         return 0;
 
     return scrypt_alg((char *)ctx->pass, ctx->pass_len, ctx->salt,
         ctx->salt_len, ctx->N, ctx->r, ctx->p,
-        ctx->maxmem_bytes, key, keylen, ctx->sha256,
+        ctx->maxmem_bytes, ctx->threads, key, keylen, ctx->sha256,
         ctx->libctx, ctx->propq);
 }
 
@@ -222,6 +272,7 @@ static int kdf_scrypt_set_ctx_params(void *vctx, const OSSL_PARAM params[])
     struct scrypt_set_ctx_params_st p;
     KDF_SCRYPT *ctx = vctx;
     uint64_t u64_value;
+    uint32_t u32_value;
 
     if (ctx == NULL || !scrypt_set_ctx_params_decoder(params, &p))
         return 0;
@@ -258,6 +309,12 @@ static int kdf_scrypt_set_ctx_params(void *vctx, const OSSL_PARAM params[])
         ctx->maxmem_bytes = u64_value;
     }
 
+    if (p.thrds != NULL) {
+        if (!OSSL_PARAM_get_uint32(p.thrds, &u32_value) || u32_value < 1)
+            return 0;
+        ctx->threads = u32_value;
+    }
+
     if (p.propq != NULL) {
         if (p.propq->data_type != OSSL_PARAM_UTF8_STRING
             || !set_property_query(ctx, p.propq->data)
@@ -307,6 +364,163 @@ const OSSL_DISPATCH ossl_kdf_scrypt_functions[] = {
     OSSL_DISPATCH_END
 };
 
+#if defined(SCRYPT_SSE2)
+
+#define SALSA_R(T, X, n) \
+    (X) = _mm_xor_si128(_mm_xor_si128((X), _mm_slli_epi32((T), (n))), \
+        _mm_srli_epi32((T), 32 - (n)))
+
+/*
+ * Salsa20/8 of the shuffled block in X0..X3: on entry X0 holds the diagonal
+ * words 0, 5, 10, 15, X1 holds 4, 9, 14, 3, X2 holds 8, 13, 2, 7 and X3 holds
+ * 12, 1, 6, 11.
+ */
+static ossl_inline void salsa208_sse2(__m128i *X0, __m128i *X1, __m128i *X2,
+    __m128i *X3)
+{
+    __m128i x0 = *X0, x1 = *X1, x2 = *X2, x3 = *X3, t;
+    int i;
+
+    for (i = 8; i > 0; i -= 2) {
+        /* Columns */
+        t = _mm_add_epi32(x0, x3);
+        SALSA_R(t, x1, 7);
+        t = _mm_add_epi32(x1, x0);
+        SALSA_R(t, x2, 9);
+        t = _mm_add_epi32(x2, x1);
+        SALSA_R(t, x3, 13);
+        t = _mm_add_epi32(x3, x2);
+        SALSA_R(t, x0, 18);
+
+        x1 = _mm_shuffle_epi32(x1, 0x93);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x39);
+
+        /* Rows */
+        t = _mm_add_epi32(x0, x1);
+        SALSA_R(t, x3, 7);
+        t = _mm_add_epi32(x3, x0);
+        SALSA_R(t, x2, 9);
+        t = _mm_add_epi32(x2, x3);
+        SALSA_R(t, x1, 13);
+        t = _mm_add_epi32(x1, x2);
+        SALSA_R(t, x0, 18);
+
+        x1 = _mm_shuffle_epi32(x1, 0x39);
+        x2 = _mm_shuffle_epi32(x2, 0x4E);
+        x3 = _mm_shuffle_epi32(x3, 0x93);
+    }
+    *X0 = _mm_add_epi32(*X0, x0);
+    *X1 = _mm_add_epi32(*X1, x1);
+    *X2 = _mm_add_epi32(*X2, x2);
+    *X3 = _mm_add_epi32(*X3, x3);
+}
+
+#undef SALSA_R
+
+static void scryptBlockMix(uint32_t *B_, uint32_t *B, uint64_t r)
+{
+    const __m128i *in = (const __m128i *)B;
+    __m128i *out;
+    __m128i X0, X1, X2, X3;
+    uint64_t i;
+
+    in += (r * 2 - 1) * 4;
+    X0 = _mm_loadu_si128(in);
+    X1 = _mm_loadu_si128(in + 1);
+    X2 = _mm_loadu_si128(in + 2);
+    X3 = _mm_loadu_si128(in + 3);
+    in = (const __m128i *)B;
+    for (i = 0; i < r * 2; i++, in += 4) {
+        X0 = _mm_xor_si128(X0, _mm_loadu_si128(in));
+        X1 = _mm_xor_si128(X1, _mm_loadu_si128(in + 1));
+        X2 = _mm_xor_si128(X2, _mm_loadu_si128(in + 2));
+        X3 = _mm_xor_si128(X3, _mm_loadu_si128(in + 3));
+        salsa208_sse2(&X0, &X1, &X2, &X3);
+        out = (__m128i *)(B_ + (i / 2 + (i & 1) * r) * 16);
+        _mm_storeu_si128(out, X0);
+        _mm_storeu_si128(out + 1, X1);
+        _mm_storeu_si128(out + 2, X2);
+        _mm_storeu_si128(out + 3, X3);
+    }
+}
+
+#elif defined(SCRYPT_NEON)
+
+#define SALSA_R(T, X, n) \
+    (X) = veorq_u32((X), vsriq_n_u32(vshlq_n_u32((T), (n)), (T), 32 - (n)))
+
+/* Same as salsa208_sse2(), vextq_u32() rotates the words of a row. */
+static ossl_inline void salsa208_neon(uint32x4_t *X0, uint32x4_t *X1,
+    uint32x4_t *X2, uint32x4_t *X3)
+{
+    uint32x4_t x0 = *X0, x1 = *X1, x2 = *X2, x3 = *X3, t;
+    int i;
+
+    for (i = 8; i > 0; i -= 2) {
+        /* Columns */
+        t = vaddq_u32(x0, x3);
+        SALSA_R(t, x1, 7);
+        t = vaddq_u32(x1, x0);
+        SALSA_R(t, x2, 9);
+        t = vaddq_u32(x2, x1);
+        SALSA_R(t, x3, 13);
+        t = vaddq_u32(x3, x2);
+        SALSA_R(t, x0, 18);
+
+        x1 = vextq_u32(x1, x1, 3);
+        x2 = vextq_u32(x2, x2, 2);
+        x3 = vextq_u32(x3, x3, 1);
+
+        /* Rows */
+        t = vaddq_u32(x0, x1);
+        SALSA_R(t, x3, 7);
+        t = vaddq_u32(x3, x0);
+        SALSA_R(t, x2, 9);
+        t = vaddq_u32(x2, x3);
+        SALSA_R(t, x1, 13);
+        t = vaddq_u32(x1, x2);
+        SALSA_R(t, x0, 18);
+
+        x1 = vextq_u32(x1, x1, 1);
+        x2 = vextq_u32(x2, x2, 2);
+        x3 = vextq_u32(x3, x3, 3);
+    }
+    *X0 = vaddq_u32(*X0, x0);
+    *X1 = vaddq_u32(*X1, x1);
+    *X2 = vaddq_u32(*X2, x2);
+    *X3 = vaddq_u32(*X3, x3);
+}
+
+#undef SALSA_R
+
+static void scryptBlockMix(uint32_t *B_, uint32_t *B, uint64_t r)
+{
+    const uint32_t *in = B + (r * 2 - 1) * 16;
+    uint32_t *out;
+    uint32x4_t X0, X1, X2, X3;
+    uint64_t i;
+
+    X0 = vld1q_u32(in);
+    X1 = vld1q_u32(in + 4);
+    X2 = vld1q_u32(in + 8);
+    X3 = vld1q_u32(in + 12);
+    for (i = 0, in = B; i < r * 2; i++, in += 16) {
+        X0 = veorq_u32(X0, vld1q_u32(in));
+        X1 = veorq_u32(X1, vld1q_u32(in + 4));
+        X2 = veorq_u32(X2, vld1q_u32(in + 8));
+        X3 = veorq_u32(X3, vld1q_u32(in + 12));
+        salsa208_neon(&X0, &X1, &X2, &X3);
+        out = B_ + (i / 2 + (i & 1) * r) * 16;
+        vst1q_u32(out, X0);
+        vst1q_u32(out + 4, X1);
+        vst1q_u32(out + 8, X2);
+        vst1q_u32(out + 12, X3);
+    }
+}
+
+#else
+
 #define R(a, b) (((a) << (b)) | ((a) >> (32 - (b))))
 static void salsa208_word_specification(uint32_t inout[16])
 {
@@ -369,6 +583,13 @@ static void scryptBlockMix(uint32_t *B_, uint32_t *B, uint64_t r)
     OPENSSL_cleanse(X, sizeof(X));
 }
 
+#endif
+
+/*
+ * The blocks in V, X and T are kept in the word order given by SCRYPT_WORD(),
+ * B is converted on the way in and out.  Word 0 of a block is never moved,
+ * so Integerify() is the same in both layouts.
+ */
 static void scryptROMix(unsigned char *B, uint64_t r, uint64_t N,
     uint32_t *X, uint32_t *T, uint32_t *V)
 {
@@ -377,11 +598,12 @@ static void scryptROMix(unsigned char *B, uint64_t r, uint64_t N,
     uint64_t i, k;
 
     /* Convert from little endian input */
-    for (pV = V, i = 0, pB = B; i < 32 * r; i++, pV++) {
-        *pV = *pB++;
-        *pV |= *pB++ << 8;
-        *pV |= *pB++ << 16;
-        *pV |= (uint32_t)*pB++ << 24;
+    for (pV = V, i = 0; i < 32 * r; i++, pV++) {
+        pB = B + 4 * ((i & ~(uint64_t)15) + SCRYPT_WORD(i & 15));
+        *pV = pB[0];
+        *pV |= pB[1] << 8;
+        *pV |= pB[2] << 16;
+        *pV |= (uint32_t)pB[3] << 24;
     }
 
     for (i = 1; i < N; i++, pV += 32 * r)
@@ -398,15 +620,79 @@ static void scryptROMix(unsigned char *B, uint64_t r, uint64_t N,
         scryptBlockMix(X, T, r);
     }
     /* Convert output to little endian */
-    for (i = 0, pB = B; i < 32 * r; i++) {
+    for (i = 0; i < 32 * r; i++) {
         uint32_t xtmp = X[i];
-        *pB++ = xtmp & 0xff;
-        *pB++ = (xtmp >> 8) & 0xff;
-        *pB++ = (xtmp >> 16) & 0xff;
-        *pB++ = (xtmp >> 24) & 0xff;
+
+        pB = B + 4 * ((i & ~(uint64_t)15) + SCRYPT_WORD(i & 15));
+        pB[0] = xtmp & 0xff;
+        pB[1] = (xtmp >> 8) & 0xff;
+        pB[2] = (xtmp >> 16) & 0xff;
+        pB[3] = (xtmp >> 24) & 0xff;
     }
 }
 
+/*
+ * The p lanes of B are independent: each share of the work runs ROMix on
+ * every |step|-th lane starting at |first|, using its own X, T and V.
+ */
+typedef struct {
+    unsigned char *B;
+    uint32_t *XTV;
+    uint64_t N, r, p;
+    uint64_t first, step;
+} SCRYPT_SHARE;
+
+static void scrypt_romix_share(const SCRYPT_SHARE *share)
+{
+    uint64_t i, r = share->r;
+    uint32_t *X = share->XTV, *T = X + 32 * r, *V = T + 32 * r;
+
+    for (i = share->first; i < share->p; i += share->step)
+        scryptROMix(share->B + 128 * r * i, r, share->N, X, T, V);
+}
+
+#if !defined(SCRYPT_NO_THREADS)
+
+static uint32_t scrypt_romix_thr(void *data)
+{
+    scrypt_romix_share(data);
+    return 1;
+}
+
+/*
+ * Runs shares 1 .. |n| - 1 on pool threads and share 0 on the calling
+ * thread.
+ */
+static int scrypt_romix_mt(OSSL_LIB_CTX *libctx, SCRYPT_SHARE *shares,
+    uint32_t n)
+{
+    void **t;
+    uint32_t i, started = 1;
+    int ret = 1;
+
+    t = OPENSSL_calloc(n, sizeof(*t));
+    for (; t != NULL && started < n; started++) {
+        t[started] = ossl_crypto_thread_start(libctx, &scrypt_romix_thr,
+            &shares[started]);
+        if (t[started] == NULL)
+            break;
+    }
+    scrypt_romix_share(&shares[0]);
+    for (i = 1; i < started; i++) {
+        if (ossl_crypto_thread_join(t[i], NULL) == 0)
+            ret = 0;
+        if (ossl_crypto_thread_clean(t[i]) == 0)
+            ret = 0;
+    }
+    OPENSSL_free(t);
+    /* Shares that could not be started are run here */
+    for (i = started; i < n; i++)
+        scrypt_romix_share(&shares[i]);
+    return ret;
+}
+
+#endif /* !defined(SCRYPT_NO_THREADS) */
+
 #ifndef SIZE_MAX
 #define SIZE_MAX ((size_t)-1)
 #endif
@@ -430,13 +716,13 @@ static void scryptROMix(unsigned char *B, uint64_t r, uint64_t N,
 static int scrypt_alg(const char *pass, size_t passlen,
     const unsigned char *salt, size_t saltlen,
     uint64_t N, uint64_t r, uint64_t p, uint64_t maxmem,
-    unsigned char *key, size_t keylen, EVP_MD *sha256,
+    uint32_t threads, unsigned char *key, size_t keylen, EVP_MD *sha256,
     OSSL_LIB_CTX *libctx, const char *propq)
 {
     int rv = 0;
     unsigned char *B;
-    uint32_t *X, *V, *T;
-    uint64_t i, Blen, Vlen;
+    SCRYPT_SHARE *shares = NULL;
+    uint64_t i, Blen, Vlen, nshares;
 
     /* Sanity check parameters */
     /* initial check, r,p must be non zero, N >= 2 and a power of 2 */
@@ -488,8 +774,16 @@ static int scrypt_alg(const char *pass, size_t passlen,
     }
     Vlen = 32 * r * (N + 2) * sizeof(uint32_t);
 
+    /*
+     * Every thread working on the p lanes needs its own V, X and T, so the
+     * memory limit applies to all of them.
+     */
+    nshares = threads < p ? threads : p;
+    if (nshares == 0)
+        nshares = 1;
+
     /* check total allocated size fits in uint64_t */
-    if (Blen > UINT64_MAX - Vlen) {
+    if (Vlen > (UINT64_MAX - Blen) / nshares) {
         ERR_raise(ERR_LIB_EVP, EVP_R_MEMORY_LIMIT_EXCEEDED);
         return 0;
     }
@@ -498,7 +792,7 @@ static int scrypt_alg(const char *pass, size_t passlen,
     if (maxmem > SIZE_MAX)
         maxmem = SIZE_MAX;
 
-    if (Blen + Vlen > maxmem) {
+    if (Blen + nshares * Vlen > maxmem) {
         ERR_raise(ERR_LIB_EVP, EVP_R_MEMORY_LIMIT_EXCEEDED);
         return 0;
     }
@@ -507,19 +801,36 @@ static int scrypt_alg(const char *pass, size_t passlen,
     if (key == NULL)
         return 1;
 
-    B = OPENSSL_malloc((size_t)(Blen + Vlen));
+    B = OPENSSL_malloc((size_t)(Blen + nshares * Vlen));
     if (B == NULL)
         return 0;
-    X = (uint32_t *)(B + Blen);
-    T = X + 32 * r;
-    V = T + 32 * r;
+    shares = OPENSSL_malloc_array((size_t)nshares, sizeof(*shares));
+    if (shares == NULL)
+        goto err;
+    for (i = 0; i < nshares; i++) {
+        shares[i].B = B;
+        shares[i].XTV = (uint32_t *)(B + Blen + i * Vlen);
+        shares[i].N = N;
+        shares[i].r = r;
+        shares[i].p = p;
+        shares[i].first = i;
+        shares[i].step = nshares;
+    }
     if (ossl_pkcs5_pbkdf2_hmac_ex(pass, (int)passlen, salt, (int)saltlen, 1,
             sha256, (int)Blen, B, libctx, propq)
         == 0)
         goto err;
 
-    for (i = 0; i < p; i++)
-        scryptROMix(B + 128 * r * i, r, N, X, T, V);
+#if !defined(SCRYPT_NO_THREADS)
+    if (nshares > 1) {
+        if (!scrypt_romix_mt(libctx, shares, (uint32_t)nshares))
+            goto err;
+    } else
+#endif
+    {
+        for (i = 0; i < nshares; i++)
+            scrypt_romix_share(&shares[i]);
+    }
 
     if (ossl_pkcs5_pbkdf2_hmac_ex(pass, (int)passlen, B, (int)Blen, 1, sha256,
             (int)keylen, key, libctx, propq)
@@ -530,7 +841,8 @@ err:
     if (rv == 0)
         ERR_raise(ERR_LIB_EVP, EVP_R_PBKDF2_ERROR);
 
-    OPENSSL_clear_free(B, (size_t)(Blen + Vlen));
+    OPENSSL_free(shares);
+    OPENSSL_clear_free(B, (size_t)(Blen + nshares * Vlen));
     return rv;
 }
 
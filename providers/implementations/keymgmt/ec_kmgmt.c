@@ -727,6 +727,11 @@ static int common_get_params(void *key, OSSL_PARAM params[], int sm2)
                 goto err;
         }
     }
+    if ((p = OSSL_PARAM_locate(params,
+             OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC))
+            != NULL
+        && !OSSL_PARAM_set_int(p, ossl_ec_key_has_public_precomp(eck)))
+        goto err;
     if ((p = OSSL_PARAM_locate(params,
              OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY))
         != NULL) {
@@ -786,6 +791,7 @@ static const OSSL_PARAM ec_known_gettable_params[] = {
     OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_DEFAULT_DIGEST, NULL, 0),
     OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY, NULL, 0),
     OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_DECODED_FROM_EXPLICIT_PARAMS, NULL),
+    OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC, NULL),
     EC_IMEXPORTABLE_DOM_PARAMETERS,
     EC2M_GETTABLE_DOM_PARAMS
         EC_IMEXPORTABLE_PUBLIC_KEY,
@@ -809,6 +815,7 @@ static const OSSL_PARAM ec_known_settable_params[] = {
     OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_EC_SEED, NULL, 0),
     OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_INCLUDE_PUBLIC, NULL),
     OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_EC_GROUP_CHECK_TYPE, NULL, 0),
+    OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC, NULL),
     OSSL_PARAM_END
 };
 
@@ -34,6 +34,8 @@ static OSSL_FUNC_keymgmt_import_types_fn ml_dsa_import_types;
 static OSSL_FUNC_keymgmt_export_types_fn ml_dsa_export_types;
 static OSSL_FUNC_keymgmt_dup_fn ml_dsa_dup_key;
 static OSSL_FUNC_keymgmt_gettable_params_fn ml_dsa_gettable_params;
+static OSSL_FUNC_keymgmt_set_params_fn ml_dsa_set_params;
+static OSSL_FUNC_keymgmt_settable_params_fn ml_dsa_settable_params;
 static OSSL_FUNC_keymgmt_validate_fn ml_dsa_validate;
 static OSSL_FUNC_keymgmt_gen_init_fn ml_dsa_gen_init;
 static OSSL_FUNC_keymgmt_gen_cleanup_fn ml_dsa_gen_cleanup;
@@ -48,6 +50,7 @@ struct ml_dsa_gen_ctx {
     char *propq;
     uint8_t entropy[32];
     size_t entropy_len;
+    int precompute;
 };
 
 #ifdef FIPS_MODULE
@@ -340,6 +343,27 @@ static const OSSL_PARAM *ml_dsa_gettable_params(void *provctx)
     return ml_dsa_get_params_list;
 }
 
+static const OSSL_PARAM *ml_dsa_settable_params(void *provctx)
+{
+    return ml_dsa_set_params_list;
+}
+
+static int ml_dsa_set_params(void *keydata, const OSSL_PARAM params[])
+{
+    ML_DSA_KEY *key = keydata;
+    struct ml_dsa_set_params_st p;
+    int precompute;
+
+    if (key == NULL || !ml_dsa_set_params_decoder(params, &p))
+        return 0;
+
+    if (p.precompute != NULL
+        && (!OSSL_PARAM_get_int(p.precompute, &precompute)
+            || !ossl_ml_dsa_key_precompute(key, precompute)))
+        return 0;
+    return 1;
+}
+
 static int ml_dsa_get_params(void *keydata, OSSL_PARAM params[])
 {
     ML_DSA_KEY *key = keydata;
@@ -519,6 +543,8 @@ static void *ml_dsa_gen(void *genctx, int evp_type)
     if (!ml_dsa_pairwise_test(key))
         goto err;
 #endif
+    if (gctx->precompute && !ossl_ml_dsa_key_precompute(key, 1))
+        goto err;
     return key;
 err:
     ossl_ml_dsa_key_free(key);
@@ -549,6 +575,10 @@ static int ml_dsa_gen_set_params(void *genctx, const OSSL_PARAM params[])
         if (!OSSL_PARAM_get_utf8_string(p.propq, &gctx->propq, 0))
             return 0;
     }
+
+    if (p.precompute != NULL
+        && !OSSL_PARAM_get_int(p.precompute, &gctx->precompute))
+        return 0;
     return 1;
 }
 
@@ -599,6 +629,8 @@ static void ml_dsa_gen_cleanup(void *genctx)
         { OSSL_FUNC_KEYMGMT_EXPORT_TYPES, (void (*)(void))ml_dsa_export_types },              \
         DISPATCH_LOAD_FN { OSSL_FUNC_KEYMGMT_GET_PARAMS, (void (*)(void))ml_dsa_get_params }, \
         { OSSL_FUNC_KEYMGMT_GETTABLE_PARAMS, (void (*)(void))ml_dsa_gettable_params },        \
+        { OSSL_FUNC_KEYMGMT_SET_PARAMS, (void (*)(void))ml_dsa_set_params },                  \
+        { OSSL_FUNC_KEYMGMT_SETTABLE_PARAMS, (void (*)(void))ml_dsa_settable_params },        \
         { OSSL_FUNC_KEYMGMT_VALIDATE, (void (*)(void))ml_dsa_validate },                      \
         { OSSL_FUNC_KEYMGMT_GEN_INIT, (void (*)(void))ml_dsa_gen_init },                      \
         { OSSL_FUNC_KEYMGMT_GEN, (void (*)(void))ml_dsa_##alg##_gen },                        \
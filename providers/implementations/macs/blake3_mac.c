@@ -0,0 +1,208 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/* The keyed hash mode of BLAKE3 */
+
+#include <string.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/proverr.h>
+#include <openssl/err.h>
+
+#include "prov/blake3.h"
+#include "internal/cryptlib.h"
+#include "prov/implementations.h"
+#include "prov/providercommon.h"
+
+#include "providers/implementations/macs/blake3_mac.inc"
+
+/*
+ * Forward declaration of everything implemented here.  This is not strictly
+ * necessary for the compiler, but provides an assurance that the signatures
+ * of the functions in the dispatch table are correct.
+ */
+static OSSL_FUNC_mac_newctx_fn blake3_mac_new;
+static OSSL_FUNC_mac_dupctx_fn blake3_mac_dup;
+static OSSL_FUNC_mac_freectx_fn blake3_mac_free;
+static OSSL_FUNC_mac_gettable_ctx_params_fn blake3_mac_gettable_ctx_params;
+static OSSL_FUNC_mac_get_ctx_params_fn blake3_mac_get_ctx_params;
+static OSSL_FUNC_mac_settable_ctx_params_fn blake3_mac_settable_ctx_params;
+static OSSL_FUNC_mac_set_ctx_params_fn blake3_mac_set_ctx_params;
+static OSSL_FUNC_mac_init_fn blake3_mac_init;
+static OSSL_FUNC_mac_update_fn blake3_mac_update;
+static OSSL_FUNC_mac_final_fn blake3_mac_final;
+
+struct blake3_mac_data_st {
+    BLAKE3_CTX ctx;
+    size_t size;
+    int key_set;
+    unsigned char key[BLAKE3_KEY_LEN];
+};
+
+static void *blake3_mac_new(void *unused_provctx)
+{
+    struct blake3_mac_data_st *macctx;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+
+    macctx = OPENSSL_zalloc(sizeof(*macctx));
+    if (macctx != NULL)
+        macctx->size = BLAKE3_OUT_LEN;
+    return macctx;
+}
+
+static void *blake3_mac_dup(void *vsrc)
+{
+    struct blake3_mac_data_st *dst;
+    struct blake3_mac_data_st *src = vsrc;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+
+    dst = OPENSSL_malloc(sizeof(*dst));
+    if (dst == NULL)
+        return NULL;
+
+    *dst = *src;
+    return dst;
+}
+
+static void blake3_mac_free(void *vmacctx)
+{
+    OPENSSL_clear_free(vmacctx, sizeof(struct blake3_mac_data_st));
+}
+
+static int blake3_setkey(struct blake3_mac_data_st *macctx,
+    const unsigned char *key, size_t keylen)
+{
+    if (keylen != BLAKE3_KEY_LEN) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+        return 0;
+    }
+    memcpy(macctx->key, key, keylen);
+    macctx->key_set = 1;
+    return 1;
+}
+
+static int blake3_mac_init(void *vmacctx, const unsigned char *key,
+    size_t keylen, const OSSL_PARAM params[])
+{
+    struct blake3_mac_data_st *macctx = vmacctx;
+
+    if (!ossl_prov_is_running() || !blake3_mac_set_ctx_params(macctx, params))
+        return 0;
+    if (key != NULL) {
+        if (!blake3_setkey(macctx, key, keylen))
+            return 0;
+    } else if (!macctx->key_set) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_NO_KEY_SET);
+        return 0;
+    }
+    ossl_blake3_init_keyed(&macctx->ctx, macctx->key);
+    return 1;
+}
+
+static int blake3_mac_update(void *vmacctx,
+    const unsigned char *data, size_t datalen)
+{
+    struct blake3_mac_data_st *macctx = vmacctx;
+
+    return ossl_blake3_update(&macctx->ctx, data, datalen);
+}
+
+static int blake3_mac_final(void *vmacctx,
+    unsigned char *out, size_t *outl,
+    size_t outsize)
+{
+    struct blake3_mac_data_st *macctx = vmacctx;
+
+    if (!ossl_prov_is_running())
+        return 0;
+    if (outsize < macctx->size)
+        return 0;
+
+    *outl = macctx->size;
+    return ossl_blake3_squeeze(&macctx->ctx, out, macctx->size);
+}
+
+static const OSSL_PARAM *blake3_mac_gettable_ctx_params(ossl_unused void *ctx,
+    ossl_unused void *provctx)
+{
+    return blake3_mac_get_ctx_params_list;
+}
+
+static int blake3_mac_get_ctx_params(void *vmacctx, OSSL_PARAM params[])
+{
+    struct blake3_mac_data_st *macctx = vmacctx;
+    struct blake3_mac_get_ctx_params_st p;
+
+    if (macctx == NULL || !blake3_mac_get_ctx_params_decoder(params, &p))
+        return 0;
+
+    if (p.size != NULL && !OSSL_PARAM_set_size_t(p.size, macctx->size))
+        return 0;
+
+    if (p.bsize != NULL && !OSSL_PARAM_set_size_t(p.bsize, BLAKE3_BLOCK_LEN))
+        return 0;
+
+    return 1;
+}
+
+static const OSSL_PARAM *blake3_mac_settable_ctx_params(
+    ossl_unused void *ctx, ossl_unused void *p_ctx)
+{
+    return blake3_mac_set_ctx_params_list;
+}
+
+/*
+ * ALL parameters should be set before init().
+ */
+static int blake3_mac_set_ctx_params(void *vmacctx, const OSSL_PARAM params[])
+{
+    struct blake3_mac_data_st *macctx = vmacctx;
+    struct blake3_mac_set_ctx_params_st p;
+
+    if (macctx == NULL || !blake3_mac_set_ctx_params_decoder(params, &p))
+        return 0;
+
+    if (p.size != NULL) {
+        size_t size;
+
+        if (!OSSL_PARAM_get_size_t(p.size, &size) || size < 1) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_NOT_XOF_OR_INVALID_LENGTH);
+            return 0;
+        }
+        macctx->size = size;
+    }
+
+    if (p.key != NULL)
+        if (p.key->data_type != OSSL_PARAM_OCTET_STRING
+            || !blake3_setkey(macctx, p.key->data, p.key->data_size))
+            return 0;
+
+    return 1;
+}
+
+const OSSL_DISPATCH ossl_blake3mac_functions[] = {
+    { OSSL_FUNC_MAC_NEWCTX, (void (*)(void))blake3_mac_new },
+    { OSSL_FUNC_MAC_DUPCTX, (void (*)(void))blake3_mac_dup },
+    { OSSL_FUNC_MAC_FREECTX, (void (*)(void))blake3_mac_free },
+    { OSSL_FUNC_MAC_INIT, (void (*)(void))blake3_mac_init },
+    { OSSL_FUNC_MAC_UPDATE, (void (*)(void))blake3_mac_update },
+    { OSSL_FUNC_MAC_FINAL, (void (*)(void))blake3_mac_final },
+    { OSSL_FUNC_MAC_GETTABLE_CTX_PARAMS,
+        (void (*)(void))blake3_mac_gettable_ctx_params },
+    { OSSL_FUNC_MAC_GET_CTX_PARAMS, (void (*)(void))blake3_mac_get_ctx_params },
+    { OSSL_FUNC_MAC_SETTABLE_CTX_PARAMS,
+        (void (*)(void))blake3_mac_settable_ctx_params },
+    { OSSL_FUNC_MAC_SET_CTX_PARAMS, (void (*)(void))blake3_mac_set_ctx_params },
+    OSSL_DISPATCH_END
+};
@@ -13,6 +13,7 @@
  */
 #include "internal/deprecated.h"
 
+#include <string.h>
 #include <openssl/core_dispatch.h>
 #include <openssl/core_names.h>
 #include <openssl/params.h>
@@ -28,8 +29,15 @@
 #include "prov/provider_util.h"
 #include "prov/providercommon.h"
 #include "crypto/cmac.h"
+#include "crypto/modes.h"
+#include "crypto/aes_platform.h"
 #include "providers/implementations/macs/cmac_prov.inc"
 
+#if defined(AES_CBC_HMAC_SHA_CAPABLE) && !defined(FIPS_MODULE)
+/* AES-CMAC of several messages at once with the interleaved CBC of aesni-mb */
+#define CMAC_AESNI_MB
+#endif
+
 /*
  * Forward declaration of everything implemented here.  This is not strictly
  * necessary for the compiler, but provides an assurance that the signatures
@@ -45,6 +53,7 @@ static OSSL_FUNC_mac_set_ctx_params_fn cmac_set_ctx_params;
 static OSSL_FUNC_mac_init_fn cmac_init;
 static OSSL_FUNC_mac_update_fn cmac_update;
 static OSSL_FUNC_mac_final_fn cmac_final;
+static OSSL_FUNC_mac_batch_fn cmac_batch;
 
 /* local CMAC data */
 
@@ -52,6 +61,15 @@ struct cmac_data_st {
     void *provctx;
     CMAC_CTX *ctx;
     PROV_CIPHER cipher;
+    /* Set when data was added since the key was set or the MAC restarted */
+    int updated;
+#ifdef CMAC_AESNI_MB
+    /* An AES-NI copy of the key and the subkeys, when the cipher is AES */
+    int mb;
+    AES_KEY ks;
+    unsigned char k1[16];
+    unsigned char k2[16];
+#endif
     OSSL_FIPS_IND_DECLARE
 };
 
@@ -81,7 +99,7 @@ static void cmac_free(void *vmacctx)
     if (macctx != NULL) {
         CMAC_CTX_free(macctx->ctx);
         ossl_prov_cipher_reset(&macctx->cipher);
-        OPENSSL_free(macctx);
+        OPENSSL_clear_free(macctx, sizeof(*macctx));
     }
 }
 
@@ -101,6 +119,13 @@ static void *cmac_dup(void *vsrc)
         cmac_free(dst);
         return NULL;
     }
+    dst->updated = src->updated;
+#ifdef CMAC_AESNI_MB
+    dst->mb = src->mb;
+    dst->ks = src->ks;
+    memcpy(dst->k1, src->k1, sizeof(dst->k1));
+    memcpy(dst->k2, src->k2, sizeof(dst->k2));
+#endif
     OSSL_FIPS_IND_COPY(dst, src)
     return dst;
 }
@@ -116,6 +141,142 @@ static size_t cmac_size(void *vmacctx)
     return EVP_CIPHER_CTX_get_block_size(cipherctx);
 }
 
+#ifdef CMAC_AESNI_MB
+typedef struct {
+    const unsigned char *inp;
+    unsigned char *out;
+    int blocks;
+    uint64_t iv[2];
+} CIPH_DESC;
+
+void aesni_multi_cbc_encrypt(CIPH_DESC *, void *, int);
+
+/* Blocks a message advances by in one call, before its chain value is read */
+#define CMAC_MB_CHUNK 32
+#define CMAC_MB_MAX_LANES 8
+
+static void cmac_mb_dbl(unsigned char *out, const unsigned char *in)
+{
+    unsigned char carry = in[0] >> 7;
+    int i;
+
+    for (i = 0; i < 15; i++)
+        out[i] = (unsigned char)((in[i] << 1) | (in[i + 1] >> 7));
+    out[15] = (unsigned char)((in[15] << 1) ^ ((0 - carry) & 0x87));
+}
+
+/* Keep an AES-NI key schedule and the subkeys when the cipher is AES-CBC */
+static void cmac_mb_setkey(struct cmac_data_st *macctx,
+    const unsigned char *key, size_t keylen)
+{
+    const EVP_CIPHER *cipher
+        = EVP_CIPHER_CTX_get0_cipher(CMAC_CTX_get0_cipher_ctx(macctx->ctx));
+    unsigned char l[16] = { 0 };
+
+    if (!AESNI_CAPABLE || cipher == NULL || keylen > 32)
+        return;
+    switch (EVP_CIPHER_get_nid(cipher)) {
+    case NID_aes_128_cbc:
+    case NID_aes_192_cbc:
+    case NID_aes_256_cbc:
+        break;
+    default:
+        return;
+    }
+    if (aesni_set_encrypt_key(key, (int)(keylen * 8), &macctx->ks) != 0)
+        return;
+    aesni_encrypt(l, l, &macctx->ks);
+    cmac_mb_dbl(macctx->k1, l);
+    cmac_mb_dbl(macctx->k2, macctx->k1);
+    OPENSSL_cleanse(l, sizeof(l));
+    macctx->mb = 1;
+}
+
+/*
+ * CMAC of up to eight messages.  The CBC of all but the last block of every
+ * message runs through aesni_multi_cbc_encrypt() in chunks, eight lanes wide
+ * with AVX and two groups of four otherwise.  The messages that still have
+ * blocks are moved to the front, as it stops at the first group of four
+ * lanes that has none.  The last blocks, already masked with a subkey, then
+ * take one more call.
+ */
+static void cmac_mb_lanes(struct cmac_data_st *macctx,
+    const unsigned char *const in[], const size_t inl[],
+    unsigned char *const out[], size_t n)
+{
+    static const unsigned char zero[16] = { 0 };
+    CIPH_DESC desc[CMAC_MB_MAX_LANES];
+    unsigned char sink[CMAC_MB_MAX_LANES][CMAC_MB_CHUNK * 16];
+    unsigned char last[CMAC_MB_MAX_LANES][16], cv[CMAC_MB_MAX_LANES][16];
+    const unsigned char *p[CMAC_MB_MAX_LANES];
+    size_t left[CMAC_MB_MAX_LANES], lane[CMAC_MB_MAX_LANES];
+    size_t i, j, a, off, rem;
+
+    for (i = 0; i < n; i++) {
+        left[i] = inl[i] == 0 ? 0 : (inl[i] - 1) / 16;
+        off = 16 * left[i];
+        rem = inl[i] - off;
+        p[i] = in[i];
+        memset(cv[i], 0, 16);
+        if (rem == 16) {
+            for (j = 0; j < 16; j++)
+                last[i][j] = in[i][off + j] ^ macctx->k1[j];
+        } else {
+            memset(last[i], 0, 16);
+            if (rem > 0)
+                memcpy(last[i], in[i] + off, rem);
+            last[i][rem] = 0x80;
+            for (j = 0; j < 16; j++)
+                last[i][j] ^= macctx->k2[j];
+        }
+    }
+
+    for (;;) {
+        for (i = 0, a = 0; i < n; i++) {
+            if (left[i] == 0)
+                continue;
+            desc[a].inp = p[i];
+            desc[a].out = sink[a];
+            desc[a].blocks = (int)(left[i] < CMAC_MB_CHUNK
+                    ? left[i]
+                    : CMAC_MB_CHUNK);
+            memcpy(desc[a].iv, cv[i], 16);
+            lane[a++] = i;
+        }
+        if (a == 0)
+            break;
+        for (i = a; i < CMAC_MB_MAX_LANES; i++) {
+            desc[i].inp = zero;
+            desc[i].out = sink[i];
+            desc[i].blocks = 0;
+        }
+        aesni_multi_cbc_encrypt(desc, &macctx->ks, a > 4 ? 2 : 1);
+        for (j = 0; j < a; j++) {
+            i = lane[j];
+            memcpy(cv[i], sink[j] + 16 * (desc[j].blocks - 1), 16);
+            p[i] += 16 * (size_t)desc[j].blocks;
+            left[i] -= desc[j].blocks;
+        }
+    }
+
+    for (i = 0; i < CMAC_MB_MAX_LANES; i++) {
+        desc[i].inp = i < n ? last[i] : zero;
+        desc[i].out = sink[i];
+        desc[i].blocks = i < n ? 1 : 0;
+        if (i < n)
+            memcpy(desc[i].iv, cv[i], 16);
+    }
+    aesni_multi_cbc_encrypt(desc, &macctx->ks, n > 4 ? 2 : 1);
+    for (i = 0; i < n; i++)
+        memcpy(out[i], sink[i], 16);
+
+    OPENSSL_cleanse(sink, sizeof(sink));
+    OPENSSL_cleanse(last, sizeof(last));
+    OPENSSL_cleanse(cv, sizeof(cv));
+    OPENSSL_cleanse(desc, sizeof(desc));
+}
+#endif /* CMAC_AESNI_MB */
+
 #ifdef FIPS_MODULE
 /*
  * TDES Encryption is not approved in FIPS 140-3.
@@ -161,10 +322,18 @@ static int cmac_setkey(struct cmac_data_st *macctx,
         return 0;
     if (state != OSSL_FIPS_IND_STATE_UNKNOWN)
         p = prms;
+#endif
+#ifdef CMAC_AESNI_MB
+    macctx->mb = 0;
 #endif
     rv = ossl_cmac_init(macctx->ctx, key, keylen,
         ossl_prov_cipher_cipher(&macctx->cipher), p);
     ossl_prov_cipher_reset(&macctx->cipher);
+    macctx->updated = 0;
+#ifdef CMAC_AESNI_MB
+    if (rv)
+        cmac_mb_setkey(macctx, key, keylen);
+#endif
     return rv;
 }
 
@@ -178,6 +347,7 @@ static int cmac_init(void *vmacctx, const unsigned char *key,
     if (key != NULL)
         return cmac_setkey(macctx, key, keylen);
     /* Reinitialize the CMAC context */
+    macctx->updated = 0;
     return CMAC_Init(macctx->ctx, NULL, 0, NULL, NULL);
 }
 
@@ -186,6 +356,8 @@ static int cmac_update(void *vmacctx, const unsigned char *data,
 {
     struct cmac_data_st *macctx = vmacctx;
 
+    if (datalen > 0)
+        macctx->updated = 1;
     return CMAC_Update(macctx->ctx, data, datalen);
 }
 
@@ -200,6 +372,41 @@ static int cmac_final(void *vmacctx, unsigned char *out, size_t *outl,
     return CMAC_Final(macctx->ctx, out, outl);
 }
 
+static int cmac_batch(void *vmacctx, const unsigned char *const in[],
+    const size_t inl[], unsigned char *const out[], size_t outsize, size_t n)
+{
+    struct cmac_data_st *macctx = vmacctx;
+    CMAC_CTX *tmp;
+    size_t i, l;
+    int ret = 1;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (outsize < cmac_size(macctx)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+
+#ifdef CMAC_AESNI_MB
+    if (macctx->mb && !macctx->updated) {
+        for (i = 0; i < n; i += CMAC_MB_MAX_LANES)
+            cmac_mb_lanes(macctx, in + i, inl + i, out + i,
+                n - i < CMAC_MB_MAX_LANES ? n - i : CMAC_MB_MAX_LANES);
+        return 1;
+    }
+#endif
+
+    if ((tmp = CMAC_CTX_new()) == NULL)
+        return 0;
+    for (i = 0; i < n && ret; i++)
+        ret = CMAC_CTX_copy(tmp, macctx->ctx)
+            && CMAC_Update(tmp, in[i], inl[i])
+            && CMAC_Final(tmp, out[i], &l);
+    CMAC_CTX_free(tmp);
+    return ret;
+}
+
 static const OSSL_PARAM *cmac_gettable_ctx_params(ossl_unused void *ctx,
     ossl_unused void *provctx)
 {
@@ -288,6 +495,7 @@ const OSSL_DISPATCH ossl_cmac_functions[] = {
     { OSSL_FUNC_MAC_INIT, (void (*)(void))cmac_init },
     { OSSL_FUNC_MAC_UPDATE, (void (*)(void))cmac_update },
     { OSSL_FUNC_MAC_FINAL, (void (*)(void))cmac_final },
+    { OSSL_FUNC_MAC_BATCH, (void (*)(void))cmac_batch },
     { OSSL_FUNC_MAC_GETTABLE_CTX_PARAMS,
         (void (*)(void))cmac_gettable_ctx_params },
     { OSSL_FUNC_MAC_GET_CTX_PARAMS, (void (*)(void))cmac_get_ctx_params },
@@ -79,6 +79,7 @@ static OSSL_FUNC_signature_sign_fn ed25519_sign;
 static OSSL_FUNC_signature_sign_fn ed448_sign;
 static OSSL_FUNC_signature_verify_fn ed25519_verify;
 static OSSL_FUNC_signature_verify_fn ed448_verify;
+static OSSL_FUNC_signature_verify_message_batch_fn ed25519_verify_message_batch;
 static OSSL_FUNC_signature_digest_sign_init_fn ed25519_digest_signverify_init;
 static OSSL_FUNC_signature_digest_sign_init_fn ed448_digest_signverify_init;
 static OSSL_FUNC_signature_digest_sign_fn ed25519_digest_sign;
@@ -653,6 +654,85 @@ static int ed25519_verify(void *vpeddsactx,
         peddsactx->libctx, edkey->propq);
 }
 
+static int ed25519_verify_message_batch(void *vpeddsactx,
+    const unsigned char *const sigs[], const size_t siglens[],
+    const unsigned char *const tbs[], const size_t tbslens[],
+    int results[], size_t n)
+{
+    PROV_EDDSA_CTX *peddsactx = (PROV_EDDSA_CTX *)vpeddsactx;
+    const ECX_KEY *edkey = peddsactx->key;
+    const unsigned char **mds = NULL;
+    unsigned char *md = NULL;
+    size_t i, mdlen, *mdlens = NULL;
+    int ret = 0;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+#ifdef S390X_EC_ASM
+    /* See ed25519_verify() */
+    if (S390X_CAN_SIGN(ED25519)
+        && !peddsactx->dom2_flag
+        && !peddsactx->context_string_flag
+        && peddsactx->context_string_len == 0
+        && !peddsactx->prehash_flag
+        && !peddsactx->prehash_by_caller_flag) {
+        for (i = 0; i < n; i++)
+            results[i] = siglens[i] == ED25519_SIGSIZE
+                && s390x_ed25519_digestverify(edkey, sigs[i], tbs[i],
+                    tbslens[i]);
+        return 1;
+    }
+#endif /* S390X_EC_ASM */
+
+    if (peddsactx->prehash_flag) {
+        mds = OPENSSL_malloc_array(n, sizeof(*mds));
+        mdlens = OPENSSL_malloc_array(n, sizeof(*mdlens));
+        md = OPENSSL_malloc_array(n, EDDSA_PREHASH_OUTPUT_LEN);
+        if (n > 0 && (mds == NULL || mdlens == NULL || md == NULL))
+            goto err;
+        for (i = 0; i < n; i++) {
+            if (peddsactx->prehash_by_caller_flag) {
+                /* A digest of the wrong length is a bad signature */
+                mds[i] = tbs[i];
+                mdlens[i] = tbslens[i];
+                continue;
+            }
+            mds[i] = md + i * EDDSA_PREHASH_OUTPUT_LEN;
+            if (!EVP_Q_digest(peddsactx->libctx, SN_sha512, NULL,
+                    tbs[i], tbslens[i], md + i * EDDSA_PREHASH_OUTPUT_LEN,
+                    &mdlen)
+                || mdlen != EDDSA_PREHASH_OUTPUT_LEN) {
+                ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_PREHASHED_DIGEST_LENGTH);
+                goto err;
+            }
+            mdlens[i] = mdlen;
+        }
+        tbs = mds;
+        tbslens = mdlens;
+    } else if (peddsactx->prehash_by_caller_flag) {
+        /* The caller is supposed to set up a ph instance! */
+        ERR_raise(ERR_LIB_PROV,
+            PROV_R_INVALID_EDDSA_INSTANCE_FOR_ATTEMPTED_OPERATION);
+        return 0;
+    }
+
+    ret = ossl_ed25519_verify_batch(tbs, tbslens, sigs, siglens, edkey->pubkey,
+        peddsactx->dom2_flag, peddsactx->prehash_flag,
+        peddsactx->context_string_flag,
+        peddsactx->context_string, peddsactx->context_string_len,
+        results, n, peddsactx->libctx, edkey->propq);
+    if (peddsactx->prehash_flag && peddsactx->prehash_by_caller_flag)
+        for (i = 0; i < n; i++)
+            if (tbslens[i] != EDDSA_PREHASH_OUTPUT_LEN)
+                results[i] = 0;
+err:
+    OPENSSL_free(mds);
+    OPENSSL_free(mdlens);
+    OPENSSL_free(md);
+    return ret;
+}
+
 /*
  * This is used directly for OSSL_FUNC_SIGNATURE_VERIFY and indirectly
  * for OSSL_FUNC_SIGNATURE_DIGEST_VERIFY
@@ -989,6 +1069,8 @@ static int eddsa_set_variant_ctx_params(void *vpeddsactx,
             (void (*)(void))ed25519_digest_signverify_init }, \
         { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY,                  \
             (void (*)(void))ed25519_digest_verify },          \
+        { OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_BATCH,           \
+            (void (*)(void))ed25519_verify_message_batch },   \
         { OSSL_FUNC_SIGNATURE_GET_CTX_PARAMS,                 \
             (void (*)(void))eddsa_get_ctx_params },           \
         { OSSL_FUNC_SIGNATURE_GETTABLE_CTX_PARAMS,            \
@@ -1014,14 +1096,19 @@ static int eddsa_set_variant_ctx_params(void *vpeddsactx,
             (void (*)(void))eddsa_settable_variant_ctx_params }, \
         OSSL_DISPATCH_END
 
-#define ed25519ph_DISPATCH_END                           \
-    { OSSL_FUNC_SIGNATURE_SIGN_INIT,                     \
-        (void (*)(void))ed25519ph_signverify_init },     \
-        { OSSL_FUNC_SIGNATURE_VERIFY_INIT,               \
-            (void (*)(void))ed25519ph_signverify_init }, \
+#define ed25519ph_DISPATCH_END                              \
+    { OSSL_FUNC_SIGNATURE_SIGN_INIT,                        \
+        (void (*)(void))ed25519ph_signverify_init },        \
+        { OSSL_FUNC_SIGNATURE_VERIFY_INIT,                  \
+            (void (*)(void))ed25519ph_signverify_init },    \
+        { OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_BATCH,         \
+            (void (*)(void))ed25519_verify_message_batch }, \
         eddsa_variant_DISPATCH_END(ed25519ph)
 
-#define ed25519ctx_DISPATCH_END eddsa_variant_DISPATCH_END(ed25519ctx)
+#define ed25519ctx_DISPATCH_END                         \
+    { OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_BATCH,         \
+        (void (*)(void))ed25519_verify_message_batch }, \
+        eddsa_variant_DISPATCH_END(ed25519ctx)
 
 #define ed448_DISPATCH_END                                  \
     { OSSL_FUNC_SIGNATURE_SIGN_INIT,                        \
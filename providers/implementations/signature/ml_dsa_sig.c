@@ -41,6 +41,7 @@ static OSSL_FUNC_signature_verify_message_init_fn ml_dsa_verify_msg_init;
 static OSSL_FUNC_signature_verify_message_update_fn ml_dsa_signverify_msg_update;
 static OSSL_FUNC_signature_verify_message_final_fn ml_dsa_verify_msg_final;
 static OSSL_FUNC_signature_verify_fn ml_dsa_verify;
+static OSSL_FUNC_signature_verify_message_batch_fn ml_dsa_verify_msg_batch;
 static OSSL_FUNC_signature_digest_sign_init_fn ml_dsa_digest_signverify_init;
 static OSSL_FUNC_signature_digest_sign_fn ml_dsa_digest_sign;
 static OSSL_FUNC_signature_digest_verify_fn ml_dsa_digest_verify;
@@ -363,6 +364,21 @@ static int ml_dsa_verify(void *vctx, const uint8_t *sig, size_t siglen,
         ctx->context_string, ctx->context_string_len,
         ctx->msg_encode, sig, siglen);
 }
+
+static int ml_dsa_verify_msg_batch(void *vctx,
+    const uint8_t *const sigs[], const size_t siglens[],
+    const uint8_t *const msgs[], const size_t msg_lens[],
+    int results[], size_t n)
+{
+    PROV_ML_DSA_CTX *ctx = (PROV_ML_DSA_CTX *)vctx;
+
+    if (!ossl_prov_is_running())
+        return 0;
+    return ossl_ml_dsa_verify_batch(ctx->key, ctx->mu, msgs, msg_lens,
+        ctx->context_string, ctx->context_string_len,
+        ctx->msg_encode, sigs, siglens, results, n);
+}
+
 static int ml_dsa_digest_verify(void *vctx,
     const uint8_t *sig, size_t siglen,
     const uint8_t *tbs, size_t tbslen)
@@ -484,6 +500,8 @@ static int ml_dsa_get_ctx_params(void *vctx, OSSL_PARAM *params)
         { OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_FINAL,                            \
             (void (*)(void))ml_dsa_verify_msg_final },                         \
         { OSSL_FUNC_SIGNATURE_VERIFY, (void (*)(void))ml_dsa_verify },         \
+        { OSSL_FUNC_SIGNATURE_VERIFY_MESSAGE_BATCH,                            \
+            (void (*)(void))ml_dsa_verify_msg_batch },                         \
         { OSSL_FUNC_SIGNATURE_DIGEST_SIGN_INIT,                                \
             (void (*)(void))ml_dsa_digest_signverify_init },                   \
         { OSSL_FUNC_SIGNATURE_DIGEST_SIGN,                                     \
@@ -679,6 +679,39 @@ static int rsa_sign_init(void *vprsactx, void *vrsa, const OSSL_PARAM params[])
         EVP_PKEY_OP_SIGN, "RSA Sign Init");
 }
 
+/* Check PSS restrictions */
+static int rsa_pss_check_restrictions(PROV_RSA_CTX *prsactx)
+{
+    if (rsa_pss_restricted(prsactx)) {
+        switch (prsactx->saltlen) {
+        case RSA_PSS_SALTLEN_DIGEST:
+            if (prsactx->min_saltlen > EVP_MD_get_size(prsactx->md)) {
+                ERR_raise_data(ERR_LIB_PROV,
+                    PROV_R_PSS_SALTLEN_TOO_SMALL,
+                    "minimum salt length set to %d, "
+                    "but the digest only gives %d",
+                    prsactx->min_saltlen,
+                    EVP_MD_get_size(prsactx->md));
+                return 0;
+            }
+            /* FALLTHRU */
+        default:
+            if (prsactx->saltlen >= 0
+                && prsactx->saltlen < prsactx->min_saltlen) {
+                ERR_raise_data(ERR_LIB_PROV,
+                    PROV_R_PSS_SALTLEN_TOO_SMALL,
+                    "minimum salt length set to %d, but the"
+                    "actual salt length is only set to %d",
+                    prsactx->min_saltlen,
+                    prsactx->saltlen);
+                return 0;
+            }
+            break;
+        }
+    }
+    return 1;
+}
+
 /*
  * Sign tbs without digesting it first.  This is suitable for "primitive"
  * signing and signing the digest of a message, i.e. should be used with
@@ -765,34 +798,8 @@ static int rsa_sign_directly(PROV_RSA_CTX *prsactx,
         case RSA_PKCS1_PSS_PADDING: {
             int saltlen;
 
-            /* Check PSS restrictions */
-            if (rsa_pss_restricted(prsactx)) {
-                switch (prsactx->saltlen) {
-                case RSA_PSS_SALTLEN_DIGEST:
-                    if (prsactx->min_saltlen > EVP_MD_get_size(prsactx->md)) {
-                        ERR_raise_data(ERR_LIB_PROV,
-                            PROV_R_PSS_SALTLEN_TOO_SMALL,
-                            "minimum salt length set to %d, "
-                            "but the digest only gives %d",
-                            prsactx->min_saltlen,
-                            EVP_MD_get_size(prsactx->md));
-                        return 0;
-                    }
-                    /* FALLTHRU */
-                default:
-                    if (prsactx->saltlen >= 0
-                        && prsactx->saltlen < prsactx->min_saltlen) {
-                        ERR_raise_data(ERR_LIB_PROV,
-                            PROV_R_PSS_SALTLEN_TOO_SMALL,
-                            "minimum salt length set to %d, but the"
-                            "actual salt length is only set to %d",
-                            prsactx->min_saltlen,
-                            prsactx->saltlen);
-                        return 0;
-                    }
-                    break;
-                }
-            }
+            if (!rsa_pss_check_restrictions(prsactx))
+                return 0;
             if (!setup_tbuf(prsactx))
                 return 0;
             saltlen = prsactx->saltlen;
@@ -834,6 +841,136 @@ end:
     return 1;
 }
 
+/*
+ * Sign several digests with the same key.  The PKCS#1 v1.5 and PSS encodings
+ * are made here, and the private key operations of all the inputs are then
+ * done together by ossl_rsa_private_encrypt_batch().  The cases that
+ * rsa_sign_directly() hands to special functions are signed one at a time.
+ */
+static int rsa_sign_batch(void *vprsactx, unsigned char *const sigs[],
+    size_t siglens[], const unsigned char *const tbs[],
+    const size_t tbslens[], size_t n)
+{
+    PROV_RSA_CTX *prsactx = (PROV_RSA_CTX *)vprsactx;
+    size_t rsasize, mdsize, prefixlen = 0, i;
+    const unsigned char *prefix = NULL;
+    const unsigned char **from = NULL;
+    unsigned char *enc = NULL;
+    size_t *flen = NULL, enclen = 0;
+    int padding, saltlen, ret = 0;
+
+    if (!ossl_prov_is_running() || prsactx == NULL)
+        return 0;
+    if (prsactx->operation != EVP_PKEY_OP_SIGN) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_NOT_SUPPORTED);
+        return 0;
+    }
+    if (n == 0)
+        return 1;
+
+    rsasize = RSA_size(prsactx->rsa);
+    mdsize = rsa_get_md_size(prsactx);
+    padding = prsactx->pad_mode;
+    if (mdsize != 0
+        && (padding == RSA_X931_PADDING
+            || prsactx->mdnid == NID_md5_sha1
+#ifndef FIPS_MODULE
+            || EVP_MD_is_a(prsactx->md, OSSL_DIGEST_NAME_MDC2)
+#endif
+            )) {
+        for (i = 0; i < n; i++)
+            if (!rsa_sign_directly(prsactx, sigs[i], &siglens[i], siglens[i],
+                    tbs[i], tbslens[i]))
+                return 0;
+        return 1;
+    }
+
+    for (i = 0; i < n; i++) {
+        if (siglens[i] < rsasize) {
+            ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_SIGNATURE_SIZE,
+                "is %zu, should be at least %zu", siglens[i], rsasize);
+            return 0;
+        }
+        if (mdsize != 0 && tbslens[i] != mdsize) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_DIGEST_LENGTH);
+            return 0;
+        }
+    }
+
+    from = OPENSSL_malloc_array(n, sizeof(*from));
+    flen = OPENSSL_malloc_array(n, sizeof(*flen));
+    if (from == NULL || flen == NULL)
+        goto end;
+
+    if (mdsize == 0) {
+        for (i = 0; i < n; i++) {
+            from[i] = tbs[i];
+            flen[i] = tbslens[i];
+        }
+    } else {
+        switch (padding) {
+        case RSA_PKCS1_PADDING:
+            prefix = ossl_rsa_digestinfo_encoding(prsactx->mdnid, &prefixlen);
+            if (prefix == NULL) {
+                ERR_raise(ERR_LIB_PROV, ERR_R_RSA_LIB);
+                goto end;
+            }
+            enclen = prefixlen + mdsize;
+            break;
+        case RSA_PKCS1_PSS_PADDING:
+            if (!rsa_pss_check_restrictions(prsactx))
+                goto end;
+            enclen = rsasize;
+            padding = RSA_NO_PADDING;
+            break;
+        default:
+            ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_PADDING_MODE,
+                "Only X.931, PKCS#1 v1.5 or PSS padding allowed");
+            goto end;
+        }
+        if ((enc = OPENSSL_malloc_array(n, enclen)) == NULL)
+            goto end;
+
+        for (i = 0; i < n; i++) {
+            unsigned char *p = enc + i * enclen;
+
+            if (prefix != NULL) {
+                /* The DigestInfo, without the padding */
+                memcpy(p, prefix, prefixlen);
+                memcpy(p + prefixlen, tbs[i], mdsize);
+            } else {
+                saltlen = prsactx->saltlen;
+                if (!ossl_rsa_padding_add_PKCS1_PSS_mgf1(prsactx->rsa, p,
+                        tbs[i], prsactx->md, prsactx->mgf1_md, &saltlen)) {
+                    ERR_raise(ERR_LIB_PROV, ERR_R_RSA_LIB);
+                    goto end;
+                }
+#ifdef FIPS_MODULE
+                if (!rsa_pss_saltlen_check_passed(prsactx, "RSA Sign",
+                        saltlen))
+                    goto end;
+#endif
+            }
+            from[i] = p;
+            flen[i] = enclen;
+        }
+    }
+
+    if (!ossl_rsa_private_encrypt_batch(prsactx->rsa, n, from, flen, sigs,
+            padding)) {
+        ERR_raise(ERR_LIB_PROV, ERR_R_RSA_LIB);
+        goto end;
+    }
+    for (i = 0; i < n; i++)
+        siglens[i] = rsasize;
+    ret = 1;
+end:
+    OPENSSL_clear_free(enc, n * enclen);
+    OPENSSL_free(flen);
+    OPENSSL_free(from);
+    return ret;
+}
+
 static int rsa_signverify_message_update(void *vprsactx,
     const unsigned char *data,
     size_t datalen)
@@ -1832,6 +1969,7 @@ const OSSL_DISPATCH ossl_rsa_signature_functions[] = {
     { OSSL_FUNC_SIGNATURE_NEWCTX, (void (*)(void))rsa_newctx },
     { OSSL_FUNC_SIGNATURE_SIGN_INIT, (void (*)(void))rsa_sign_init },
     { OSSL_FUNC_SIGNATURE_SIGN, (void (*)(void))rsa_sign },
+    { OSSL_FUNC_SIGNATURE_SIGN_BATCH, (void (*)(void))rsa_sign_batch },
     { OSSL_FUNC_SIGNATURE_VERIFY_INIT, (void (*)(void))rsa_verify_init },
     { OSSL_FUNC_SIGNATURE_VERIFY, (void (*)(void))rsa_verify },
     { OSSL_FUNC_SIGNATURE_VERIFY_RECOVER_INIT,
@@ -66,6 +66,7 @@ typedef struct {
     size_t add_random_len;
     int msg_encode;
     int deterministic;
+    uint32_t threads;
     OSSL_LIB_CTX *libctx;
     char *propq;
     const char *alg;
@@ -183,6 +184,7 @@ static int slh_dsa_signverify_msg_init(void *vctx, void *vkey,
         ctx->hash_ctx = ossl_slh_dsa_hash_ctx_new(key);
         if (ctx->hash_ctx == NULL)
             return 0;
+        ossl_slh_dsa_hash_ctx_set_threads(ctx->hash_ctx, ctx->threads);
         ctx->key = vkey;
     }
 
@@ -311,6 +313,13 @@ static int slh_dsa_set_ctx_params(void *vctx, const OSSL_PARAM params[])
 
     if (p.msgenc != NULL && !OSSL_PARAM_get_int(p.msgenc, &pctx->msg_encode))
         return 0;
+
+    if (p.threads != NULL) {
+        if (!OSSL_PARAM_get_uint32(p.threads, &pctx->threads))
+            return 0;
+        if (pctx->hash_ctx != NULL)
+            ossl_slh_dsa_hash_ctx_set_threads(pctx->hash_ctx, pctx->threads);
+    }
     return 1;
 }
 
@@ -5396,6 +5396,9 @@ EVP_PKEY *ssl_generate_pkey_group(SSL_CONNECTION *s, uint16_t id)
         goto err;
     }
 
+    if ((pkey = ssl_keyshare_pool_take(sctx, id)) != NULL)
+        return pkey;
+
     pctx = EVP_PKEY_CTX_new_from_name(sctx->libctx, ginf->algorithm,
         sctx->propq);
 
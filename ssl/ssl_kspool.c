@@ -0,0 +1,448 @@
+/*
+ * Copyright 2026 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * A per SSL_CTX pool of pre-generated key share keys, so that the (possibly
+ * hybrid) key generation does not have to happen while constructing the
+ * ClientHello.
+ *
+ * Every key is handed out at most once: ssl_keyshare_pool_take() removes it
+ * from the pool and from then on it is owned by the connection, which frees
+ * it like any key it generated itself.  Keys are never returned to the pool.
+ */
+
+#include <openssl/evp.h>
+#include <openssl/thread.h>
+#include "internal/thread_arch.h"
+#include "internal/thread_once.h"
+#include "ssl_local.h"
+
+#ifdef OPENSSL_SYS_UNIX
+#include <unistd.h>
+#endif
+
+#if defined(OPENSSL_THREADS) && defined(OPENSSL_SYS_UNIX)
+#include <pthread.h>
+
+/*
+ * Counts the fork() calls in the history of this process, so that telling
+ * whether the pool is from the parent does not take a getpid() every time a
+ * key is taken.  It is only written in the child, before any other thread
+ * exists there.
+ */
+static long keyshare_pool_forks = 0;
+static int keyshare_pool_atfork = 0;
+static CRYPTO_ONCE keyshare_pool_fork_once = CRYPTO_ONCE_STATIC_INIT;
+
+static void keyshare_pool_fork_child(void)
+{
+    keyshare_pool_forks++;
+}
+
+DEFINE_RUN_ONCE_STATIC(keyshare_pool_fork_init)
+{
+    keyshare_pool_atfork
+        = pthread_atfork(NULL, NULL, keyshare_pool_fork_child) == 0;
+    return 1;
+}
+
+static int keyshare_pool_fork_setup(void)
+{
+    return RUN_ONCE(&keyshare_pool_fork_once, keyshare_pool_fork_init);
+}
+
+static long keyshare_pool_fork_id(void)
+{
+    return keyshare_pool_atfork ? keyshare_pool_forks
+                                : (long)getpid();
+}
+#elif defined(OPENSSL_SYS_UNIX)
+#define keyshare_pool_fork_setup() 1
+#define keyshare_pool_fork_id() ((long)getpid())
+#else
+#define keyshare_pool_fork_setup() 1
+#define keyshare_pool_fork_id() 0L
+#endif
+
+typedef struct {
+    uint16_t group_id;
+    /*
+     * Copied from the TLS_GROUP_INFO of the SSL_CTX when the group is added,
+     * so that the refill thread does not look at the SSL_CTX groups.
+     */
+    char *algorithm;
+    char *realname;
+    size_t num; /* Number of keys in |keys| */
+    EVP_PKEY **keys; /* Room for at least |size| keys of the pool */
+} KEYSHARE_POOL_GROUP;
+
+struct ssl_keyshare_pool_st {
+    CRYPTO_RWLOCK *lock;
+    /* The number of keys to keep per group, 0 if the pool is disabled */
+    size_t size;
+    KEYSHARE_POOL_GROUP groups[OPENSSL_CLIENT_MAX_KEY_SHARES];
+    size_t num_groups;
+    /* The process the keys were generated in */
+    long fork_id;
+#ifndef OPENSSL_NO_THREAD_POOL
+    CRYPTO_THREAD *refill; /* The last background refill thread started */
+    int refilling; /* Set while |refill| is still generating keys */
+    int teardown;
+#endif
+};
+
+/* Like ssl_generate_pkey_group(), but without a connection */
+static EVP_PKEY *keyshare_pool_generate(SSL_CTX *ctx, const char *algorithm,
+    const char *realname)
+{
+    EVP_PKEY_CTX *pctx = NULL;
+    EVP_PKEY *pkey = NULL;
+
+    pctx = EVP_PKEY_CTX_new_from_name(ctx->libctx, algorithm, ctx->propq);
+    if (pctx == NULL
+        || EVP_PKEY_keygen_init(pctx) <= 0
+        || EVP_PKEY_CTX_set_group_name(pctx, realname) <= 0
+        || EVP_PKEY_keygen(pctx, &pkey) <= 0) {
+        EVP_PKEY_free(pkey);
+        pkey = NULL;
+    }
+    EVP_PKEY_CTX_free(pctx);
+    return pkey;
+}
+
+static void keyshare_pool_group_clear(KEYSHARE_POOL_GROUP *g)
+{
+    while (g->num > 0) {
+        EVP_PKEY_free(g->keys[--g->num]);
+        g->keys[g->num] = NULL;
+    }
+}
+
+static KEYSHARE_POOL_GROUP *keyshare_pool_find(SSL_KEYSHARE_POOL *pool,
+    uint16_t id)
+{
+    size_t i;
+
+    for (i = 0; i < pool->num_groups; i++)
+        if (pool->groups[i].group_id == id)
+            return &pool->groups[i];
+    return NULL;
+}
+
+/*
+ * Called with the pool lock held, |ginf| comes from the SSL_CTX of the
+ * calling thread.
+ */
+static KEYSHARE_POOL_GROUP *keyshare_pool_add(SSL_KEYSHARE_POOL *pool,
+    const TLS_GROUP_INFO *ginf)
+{
+    KEYSHARE_POOL_GROUP *g = keyshare_pool_find(pool, ginf->group_id);
+
+    if (g != NULL)
+        return g;
+    if (pool->num_groups == OSSL_NELEM(pool->groups))
+        return NULL;
+
+    g = &pool->groups[pool->num_groups];
+    g->keys = OPENSSL_calloc(pool->size, sizeof(*g->keys));
+    g->algorithm = OPENSSL_strdup(ginf->algorithm);
+    g->realname = OPENSSL_strdup(ginf->realname);
+    if (g->keys == NULL || g->algorithm == NULL || g->realname == NULL) {
+        OPENSSL_free(g->keys);
+        OPENSSL_free(g->algorithm);
+        OPENSSL_free(g->realname);
+        memset(g, 0, sizeof(*g));
+        return NULL;
+    }
+    g->group_id = ginf->group_id;
+    g->num = 0;
+    pool->num_groups++;
+    return g;
+}
+
+/*
+ * Called with the pool lock held.  Keys generated before a fork() must not be
+ * used by both the parent and the child, so the child discards them.
+ */
+static void keyshare_pool_check_fork(SSL_KEYSHARE_POOL *pool)
+{
+    long fork_id = keyshare_pool_fork_id();
+    size_t i;
+
+    if (pool->fork_id == fork_id)
+        return;
+
+    for (i = 0; i < pool->num_groups; i++)
+        keyshare_pool_group_clear(&pool->groups[i]);
+    pool->fork_id = fork_id;
+#ifndef OPENSSL_NO_THREAD_POOL
+    /* The refill thread of the parent does not exist here */
+    pool->refill = NULL;
+    pool->refilling = 0;
+#endif
+}
+
+/*
+ * Generate one key for a group of the pool that is not full.  Returns 1 if a
+ * key was added, 0 if the pool is full and -1 on error.
+ */
+static int keyshare_pool_refill_one(SSL_CTX *ctx)
+{
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+    KEYSHARE_POOL_GROUP *g = NULL;
+    EVP_PKEY *pkey;
+    uint16_t id = 0;
+    size_t i;
+    int ret = 0;
+
+    if (!CRYPTO_THREAD_write_lock(pool->lock))
+        return -1;
+    keyshare_pool_check_fork(pool);
+#ifndef OPENSSL_NO_THREAD_POOL
+    if (!pool->teardown)
+#endif
+        for (i = 0; i < pool->num_groups; i++) {
+            if (pool->groups[i].num < pool->size) {
+                g = &pool->groups[i];
+                id = g->group_id;
+                break;
+            }
+        }
+    CRYPTO_THREAD_unlock(pool->lock);
+    if (g == NULL)
+        return 0;
+
+    /*
+     * The lock is not held while generating the key.  Groups are never
+     * removed from the pool before ssl_keyshare_pool_free() has joined this
+     * thread, so the names of |g| stay valid.
+     */
+    if ((pkey = keyshare_pool_generate(ctx, g->algorithm, g->realname)) == NULL)
+        return -1;
+
+    if (!CRYPTO_THREAD_write_lock(pool->lock)) {
+        EVP_PKEY_free(pkey);
+        return -1;
+    }
+    g = keyshare_pool_find(pool, id);
+    if (g != NULL && g->num < pool->size) {
+        g->keys[g->num++] = pkey;
+        pkey = NULL;
+        ret = 1;
+    }
+    CRYPTO_THREAD_unlock(pool->lock);
+    EVP_PKEY_free(pkey);
+    return ret;
+}
+
+#ifndef OPENSSL_NO_THREAD_POOL
+static CRYPTO_THREAD_RETVAL keyshare_pool_refill_main(void *arg)
+{
+    SSL_CTX *ctx = arg;
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+
+    while (keyshare_pool_refill_one(ctx) > 0)
+        continue;
+
+    if (CRYPTO_THREAD_write_lock(pool->lock)) {
+        pool->refilling = 0;
+        CRYPTO_THREAD_unlock(pool->lock);
+    }
+    return 0;
+}
+
+static void keyshare_pool_reap(SSL_KEYSHARE_POOL *pool)
+{
+    CRYPTO_THREAD_RETVAL rv;
+
+    if (pool->refill != NULL) {
+        ossl_crypto_thread_native_join(pool->refill, &rv);
+        ossl_crypto_thread_native_clean(pool->refill);
+        pool->refill = NULL;
+    }
+}
+#endif
+
+/*
+ * Called with the pool lock held.  The refill runs in the background if the
+ * application allows the library context to use threads (see
+ * OSSL_set_max_threads(3)), otherwise it is left to
+ * SSL_CTX_fill_keyshare_pool().
+ */
+static void keyshare_pool_start_refill(SSL_CTX *ctx)
+{
+#ifndef OPENSSL_NO_THREAD_POOL
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+
+    if (pool->refilling || pool->teardown
+        || OSSL_get_max_threads(ctx->libctx) == 0)
+        return;
+
+    /* The previous refill thread no longer takes the lock, join it */
+    keyshare_pool_reap(pool);
+    pool->refilling = 1;
+    pool->refill = ossl_crypto_thread_native_start(keyshare_pool_refill_main,
+        ctx, /*joinable=*/1);
+    if (pool->refill == NULL)
+        pool->refilling = 0;
+#endif
+}
+
+/*
+ * Take a pre-generated key for the group |id| out of the pool of |ctx|, or
+ * return NULL if there is none.  Groups that are asked for are added to the
+ * pool, so that they are available for later connections.
+ */
+EVP_PKEY *ssl_keyshare_pool_take(SSL_CTX *ctx, uint16_t id)
+{
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+    const TLS_GROUP_INFO *ginf;
+    KEYSHARE_POOL_GROUP *g;
+    EVP_PKEY *pkey = NULL;
+
+    if (pool == NULL || (ginf = tls1_group_id_lookup(ctx, id)) == NULL
+        || !CRYPTO_THREAD_write_lock(pool->lock))
+        return NULL;
+    keyshare_pool_check_fork(pool);
+    if (pool->size > 0 && (g = keyshare_pool_add(pool, ginf)) != NULL) {
+        if (g->num > 0) {
+            pkey = g->keys[--g->num];
+            g->keys[g->num] = NULL;
+        }
+        if (g->num <= pool->size / 2)
+            keyshare_pool_start_refill(ctx);
+    }
+    CRYPTO_THREAD_unlock(pool->lock);
+    return pkey;
+}
+
+/* The number of keys in the pool of |ctx| over all of its groups */
+size_t ssl_keyshare_pool_count(SSL_CTX *ctx)
+{
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+    size_t i, num = 0;
+
+    if (pool == NULL || !CRYPTO_THREAD_write_lock(pool->lock))
+        return 0;
+    keyshare_pool_check_fork(pool);
+    for (i = 0; i < pool->num_groups; i++)
+        num += pool->groups[i].num;
+    CRYPTO_THREAD_unlock(pool->lock);
+    return num;
+}
+
+void ssl_keyshare_pool_free(SSL_CTX *ctx)
+{
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+    size_t i;
+
+    if (pool == NULL)
+        return;
+
+#ifndef OPENSSL_NO_THREAD_POOL
+    if (CRYPTO_THREAD_write_lock(pool->lock)) {
+        pool->teardown = 1;
+        CRYPTO_THREAD_unlock(pool->lock);
+    }
+    /* The thread stops after the key it is generating, if any */
+    keyshare_pool_reap(pool);
+#endif
+
+    for (i = 0; i < pool->num_groups; i++) {
+        keyshare_pool_group_clear(&pool->groups[i]);
+        OPENSSL_free(pool->groups[i].keys);
+        OPENSSL_free(pool->groups[i].algorithm);
+        OPENSSL_free(pool->groups[i].realname);
+    }
+    CRYPTO_THREAD_lock_free(pool->lock);
+    OPENSSL_free(pool);
+    ctx->keyshare_pool = NULL;
+}
+
+int SSL_CTX_set_keyshare_pool_size(SSL_CTX *ctx, size_t size)
+{
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+    KEYSHARE_POOL_GROUP *g;
+    EVP_PKEY **keys;
+    size_t i;
+
+    if (pool == NULL) {
+        if (size == 0)
+            return 1;
+        if (!keyshare_pool_fork_setup())
+            return 0;
+        if ((pool = OPENSSL_zalloc(sizeof(*pool))) == NULL)
+            return 0;
+        if ((pool->lock = CRYPTO_THREAD_lock_new()) == NULL) {
+            ERR_raise(ERR_LIB_SSL, ERR_R_CRYPTO_LIB);
+            OPENSSL_free(pool);
+            return 0;
+        }
+        pool->fork_id = keyshare_pool_fork_id();
+        ctx->keyshare_pool = pool;
+    }
+
+    if (!CRYPTO_THREAD_write_lock(pool->lock))
+        return 0;
+    for (i = 0; i < pool->num_groups; i++) {
+        g = &pool->groups[i];
+        if (size > pool->size) {
+            keys = OPENSSL_realloc_array(g->keys, size, sizeof(*keys));
+            if (keys == NULL) {
+                CRYPTO_THREAD_unlock(pool->lock);
+                return 0;
+            }
+            memset(keys + pool->size, 0, (size - pool->size) * sizeof(*keys));
+            g->keys = keys;
+        }
+        while (g->num > size) {
+            EVP_PKEY_free(g->keys[--g->num]);
+            g->keys[g->num] = NULL;
+        }
+    }
+    pool->size = size;
+    CRYPTO_THREAD_unlock(pool->lock);
+    return 1;
+}
+
+size_t SSL_CTX_get_keyshare_pool_size(const SSL_CTX *ctx)
+{
+    return ctx->keyshare_pool == NULL ? 0 : ctx->keyshare_pool->size;
+}
+
+int SSL_CTX_fill_keyshare_pool(SSL_CTX *ctx)
+{
+    SSL_KEYSHARE_POOL *pool = ctx->keyshare_pool;
+    const TLS_GROUP_INFO *ginf;
+    size_t i;
+    uint16_t id;
+    int r, ret = 1;
+
+    if (pool == NULL || pool->size == 0)
+        return 1;
+
+    /* Make sure the groups the CTX sends key shares for are in the pool */
+    if (!CRYPTO_THREAD_write_lock(pool->lock))
+        return 0;
+    for (i = 0; i < ctx->ext.keyshares_len; i++) {
+        id = ctx->ext.keyshares[i];
+        /* 0 stands for the first group of a list without key share prefixes */
+        if (id == 0 && ctx->ext.supportedgroups_len > 0)
+            id = ctx->ext.supportedgroups[0];
+        if (id == 0 || (ginf = tls1_group_id_lookup(ctx, id)) == NULL)
+            continue;
+        if (keyshare_pool_add(pool, ginf) == NULL)
+            ret = 0;
+    }
+    CRYPTO_THREAD_unlock(pool->lock);
+
+    while ((r = keyshare_pool_refill_one(ctx)) > 0)
+        continue;
+    return r == 0 ? ret : 0;
+}
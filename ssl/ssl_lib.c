@@ -4565,6 +4565,9 @@ void SSL_CTX_free(SSL_CTX *a)
     }
 #endif
 
+    /* This stops any background key generation using |a| */
+    ssl_keyshare_pool_free(a);
+
     X509_VERIFY_PARAM_free(a->param);
     dane_ctx_final(&a->dane);
 
@@ -809,6 +809,8 @@ typedef struct {
     uint32_t amask; /* authmask corresponding to key type */
 } SSL_CERT_LOOKUP;
 
+typedef struct ssl_keyshare_pool_st SSL_KEYSHARE_POOL;
+
 #if !defined(OPENSSL_NO_TLS1)      \
     || !defined(OPENSSL_NO_TLS1_1) \
     || !defined(OPENSSL_NO_TLS1_2) \
@@ -1194,6 +1196,9 @@ struct ssl_ctx_st {
     size_t group_list_len;
     size_t group_list_max_len;
 
+    /* Pre-generated key shares, see ssl_kspool.c */
+    SSL_KEYSHARE_POOL *keyshare_pool;
+
     TLS_SIGALG_INFO *sigalg_list;
     size_t sigalg_list_len;
     size_t sigalg_list_max_len;
@@ -2775,6 +2780,9 @@ __owur int tls1_set_groups_list(SSL_CTX *ctx,
     size_t **tplext, size_t *tplextlen,
     const char *str);
 __owur EVP_PKEY *ssl_generate_pkey_group(SSL_CONNECTION *s, uint16_t id);
+__owur EVP_PKEY *ssl_keyshare_pool_take(SSL_CTX *ctx, uint16_t id);
+void ssl_keyshare_pool_free(SSL_CTX *ctx);
+size_t ssl_keyshare_pool_count(SSL_CTX *ctx);
 __owur int tls_valid_group(SSL_CONNECTION *s, uint16_t group_id, int minversion,
     int maxversion, int *okfortls13, const TLS_GROUP_INFO **giptr);
 __owur EVP_PKEY *ssl_generate_param_group(SSL_CONNECTION *s, uint16_t id);
@@ -18,7 +18,9 @@
 
 #ifndef OPENSSL_NO_EC
 
+#include <string.h>
 #include <openssl/evp.h>
+#include <openssl/core_names.h>
 #include <openssl/bn.h>
 #include <openssl/ec.h>
 #include <openssl/rand.h>
@@ -390,6 +392,109 @@ static int test_ecdsa_sig_NULL(void)
     return ret;
 }
 
+static int verify_with(EVP_MD_CTX *mctx, EVP_PKEY *pkey,
+    const unsigned char *sig, size_t sig_len,
+    const unsigned char *tbs, size_t tbs_len)
+{
+    if (!TEST_true(EVP_DigestVerifyInit(mctx, NULL, EVP_sha256(), NULL, pkey)))
+        return -1;
+    return EVP_DigestVerify(mctx, sig, sig_len, tbs, tbs_len);
+}
+
+/*
+ * Verify with a public key table attached to the key, and check every
+ * result against a copy of the key that takes the generic path.  Curves
+ * without support for the table must ignore the request.
+ */
+static int test_ecdsa_precompute_public(int n)
+{
+    static const char *precomp_curves[] = { "P-256", "P-384" };
+    const char *curve = precomp_curves[n];
+    int ret = 0, i, enable = 1, table = -1, res;
+    EVP_PKEY *pkey = NULL, *generic = NULL;
+    EVP_MD_CTX *mctx = NULL;
+    OSSL_PARAM params[2];
+    unsigned char tbs[64], sig[256];
+    size_t sig_len;
+
+    params[0] = OSSL_PARAM_construct_int(OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC,
+        &enable);
+    params[1] = OSSL_PARAM_construct_end();
+
+    if (!TEST_ptr(pkey = EVP_PKEY_Q_keygen(NULL, NULL, "EC", curve))
+        || !TEST_ptr(generic = EVP_PKEY_dup(pkey))
+        || !TEST_true(EVP_PKEY_get_int_param(pkey,
+            OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC, &table))
+        || !TEST_int_eq(table, 0)
+        || !TEST_true(EVP_PKEY_set_params(pkey, params))
+        || !TEST_true(EVP_PKEY_get_int_param(pkey,
+            OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC, &table))
+        || !TEST_int_ge(table, 0)
+        || !TEST_int_le(table, 1)
+        /* Asking again must leave the table in place */
+        || !TEST_true(EVP_PKEY_set_params(pkey, params))
+        || !TEST_true(EVP_PKEY_get_int_param(generic,
+            OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC, &enable))
+        || !TEST_int_eq(enable, 0)
+        || !TEST_ptr(mctx = EVP_MD_CTX_new()))
+        goto err;
+    TEST_info("%s: public key table %s", curve, table ? "built" : "ignored");
+
+    for (i = 0; i < 16; i++) {
+        memset(tbs, i, sizeof(tbs));
+        sig_len = sizeof(sig);
+        if (!TEST_true(EVP_DigestSignInit(mctx, NULL, EVP_sha256(), NULL,
+                (i & 1) ? generic : pkey))
+            || !TEST_true(EVP_DigestSign(mctx, sig, &sig_len, tbs,
+                sizeof(tbs)))
+            || !TEST_int_eq(verify_with(mctx, pkey, sig, sig_len, tbs,
+                                sizeof(tbs)),
+                1)
+            || !TEST_int_eq(verify_with(mctx, generic, sig, sig_len, tbs,
+                                sizeof(tbs)),
+                1))
+            goto err;
+
+        /* A wrong message, and a signature with a bit flipped in r or s */
+        tbs[i] ^= 1;
+        if (!TEST_int_eq(verify_with(mctx, pkey, sig, sig_len, tbs,
+                             sizeof(tbs)),
+                0))
+            goto err;
+        tbs[i] ^= 1;
+        sig[sig_len - 1 - i] ^= 0x10;
+        res = verify_with(mctx, generic, sig, sig_len, tbs, sizeof(tbs));
+        if (!TEST_int_ne(res, 1)
+            || !TEST_int_eq(verify_with(mctx, pkey, sig, sig_len, tbs,
+                                sizeof(tbs)),
+                res))
+            goto err;
+        sig[sig_len - 1 - i] ^= 0x10;
+    }
+
+    /*
+     * Other threads may be verifying with the key, so a table that has been
+     * built cannot be dropped, and the key keeps using it
+     */
+    enable = 0;
+    if ((table ? !TEST_false(EVP_PKEY_set_params(pkey, params))
+               : !TEST_true(EVP_PKEY_set_params(pkey, params)))
+        || !TEST_true(EVP_PKEY_get_int_param(pkey,
+            OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC, &enable))
+        || !TEST_int_eq(enable, table)
+        || !TEST_int_eq(verify_with(mctx, pkey, sig, sig_len, tbs,
+                            sizeof(tbs)),
+            1))
+        goto err;
+
+    ret = 1;
+err:
+    EVP_MD_CTX_free(mctx);
+    EVP_PKEY_free(generic);
+    EVP_PKEY_free(pkey);
+    return ret;
+}
+
 #endif /* OPENSSL_NO_EC */
 
 int setup_tests(void)
@@ -410,6 +515,7 @@ int setup_tests(void)
     }
     ADD_ALL_TESTS(test_builtin_as_ec, (int)crv_len);
     ADD_TEST(test_ecdsa_sig_NULL);
+    ADD_ALL_TESTS(test_ecdsa_precompute_public, 2);
 #ifndef OPENSSL_NO_SM2
     ADD_ALL_TESTS(test_builtin_as_sm2, (int)crv_len);
 #endif
@@ -325,6 +325,63 @@ err:
     return res;
 }
 
+/*
+ * The file and function names are copied into buffers owned by the error
+ * stack slots, which are reused for later errors.  Check that a reused slot
+ * never reports stale or truncated names.
+ */
+static int test_debug_strings(void)
+{
+    static const char longfile[] =
+        "a/rather/long/path/to/some/provider/source/file/name_that_is_long.c";
+    static const char longfunc[] =
+        "a_rather_long_function_name_that_does_not_fit_the_minimum_buffer";
+    const char *file = NULL, *func = NULL;
+    int line = 0, i, res = 0;
+
+    ERR_clear_error();
+    for (i = 0; i < ERR_NUM_ERRORS * 2; i++) {
+        ERR_new();
+        ERR_set_debug(longfile, i, longfunc);
+        ERR_set_error(ERR_LIB_NONE, ERR_R_INTERNAL_ERROR, NULL);
+        ERR_new();
+        ERR_set_debug("f.c", i, "fn");
+        ERR_set_error(ERR_LIB_NONE, ERR_R_INTERNAL_ERROR, NULL);
+        if (!TEST_ulong_ne(ERR_peek_last_error_all(&file, &line, &func,
+                               NULL, NULL),
+                0)
+            || !TEST_str_eq(file, "f.c")
+            || !TEST_int_eq(line, i)
+            || !TEST_str_eq(func, "fn"))
+            goto err;
+    }
+
+    ERR_new();
+    ERR_set_debug(NULL, 0, NULL);
+    ERR_set_error(ERR_LIB_NONE, ERR_R_INTERNAL_ERROR, NULL);
+    if (!TEST_ulong_ne(ERR_peek_last_error_all(&file, &line, &func,
+                           NULL, NULL),
+            0)
+        || !TEST_str_eq(file, "")
+        || !TEST_str_eq(func, ""))
+        goto err;
+
+    ERR_clear_error();
+    ERR_new();
+    ERR_set_debug(longfile, 42, longfunc);
+    ERR_set_error(ERR_LIB_NONE, ERR_R_INTERNAL_ERROR, NULL);
+    if (!TEST_ulong_ne(ERR_get_error_all(&file, &line, &func, NULL, NULL), 0)
+        || !TEST_str_eq(file, longfile)
+        || !TEST_int_eq(line, 42)
+        || !TEST_str_eq(func, longfunc))
+        goto err;
+
+    res = 1;
+err:
+    ERR_clear_error();
+    return res;
+}
+
 /*
  * Test saving and restoring error state.
  * Test 0: Save using OSSL_ERR_STATE_save()
@@ -461,6 +518,7 @@ int setup_tests(void)
     ADD_TEST(test_marks);
     ADD_ALL_TESTS(test_save_restore, 2);
     ADD_TEST(test_clear_error);
+    ADD_TEST(test_debug_strings);
     ADD_TEST(test_error_reason);
     ADD_TEST(test_error_string);
     return 1;
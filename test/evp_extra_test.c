@@ -33,6 +33,8 @@
 #include <openssl/rsa.h>
 #include <openssl/proverr.h>
 #include <openssl/rand.h>
+#include <openssl/sha.h>
+#include <openssl/thread.h>
 #include <crypto/ml_kem.h>
 #include "testutil.h"
 #include "internal/nelem.h"
@@ -7509,8 +7511,276 @@ err:
 
     return testresult;
 }
+
+/*
+ * Check that EVP_PKEY_verify_message_batch() gives the same results as
+ * verifying each Ed25519 signature on its own, both for a batch that is too
+ * small to be worth precomputing for and for one that spans several rounds
+ * of the batched implementation.
+ */
+static int test_ed25519_verify_batch(int tst)
+{
+    static const char *algs[] = { "ED25519", "ED25519ph", "ED25519ctx" };
+    const char *alg = algs[tst % OSSL_NELEM(algs)];
+    size_t n = tst < (int)OSSL_NELEM(algs) ? 3 : 20, i;
+    EVP_PKEY *pkey = NULL;
+    EVP_PKEY_CTX *sctx = NULL, *vctx = NULL, *ctx = NULL;
+    EVP_SIGNATURE *sig_alg = NULL;
+    unsigned char msgbuf[64], sigs[20][64];
+    const unsigned char *sigptrs[20], *tbs[20];
+    size_t siglens[20], tbslens[20];
+    int results[20], expected[20], all_valid = 1, testresult = 0;
+    OSSL_PARAM params[2], *p = NULL;
+
+    if (strcmp(alg, "ED25519ctx") == 0) {
+        params[0] = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+            (void *)"context", 7);
+        params[1] = OSSL_PARAM_construct_end();
+        p = params;
+    }
+    for (i = 0; i < sizeof(msgbuf); i++)
+        msgbuf[i] = (unsigned char)i;
+
+    ERR_set_mark();
+    sig_alg = EVP_SIGNATURE_fetch(testctx, alg, testpropq);
+    ERR_pop_to_mark();
+    if (sig_alg == NULL)
+        return TEST_skip("%s is not available", alg);
+
+    if (!TEST_ptr(pkey = EVP_PKEY_Q_keygen(testctx, testpropq, "ED25519"))
+        || !TEST_ptr(sctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq))
+        || !TEST_ptr(vctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq))
+        || !TEST_int_eq(EVP_PKEY_sign_message_init(sctx, sig_alg, p), 1))
+        goto err;
+
+    for (i = 0; i < n; i++) {
+        siglens[i] = sizeof(sigs[i]);
+        tbs[i] = msgbuf;
+        tbslens[i] = 3 * i;
+        sigptrs[i] = sigs[i];
+        if (!TEST_int_eq(EVP_PKEY_sign(sctx, sigs[i], &siglens[i],
+                             tbs[i], tbslens[i]),
+                1))
+            goto err;
+    }
+
+    /* Make some of the signatures invalid in different ways */
+    sigs[1][0] ^= 1;
+    sigs[n - 1][40] ^= 1;
+    siglens[n / 2]--;
+    tbslens[2]++;
+    if (n > 4) {
+        /* s >= L, and a valid signature for a different message */
+        memset(sigs[4] + 32, 0xff, 32);
+        memcpy(sigs[n - 2], sigs[n - 3], sizeof(sigs[0]));
+    }
+
+    for (i = 0; i < n; i++) {
+        if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq))
+            || !TEST_int_eq(EVP_PKEY_verify_message_init(ctx, sig_alg, p), 1))
+            goto err;
+        ERR_set_mark();
+        expected[i] = EVP_PKEY_verify(ctx, sigptrs[i], siglens[i],
+                          tbs[i], tbslens[i])
+            == 1;
+        ERR_pop_to_mark();
+        EVP_PKEY_CTX_free(ctx);
+        ctx = NULL;
+        all_valid &= expected[i];
+    }
+
+    if (!TEST_false(all_valid)
+        || !TEST_int_eq(EVP_PKEY_verify_message_init(vctx, sig_alg, p), 1)
+        || !TEST_int_eq(EVP_PKEY_verify_message_batch(vctx, sigptrs, siglens,
+                            tbs, tbslens, results, n),
+            0))
+        goto err;
+    for (i = 0; i < n; i++)
+        if (!TEST_int_eq(results[i], expected[i]))
+            goto err;
+
+    /* Signatures 5 to 9 are valid in the larger batch, and 0 in both */
+    i = n > 4 ? 5 : 0;
+    if (!TEST_int_eq(EVP_PKEY_verify_message_batch(vctx, sigptrs + i,
+                         siglens + i, tbs + i, tbslens + i, results,
+                         n > 4 ? 5 : 1),
+            1))
+        goto err;
+    testresult = 1;
+err:
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_CTX_free(sctx);
+    EVP_PKEY_CTX_free(vctx);
+    EVP_SIGNATURE_free(sig_alg);
+    EVP_PKEY_free(pkey);
+    return testresult;
+}
 #endif /* OPENSSL_NO_ECX */
 
+/*
+ * RSA and ECDSA have no batch verification in the provider, so this tests
+ * the EVP_PKEY_verify_message_batch() fallback: the invalid signatures are
+ * reported in the results and leave no error behind.
+ */
+static int test_verify_batch_fallback(int tst)
+{
+    static const char *algs[] = { "RSA-SHA256", "ECDSA-SHA256" };
+    const char *alg = algs[tst];
+    EVP_PKEY *pkey = NULL;
+    EVP_PKEY_CTX *sctx = NULL, *vctx = NULL;
+    EVP_SIGNATURE *sig_alg = NULL;
+    unsigned char msg[] = "batch", sigs[5][256];
+    const unsigned char *sigptrs[5], *tbs[5];
+    size_t siglens[5], tbslens[5], i;
+    int results[5], testresult = 0;
+
+    ERR_set_mark();
+    sig_alg = EVP_SIGNATURE_fetch(testctx, alg, testpropq);
+    ERR_pop_to_mark();
+    if (sig_alg == NULL)
+        return TEST_skip("%s is not available", alg);
+
+    if (tst == 0)
+        pkey = EVP_PKEY_Q_keygen(testctx, testpropq, "RSA", (size_t)1024);
+    else
+        pkey = EVP_PKEY_Q_keygen(testctx, testpropq, "EC", "P-256");
+    if (!TEST_ptr(pkey)
+        || !TEST_ptr(sctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq))
+        || !TEST_ptr(vctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey, testpropq)))
+        goto err;
+    for (i = 0; i < OSSL_NELEM(sigs); i++) {
+        siglens[i] = sizeof(sigs[i]);
+        tbs[i] = msg;
+        tbslens[i] = sizeof(msg) - 1;
+        sigptrs[i] = sigs[i];
+        if (!TEST_int_eq(EVP_PKEY_sign_message_init(sctx, sig_alg, NULL), 1)
+            || !TEST_int_eq(EVP_PKEY_sign(sctx, sigs[i], &siglens[i],
+                             tbs[i], tbslens[i]),
+                1))
+            goto err;
+    }
+
+    /* A corrupted, a truncated and a malformed signature */
+    sigs[1][siglens[1] - 1] ^= 1;
+    siglens[2]--;
+    memset(sigs[3], 0xff, 8);
+
+    ERR_clear_error();
+    if (!TEST_int_eq(EVP_PKEY_verify_message_init(vctx, sig_alg, NULL), 1)
+        || !TEST_int_eq(EVP_PKEY_verify_message_batch(vctx, sigptrs, siglens,
+                            tbs, tbslens, results, OSSL_NELEM(sigs)),
+            0)
+        || !TEST_ulong_eq(ERR_peek_error(), 0)
+        || !TEST_int_eq(results[0], 1)
+        || !TEST_int_eq(results[1], 0)
+        || !TEST_int_eq(results[2], 0)
+        || !TEST_int_eq(results[3], 0)
+        || !TEST_int_eq(results[4], 1))
+        goto err;
+    testresult = 1;
+err:
+    EVP_PKEY_CTX_free(sctx);
+    EVP_PKEY_CTX_free(vctx);
+    EVP_SIGNATURE_free(sig_alg);
+    EVP_PKEY_free(pkey);
+    return testresult;
+}
+
+/*
+ * Check that EVP_PKEY_sign_batch() gives the same RSA signatures as
+ * EVP_PKEY_sign() with PKCS#1 v1.5 padding, and valid ones with PSS, with
+ * and without a thread pool.  The number of inputs is chosen not to fill the
+ * groups of the batched implementation exactly.
+ */
+static int test_rsa_sign_batch(int tst)
+{
+    static const int bits[] = { 1024, 2048, 3072, 4096 };
+    int nbits = bits[tst % OSSL_NELEM(bits)];
+    int threads = tst >= (int)OSSL_NELEM(bits);
+    EVP_PKEY *pkey = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+    unsigned char md[11][SHA256_DIGEST_LENGTH], sigs[11][512], sig[512];
+    unsigned char *sigptrs[11];
+    const unsigned char *tbs[11];
+    size_t siglens[11], tbslens[11], siglen, i, j;
+    int padding, testresult = 0;
+
+    for (i = 0; i < OSSL_NELEM(md); i++) {
+        for (j = 0; j < sizeof(md[i]); j++)
+            md[i][j] = (unsigned char)(i * 31 + j);
+        tbs[i] = md[i];
+        tbslens[i] = sizeof(md[i]);
+        sigptrs[i] = sigs[i];
+    }
+
+#if defined(OPENSSL_THREADS) && !defined(OPENSSL_NO_THREAD_POOL)
+    if (threads && !TEST_true(OSSL_set_max_threads(testctx, 4)))
+        return 0;
+#else
+    if (threads)
+        return TEST_skip("no thread pool support");
+#endif
+
+    if (!TEST_ptr(pkey = EVP_PKEY_Q_keygen(testctx, testpropq, "RSA",
+                      (size_t)nbits)))
+        goto err;
+
+    for (padding = RSA_PKCS1_PADDING; padding != 0;
+        padding = padding == RSA_PKCS1_PADDING ? RSA_PKCS1_PSS_PADDING : 0) {
+        EVP_PKEY_CTX_free(ctx);
+        if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey,
+                          testpropq))
+            || !TEST_int_eq(EVP_PKEY_sign_init(ctx), 1)
+            || !TEST_int_gt(EVP_PKEY_CTX_set_rsa_padding(ctx, padding), 0)
+            || !TEST_int_gt(EVP_PKEY_CTX_set_signature_md(ctx, EVP_sha256()),
+                0))
+            goto err;
+
+        for (i = 0; i < OSSL_NELEM(md); i++)
+            siglens[i] = sizeof(sigs[i]);
+        if (!TEST_int_eq(EVP_PKEY_sign_batch(ctx, sigptrs, siglens, tbs,
+                             tbslens, OSSL_NELEM(md)),
+                1))
+            goto err;
+
+        for (i = 0; i < OSSL_NELEM(md); i++) {
+            if (!TEST_size_t_eq(siglens[i], (size_t)nbits / 8))
+                goto err;
+            if (padding == RSA_PKCS1_PADDING) {
+                siglen = sizeof(sig);
+                if (!TEST_int_eq(EVP_PKEY_sign(ctx, sig, &siglen, tbs[i],
+                                     tbslens[i]),
+                        1)
+                    || !TEST_mem_eq(sigs[i], siglens[i], sig, siglen))
+                    goto err;
+            }
+        }
+
+        EVP_PKEY_CTX_free(ctx);
+        if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(testctx, pkey,
+                          testpropq))
+            || !TEST_int_eq(EVP_PKEY_verify_init(ctx), 1)
+            || !TEST_int_gt(EVP_PKEY_CTX_set_rsa_padding(ctx, padding), 0)
+            || !TEST_int_gt(EVP_PKEY_CTX_set_signature_md(ctx, EVP_sha256()),
+                0))
+            goto err;
+        for (i = 0; i < OSSL_NELEM(md); i++)
+            if (!TEST_int_eq(EVP_PKEY_verify(ctx, sigs[i], siglens[i], tbs[i],
+                                 tbslens[i]),
+                    1))
+                goto err;
+    }
+    testresult = 1;
+err:
+#if defined(OPENSSL_THREADS) && !defined(OPENSSL_NO_THREAD_POOL)
+    if (threads && !TEST_true(OSSL_set_max_threads(testctx, 0)))
+        testresult = 0;
+#endif
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    return testresult;
+}
+
 static int test_sign_continuation(void)
 {
     OSSL_PROVIDER *fake_rsa = NULL;
@@ -7951,6 +8221,68 @@ err:
     return ret;
 }
 
+/*
+ * AES-GCM-SIV context reuse: every message started by setting a new nonce
+ * must give the same result as a fresh context, i.e. neither the AAD nor the
+ * derived keys of the previous message may be carried over.
+ */
+static int test_aes_gcm_siv_reuse(void)
+{
+    unsigned char key[32] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+    unsigned char nonce[12] = { 0xaa, 0xbb, 0xcc, 0xdd };
+    unsigned char aad[24] = "reused context AAD";
+    unsigned char pt[100], ct[100], ct2[100], tag[16], tag2[16];
+    int outl, i, ret = 0;
+    EVP_CIPHER_CTX *ctx = NULL, *ctx2 = NULL, *dup = NULL;
+    EVP_CIPHER *c = EVP_CIPHER_fetch(NULL, "AES-256-GCM-SIV", NULL);
+
+    if (c == NULL)
+        return TEST_skip("AES-256-GCM-SIV cipher is not available");
+
+    memset(pt, 0x5a, sizeof(pt));
+    if (!TEST_ptr(ctx = EVP_CIPHER_CTX_new())
+        || !TEST_true(EVP_EncryptInit_ex2(ctx, c, key, NULL, NULL)))
+        goto err;
+    for (i = 0; i < 3; i++) {
+        nonce[11] = (unsigned char)i;
+        if (!TEST_true(EVP_EncryptInit_ex2(ctx, NULL, NULL, nonce, NULL))
+            || !TEST_true(EVP_EncryptUpdate(ctx, NULL, &outl, aad, sizeof(aad)))
+            || !TEST_true(EVP_EncryptUpdate(ctx, ct, &outl, pt, sizeof(pt)))
+            || !TEST_true(EVP_EncryptFinal_ex(ctx, ct, &outl))
+            || !TEST_true(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, tag)))
+            goto err;
+
+        EVP_CIPHER_CTX_free(ctx2);
+        if (!TEST_ptr(ctx2 = EVP_CIPHER_CTX_new())
+            || !TEST_true(EVP_EncryptInit_ex2(ctx2, c, key, nonce, NULL))
+            || !TEST_true(EVP_EncryptUpdate(ctx2, NULL, &outl, aad, sizeof(aad)))
+            || !TEST_true(EVP_EncryptUpdate(ctx2, ct2, &outl, pt, sizeof(pt)))
+            || !TEST_true(EVP_EncryptFinal_ex(ctx2, ct2, &outl))
+            || !TEST_true(EVP_CIPHER_CTX_ctrl(ctx2, EVP_CTRL_AEAD_GET_TAG, 16, tag2))
+            || !TEST_mem_eq(ct, sizeof(ct), ct2, sizeof(ct2))
+            || !TEST_mem_eq(tag, sizeof(tag), tag2, sizeof(tag2)))
+            goto err;
+    }
+
+    /* A duplicated context decrypts the last message with a new key schedule */
+    if (!TEST_ptr(dup = EVP_CIPHER_CTX_dup(ctx))
+        || !TEST_true(EVP_DecryptInit_ex2(dup, NULL, NULL, nonce, NULL))
+        || !TEST_true(EVP_CIPHER_CTX_ctrl(dup, EVP_CTRL_AEAD_SET_TAG, 16, tag))
+        || !TEST_true(EVP_DecryptUpdate(dup, NULL, &outl, aad, sizeof(aad)))
+        || !TEST_true(EVP_DecryptUpdate(dup, ct2, &outl, ct, sizeof(ct)))
+        || !TEST_true(EVP_DecryptFinal_ex(dup, ct2, &outl))
+        || !TEST_mem_eq(ct2, sizeof(ct2), pt, sizeof(pt)))
+        goto err;
+
+    ret = 1;
+err:
+    EVP_CIPHER_CTX_free(ctx);
+    EVP_CIPHER_CTX_free(ctx2);
+    EVP_CIPHER_CTX_free(dup);
+    EVP_CIPHER_free(c);
+    return ret;
+}
+
 /*
  * AES-SIV reuse-without-rekey:
  *   msg1: legit non-empty CT, tag verifies, final_ret=0
@@ -8670,6 +9002,509 @@ end:
     return testresult;
 }
 
+static const struct {
+    const char *name;
+    size_t numpipes, ivlen, taglen;
+} aes_ccm_pipeline_tests[] = {
+    { "AES-128-CCM", 1, 12, 16 },
+    { "AES-128-CCM", 2, 13, 8 },
+    { "AES-256-CCM", 7, 7, 16 },
+    { "AES-192-CCM", EVP_MAX_PIPES, 12, 12 },
+};
+
+/*
+ * The built-in AES-CCM pipeline must match one message at a time CCM, and
+ * a bad tag must fail and clear the output of its pipe.
+ */
+static int test_aes_ccm_pipeline(int idx)
+{
+    size_t numpipes = aes_ccm_pipeline_tests[idx].numpipes;
+    size_t ivlen = aes_ccm_pipeline_tests[idx].ivlen;
+    size_t taglen = aes_ccm_pipeline_tests[idx].taglen;
+    unsigned char key[32], ref[400], reftag[16];
+    unsigned char iv[EVP_MAX_PIPES][13], aad[EVP_MAX_PIPES][40];
+    unsigned char pt[EVP_MAX_PIPES][400], ct[EVP_MAX_PIPES][400];
+    unsigned char dec[EVP_MAX_PIPES][400], tag[EVP_MAX_PIPES][16];
+    unsigned char *ivp[EVP_MAX_PIPES], *aadp[EVP_MAX_PIPES];
+    unsigned char *ptp[EVP_MAX_PIPES], *ctp[EVP_MAX_PIPES];
+    unsigned char *decp[EVP_MAX_PIPES], *tagp[EVP_MAX_PIPES];
+    void **tags = (void **)&tagp;
+    size_t len[EVP_MAX_PIPES], aadlen[EVP_MAX_PIPES];
+    size_t outsize[EVP_MAX_PIPES], outl[EVP_MAX_PIPES];
+    OSSL_PARAM params[2] = { OSSL_PARAM_END, OSSL_PARAM_END };
+    EVP_CIPHER *cipher = NULL;
+    EVP_CIPHER_CTX *ctx = NULL;
+    size_t i, j, last = numpipes - 1;
+    int keylen, ioutl, ret = 0;
+
+    if (!TEST_ptr(cipher = EVP_CIPHER_fetch(testctx,
+                      aes_ccm_pipeline_tests[idx].name, testpropq))
+        || !TEST_true(EVP_CIPHER_can_pipeline(cipher, 1))
+        || !TEST_true(EVP_CIPHER_can_pipeline(cipher, 0))
+        || !TEST_ptr(ctx = EVP_CIPHER_CTX_new()))
+        goto err;
+    keylen = EVP_CIPHER_get_key_length(cipher);
+
+    for (j = 0; j < sizeof(key); j++)
+        key[j] = (unsigned char)(j * 7 + idx);
+    for (i = 0; i < numpipes; i++) {
+        /* A mix of empty, partial and whole block payloads and AAD */
+        len[i] = (i * 37) % 400;
+        aadlen[i] = (i % 3 == 1) ? 0 : (i * 11 + 5) % 40;
+        for (j = 0; j < ivlen; j++)
+            iv[i][j] = (unsigned char)(i * 13 + j);
+        for (j = 0; j < aadlen[i]; j++)
+            aad[i][j] = (unsigned char)(i + j * 3);
+        for (j = 0; j < len[i]; j++)
+            pt[i][j] = (unsigned char)(i * 5 + j);
+        ivp[i] = iv[i];
+        aadp[i] = aad[i];
+        ptp[i] = pt[i];
+        ctp[i] = ct[i];
+        decp[i] = dec[i];
+        tagp[i] = tag[i];
+        outsize[i] = sizeof(ct[i]);
+    }
+
+    /* An operation that was started and abandoned leaves no nonces behind */
+    if (!TEST_true(EVP_CipherPipelineEncryptInit(ctx, cipher, key, keylen,
+            numpipes, (const unsigned char **)ivp, ivlen))
+        || !TEST_true(EVP_CipherPipelineEncryptInit(ctx, NULL, key, keylen,
+            numpipes, NULL, 0))
+        || !TEST_false(EVP_CipherPipelineUpdate(ctx, ctp, outl, outsize,
+            (const unsigned char **)ptp, len)))
+        goto err;
+
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_CIPHER_PARAM_AEAD_TAG,
+        NULL, taglen);
+    if (!TEST_true(EVP_CipherPipelineEncryptInit(ctx, cipher, key, keylen,
+            numpipes, (const unsigned char **)ivp, ivlen))
+        || !TEST_true(EVP_CIPHER_CTX_set_params(ctx, params))
+        || !TEST_true(EVP_CipherPipelineUpdate(ctx, NULL, outl, NULL,
+            (const unsigned char **)aadp, aadlen))
+        || !TEST_true(EVP_CipherPipelineUpdate(ctx, ctp, outl, outsize,
+            (const unsigned char **)ptp, len))
+        || !TEST_true(EVP_CipherPipelineFinal(ctx, decp, outl, outsize)))
+        goto err;
+    params[0] = OSSL_PARAM_construct_octet_ptr(
+        OSSL_CIPHER_PARAM_PIPELINE_AEAD_TAG, (void **)&tags, taglen);
+    if (!TEST_true(EVP_CIPHER_CTX_get_params(ctx, params)))
+        goto err;
+
+    for (i = 0; i < numpipes; i++) {
+        OSSL_PARAM p[3];
+
+        p[0] = OSSL_PARAM_construct_size_t(OSSL_CIPHER_PARAM_AEAD_IVLEN,
+            &ivlen);
+        p[1] = OSSL_PARAM_construct_octet_string(OSSL_CIPHER_PARAM_AEAD_TAG,
+            NULL, taglen);
+        p[2] = OSSL_PARAM_construct_end();
+        if (!TEST_true(EVP_CIPHER_CTX_reset(ctx))
+            || !TEST_true(EVP_EncryptInit_ex2(ctx, cipher, NULL, NULL, p))
+            || !TEST_true(EVP_EncryptInit_ex2(ctx, NULL, key, iv[i], NULL))
+            || !TEST_true(EVP_EncryptUpdate(ctx, NULL, &ioutl, NULL,
+                (int)len[i]))
+            || (aadlen[i] > 0
+                && !TEST_true(EVP_EncryptUpdate(ctx, NULL, &ioutl, aad[i],
+                    (int)aadlen[i])))
+            || !TEST_true(EVP_EncryptUpdate(ctx, ref, &ioutl, pt[i],
+                (int)len[i]))
+            || !TEST_true(EVP_EncryptFinal_ex(ctx, ref, &ioutl))
+            || !TEST_true(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG,
+                (int)taglen, reftag))
+            || !TEST_mem_eq(ct[i], len[i], ref, len[i])
+            || !TEST_mem_eq(tag[i], taglen, reftag, taglen))
+            goto err;
+    }
+
+    params[0] = OSSL_PARAM_construct_octet_ptr(
+        OSSL_CIPHER_PARAM_PIPELINE_AEAD_TAG, (void **)&tags, taglen);
+    if (!TEST_true(EVP_CIPHER_CTX_reset(ctx))
+        || !TEST_true(EVP_CipherPipelineDecryptInit(ctx, cipher, key, keylen,
+            numpipes, (const unsigned char **)ivp, ivlen))
+        || !TEST_true(EVP_CIPHER_CTX_set_params(ctx, params))
+        || !TEST_true(EVP_CipherPipelineUpdate(ctx, NULL, outl, NULL,
+            (const unsigned char **)aadp, aadlen))
+        || !TEST_true(EVP_CipherPipelineUpdate(ctx, decp, outl, outsize,
+            (const unsigned char **)ctp, len))
+        || !TEST_true(EVP_CipherPipelineFinal(ctx, decp, outl, outsize)))
+        goto err;
+    for (i = 0; i < numpipes; i++)
+        if (!TEST_mem_eq(dec[i], len[i], pt[i], len[i]))
+            goto err;
+
+    /*
+     * Decrypt in place, with a corrupted tag on the last pipe, reusing the
+     * context without a reset
+     */
+    tag[last][0] ^= 1;
+    params[0] = OSSL_PARAM_construct_octet_ptr(
+        OSSL_CIPHER_PARAM_PIPELINE_AEAD_TAG, (void **)&tags, taglen);
+    if (!TEST_true(EVP_CipherPipelineDecryptInit(ctx, cipher, key, keylen,
+            numpipes, (const unsigned char **)ivp, ivlen))
+        || !TEST_true(EVP_CIPHER_CTX_set_params(ctx, params))
+        || !TEST_true(EVP_CipherPipelineUpdate(ctx, NULL, outl, NULL,
+            (const unsigned char **)aadp, aadlen))
+        || !TEST_false(EVP_CipherPipelineUpdate(ctx, ctp, outl, outsize,
+            (const unsigned char **)ctp, len)))
+        goto err;
+    memset(ref, 0, sizeof(ref));
+    for (i = 0; i < last; i++)
+        if (!TEST_mem_eq(ct[i], len[i], pt[i], len[i]))
+            goto err;
+    if (!TEST_mem_eq(ct[last], len[last], ref, len[last]))
+        goto err;
+
+    ret = 1;
+err:
+    EVP_CIPHER_CTX_free(ctx);
+    EVP_CIPHER_free(cipher);
+    return ret;
+}
+
+#ifndef OPENSSL_NO_SIV
+static const struct {
+    const char *name;
+    size_t numpipes, naad;
+} aes_siv_pipeline_tests[] = {
+    { "AES-128-SIV", 1, 1 },
+    { "AES-192-SIV", 3, 0 },
+    { "AES-256-SIV", 9, 2 },
+    { "AES-128-SIV", EVP_MAX_PIPES, 1 },
+};
+
+/*
+ * The built-in AES-SIV pipeline must match one message at a time SIV, and
+ * a bad tag must fail and clear the output of its pipe.
+ */
+static int test_aes_siv_pipeline(int idx)
+{
+    size_t numpipes = aes_siv_pipeline_tests[idx].numpipes;
+    size_t naad = aes_siv_pipeline_tests[idx].naad;
+    unsigned char key[64], ref[600], reftag[16];
+    unsigned char aad[EVP_MAX_PIPES][40];
+    unsigned char pt[EVP_MAX_PIPES][600], ct[EVP_MAX_PIPES][600];
+    unsigned char dec[EVP_MAX_PIPES][600], tag[EVP_MAX_PIPES][16];
+    unsigned char *aadp[EVP_MAX_PIPES];
+    unsigned char *ptp[EVP_MAX_PIPES], *ctp[EVP_MAX_PIPES];
+    unsigned char *decp[EVP_MAX_PIPES], *tagp[EVP_MAX_PIPES];
+    void **tags = (void **)&tagp;
+    size_t len[EVP_MAX_PIPES], aadlen[EVP_MAX_PIPES];
+    size_t outsize[EVP_MAX_PIPES], outl[EVP_MAX_PIPES];
+    OSSL_PARAM params[2] = { OSSL_PARAM_END, OSSL_PARAM_END };
+    EVP_CIPHER *cipher = NULL;
+    EVP_CIPHER_CTX *ctx = NULL;
+    size_t i, j, k, last = numpipes - 1;
+    int keylen, ioutl, ret = 0;
+
+    if (!TEST_ptr(cipher = EVP_CIPHER_fetch(testctx,
+                      aes_siv_pipeline_tests[idx].name, testpropq))
+        || !TEST_true(EVP_CIPHER_can_pipeline(cipher, 1))
+        || !TEST_true(EVP_CIPHER_can_pipeline(cipher, 0))
+        || !TEST_ptr(ctx = EVP_CIPHER_CTX_new()))
+        goto err;
+    keylen = EVP_CIPHER_get_key_length(cipher);
+
+    for (j = 0; j < sizeof(key); j++)
+        key[j] = (unsigned char)(j * 5 + idx);
+    for (i = 0; i < numpipes; i++) {
+        /* Partial and whole block payloads and associated data */
+        len[i] = 1 + (i * 67) % 600;
+        aadlen[i] = 1 + (i * 11 + 4) % 40;
+        for (j = 0; j < aadlen[i]; j++)
+            aad[i][j] = (unsigned char)(i + j * 3);
+        for (j = 0; j < len[i]; j++)
+            pt[i][j] = (unsigned char)(i * 5 + j);
+        aadp[i] = aad[i];
+        ptp[i] = pt[i];
+        ctp[i] = ct[i];
+        decp[i] = dec[i];
+        tagp[i] = tag[i];
+        outsize[i] = sizeof(ct[i]);
+    }
+
+    if (!TEST_true(EVP_CipherPipelineEncryptInit(ctx, cipher, key, keylen,
+            numpipes, NULL, 0)))
+        goto err;
+    for (k = 0; k < naad; k++)
+        if (!TEST_true(EVP_CipherPipelineUpdate(ctx, NULL, outl, NULL,
+                (const unsigned char **)aadp, aadlen)))
+            goto err;
+    params[0] = OSSL_PARAM_construct_octet_ptr(
+        OSSL_CIPHER_PARAM_PIPELINE_AEAD_TAG, (void **)&tags, sizeof(tag[0]));
+    if (!TEST_true(EVP_CipherPipelineUpdate(ctx, ctp, outl, outsize,
+            (const unsigned char **)ptp, len))
+        || !TEST_true(EVP_CipherPipelineFinal(ctx, decp, outl, outsize))
+        || !TEST_true(EVP_CIPHER_CTX_get_params(ctx, params)))
+        goto err;
+
+    for (i = 0; i < numpipes; i++) {
+        if (!TEST_true(EVP_CIPHER_CTX_reset(ctx))
+            || !TEST_true(EVP_EncryptInit_ex2(ctx, cipher, key, NULL, NULL)))
+            goto err;
+        for (k = 0; k < naad; k++)
+            if (!TEST_true(EVP_EncryptUpdate(ctx, NULL, &ioutl, aad[i],
+                    (int)aadlen[i])))
+                goto err;
+        if (!TEST_true(EVP_EncryptUpdate(ctx, ref, &ioutl, pt[i],
+                (int)len[i]))
+            || !TEST_true(EVP_EncryptFinal_ex(ctx, ref, &ioutl))
+            || !TEST_true(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG,
+                sizeof(reftag), reftag))
+            || !TEST_mem_eq(ct[i], len[i], ref, len[i])
+            || !TEST_mem_eq(tag[i], sizeof(tag[i]), reftag, sizeof(reftag)))
+            goto err;
+    }
+
+    if (!TEST_true(EVP_CIPHER_CTX_reset(ctx))
+        || !TEST_true(EVP_CipherPipelineDecryptInit(ctx, cipher, key, keylen,
+            numpipes, NULL, 0))
+        || !TEST_true(EVP_CIPHER_CTX_set_params(ctx, params)))
+        goto err;
+    for (k = 0; k < naad; k++)
+        if (!TEST_true(EVP_CipherPipelineUpdate(ctx, NULL, outl, NULL,
+                (const unsigned char **)aadp, aadlen)))
+            goto err;
+    if (!TEST_true(EVP_CipherPipelineUpdate(ctx, decp, outl, outsize,
+            (const unsigned char **)ctp, len))
+        || !TEST_true(EVP_CipherPipelineFinal(ctx, decp, outl, outsize)))
+        goto err;
+    for (i = 0; i < numpipes; i++)
+        if (!TEST_mem_eq(dec[i], len[i], pt[i], len[i]))
+            goto err;
+
+    /*
+     * Decrypt in place, with a corrupted tag on the last pipe, reusing the
+     * context without a reset
+     */
+    tag[last][15] ^= 1;
+    if (!TEST_true(EVP_CipherPipelineDecryptInit(ctx, cipher, key, keylen,
+            numpipes, NULL, 0))
+        || !TEST_true(EVP_CIPHER_CTX_set_params(ctx, params)))
+        goto err;
+    for (k = 0; k < naad; k++)
+        if (!TEST_true(EVP_CipherPipelineUpdate(ctx, NULL, outl, NULL,
+                (const unsigned char **)aadp, aadlen)))
+            goto err;
+    if (!TEST_false(EVP_CipherPipelineUpdate(ctx, ctp, outl, outsize,
+            (const unsigned char **)ctp, len)))
+        goto err;
+    memset(ref, 0, sizeof(ref));
+    for (i = 0; i < last; i++)
+        if (!TEST_mem_eq(ct[i], len[i], pt[i], len[i]))
+            goto err;
+    if (!TEST_mem_eq(ct[last], len[last], ref, len[last]))
+        goto err;
+
+    ret = 1;
+err:
+    EVP_CIPHER_CTX_free(ctx);
+    EVP_CIPHER_free(cipher);
+    return ret;
+}
+#endif
+
+#ifndef OPENSSL_NO_CMAC
+static const char *mac_batch_tests[] = { "CMAC", "HMAC" };
+
+/*
+ * EVP_MAC_batch() must give the MAC of each message appended to the data
+ * already in the context, and leave the context unchanged.  CMAC has its
+ * own batch function, HMAC uses the generic loop.
+ */
+static int test_evp_mac_batch(int idx)
+{
+    static const size_t lens[] = { 0, 1, 15, 16, 17, 100, 513, 1024, 31, 32,
+        4096, 48 };
+    const char *name = mac_batch_tests[idx];
+    unsigned char key[32], data[4096 + 64];
+    unsigned char *mac[OSSL_NELEM(lens)], *msg[OSSL_NELEM(lens)];
+    unsigned char ref[EVP_MAX_MD_SIZE];
+    size_t reflen, maclen, i, pre;
+    OSSL_PARAM params[2];
+    EVP_MAC *evpmac = NULL;
+    EVP_MAC_CTX *ctx = NULL, *ctx2 = NULL;
+    int ret = 0;
+
+    for (i = 0; i < OSSL_NELEM(lens); i++)
+        mac[i] = NULL;
+    for (i = 0; i < sizeof(key); i++)
+        key[i] = (unsigned char)(i * 3 + 1);
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i * 7);
+
+    if (idx == 0)
+        params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_CIPHER,
+            "AES-256-CBC", 0);
+    else
+        params[0] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+            "SHA256", 0);
+    params[1] = OSSL_PARAM_construct_end();
+
+    if (!TEST_ptr(evpmac = EVP_MAC_fetch(testctx, name, testpropq))
+        || !TEST_ptr(ctx = EVP_MAC_CTX_new(evpmac))
+        || !TEST_true(EVP_MAC_init(ctx, key, sizeof(key), params)))
+        goto err;
+    maclen = EVP_MAC_CTX_get_mac_size(ctx);
+    for (i = 0; i < OSSL_NELEM(lens); i++) {
+        msg[i] = data + i * 5;
+        if (!TEST_ptr(mac[i] = OPENSSL_malloc(maclen)))
+            goto err;
+    }
+    if (!TEST_true(EVP_MAC_batch(ctx, NULL, NULL, NULL, maclen, 0))
+        || !TEST_false(EVP_MAC_batch(ctx, (const unsigned char **)msg, lens,
+            mac, maclen - 1, OSSL_NELEM(lens))))
+        goto err;
+
+    /* A fresh context first, then one with a prefix of data */
+    for (pre = 0; pre <= 21; pre += 21) {
+        if (pre > 0 && !TEST_true(EVP_MAC_update(ctx, data, pre)))
+            goto err;
+        if (!TEST_true(EVP_MAC_batch(ctx, (const unsigned char **)msg, lens,
+                mac, maclen, OSSL_NELEM(lens))))
+            goto err;
+        for (i = 0; i < OSSL_NELEM(lens); i++) {
+            if (!TEST_ptr(ctx2 = EVP_MAC_CTX_dup(ctx))
+                || !TEST_true(EVP_MAC_update(ctx2, msg[i], lens[i]))
+                || !TEST_true(EVP_MAC_final(ctx2, ref, &reflen, sizeof(ref)))
+                || !TEST_mem_eq(mac[i], maclen, ref, reflen))
+                goto err;
+            EVP_MAC_CTX_free(ctx2);
+            ctx2 = NULL;
+        }
+    }
+
+    /* The context still gives the MAC of the prefix alone */
+    if (!TEST_true(EVP_MAC_final(ctx, ref, &reflen, sizeof(ref)))
+        || !TEST_true(EVP_MAC_init(ctx, NULL, 0, NULL))
+        || !TEST_true(EVP_MAC_update(ctx, data, 21))
+        || !TEST_true(EVP_MAC_final(ctx, mac[0], &maclen, maclen))
+        || !TEST_mem_eq(mac[0], maclen, ref, reflen))
+        goto err;
+
+    ret = 1;
+err:
+    for (i = 0; i < OSSL_NELEM(lens); i++)
+        OPENSSL_free(mac[i]);
+    EVP_MAC_CTX_free(ctx2);
+    EVP_MAC_CTX_free(ctx);
+    EVP_MAC_free(evpmac);
+    return ret;
+}
+#endif
+
+static const char *digest_batch_tests[] = {
+    "SHA1", "SHA224", "SHA256", "SHA384", "SHA512", "SHA512-224",
+    "SHA3-256", "SHA3-512", "KECCAK-256", "SHAKE128", "SHAKE256", "SM3", "MD5"
+};
+
+/*
+ * EVP_DigestBatch() must give the digest of each message appended to the
+ * data already in the context, and leave the context unchanged.  Runs of
+ * equal lengths and lengths around the block sizes exercise the multi-lane
+ * paths, MD5 uses the generic loop.
+ */
+static int test_evp_digest_batch(int idx)
+{
+    static const size_t lens[] = { 64, 64, 64, 64, 0, 1, 55, 56, 63, 111,
+        112, 127, 128, 135, 136, 167, 168, 300, 1000, 4096, 33 };
+    const char *name = digest_batch_tests[idx];
+    unsigned char data[8192];
+    unsigned char *md[OSSL_NELEM(lens)], *msg[OSSL_NELEM(lens)];
+    unsigned char ref[256];
+    size_t mdlen, i, n, p;
+    size_t pre[3];
+    unsigned int reflen;
+    EVP_MD *evpmd = NULL;
+    EVP_MD_CTX *ctx = NULL, *ctx2 = NULL;
+    int xof, ret = 0;
+
+    for (i = 0; i < OSSL_NELEM(lens); i++)
+        md[i] = NULL;
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = (unsigned char)(i * 7 + (i >> 8));
+
+    if ((evpmd = EVP_MD_fetch(testctx, name, testpropq)) == NULL)
+        return TEST_skip("%s is not available", name);
+    xof = EVP_MD_xof(evpmd);
+    /* XOFs squeeze more than a block's worth to cover the squeeze loop */
+    mdlen = xof ? 200 : (size_t)EVP_MD_get_size(evpmd);
+    pre[0] = 0;
+    pre[1] = 21;
+    pre[2] = 2 * (size_t)EVP_MD_get_block_size(evpmd);
+    for (i = 0; i < OSSL_NELEM(lens); i++) {
+        msg[i] = data + pre[2] + i * 5;
+        if (!TEST_ptr(md[i] = OPENSSL_malloc(mdlen)))
+            goto err;
+    }
+
+    if (!TEST_ptr(ctx = EVP_MD_CTX_new())
+        || !TEST_ptr(ctx2 = EVP_MD_CTX_new())
+        || !TEST_true(EVP_DigestInit_ex2(ctx, evpmd, NULL))
+        || !TEST_true(EVP_DigestBatch(ctx, NULL, NULL, NULL, mdlen, 0)))
+        goto err;
+    if (!xof
+        && !TEST_false(EVP_DigestBatch(ctx, (const unsigned char **)msg, lens,
+            md, mdlen - 1, OSSL_NELEM(lens))))
+        goto err;
+
+    /*
+     * A fresh context, then a partial block of prefix, then a prefix of
+     * whole blocks, each with two, three and all of the messages
+     */
+    for (p = 0; p < OSSL_NELEM(pre); p++) {
+        if (!TEST_true(EVP_DigestInit_ex2(ctx, evpmd, NULL))
+            || !TEST_true(EVP_DigestUpdate(ctx, data, pre[p])))
+            goto err;
+        for (n = 2; n <= OSSL_NELEM(lens); n = n == 3 ? OSSL_NELEM(lens) : n + 1) {
+            if (!TEST_true(EVP_DigestBatch(ctx, (const unsigned char **)msg,
+                    lens, md, mdlen, n)))
+                goto err;
+            for (i = 0; i < n; i++) {
+                if (!TEST_true(EVP_MD_CTX_copy_ex(ctx2, ctx))
+                    || !TEST_true(EVP_DigestUpdate(ctx2, msg[i], lens[i])))
+                    goto err;
+                if (xof) {
+                    if (!TEST_true(EVP_DigestFinalXOF(ctx2, ref, mdlen)))
+                        goto err;
+                } else if (!TEST_true(EVP_DigestFinal_ex(ctx2, ref, &reflen))) {
+                    goto err;
+                }
+                if (!TEST_mem_eq(md[i], mdlen, ref, mdlen)) {
+                    TEST_info("%s: message %zu of %zu, prefix %zu", name, i, n,
+                        pre[p]);
+                    goto err;
+                }
+            }
+        }
+    }
+
+    /* The context still gives the digest of the prefix alone */
+    if (!TEST_true(EVP_DigestUpdate(ctx, msg[0], lens[0])))
+        goto err;
+    if (xof) {
+        if (!TEST_true(EVP_DigestFinalXOF(ctx, ref, mdlen)))
+            goto err;
+    } else if (!TEST_true(EVP_DigestFinal_ex(ctx, ref, &reflen))) {
+        goto err;
+    }
+    if (!TEST_true(EVP_DigestInit_ex2(ctx, evpmd, NULL))
+        || !TEST_true(EVP_DigestUpdate(ctx, data, pre[2]))
+        || !TEST_true(EVP_DigestBatch(ctx, (const unsigned char **)msg, lens,
+            md, mdlen, 1))
+        || !TEST_mem_eq(md[0], mdlen, ref, mdlen))
+        goto err;
+
+    ret = 1;
+err:
+    for (i = 0; i < OSSL_NELEM(lens); i++)
+        OPENSSL_free(md[i]);
+    EVP_MD_CTX_free(ctx2);
+    EVP_MD_CTX_free(ctx);
+    EVP_MD_free(evpmd);
+    return ret;
+}
+
 #ifndef OPENSSL_NO_DEPRECATED_3_0
 
 static int sign_hits = 0;
@@ -9304,6 +10139,7 @@ int setup_tests(void)
 #ifndef OPENSSL_NO_ECX
     ADD_ALL_TESTS(test_ecx_short_keys, OSSL_NELEM(ecxnids));
     ADD_ALL_TESTS(test_ecx_not_private_key, OSSL_NELEM(keys));
+    ADD_ALL_TESTS(test_ed25519_verify_batch, 6);
 #endif
 
     ADD_TEST(test_sign_continuation);
@@ -9318,6 +10154,7 @@ int setup_tests(void)
 
     /* Test cases for CVE-2026-45446 */
     ADD_TEST(test_aes_gcm_siv_empty_data);
+    ADD_TEST(test_aes_gcm_siv_reuse);
     ADD_TEST(test_aes_siv_ctx_reuse);
 
     ADD_TEST(test_invalid_ctx_for_digest);
@@ -9326,6 +10163,16 @@ int setup_tests(void)
     ADD_TEST(test_aes_xts_rejects_missing_iv);
 
     ADD_TEST(test_evp_cipher_pipeline);
+    ADD_ALL_TESTS(test_aes_ccm_pipeline, OSSL_NELEM(aes_ccm_pipeline_tests));
+#ifndef OPENSSL_NO_SIV
+    ADD_ALL_TESTS(test_aes_siv_pipeline, OSSL_NELEM(aes_siv_pipeline_tests));
+#endif
+#ifndef OPENSSL_NO_CMAC
+    ADD_ALL_TESTS(test_evp_mac_batch, OSSL_NELEM(mac_batch_tests));
+#endif
+    ADD_ALL_TESTS(test_evp_digest_batch, OSSL_NELEM(digest_batch_tests));
+    ADD_ALL_TESTS(test_rsa_sign_batch, 8);
+    ADD_ALL_TESTS(test_verify_batch_fallback, 2);
 
 #ifndef OPENSSL_NO_ML_KEM
     ADD_ALL_TESTS(test_ml_kem_seed_only, 2);
@@ -5786,7 +5786,11 @@ void cleanup_tests(void)
 static int is_digest_disabled(const char *name)
 {
 #ifdef OPENSSL_NO_BLAKE2
-    if (HAS_CASE_PREFIX(name, "BLAKE"))
+    if (HAS_CASE_PREFIX(name, "BLAKE2"))
+        return 1;
+#endif
+#ifdef OPENSSL_NO_BLAKE3
+    if (HAS_CASE_PREFIX(name, "BLAKE3"))
         return 1;
 #endif
 #ifdef OPENSSL_NO_MD2
@@ -5862,6 +5866,10 @@ static int is_mac_disabled(const char *name)
         || HAS_CASE_PREFIX(name, "BLAKE2SMAC"))
         return 1;
 #endif
+#ifdef OPENSSL_NO_BLAKE3
+    if (HAS_CASE_PREFIX(name, "BLAKE3MAC"))
+        return 1;
+#endif
 #ifdef OPENSSL_NO_CMAC
     if (HAS_CASE_PREFIX(name, "CMAC"))
         return 1;
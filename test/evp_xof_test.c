@@ -74,6 +74,44 @@ static const uint8_t cshake256_output[] = {
     0x4a, 0xa8, 0x70, 0xe7, 0x61, 0x6b, 0x0c, 0x3c
 };
 
+#ifndef OPENSSL_NO_BLAKE3
+/* BLAKE3 of shake256_input, 250 bytes cross several 64 byte output blocks */
+static const uint8_t blake3_output[] = {
+    0xf4, 0x8d, 0x8f, 0xbc, 0x7d, 0x87, 0xce, 0xb2,
+    0x38, 0x12, 0xa3, 0x90, 0x9b, 0x8a, 0x92, 0xef,
+    0xd2, 0xd3, 0x1a, 0xa6, 0xd4, 0xb4, 0x03, 0xb9,
+    0x73, 0x94, 0x08, 0x8a, 0x45, 0xf9, 0x4e, 0xf9,
+    0x4f, 0xce, 0xe9, 0x2f, 0x71, 0xc8, 0x40, 0x8c,
+    0x5f, 0xa8, 0xd2, 0xa6, 0xb4, 0xf2, 0xfb, 0x38,
+    0xe2, 0x61, 0x75, 0x64, 0xbb, 0x4d, 0x73, 0xa0,
+    0x76, 0x57, 0xaf, 0x21, 0xb6, 0x8b, 0xd8, 0x5d,
+    0xcb, 0x4b, 0xb0, 0x24, 0x4f, 0x2b, 0xfb, 0x28,
+    0xb4, 0x08, 0x43, 0x15, 0x04, 0xdf, 0x39, 0xdf,
+    0x69, 0xf8, 0xec, 0xe8, 0x1c, 0x6d, 0xd0, 0x2e,
+    0xd6, 0x47, 0x71, 0xc6, 0xc5, 0x3e, 0x94, 0x7d,
+    0x2a, 0x8e, 0xdf, 0x84, 0x9e, 0xdc, 0xc2, 0x13,
+    0xde, 0x50, 0x72, 0x30, 0x8e, 0xa8, 0xf6, 0xe4,
+    0xff, 0x7b, 0x03, 0x03, 0xa5, 0xcc, 0xf1, 0xcd,
+    0x57, 0xaa, 0xbc, 0x6b, 0x2b, 0xbf, 0xd0, 0xff,
+    0x7b, 0x35, 0x2d, 0x6c, 0xf5, 0x90, 0x10, 0x3b,
+    0x78, 0xfb, 0xe6, 0xfd, 0x4e, 0x56, 0x7c, 0x52,
+    0x37, 0xfb, 0xf8, 0x77, 0x4c, 0xe8, 0xf9, 0x0d,
+    0x2b, 0x68, 0x21, 0xda, 0x94, 0x9a, 0xcc, 0x2a,
+    0xf8, 0xde, 0xe8, 0xd6, 0xef, 0x36, 0x33, 0x1d,
+    0xa5, 0x10, 0x70, 0x8b, 0x80, 0x37, 0x27, 0x67,
+    0x62, 0x94, 0x6e, 0x02, 0x44, 0xa8, 0xd2, 0xe7,
+    0xfe, 0xb0, 0x7b, 0xe6, 0xcb, 0xae, 0x0d, 0xfb,
+    0x46, 0xfe, 0x72, 0x09, 0x8b, 0x0d, 0x81, 0x6f,
+    0x44, 0x8d, 0xe2, 0xe1, 0x77, 0x41, 0xa6, 0xf1,
+    0xbe, 0x19, 0xf5, 0xeb, 0x91, 0x91, 0x88, 0xd3,
+    0x51, 0xf8, 0x65, 0x1b, 0xa6, 0x0e, 0xca, 0xd3,
+    0xab, 0x4b, 0xa9, 0x52, 0x3c, 0xa9, 0x90, 0x49,
+    0x2f, 0x13, 0xd6, 0x52, 0xb6, 0xbc, 0xe1, 0x1a,
+    0x8c, 0xa6, 0x8f, 0xfb, 0x9b, 0x38, 0xf2, 0x2b,
+    0xe4, 0x88
+};
+#endif
+
 typedef struct test_data_st {
     const char *alg;
     const uint8_t *in;
@@ -103,6 +141,12 @@ static const TEST_DATA xof_test_data[] = {
         64,
         "KMAC",
         "Custom" },
+#ifndef OPENSSL_NO_BLAKE3
+    { "BLAKE3",
+        shake256_input, sizeof(shake256_input),
+        blake3_output, sizeof(blake3_output),
+        32 },
+#endif
 };
 
 static const unsigned char shake256_largemsg_input[] = {
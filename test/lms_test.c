@@ -388,10 +388,15 @@ end:
     return ret;
 }
 
-static int lms_verify_bad_sig_test(void)
+/*
+ * If |tst| is non zero then the valid signature is verified first, so that the
+ * corrupted signatures are checked against the tree nodes cached by the key.
+ * The last test uses SHA256 rather than SHAKE.
+ */
+static int lms_verify_bad_sig_test(int tst)
 {
     int ret = 0, i = 0;
-    LMS_ACVP_TEST_DATA *td = &lms_testdata[1];
+    LMS_ACVP_TEST_DATA *td = &lms_testdata[tst == 2 ? 0 : 1];
     EVP_PKEY *pkey = NULL;
     EVP_SIGNATURE *sig = NULL;
     EVP_PKEY_CTX *ctx = NULL;
@@ -420,6 +425,12 @@ static int lms_verify_bad_sig_test(void)
     if (!TEST_int_eq(EVP_PKEY_verify_message_init(ctx, sig, NULL), 1))
         goto end;
 
+    if (tst != 0
+        && !TEST_int_eq(EVP_PKEY_verify(ctx, td->sig, td->siglen,
+                            td->msg, td->msglen),
+            1))
+        goto end;
+
     for (i = 0; i < (int)td->siglen; i += step) {
         sig_data[i] ^= corrupt_mask; /* corrupt a byte */
         if (i > 0)
@@ -435,6 +446,12 @@ static int lms_verify_bad_sig_test(void)
         }
     }
 
+    /* The valid signature still verifies */
+    if (!TEST_int_eq(EVP_PKEY_verify(ctx, td->sig, td->siglen,
+                         td->msg, td->msglen),
+            1))
+        goto end;
+
     ret = 1;
 end:
     EVP_SIGNATURE_free(sig);
@@ -604,7 +621,7 @@ int setup_tests(void)
     ADD_TEST(lms_message_signing_fail_test);
     ADD_TEST(lms_paramgen_fail_test);
     ADD_TEST(lms_keygen_fail_test);
-    ADD_TEST(lms_verify_bad_sig_test);
+    ADD_ALL_TESTS(lms_verify_bad_sig_test, 3);
     ADD_TEST(lms_verify_bad_sig_len_test);
     ADD_TEST(lms_verify_bad_pub_sig_test);
 
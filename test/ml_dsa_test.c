@@ -211,6 +211,104 @@ err:
     return ret;
 }
 
+/*
+ * Sign the known answer tests with an expanded private key, and verify the
+ * result with duplicated and expanded public keys.
+ */
+static int ml_dsa_precompute_test(int tst_id)
+{
+    int ret = 0;
+    const ML_DSA_SIG_GEN_TEST_DATA *td = &ml_dsa_siggen_testdata[tst_id];
+    EVP_PKEY_CTX *sctx = NULL, *vctx = NULL;
+    EVP_PKEY *pkey = NULL, *pkey_copy = NULL, *pub = NULL;
+    EVP_SIGNATURE *sig_alg = NULL;
+    OSSL_PARAM params[4], vparams[2], *p = params;
+    uint8_t *psig = NULL, *pubenc = NULL;
+    size_t psig_len = 0, pubenc_len = 0;
+    uint8_t digest[32];
+    size_t digest_len = sizeof(digest);
+    int encode = 0, deterministic = 1;
+
+    *p++ = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_DETERMINISTIC, &deterministic);
+    *p++ = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_MESSAGE_ENCODING, &encode);
+    if (td->add_random != NULL)
+        *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_TEST_ENTROPY,
+            (char *)td->add_random,
+            td->add_random_len);
+    *p = OSSL_PARAM_construct_end();
+    vparams[0] = params[1];
+    vparams[1] = OSSL_PARAM_construct_end();
+
+    if (!TEST_true(ml_dsa_create_keypair(&pkey, td->alg, td->priv, td->priv_len,
+            NULL, 0, 1))
+        || !TEST_true(EVP_PKEY_set_int_param(pkey,
+            OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, 1))
+        /* The expanded key is kept while the key may be shared */
+        || !TEST_true(EVP_PKEY_set_int_param(pkey,
+            OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, 1))
+        || !TEST_false(EVP_PKEY_set_int_param(pkey,
+            OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, 0))
+        || !TEST_ptr(sctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, pkey, NULL))
+        || !TEST_ptr(sig_alg = EVP_SIGNATURE_fetch(lib_ctx, td->alg, NULL))
+        || !TEST_int_eq(EVP_PKEY_sign_message_init(sctx, sig_alg, params), 1)
+        || !TEST_int_eq(EVP_PKEY_sign(sctx, NULL, &psig_len,
+                            td->msg, td->msg_len),
+            1)
+        || !TEST_ptr(psig = OPENSSL_zalloc(psig_len))
+        || !TEST_int_eq(EVP_PKEY_sign(sctx, psig, &psig_len,
+                            td->msg, td->msg_len),
+            1)
+        || !TEST_int_eq(EVP_Q_digest(lib_ctx, "SHA256", NULL, psig, psig_len,
+                            digest, &digest_len),
+            1)
+        || !TEST_mem_eq(digest, digest_len, td->sig_digest, td->sig_digest_len))
+        goto err;
+
+    /* A duplicate keeps the expanded key */
+    if (!TEST_ptr(pkey_copy = EVP_PKEY_dup(pkey))
+        || !TEST_ptr(vctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, pkey_copy, NULL))
+        || !TEST_int_eq(EVP_PKEY_verify_message_init(vctx, sig_alg, vparams), 1)
+        || !TEST_int_eq(EVP_PKEY_verify(vctx, psig, psig_len,
+                            td->msg, td->msg_len),
+            1))
+        goto err;
+    EVP_PKEY_CTX_free(vctx);
+    vctx = NULL;
+
+    /* An expanded public key */
+    if (!TEST_true(EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PUB_KEY,
+            NULL, 0, &pubenc_len))
+        || !TEST_ptr(pubenc = OPENSSL_malloc(pubenc_len))
+        || !TEST_true(EVP_PKEY_get_octet_string_param(pkey, OSSL_PKEY_PARAM_PUB_KEY,
+            pubenc, pubenc_len, &pubenc_len))
+        || !TEST_true(ml_dsa_create_keypair(&pub, td->alg, NULL, 0,
+            pubenc, pubenc_len, 1))
+        || !TEST_true(EVP_PKEY_set_int_param(pub,
+            OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, 1))
+        || !TEST_ptr(vctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, pub, NULL))
+        || !TEST_int_eq(EVP_PKEY_verify_message_init(vctx, sig_alg, vparams), 1)
+        || !TEST_int_eq(EVP_PKEY_verify(vctx, psig, psig_len,
+                            td->msg, td->msg_len),
+            1))
+        goto err;
+    psig[0] ^= 1;
+    if (!TEST_int_eq(EVP_PKEY_verify(vctx, psig, psig_len,
+                         td->msg, td->msg_len),
+            0))
+        goto err;
+    ret = 1;
+err:
+    EVP_SIGNATURE_free(sig_alg);
+    EVP_PKEY_free(pkey);
+    EVP_PKEY_free(pkey_copy);
+    EVP_PKEY_free(pub);
+    EVP_PKEY_CTX_free(sctx);
+    EVP_PKEY_CTX_free(vctx);
+    OPENSSL_free(psig);
+    OPENSSL_free(pubenc);
+    return ret;
+}
+
 static int ml_dsa_siggen_upd_test(int tst_id)
 {
     int ret = 0;
@@ -550,6 +648,95 @@ static int ml_dsa_87_sign_verify_test(int tstid)
     return do_ml_dsa_sign_verify("ML-DSA-87", tstid);
 }
 
+static int ml_dsa_verify_batch_test(int tstid)
+{
+    static const char *algs[] = { "ML-DSA-44", "ML-DSA-65", "ML-DSA-87" };
+    /* Signatures 1, 4 and 6 are made invalid below */
+    static const int expected[] = { 1, 0, 1, 1, 0, 1, 0 };
+    int ret = 0, i, results[OSSL_NELEM(expected)];
+    const char *alg = algs[tstid % OSSL_NELEM(algs)];
+    int precompute = tstid >= (int)OSSL_NELEM(algs), encode = 1;
+    EVP_PKEY_CTX *sctx = NULL, *vctx = NULL;
+    EVP_PKEY *key = NULL;
+    EVP_SIGNATURE *sig_alg = NULL;
+    uint8_t msgbuf[64], *sigs[OSSL_NELEM(expected)] = { NULL };
+    const uint8_t *tbs[OSSL_NELEM(expected)];
+    size_t tbslens[OSSL_NELEM(expected)], siglens[OSSL_NELEM(expected)];
+    OSSL_PARAM params[3];
+
+    params[0] = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_MESSAGE_ENCODING,
+        &encode);
+    params[1] = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+        ctx1, sizeof(ctx1));
+    params[2] = OSSL_PARAM_construct_end();
+    for (i = 0; i < (int)sizeof(msgbuf); i++)
+        msgbuf[i] = (uint8_t)i;
+
+    if (!TEST_ptr(key = do_gen_key(alg, NULL, 0))
+        || (precompute
+            && !TEST_true(EVP_PKEY_set_int_param(key,
+                OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE, 1)))
+        || !TEST_ptr(sctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, key, NULL))
+        || !TEST_ptr(vctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, key, NULL))
+        || !TEST_ptr(sig_alg = EVP_SIGNATURE_fetch(lib_ctx, alg, NULL))
+        || !TEST_int_eq(EVP_PKEY_sign_message_init(sctx, sig_alg, params), 1))
+        goto err;
+
+    /* Sign messages of different lengths */
+    for (i = 0; i < (int)OSSL_NELEM(expected); i++) {
+        tbs[i] = msgbuf;
+        tbslens[i] = 1 + 9 * i;
+        if (!TEST_int_eq(EVP_PKEY_sign(sctx, NULL, &siglens[i],
+                             tbs[i], tbslens[i]),
+                1)
+            || !TEST_ptr(sigs[i] = OPENSSL_zalloc(siglens[i]))
+            || !TEST_int_eq(EVP_PKEY_sign(sctx, sigs[i], &siglens[i],
+                                tbs[i], tbslens[i]),
+                1))
+            goto err;
+    }
+
+    if (!TEST_int_eq(EVP_PKEY_verify_message_init(vctx, sig_alg, params), 1)
+        || !TEST_int_eq(EVP_PKEY_verify_message_batch(vctx,
+                            (const uint8_t *const *)sigs, siglens,
+                            tbs, tbslens, results,
+                            OSSL_NELEM(expected)),
+            1))
+        goto err;
+    for (i = 0; i < (int)OSSL_NELEM(expected); i++)
+        if (!TEST_int_eq(results[i], 1))
+            goto err;
+
+    /* A corrupted signature, a truncated signature and the wrong message */
+    sigs[1][siglens[1] / 2] ^= 1;
+    siglens[4]--;
+    tbslens[6]--;
+    if (!TEST_int_eq(EVP_PKEY_verify_message_batch(vctx,
+                         (const uint8_t *const *)sigs, siglens,
+                         tbs, tbslens, results,
+                         OSSL_NELEM(expected)),
+            0))
+        goto err;
+    for (i = 0; i < (int)OSSL_NELEM(expected); i++)
+        if (!TEST_int_eq(results[i], expected[i]))
+            goto err;
+
+    /* The context can still be used for a one-shot verification */
+    if (!TEST_int_eq(EVP_PKEY_verify(vctx, sigs[0], siglens[0],
+                         tbs[0], tbslens[0]),
+            1))
+        goto err;
+    ret = 1;
+err:
+    for (i = 0; i < (int)OSSL_NELEM(expected); i++)
+        OPENSSL_free(sigs[i]);
+    EVP_SIGNATURE_free(sig_alg);
+    EVP_PKEY_CTX_free(sctx);
+    EVP_PKEY_CTX_free(vctx);
+    EVP_PKEY_free(key);
+    return ret;
+}
+
 static int ml_dsa_digest_sign_verify_test(void)
 {
     int ret = 0;
@@ -787,6 +974,8 @@ int setup_tests(void)
         ADD_ALL_TESTS(ml_dsa_siggen_upd_test, OSSL_NELEM(ml_dsa_siggen_testdata));
         ADD_ALL_TESTS(ml_dsa_sigver_upd_test, OSSL_NELEM(ml_dsa_sigver_testdata));
     }
+    if (fips_provider_version_ge(lib_ctx, 4, 1, 0))
+        ADD_ALL_TESTS(ml_dsa_precompute_test, OSSL_NELEM(ml_dsa_siggen_testdata));
     ADD_TEST(ml_dsa_key_dup_test);
     ADD_TEST(ml_dsa_key_internal_test);
     ADD_TEST(ml_dsa_keygen_drbg_test);
@@ -796,6 +985,8 @@ int setup_tests(void)
     ADD_TEST(from_data_invalid_public_test);
     ADD_TEST(from_data_bad_input_test);
     ADD_TEST(ml_dsa_digest_sign_verify_test);
+    if (fips_provider_version_ge(lib_ctx, 4, 1, 0))
+        ADD_ALL_TESTS(ml_dsa_verify_batch_test, 3 * 2); /* with and without precompute */
     ADD_TEST(ml_dsa_priv_pub_bad_t0_test);
 
     /*
@@ -168,10 +168,12 @@ my @defltfiles = qw(
                      evpkdf_scrypt.txt
                      evpkdf_tls11_prf.txt
                      evpmac_blake.txt
+                     evpmac_blake3.txt
                      evpmac_poly1305.txt
                      evpmac_siphash.txt
                      evpmac_sm3.txt
                      evpmd_blake.txt
+                     evpmd_blake3.txt
                      evpmd_md.txt
                      evpmd_mdc2.txt
                      evpmd_ripemd.txt
@@ -192,9 +194,18 @@ push @defltfiles, qw(evpciph_aes_siv.txt) unless $no_siv;
 push @defltfiles, qw(evpkdf_argon2.txt) unless $no_argon2;
 push @defltfiles, qw(evpkdf_hmac_drbg.txt) unless $no_determinstic_nonce;
 
+# Tests that are run again with CPU capabilities masked off in
+# OPENSSL_ia32cap, to cover the code paths for x86 CPUs without them.
+# Only the words 2 and 3 are masked, the others are left as detected.
+my %capfiles = (
+    'evpkdf_pbkdf2.txt' => ':~0x20000000:~0:~0:~0', # SHA extensions
+    'evpciph_aes_ocb.txt' => ':~0x20000000000:~0:~0:~0', # VAES
+);
+
 plan tests =>
     + (scalar(@configs) * scalar(@files))
     + scalar(@defltfiles)
+    + scalar(keys %capfiles)
     + 3; # error output tests
 
 foreach (@configs) {
@@ -216,6 +227,15 @@ foreach my $f ( @defltfiles ) {
        "running evp_test -config $conf $f");
 }
 
+foreach my $f ( sort keys %capfiles ) {
+    local $ENV{OPENSSL_ia32cap} = $capfiles{$f};
+
+    ok(run(test(["evp_test",
+                 "-config", $conf,
+                 data_file("$f")])),
+       "running evp_test -config $conf $f with OPENSSL_ia32cap=$ENV{OPENSSL_ia32cap}");
+}
+
 # test_errors OPTIONS
 #
 # OPTIONS may include:
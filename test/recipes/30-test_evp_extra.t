@@ -17,7 +17,7 @@ setup("test_evp_extra");
 
 my $no_conf_autoload = disabled('autoload-config');
 
-plan tests => $no_conf_autoload ? 3 : 4;
+plan tests => $no_conf_autoload ? 4 : 5;
 
 ok(run(test(["evp_extra_test"])), "running evp_extra_test");
 
@@ -32,3 +32,10 @@ unless ($no_conf_autoload) {
 ok(run(test(["evp_extra_test", "-context"])), "running evp_extra_test with a non-default library context");
 
 ok(run(test(["evp_extra_test2"])), "running evp_extra_test2");
+
+# The multi-buffer digests without the SHA extensions and AVX2
+{
+    local $ENV{OPENSSL_ia32cap} = ":~0x20000020:~0:~0:~0";
+    ok(run(test(["evp_extra_test", "-test", "test_evp_digest_batch"])),
+       "running the digest batch tests without SHA and AVX2");
+}
@@ -12,6 +12,7 @@
 #include <openssl/param_build.h>
 #include <openssl/rand.h>
 #include <openssl/pem.h>
+#include <openssl/thread.h>
 #include "crypto/slh_dsa.h"
 #include "internal/nelem.h"
 #include "testutil.h"
@@ -240,14 +241,14 @@ err:
     return ret;
 }
 
-static int slh_dsa_sign_verify_test(int tst_id)
+static int do_slh_dsa_sign_verify(int tst_id, unsigned int threads)
 {
     int ret = 0;
     SLH_DSA_SIG_TEST_DATA *td = &slh_dsa_sig_testdata[tst_id];
     EVP_PKEY_CTX *sctx = NULL;
     EVP_PKEY *pkey = NULL;
     EVP_SIGNATURE *sig_alg = NULL;
-    OSSL_PARAM params[4], *p = params;
+    OSSL_PARAM params[5], *p = params;
     uint8_t *psig = NULL;
     size_t psig_len = 0, sig_len2 = 0;
     uint8_t digest[32];
@@ -260,6 +261,8 @@ static int slh_dsa_sign_verify_test(int tst_id)
         *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_TEST_ENTROPY,
             (char *)td->add_random,
             td->add_random_len);
+    if (threads > 1)
+        *p++ = OSSL_PARAM_construct_uint(OSSL_SIGNATURE_PARAM_THREADS, &threads);
     *p = OSSL_PARAM_construct_end();
 
     /*
@@ -303,6 +306,30 @@ err:
     return ret;
 }
 
+static int slh_dsa_sign_verify_test(int tst_id)
+{
+    return do_slh_dsa_sign_verify(tst_id, 1);
+}
+
+/*
+ * Multi-threaded signing must produce the same signatures. If there is no
+ * thread pool support the work is done by the calling thread instead.
+ */
+static int slh_dsa_sign_verify_threads_test(int tst_id)
+{
+    int ret, threads = (OSSL_get_thread_support_flags()
+                           & OSSL_THREAD_SUPPORT_FLAG_DEFAULT_SPAWN)
+        != 0;
+
+    if (threads && !TEST_true(OSSL_set_max_threads(lib_ctx, 4)))
+        return 0;
+    ret = do_slh_dsa_sign_verify(tst_id, 4);
+    /* The other tests run without threads */
+    if (threads && !TEST_true(OSSL_set_max_threads(lib_ctx, 0)))
+        ret = 0;
+    return ret;
+}
+
 static EVP_PKEY *do_gen_key(const char *alg,
     const uint8_t *seed, size_t seed_len)
 {
@@ -437,6 +464,60 @@ err:
     return ret;
 }
 
+/*
+ * SLH-DSA has no batch verification in the provider, so this tests the
+ * EVP_PKEY_verify_message_batch() fallback to one verification per signature.
+ */
+static int slh_dsa_verify_batch_test(void)
+{
+    int ret = 0, i, results[3];
+    const char *alg = "SLH-DSA-SHA2-128f";
+    EVP_PKEY_CTX *sctx = NULL, *vctx = NULL;
+    EVP_PKEY *key = NULL;
+    EVP_SIGNATURE *sig_alg = NULL;
+    uint8_t msg[] = "Hello World", *sigs[3] = { NULL };
+    const uint8_t *tbs[3];
+    size_t tbslens[3], siglens[3];
+
+    if (!TEST_ptr(key = do_gen_key(alg, NULL, 0))
+        || !TEST_ptr(sctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, key, NULL))
+        || !TEST_ptr(vctx = EVP_PKEY_CTX_new_from_pkey(lib_ctx, key, NULL))
+        || !TEST_ptr(sig_alg = EVP_SIGNATURE_fetch(lib_ctx, alg, NULL))
+        || !TEST_int_eq(EVP_PKEY_sign_message_init(sctx, sig_alg, NULL), 1))
+        goto err;
+    for (i = 0; i < 3; i++) {
+        tbs[i] = msg;
+        tbslens[i] = sizeof(msg) - 1 - i;
+        if (!TEST_int_eq(EVP_PKEY_sign(sctx, NULL, &siglens[i],
+                             tbs[i], tbslens[i]),
+                1)
+            || !TEST_ptr(sigs[i] = OPENSSL_malloc(siglens[i]))
+            || !TEST_int_eq(EVP_PKEY_sign(sctx, sigs[i], &siglens[i],
+                                tbs[i], tbslens[i]),
+                1))
+            goto err;
+    }
+    sigs[1][0] ^= 1;
+    if (!TEST_int_eq(EVP_PKEY_verify_message_init(vctx, sig_alg, NULL), 1)
+        || !TEST_int_eq(EVP_PKEY_verify_message_batch(vctx,
+                            (const uint8_t *const *)sigs, siglens,
+                            tbs, tbslens, results, 3),
+            0)
+        || !TEST_int_eq(results[0], 1)
+        || !TEST_int_eq(results[1], 0)
+        || !TEST_int_eq(results[2], 1))
+        goto err;
+    ret = 1;
+err:
+    for (i = 0; i < 3; i++)
+        OPENSSL_free(sigs[i]);
+    EVP_SIGNATURE_free(sig_alg);
+    EVP_PKEY_CTX_free(sctx);
+    EVP_PKEY_CTX_free(vctx);
+    EVP_PKEY_free(key);
+    return ret;
+}
+
 static int slh_dsa_deterministic_usage_test(void)
 {
     int ret = 0;
@@ -667,7 +748,9 @@ int setup_tests(void)
     ADD_TEST(slh_dsa_key_eq_test);
     ADD_TEST(slh_dsa_usage_test);
     ADD_TEST(slh_dsa_deterministic_usage_test);
+    ADD_TEST(slh_dsa_verify_batch_test);
     ADD_ALL_TESTS(slh_dsa_sign_verify_test, OSSL_NELEM(slh_dsa_sig_testdata));
+    ADD_ALL_TESTS(slh_dsa_sign_verify_threads_test, OSSL_NELEM(slh_dsa_sig_testdata));
     ADD_ALL_TESTS(slh_dsa_keygen_test, OSSL_NELEM(slh_dsa_keygen_testdata));
     ADD_TEST(slh_dsa_digest_sign_verify_test);
     ADD_TEST(slh_dsa_keygen_invalid_test);
@@ -33,6 +33,7 @@
 #include <openssl/param_build.h>
 #include <openssl/x509v3.h>
 #include <openssl/dh.h>
+#include <openssl/thread.h>
 
 #include "helpers/ssltestlib.h"
 #include "testutil.h"
@@ -5931,6 +5932,149 @@ end:
     return testresult;
 }
 
+#if !defined(OSSL_NO_USABLE_TLS1_3) && !defined(OPENSSL_NO_EC)
+#define KEYSHARE_POOL_CONNS 4
+
+typedef struct {
+    unsigned char *key_share[KEYSHARE_POOL_CONNS];
+    size_t key_share_len[KEYSHARE_POOL_CONNS];
+    size_t num;
+} KEYSHARE_POOL_TEST;
+
+static int keyshare_pool_hello_cb(SSL *s, int *al, void *arg)
+{
+    KEYSHARE_POOL_TEST *kst = arg;
+    const unsigned char *ext;
+    size_t len;
+
+    if (kst->num == KEYSHARE_POOL_CONNS
+        || !SSL_client_hello_get0_ext(s, TLSEXT_TYPE_key_share, &ext, &len)
+        || (kst->key_share[kst->num] = OPENSSL_memdup(ext, len)) == NULL)
+        return SSL_CLIENT_HELLO_ERROR;
+    kst->key_share_len[kst->num++] = len;
+    return SSL_CLIENT_HELLO_SUCCESS;
+}
+
+/* Wait up to about ten seconds for the background refill of the pool */
+static int keyshare_pool_wait_full(SSL_CTX *ctx, size_t num)
+{
+    int i;
+
+    for (i = 0; i < 1000 && ssl_keyshare_pool_count(ctx) < num; i++)
+        OSSL_sleep(10);
+    return TEST_size_t_eq(ssl_keyshare_pool_count(ctx), num);
+}
+
+/*
+ * Test the client key share pool
+ * Test 0: Pool filled with SSL_CTX_fill_keyshare_pool()
+ * Test 1: Pool refilled in the background
+ * Test 2: Hybrid group, pool filled with SSL_CTX_fill_keyshare_pool()
+ */
+static int test_keyshare_pool(int idx)
+{
+    SSL_CTX *sctx = NULL, *cctx = NULL;
+    SSL *serverssl = NULL, *clientssl = NULL;
+    KEYSHARE_POOL_TEST kst;
+    const char *group = "secp256r1";
+    size_t i, j;
+    int testresult = 0;
+
+    memset(&kst, 0, sizeof(kst));
+    if (idx == 1
+        && (OSSL_get_thread_support_flags()
+               & OSSL_THREAD_SUPPORT_FLAG_DEFAULT_SPAWN)
+            == 0)
+        return TEST_skip("No thread pool support");
+    if (idx == 2) {
+#if defined(OPENSSL_NO_ML_KEM) || defined(OPENSSL_NO_ECX)
+        return TEST_skip("No hybrid groups available");
+#else
+        if (is_fips)
+            return TEST_skip("X25519MLKEM768 is not supported by the fips provider.");
+        group = "X25519MLKEM768";
+#endif
+    }
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+            TLS_client_method(), TLS1_3_VERSION, TLS1_3_VERSION,
+            &sctx, &cctx, cert, privkey))
+        || !TEST_true(SSL_CTX_set1_groups_list(sctx, group))
+        || !TEST_true(SSL_CTX_set1_groups_list(cctx, group))
+        || !TEST_size_t_eq(SSL_CTX_get_keyshare_pool_size(cctx), 0)
+        || !TEST_true(SSL_CTX_set_keyshare_pool_size(cctx, 2))
+        || !TEST_size_t_eq(SSL_CTX_get_keyshare_pool_size(cctx), 2))
+        goto end;
+    SSL_CTX_set_client_hello_cb(sctx, keyshare_pool_hello_cb, &kst);
+
+    if (idx == 1) {
+        if (!TEST_true(OSSL_set_max_threads(libctx, 1))
+            || !TEST_size_t_eq(ssl_keyshare_pool_count(cctx), 0))
+            goto end;
+    } else if (!TEST_true(SSL_CTX_fill_keyshare_pool(cctx))
+        || !TEST_size_t_eq(ssl_keyshare_pool_count(cctx), 2)) {
+        goto end;
+    }
+
+    for (i = 0; i < KEYSHARE_POOL_CONNS; i++) {
+        /* Drop the pool half way through, the handshake must not notice */
+        if (i == KEYSHARE_POOL_CONNS - 1
+            && (!TEST_true(SSL_CTX_set_keyshare_pool_size(cctx, 0))
+                || !TEST_size_t_eq(SSL_CTX_get_keyshare_pool_size(cctx), 0)
+                || !TEST_size_t_eq(ssl_keyshare_pool_count(cctx), 0)))
+            goto end;
+        if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+                NULL, NULL))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                SSL_ERROR_NONE))
+            || !TEST_str_eq(SSL_get0_group_name(clientssl), group))
+            goto end;
+        SSL_shutdown(clientssl);
+        SSL_shutdown(serverssl);
+        SSL_free(serverssl);
+        SSL_free(clientssl);
+        serverssl = clientssl = NULL;
+
+        if (i == KEYSHARE_POOL_CONNS - 1)
+            break;
+        if (idx == 1) {
+            /* The key taken by the connection is replaced in the background */
+            if (!keyshare_pool_wait_full(cctx, 2))
+                goto end;
+        } else if (i % 2 == 0) {
+            /* Without threads the pool only goes down */
+            if (!TEST_size_t_eq(ssl_keyshare_pool_count(cctx), 1))
+                goto end;
+        } else if (!TEST_size_t_eq(ssl_keyshare_pool_count(cctx), 0)
+            || !TEST_true(SSL_CTX_fill_keyshare_pool(cctx))
+            || !TEST_size_t_eq(ssl_keyshare_pool_count(cctx), 2)) {
+            goto end;
+        }
+    }
+
+    /* Every pooled key must only be used once */
+    if (!TEST_size_t_eq(kst.num, KEYSHARE_POOL_CONNS))
+        goto end;
+    for (i = 0; i < kst.num; i++)
+        for (j = 0; j < i; j++)
+            if (!TEST_mem_ne(kst.key_share[i], kst.key_share_len[i],
+                    kst.key_share[j], kst.key_share_len[j]))
+                goto end;
+
+    testresult = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    for (i = 0; i < kst.num; i++)
+        OPENSSL_free(kst.key_share[i]);
+    if (idx == 1)
+        OSSL_set_max_threads(libctx, 0);
+    return testresult;
+}
+#endif
+
 #if !defined(OPENSSL_NO_TLS1_2) \
     && !defined(OPENSSL_NO_EC)  \
     && !defined(OPENSSL_NO_DH)
@@ -15505,6 +15649,9 @@ int setup_tests(void)
 #else
     /* Test with only TLSv1.3 versions */
     ADD_ALL_TESTS(test_key_exchange, 20);
+#endif
+#if !defined(OSSL_NO_USABLE_TLS1_3) && !defined(OPENSSL_NO_EC)
+    ADD_ALL_TESTS(test_keyshare_pool, 3);
 #endif
     ADD_ALL_TESTS(test_custom_exts, 6);
     ADD_TEST(test_stateless);
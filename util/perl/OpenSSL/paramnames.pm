@@ -176,6 +176,7 @@ my %params = (
     'OSSL_DIGEST_PARAM_FUNCTION_NAME' =>    "function-name", # utf8 string
     'OSSL_DIGEST_PARAM_CUSTOMIZATION' =>    "customization", # utf8 string
     'OSSL_DIGEST_PARAM_PROPERTIES' => '*OSSL_ALG_PARAM_PROPERTIES',# utf8 string
+    'OSSL_DIGEST_PARAM_THREADS' =>    '*OSSL_KDF_PARAM_THREADS',# uint32_t
 
 # external mu digest parameters
     'OSSL_DIGEST_PARAM_MU_PUB_KEY' =>        "pub",                        # octet string
@@ -464,6 +465,7 @@ my %params = (
     'OSSL_PKEY_PARAM_EC_POINT_CONVERSION_FORMAT' => "point-format",
     'OSSL_PKEY_PARAM_EC_GROUP_CHECK_TYPE' =>        "group-check",
     'OSSL_PKEY_PARAM_EC_INCLUDE_PUBLIC' =>          "include-public",
+    'OSSL_PKEY_PARAM_EC_PRECOMPUTE_PUBLIC' =>       "precompute-public",
     'OSSL_PKEY_PARAM_FIPS_SIGN_CHECK' =>            "sign-check",
     'OSSL_PKEY_PARAM_FIPS_APPROVED_INDICATOR' => '*OSSL_ALG_PARAM_FIPS_APPROVED_INDICATOR',
 
@@ -473,6 +475,7 @@ my %params = (
     'OSSL_PKEY_PARAM_ML_DSA_PREFER_SEED' =>      "ml-dsa.prefer_seed",
     'OSSL_PKEY_PARAM_ML_DSA_INPUT_FORMATS' =>    "ml-dsa.input_formats",
     'OSSL_PKEY_PARAM_ML_DSA_OUTPUT_FORMATS' =>   "ml-dsa.output_formats",
+    'OSSL_PKEY_PARAM_ML_DSA_PRECOMPUTE' =>       "ml-dsa.precompute",
 
 # SLH_DSA Key generation parameters
     'OSSL_PKEY_PARAM_SLH_DSA_SEED' =>              "seed",
@@ -518,6 +521,7 @@ my %params = (
     'OSSL_SIGNATURE_PARAM_TEST_ENTROPY' =>       "test-entropy",
     'OSSL_SIGNATURE_PARAM_ADD_RANDOM' =>         "additional-random",
     'OSSL_SIGNATURE_PARAM_TLS_VERSION' =>        "tls-version",
+    'OSSL_SIGNATURE_PARAM_THREADS' =>            '*OSSL_KDF_PARAM_THREADS',
 
 # Asym cipher parameters
     'OSSL_ASYM_CIPHER_PARAM_DIGEST' =>                   '*OSSL_PKEY_PARAM_DIGEST',